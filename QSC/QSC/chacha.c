@@ -1,6 +1,7 @@
 #include "chacha.h"
 #include "intutils.h"
 #include "memutils.h"
+#include "poly1305.h"
 
 #if defined(QSC_SYSTEM_HAS_AVX)
 #	include "intrinsics.h"
@@ -684,6 +685,7 @@ static void chacha_permute_p4x512h(chacha_avx_state* ctxw)
 void qsc_chacha_dispose(qsc_chacha_state* ctx)
 {
 	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
+	ctx->offset = 0;
 }
 
 void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* keyparams)
@@ -731,6 +733,19 @@ void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* ke
 		ctx->state[14] = qsc_intutils_le8to32(keyparams->nonce);
 		ctx->state[15] = qsc_intutils_le8to32(keyparams->nonce + 4);
 	}
+
+	ctx->offset = 0;
+}
+
+void qsc_chacha_set_position(qsc_chacha_state* ctx, uint64_t position)
+{
+	assert(ctx != NULL);
+
+	const uint64_t BLKCTR = position / QSC_CHACHA_BLOCK_SIZE;
+
+	ctx->state[12] = (uint32_t)BLKCTR;
+	ctx->state[13] = (uint32_t)(BLKCTR >> 32);
+	ctx->offset = (size_t)(position % QSC_CHACHA_BLOCK_SIZE);
 }
 
 void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
@@ -744,6 +759,26 @@ void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t*
 
 	oft = 0;
 
+	/* consume the remainder of a partial block after a position change */
+	if (ctx->offset != 0 && length != 0)
+	{
+		uint8_t tmp[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+		const size_t RMDLEN = qsc_intutils_min(QSC_CHACHA_BLOCK_SIZE - ctx->offset, length);
+
+		chacha_permute_p512c(ctx, tmp);
+		chacha_increment(ctx);
+
+		for (i = 0; i < RMDLEN; ++i)
+		{
+			output[i] = input[i] ^ tmp[ctx->offset + i];
+		}
+
+		qsc_memutils_clear(tmp, sizeof(tmp));
+		ctx->offset = 0;
+		oft = RMDLEN;
+		length -= RMDLEN;
+	}
+
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
 	if (length >= CHACHA_AVX512BLOCK_SIZE)
@@ -913,4 +948,139 @@ void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t*
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+void qsc_hchacha_compute(uint8_t* output, const uint8_t* key, const uint8_t* nonce)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(nonce != NULL);
+
+	uint8_t blk[QSC_CHACHA_BLOCK_SIZE];
+	qsc_chacha_state ctx;
+	size_t i;
+
+	ctx.state[0] = 0x61707865ULL;
+	ctx.state[1] = 0x3320646EULL;
+	ctx.state[2] = 0x79622D32ULL;
+	ctx.state[3] = 0x6B206574ULL;
+
+	for (i = 0; i < 8; ++i)
+	{
+		ctx.state[4 + i] = qsc_intutils_le8to32(key + (i * sizeof(uint32_t)));
+	}
+
+	for (i = 0; i < 4; ++i)
+	{
+		ctx.state[12 + i] = qsc_intutils_le8to32(nonce + (i * sizeof(uint32_t)));
+	}
+
+	/* HChaCha is the permutation without the feed-forward; remove the input from rows 0 and 3 */
+	chacha_permute_p512c(&ctx, blk);
+
+	for (i = 0; i < 4; ++i)
+	{
+		qsc_intutils_le32to8(output + (i * sizeof(uint32_t)), qsc_intutils_le8to32(blk + (i * sizeof(uint32_t))) - ctx.state[i]);
+		qsc_intutils_le32to8(output + 16 + (i * sizeof(uint32_t)), qsc_intutils_le8to32(blk + 48 + (i * sizeof(uint32_t))) - ctx.state[12 + i]);
+	}
+
+	qsc_memutils_clear(blk, sizeof(blk));
+	qsc_chacha_dispose(&ctx);
+}
+
+void qsc_xchacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* keyparams)
+{
+	assert(ctx != NULL);
+	assert(keyparams->nonce != NULL);
+	assert(keyparams->key != NULL);
+	assert(keyparams->keylen == QSC_CHACHA_KEY256_SIZE);
+
+	uint8_t skey[QSC_HCHACHA_OUTPUT_SIZE];
+
+	qsc_hchacha_compute(skey, keyparams->key, keyparams->nonce);
+	qsc_chacha_keyparams kp = { skey, QSC_CHACHA_KEY256_SIZE, keyparams->nonce + QSC_HCHACHA_NONCE_SIZE };
+	qsc_chacha_initialize(ctx, &kp);
+	qsc_memutils_clear(skey, sizeof(skey));
+}
+
+static void xchacha_poly1305_mac(uint8_t* output, const uint8_t* key, const uint8_t* associated, size_t adlen, const uint8_t* ciphertext, size_t ctlen)
+{
+	const uint8_t pad[QSC_POLY1305_BLOCK_SIZE] = { 0 };
+	uint8_t lens[2 * sizeof(uint64_t)];
+	qsc_poly1305_state pctx;
+
+	qsc_poly1305_initialize(&pctx, key);
+
+	if (adlen != 0)
+	{
+		qsc_poly1305_update(&pctx, associated, adlen);
+		qsc_poly1305_update(&pctx, pad, (QSC_POLY1305_BLOCK_SIZE - (adlen % QSC_POLY1305_BLOCK_SIZE)) % QSC_POLY1305_BLOCK_SIZE);
+	}
+
+	qsc_poly1305_update(&pctx, ciphertext, ctlen);
+	qsc_poly1305_update(&pctx, pad, (QSC_POLY1305_BLOCK_SIZE - (ctlen % QSC_POLY1305_BLOCK_SIZE)) % QSC_POLY1305_BLOCK_SIZE);
+	qsc_intutils_le64to8(lens, (uint64_t)adlen);
+	qsc_intutils_le64to8(lens + sizeof(uint64_t), (uint64_t)ctlen);
+	qsc_poly1305_update(&pctx, lens, sizeof(lens));
+	qsc_poly1305_finalize(&pctx, output);
+}
+
+static void xchacha_poly1305_load(qsc_chacha_state* ctx, uint8_t* mkey, const uint8_t* nonce, const uint8_t* key)
+{
+	const uint8_t zero[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	uint8_t blk[QSC_CHACHA_BLOCK_SIZE];
+	qsc_chacha_keyparams kp = { key, QSC_CHACHA_KEY256_SIZE, (uint8_t*)nonce };
+
+	/* the Poly1305 key is the first half of key-stream block zero, the message starts at block one */
+	qsc_xchacha_initialize(ctx, &kp);
+	qsc_chacha_transform(ctx, blk, zero, sizeof(blk));
+	memcpy(mkey, blk, QSC_POLY1305_KEY_SIZE);
+	qsc_memutils_clear(blk, sizeof(blk));
+}
+
+void qsc_xchacha_poly1305_encrypt(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* associated, size_t adlen, const uint8_t* nonce, const uint8_t* key)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(associated != NULL || adlen == 0);
+	assert(nonce != NULL);
+	assert(key != NULL);
+
+	uint8_t mkey[QSC_POLY1305_KEY_SIZE];
+	qsc_chacha_state ctx;
+
+	xchacha_poly1305_load(&ctx, mkey, nonce, key);
+	qsc_chacha_transform(&ctx, output, message, msglen);
+	xchacha_poly1305_mac(output + msglen, mkey, associated, adlen, output, msglen);
+
+	qsc_memutils_clear(mkey, sizeof(mkey));
+	qsc_chacha_dispose(&ctx);
+}
+
+bool qsc_xchacha_poly1305_decrypt(uint8_t* output, const uint8_t* input, size_t msglen, const uint8_t* associated, size_t adlen, const uint8_t* nonce, const uint8_t* key)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+	assert(associated != NULL || adlen == 0);
+	assert(nonce != NULL);
+	assert(key != NULL);
+
+	uint8_t code[QSC_XCHACHA_POLY1305_MAC_SIZE];
+	uint8_t mkey[QSC_POLY1305_KEY_SIZE];
+	qsc_chacha_state ctx;
+	bool res;
+
+	xchacha_poly1305_load(&ctx, mkey, nonce, key);
+	xchacha_poly1305_mac(code, mkey, associated, adlen, input, msglen);
+	res = (qsc_intutils_verify(code, input + msglen, QSC_XCHACHA_POLY1305_MAC_SIZE) == 0);
+
+	if (res == true)
+	{
+		qsc_chacha_transform(&ctx, output, input, msglen);
+	}
+
+	qsc_memutils_clear(mkey, sizeof(mkey));
+	qsc_chacha_dispose(&ctx);
+
+	return res;
+}
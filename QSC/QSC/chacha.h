@@ -47,6 +47,37 @@
 * qsc_chacha_transform(&ctx, out, msg, MSG_LEN);
 *
 * \endcode
+*
+* <b>ChaCha random-access decryption example</b> \n
+* \code
+*
+* // decrypt RANGE_LEN bytes of the cipher-text, starting at byte RANGE_START
+* qsc_chacha_state ctx;
+* qsc_chacha_initialize(&ctx, &kp);
+* qsc_chacha_set_position(&ctx, RANGE_START);
+* qsc_chacha_transform(&ctx, out, cpt + RANGE_START, RANGE_LEN);
+*
+* \endcode
+*
+* <b>XChaCha20-Poly1305 encryption example</b> \n
+* \code
+*
+* uint8_t key[QSC_CHACHA_KEY256_SIZE] = {...};
+* uint8_t nonce[QSC_XCHACHA_NONCE_SIZE] = {...};
+* uint8_t ad[AD_LEN] = {...};
+* uint8_t msg[MSG_LEN] = {...};
+* uint8_t cpt[MSG_LEN + QSC_XCHACHA_POLY1305_MAC_SIZE] = { 0 };
+*
+* qsc_xchacha_poly1305_encrypt(cpt, msg, MSG_LEN, ad, AD_LEN, nonce, key);
+*
+* if (qsc_xchacha_poly1305_decrypt(msg, cpt, MSG_LEN, ad, AD_LEN, nonce, key) == false)
+* {
+*	// authentication has failed, do something..
+* }
+*
+* \endcode
+* XChaCha20 extends the nonce to 192 bits; HChaCha20 derives a sub-key from the key and the first 16 bytes of the nonce,
+* and the remaining 8 bytes are used as the ChaCha20 nonce, so random nonces can be used safely with a single key.
 * An implementation of the ChaChaPoly20 stream cipher by Daniel J. Bernstein.
 * Implementation contains AVX, AVX2, and AVX512 intrinsics support.
 * \remarks For usage examples, see chacha_test.h
@@ -87,13 +118,38 @@
 */
 #define QSC_CHACHA_ROUND_COUNT 20
 
+/*!
+* \def QSC_HCHACHA_NONCE_SIZE
+* \brief The size of the HChaCha20 nonce array in bytes
+*/
+#define QSC_HCHACHA_NONCE_SIZE 16
+
+/*!
+* \def QSC_HCHACHA_OUTPUT_SIZE
+* \brief The size of the HChaCha20 derived sub-key in bytes
+*/
+#define QSC_HCHACHA_OUTPUT_SIZE 32
+
+/*!
+* \def QSC_XCHACHA_NONCE_SIZE
+* \brief The size of the XChaCha20 extended nonce array in bytes
+*/
+#define QSC_XCHACHA_NONCE_SIZE 24
+
+/*!
+* \def QSC_XCHACHA_POLY1305_MAC_SIZE
+* \brief The size of the XChaCha20-Poly1305 authentication tag in bytes
+*/
+#define QSC_XCHACHA_POLY1305_MAC_SIZE 16
+
 /*!
 * \struct qsc_chacha_state
 * \brief Internal: contains the qsc_chacha_state state
 */
 QSC_EXPORT_API typedef struct
 {
-	uint32_t state[16];
+	uint32_t state[16];	/*!< the primary state array */
+	size_t offset;		/*!< the key-stream offset within the first block of the next transform */
 } qsc_chacha_state;
 
 /*! 
@@ -144,4 +200,71 @@ QSC_EXPORT_API void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chach
 */
 QSC_EXPORT_API void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+* \brief Set the key-stream position of an initialized state.
+* The block counter is set directly to the block containing the byte position, 
+* and the next call to transform begins at the byte offset within that block.
+* This allows random-access decryption of any range of a cipher-text, 
+* by initializing the state with the original key and nonce and setting the position to the first byte of the range.
+*
+* \warning The cipher must be initialized before this function can be called
+*
+* \param ctx: [struct] The cipher state structure
+* \param position: The byte position in the key-stream
+*/
+QSC_EXPORT_API void qsc_chacha_set_position(qsc_chacha_state* ctx, uint64_t position);
+
+/**
+* \brief Derive a 256-bit sub-key with the HChaCha20 function.
+*
+* \warning The key array must be 32 bytes, and the nonce array 16 bytes in length
+*
+* \param output: The output sub-key array; must be QSC_HCHACHA_OUTPUT_SIZE in length
+* \param key: [const] The 32 byte secret key array
+* \param nonce: [const] The 16 byte nonce array
+*/
+QSC_EXPORT_API void qsc_hchacha_compute(uint8_t* output, const uint8_t* key, const uint8_t* nonce);
+
+/**
+* \brief Initialize the state for XChaCha20 with the secret key and a 192-bit nonce.
+* The state is used with the qsc_chacha_transform and qsc_chacha_dispose functions.
+*
+* \warning The key must be 32 bytes, and the nonce QSC_XCHACHA_NONCE_SIZE bytes in length
+*
+* \param ctx: [struct] The cipher state structure
+* \param keyparams: [const][struct] The secret key and nonce structure
+*/
+QSC_EXPORT_API void qsc_xchacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* keyparams);
+
+/**
+* \brief Encrypt a message with XChaCha20-Poly1305.
+* The cipher-text is written to the output array, followed by the 16 byte authentication tag.
+*
+* \warning The output array must be at least msglen + QSC_XCHACHA_POLY1305_MAC_SIZE in length
+*
+* \param output: The output cipher-text and tag array
+* \param message: [const] The input message array
+* \param msglen: The number of message bytes to encrypt
+* \param associated: [const] The associated data array; can be NULL if adlen is zero
+* \param adlen: The length of the associated data
+* \param nonce: [const] The QSC_XCHACHA_NONCE_SIZE byte nonce array
+* \param key: [const] The 32 byte secret key array
+*/
+QSC_EXPORT_API void qsc_xchacha_poly1305_encrypt(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* associated, size_t adlen, const uint8_t* nonce, const uint8_t* key);
+
+/**
+* \brief Authenticate and decrypt a message with XChaCha20-Poly1305.
+* The tag following the cipher-text is verified before decryption; if authentication fails, the cipher-text is not decrypted.
+*
+* \param output: The output message array; must be at least msglen in length
+* \param input: [const] The cipher-text array, followed by the authentication tag
+* \param msglen: The number of cipher-text bytes, not including the tag
+* \param associated: [const] The associated data array; can be NULL if adlen is zero
+* \param adlen: The length of the associated data
+* \param nonce: [const] The QSC_XCHACHA_NONCE_SIZE byte nonce array
+* \param key: [const] The 32 byte secret key array
+* \return Returns false if authentication fails
+*/
+QSC_EXPORT_API bool qsc_xchacha_poly1305_decrypt(uint8_t* output, const uint8_t* input, size_t msglen, const uint8_t* associated, size_t adlen, const uint8_t* nonce, const uint8_t* key);
+
 #endif
\ No newline at end of file
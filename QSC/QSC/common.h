@@ -239,7 +239,7 @@
 // functions 'borrowed' from Botan ;)
 #	define QSC_SYSTEM_FAST_64X64_MUL(X,Y,Low,High)			\
 	do {													\
-      const uint128_t r = static_cast<uint128_t>(X) * Y;	\
+      const uint128_t r = (uint128_t)(X) * (Y);		\
       *High = (r >> 64) & 0xFFFFFFFFFFFFFFFFULL;			\
       *Low = (r) & 0xFFFFFFFFFFFFFFFFULL;					\
 	} while(0)
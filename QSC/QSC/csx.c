@@ -199,11 +199,21 @@ static void csx_store512(uint8_t* output, const __m512i x)
 	qsc_intutils_le64to8(((uint8_t*)output + 896), tmp[0]);
 }
 
-static void leincrement_512(__m512i* v)
+static void leadd_512(__m512i* lo, __m512i* hi, __m512i x)
+{
+	const __m512i ONE = _mm512_set1_epi64(1);
+	const __m512i SUM = _mm512_add_epi64(*lo, x);
+
+	/* carry into the high nonce word of each lane that wrapped */
+	*hi = _mm512_mask_add_epi64(*hi, _mm512_cmplt_epu64_mask(SUM, *lo), *hi, ONE);
+	*lo = SUM;
+}
+
+static void leincrement_512(__m512i* lo, __m512i* hi)
 {
 	const __m512i NAD = _mm512_set_epi64(8, 8, 8, 8, 8, 8, 8, 8);
 
-	*v = _mm512_add_epi64(*v, NAD);
+	leadd_512(lo, hi, NAD);
 }
 
 static void csx_permute_p8x1024h(csx_avx512_state* ctx)
@@ -376,11 +386,24 @@ static void csx_store256(uint8_t* output, const __m256i x)
 	qsc_intutils_le64to8(((uint8_t*)output + 384), tmp[0]);
 }
 
-static void leincrement_256(__m256i* v)
+static void leadd_256(__m256i* lo, __m256i* hi, __m256i x)
+{
+	const __m256i SGN = _mm256_set1_epi64x((int64_t)0x8000000000000000ULL);
+	const __m256i SUM = _mm256_add_epi64(*lo, x);
+	__m256i cry;
+
+	/* unsigned compare, the lanes that wrapped are set to all ones */
+	cry = _mm256_cmpgt_epi64(_mm256_xor_si256(*lo, SGN), _mm256_xor_si256(SUM, SGN));
+	/* carry into the high nonce word of each lane that wrapped */
+	*hi = _mm256_sub_epi64(*hi, cry);
+	*lo = SUM;
+}
+
+static void leincrement_256(__m256i* lo, __m256i* hi)
 {
 	const __m256i NAD = _mm256_set_epi64x(4, 4, 4, 4);
 
-	*v = _mm256_add_epi64(*v, NAD);
+	leadd_256(lo, hi, NAD);
 }
 
 static void csx_permute_p4x1024h(csx_avx256_state* ctx)
@@ -537,6 +560,22 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 
 	oft = 0;
 
+	/* consume the remainder of a partial block after a position change */
+	if (ctx->offset != 0 && length != 0)
+	{
+		uint8_t tmp[QSC_CSX_BLOCK_SIZE] = { 0 };
+		const size_t RMDLEN = qsc_intutils_min(QSC_CSX_BLOCK_SIZE - ctx->offset, length);
+
+		csx_permute_p1024c(ctx, tmp);
+		csx_increment(ctx);
+		qsc_memutils_copy(output, ((uint8_t*)tmp + ctx->offset), RMDLEN);
+		qsc_memutils_xor(output, input, RMDLEN);
+		qsc_memutils_clear(tmp, sizeof(tmp));
+		ctx->offset = 0;
+		oft = RMDLEN;
+		length -= RMDLEN;
+	}
+
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
 	if (length >= CSX_AVX512_BLOCK)
@@ -552,7 +591,7 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 		}
 
 		/* initialize the nonce */
-		ctxw.state[12] = _mm512_add_epi64(ctxw.state[12], _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+		leadd_512(&ctxw.state[12], &ctxw.state[13], _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7));
 
 		/* process 8 blocks in parallel (uses avx512 if available) */
 		while (length >= CSX_AVX512_BLOCK)
@@ -566,7 +605,7 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 				csx_store512(((uint8_t*)output + oft + (i * 8)), ctxw.outw[i]);
 			}
 
-			leincrement_512(&ctxw.state[12]);
+			leincrement_512(&ctxw.state[12], &ctxw.state[13]);
 			oft += CSX_AVX512_BLOCK;
 			length -= CSX_AVX512_BLOCK;
 		}
@@ -594,7 +633,7 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 		}
 
 		/* initialize the nonce */
-		ctxw.state[12] = _mm256_add_epi64(ctxw.state[12], _mm256_set_epi64x(0, 1, 2, 3));
+		leadd_256(&ctxw.state[12], &ctxw.state[13], _mm256_set_epi64x(0, 1, 2, 3));
 
 		/* process 8 blocks in parallel (uses avx512 if available) */
 		while (length >= CSX_AVX2_BLOCK)
@@ -608,7 +647,7 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 				csx_store256(((uint8_t*)output + oft + (i * 8)), ctxw.outw[i]);
 			}
 
-			leincrement_256(&ctxw.state[12]);
+			leincrement_256(&ctxw.state[12], &ctxw.state[13]);
 			oft += CSX_AVX2_BLOCK;
 			length -= CSX_AVX2_BLOCK;
 		}
@@ -670,6 +709,10 @@ static csx_load(qsc_csx_state* ctx, const uint8_t* key, const uint8_t* nonce, co
 	ctx->state[15] = qsc_intutils_le8to64(((uint8_t*)code + 40));
 
 #endif
+
+	ctx->origin[0] = ctx->state[12];
+	ctx->origin[1] = ctx->state[13];
+	ctx->offset = 0;
 }
 
 static void csx_finalize(qsc_csx_state* ctx, uint8_t* output)
@@ -706,7 +749,9 @@ void qsc_csx_dispose(qsc_csx_state* ctx)
 #endif
 
 		qsc_intutils_clear64(ctx->state, QSC_CSX_STATE_SIZE);
+		qsc_intutils_clear64(ctx->origin, 2);
 		ctx->counter = 0;
+		ctx->offset = 0;
 		ctx->encrypt = false;
 	}
 }
@@ -802,6 +847,18 @@ void qsc_csx_set_associated(qsc_csx_state* ctx, const uint8_t* data, size_t leng
 	}
 }
 
+void qsc_csx_set_position(qsc_csx_state* ctx, uint64_t position)
+{
+	assert(ctx != NULL);
+
+	const uint64_t BLKCTR = position / QSC_CSX_BLOCK_SIZE;
+
+	/* add the block index to the initial nonce with carry */
+	ctx->state[12] = ctx->origin[0] + BLKCTR;
+	ctx->state[13] = ctx->origin[1] + ((ctx->state[12] < ctx->origin[0]) ? 1 : 0);
+	ctx->offset = (size_t)(position % QSC_CSX_BLOCK_SIZE);
+}
+
 bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
 {
 	assert(ctx != NULL);
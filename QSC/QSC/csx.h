@@ -200,6 +200,8 @@ QSC_EXPORT_API typedef struct
 	qsc_keccak_state kstate;				/*!< the kmac state structure */
 #endif
 	uint64_t counter;						/*!< the processed bytes counter */
+	uint64_t origin[2];						/*!< the initial nonce, the origin of the key-stream position */
+	size_t offset;							/*!< the key-stream offset within the first block of the next transform */
 	bool encrypt;							/*!< the transformation mode; true for encryption */
 } qsc_csx_state;
 
@@ -238,6 +240,22 @@ QSC_EXPORT_API void qsc_csx_initialize(qsc_csx_state* ctx, const qsc_csx_keypara
 */
 QSC_EXPORT_API void qsc_csx_set_associated(qsc_csx_state* ctx, const uint8_t* data, size_t length);
 
+/**
+* \brief Set the key-stream position of an initialized state.
+* The nonce counter is set to the initial nonce plus the index of the block containing the byte position,
+* and the next call to transform begins at the byte offset within that block.
+* This allows random-access decryption of any range of a cipher-text,
+* by initializing the state with the original key and nonce and setting the position to the first byte of the range.
+*
+* \warning The cipher must be initialized before this function can be called.
+* In authenticated mode the MAC is chained across transform calls, so a range can not be authenticated on its own;
+* random access is intended for the unauthenticated cipher, with the full cipher-text authenticated separately.
+*
+* \param ctx: [struct] The cipher state structure
+* \param position: The byte position in the key-stream
+*/
+QSC_EXPORT_API void qsc_csx_set_position(qsc_csx_state* ctx, uint64_t position);
+
 /**
 * \brief Transform an array of bytes.
 * In encryption mode, the input plain-text is encrypted and then an authentication MAC code is appended to the ciphertext.
@@ -1,5 +1,27 @@
 #include "dilithium.h"
 #include "dilithiumbase.h"
+#include "memutils.h"
+#include "parallel.h"
+
+#if (QCX_DILITHIUM_MODE == 2)
+#	define dilithium_ksm_generate qsc_dilithium_ksm_generate_m2
+#	define dilithium_ksm_sign qsc_dilithium_ksm_sign_m2
+#	define dilithium_ksm_prepare_sk qsc_dilithium_ksm_prepare_sk_m2
+#	define dilithium_ksm_prepare_pk qsc_dilithium_ksm_prepare_pk_m2
+#	define dilithium_ksm_verify qsc_dilithium_ksm_verify_m2
+#elif (QCX_DILITHIUM_MODE == 3)
+#	define dilithium_ksm_generate qsc_dilithium_ksm_generate_m3
+#	define dilithium_ksm_sign qsc_dilithium_ksm_sign_m3
+#	define dilithium_ksm_prepare_sk qsc_dilithium_ksm_prepare_sk_m3
+#	define dilithium_ksm_prepare_pk qsc_dilithium_ksm_prepare_pk_m3
+#	define dilithium_ksm_verify qsc_dilithium_ksm_verify_m3
+#else
+#	define dilithium_ksm_generate qsc_dilithium_ksm_generate_m4
+#	define dilithium_ksm_sign qsc_dilithium_ksm_sign_m4
+#	define dilithium_ksm_prepare_sk qsc_dilithium_ksm_prepare_sk_m4
+#	define dilithium_ksm_prepare_pk qsc_dilithium_ksm_prepare_pk_m4
+#	define dilithium_ksm_verify qsc_dilithium_ksm_verify_m4
+#endif
 
 void qsc_dilithium_generate_keypair(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
 {
@@ -7,7 +29,7 @@ void qsc_dilithium_generate_keypair(uint8_t* publickey, uint8_t* privatekey, voi
 	assert(privatekey != NULL);
 	assert(rng_generate != NULL);
 
-	qsc_dilithium_ksm_generate(publickey, privatekey, rng_generate);
+	dilithium_ksm_generate(publickey, privatekey, rng_generate);
 }
 
 void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
@@ -18,7 +40,56 @@ void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* mess
 	assert(privatekey != NULL);
 	assert(rng_generate != NULL);
 
-	qsc_dilithium_ksm_sign(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+	dilithium_ksm_sign(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+}
+
+void qsc_dilithium_prepare_privatekey(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey)
+{
+	assert(psk != NULL);
+	assert(privatekey != NULL);
+
+	dilithium_ksm_prepare_sk(psk, privatekey);
+	psk->mode = (qsc_dilithium_modes)QCX_DILITHIUM_MODE;
+}
+
+void qsc_dilithium_prepared_privatekey_dispose(qsc_dilithium_prepared_privatekey* psk)
+{
+	if (psk != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)psk->mat, sizeof(psk->mat));
+		qsc_memutils_clear((uint8_t*)psk->s1, sizeof(psk->s1));
+		qsc_memutils_clear((uint8_t*)psk->s2, sizeof(psk->s2));
+		qsc_memutils_clear((uint8_t*)psk->t0, sizeof(psk->t0));
+		qsc_memutils_clear(psk->key, sizeof(psk->key));
+		qsc_memutils_clear(psk->tr, sizeof(psk->tr));
+		psk->mode = (qsc_dilithium_modes)0;
+	}
+}
+
+void qsc_dilithium_sign_prepared(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signedmsg != NULL);
+	assert(smsglen != NULL);
+	assert(message != NULL);
+	assert(psk != NULL);
+	assert(rng_generate != NULL);
+
+	if (psk->mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_sign_prepared_m2(signedmsg, smsglen, message, msglen, psk, rng_generate);
+	}
+	else if (psk->mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_sign_prepared_m3(signedmsg, smsglen, message, msglen, psk, rng_generate);
+	}
+	else if (psk->mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_sign_prepared_m4(signedmsg, smsglen, message, msglen, psk, rng_generate);
+	}
+	else
+	{
+		*smsglen = 0;
+	}
 }
 
 bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
@@ -30,7 +101,498 @@ bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signe
 
 	bool res;
 
-	res = qsc_dilithium_ksm_verify(message, msglen, signedmsg, smsglen, publickey);
+	res = dilithium_ksm_verify(message, msglen, signedmsg, smsglen, publickey);
+
+	return res;
+}
+
+void qsc_dilithium_prepare_publickey(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey)
+{
+	assert(ppk != NULL);
+	assert(publickey != NULL);
+
+	dilithium_ksm_prepare_pk(ppk, publickey);
+	ppk->mode = (qsc_dilithium_modes)QCX_DILITHIUM_MODE;
+}
+
+static bool dilithium_verify_prepared(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk)
+{
+	bool res;
+
+	res = false;
+
+	if (ppk->mode == DILITHIUM_MODE2)
+	{
+		res = qsc_dilithium_ksm_verify_prepared_m2(message, msglen, signedmsg, smsglen, ppk);
+	}
+	else if (ppk->mode == DILITHIUM_MODE3)
+	{
+		res = qsc_dilithium_ksm_verify_prepared_m3(message, msglen, signedmsg, smsglen, ppk);
+	}
+	else if (ppk->mode == DILITHIUM_MODE4)
+	{
+		res = qsc_dilithium_ksm_verify_prepared_m4(message, msglen, signedmsg, smsglen, ppk);
+	}
+
+	if (res == false)
+	{
+		*msglen = 0;
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_verify_prepared(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk)
+{
+	assert(message != NULL);
+	assert(msglen != NULL);
+	assert(signedmsg != NULL);
+	assert(ppk != NULL);
+
+	bool res;
+
+	res = dilithium_verify_prepared(message, msglen, signedmsg, smsglen, ppk);
 
 	return res;
 }
+
+typedef struct
+{
+	bool* valid;
+	uint8_t* const* messages;
+	size_t* msglens;
+	const uint8_t* const* signedmsgs;
+	const size_t* smsglens;
+	const qsc_dilithium_prepared_publickey* ppk;
+} dilithium_verify_batch_state;
+
+static void dilithium_verify_batch_item(size_t index, void* ctx)
+{
+	dilithium_verify_batch_state* state = (dilithium_verify_batch_state*)ctx;
+
+	/* each item writes only its own result, message and length */
+	state->valid[index] = dilithium_verify_prepared(state->messages[index], &state->msglens[index],
+		state->signedmsgs[index], state->smsglens[index], state->ppk);
+}
+
+size_t qsc_dilithium_verify_batch(bool* valid, uint8_t* const* messages, size_t* msglens, const uint8_t* const* signedmsgs, const size_t* smsglens, size_t count, const qsc_dilithium_prepared_publickey* ppk)
+{
+	assert(valid != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
+	assert(signedmsgs != NULL);
+	assert(smsglens != NULL);
+	assert(ppk != NULL);
+
+	dilithium_verify_batch_state state;
+	size_t i;
+	size_t res;
+
+	state.valid = valid;
+	state.messages = messages;
+	state.msglens = msglens;
+	state.signedmsgs = signedmsgs;
+	state.smsglens = smsglens;
+	state.ppk = ppk;
+	qsc_parallel_state_for(0, count, &state, dilithium_verify_batch_item);
+
+	res = 0;
+
+	for (i = 0; i < count; ++i)
+	{
+		res += (valid[i] == true) ? 1 : 0;
+	}
+
+	return res;
+}
+
+void qsc_dilithium_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	qsc_dilithium_sign_detached_ex(signature, message, msglen, privatekey, rng_generate, (qsc_dilithium_modes)QCX_DILITHIUM_MODE);
+}
+
+bool qsc_dilithium_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = qsc_dilithium_verify_detached_ex(signature, message, msglen, publickey, (qsc_dilithium_modes)QCX_DILITHIUM_MODE);
+
+	return res;
+}
+
+void qsc_dilithium_sign_initialize(qsc_dilithium_stream_state* ctx, const uint8_t* privatekey)
+{
+	assert(ctx != NULL);
+	assert(privatekey != NULL);
+
+	qsc_dilithium_sign_initialize_ex(ctx, privatekey, (qsc_dilithium_modes)QCX_DILITHIUM_MODE);
+}
+
+void qsc_dilithium_sign_update(qsc_dilithium_stream_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_shake_update(&ctx->kstate, keccak_rate_256, message, msglen);
+}
+
+void qsc_dilithium_sign_finalize(qsc_dilithium_stream_state* ctx, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(ctx != NULL);
+	assert(signature != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	if (ctx->mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_sign_finalize_m2(&ctx->kstate, signature, privatekey, rng_generate);
+	}
+	else if (ctx->mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_sign_finalize_m3(&ctx->kstate, signature, privatekey, rng_generate);
+	}
+	else if (ctx->mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_sign_finalize_m4(&ctx->kstate, signature, privatekey, rng_generate);
+	}
+	else
+	{
+		/* the signature length is unknown; clear the smallest signature size */
+		qsc_keccak_dispose(&ctx->kstate);
+		qsc_memutils_clear(signature, QSC_DILITHIUM_MODE2_SIGNATURE_SIZE);
+	}
+}
+
+void qsc_dilithium_verify_initialize(qsc_dilithium_stream_state* ctx, const uint8_t* publickey)
+{
+	assert(ctx != NULL);
+	assert(publickey != NULL);
+
+	qsc_dilithium_verify_initialize_ex(ctx, publickey, (qsc_dilithium_modes)QCX_DILITHIUM_MODE);
+}
+
+void qsc_dilithium_verify_update(qsc_dilithium_stream_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_shake_update(&ctx->kstate, keccak_rate_256, message, msglen);
+}
+
+bool qsc_dilithium_verify_finalize(qsc_dilithium_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	assert(ctx != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx->mode == DILITHIUM_MODE2)
+	{
+		res = qsc_dilithium_ksm_verify_finalize_m2(&ctx->kstate, signature, publickey);
+	}
+	else if (ctx->mode == DILITHIUM_MODE3)
+	{
+		res = qsc_dilithium_ksm_verify_finalize_m3(&ctx->kstate, signature, publickey);
+	}
+	else if (ctx->mode == DILITHIUM_MODE4)
+	{
+		res = qsc_dilithium_ksm_verify_finalize_m4(&ctx->kstate, signature, publickey);
+	}
+	else
+	{
+		qsc_keccak_dispose(&ctx->kstate);
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_generate_keypair_ex(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode)
+{
+	assert(publickey != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	bool res;
+
+	res = true;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_generate_m2(publickey, privatekey, rng_generate);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_generate_m3(publickey, privatekey, rng_generate);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_generate_m4(publickey, privatekey, rng_generate);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+void qsc_dilithium_sign_ex(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode)
+{
+	assert(signedmsg != NULL);
+	assert(smsglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_sign_m2(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_sign_m3(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_sign_m4(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+	}
+	else
+	{
+		*smsglen = 0;
+	}
+}
+
+bool qsc_dilithium_verify_ex(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey, qsc_dilithium_modes mode)
+{
+	assert(message != NULL);
+	assert(msglen != NULL);
+	assert(signedmsg != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		res = qsc_dilithium_ksm_verify_m2(message, msglen, signedmsg, smsglen, publickey);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		res = qsc_dilithium_ksm_verify_m3(message, msglen, signedmsg, smsglen, publickey);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		res = qsc_dilithium_ksm_verify_m4(message, msglen, signedmsg, smsglen, publickey);
+	}
+	else
+	{
+		*msglen = 0;
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_prepare_privatekey_ex(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey, qsc_dilithium_modes mode)
+{
+	assert(psk != NULL);
+	assert(privatekey != NULL);
+
+	bool res;
+
+	res = true;
+	psk->mode = mode;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_prepare_sk_m2(psk, privatekey);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_prepare_sk_m3(psk, privatekey);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_prepare_sk_m4(psk, privatekey);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_prepare_publickey_ex(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey, qsc_dilithium_modes mode)
+{
+	assert(ppk != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = true;
+	ppk->mode = mode;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_prepare_pk_m2(ppk, publickey);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_prepare_pk_m3(ppk, publickey);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_prepare_pk_m4(ppk, publickey);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_sign_detached_ex(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	qsc_dilithium_stream_state ctx;
+	bool res;
+
+	res = qsc_dilithium_sign_initialize_ex(&ctx, privatekey, mode);
+	qsc_shake_update(&ctx.kstate, keccak_rate_256, message, msglen);
+	qsc_dilithium_sign_finalize(&ctx, signature, privatekey, rng_generate);
+
+	return res;
+}
+
+bool qsc_dilithium_verify_detached_ex(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey, qsc_dilithium_modes mode)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	qsc_dilithium_stream_state ctx;
+	bool res;
+
+	res = false;
+
+	if (qsc_dilithium_verify_initialize_ex(&ctx, publickey, mode) == true)
+	{
+		qsc_shake_update(&ctx.kstate, keccak_rate_256, message, msglen);
+		res = qsc_dilithium_verify_finalize(&ctx, signature, publickey);
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_sign_initialize_ex(qsc_dilithium_stream_state* ctx, const uint8_t* privatekey, qsc_dilithium_modes mode)
+{
+	assert(ctx != NULL);
+	assert(privatekey != NULL);
+
+	bool res;
+
+	res = true;
+	ctx->mode = mode;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_sign_initialize_m2(&ctx->kstate, privatekey);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_sign_initialize_m3(&ctx->kstate, privatekey);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_sign_initialize_m4(&ctx->kstate, privatekey);
+	}
+	else
+	{
+		qsc_keccak_dispose(&ctx->kstate);
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_dilithium_verify_initialize_ex(qsc_dilithium_stream_state* ctx, const uint8_t* publickey, qsc_dilithium_modes mode)
+{
+	assert(ctx != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = true;
+	ctx->mode = mode;
+
+	if (mode == DILITHIUM_MODE2)
+	{
+		qsc_dilithium_ksm_verify_initialize_m2(&ctx->kstate, publickey);
+	}
+	else if (mode == DILITHIUM_MODE3)
+	{
+		qsc_dilithium_ksm_verify_initialize_m3(&ctx->kstate, publickey);
+	}
+	else if (mode == DILITHIUM_MODE4)
+	{
+		qsc_dilithium_ksm_verify_initialize_m4(&ctx->kstate, publickey);
+	}
+	else
+	{
+		qsc_keccak_dispose(&ctx->kstate);
+		res = false;
+	}
+
+	return res;
+}
+
+size_t qsc_dilithium_signature_size(qsc_dilithium_modes mode)
+{
+	size_t len;
+
+	len = (mode == DILITHIUM_MODE2) ? QSC_DILITHIUM_MODE2_SIGNATURE_SIZE :
+		(mode == DILITHIUM_MODE3) ? QSC_DILITHIUM_MODE3_SIGNATURE_SIZE :
+		(mode == DILITHIUM_MODE4) ? QSC_DILITHIUM_MODE4_SIGNATURE_SIZE : 0;
+
+	return len;
+}
+
+size_t qsc_dilithium_privatekey_size(qsc_dilithium_modes mode)
+{
+	size_t len;
+
+	len = (mode == DILITHIUM_MODE2) ? QSC_DILITHIUM_MODE2_PRIVATEKEY_SIZE :
+		(mode == DILITHIUM_MODE3) ? QSC_DILITHIUM_MODE3_PRIVATEKEY_SIZE :
+		(mode == DILITHIUM_MODE4) ? QSC_DILITHIUM_MODE4_PRIVATEKEY_SIZE : 0;
+
+	return len;
+}
+
+size_t qsc_dilithium_publickey_size(qsc_dilithium_modes mode)
+{
+	size_t len;
+
+	len = (mode == DILITHIUM_MODE2) ? QSC_DILITHIUM_MODE2_PUBLICKEY_SIZE :
+		(mode == DILITHIUM_MODE3) ? QSC_DILITHIUM_MODE3_PUBLICKEY_SIZE :
+		(mode == DILITHIUM_MODE4) ? QSC_DILITHIUM_MODE4_PUBLICKEY_SIZE : 0;
+
+	return len;
+}
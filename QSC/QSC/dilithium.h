@@ -64,6 +64,90 @@
 #define QSC_DILITHIUM_H
 
 #include "common.h"
+#include "sha3.h"
+
+/*!
+* \enum qsc_dilithium_modes
+* \brief The Dilithium security modes selectable at runtime
+*/
+QSC_EXPORT_API typedef enum
+{
+	DILITHIUM_MODE2 = 2,	/*!< Dilithium mode 2, K=4 and L=3 */
+	DILITHIUM_MODE3 = 3,	/*!< Dilithium mode 3, K=5 and L=4 */
+	DILITHIUM_MODE4 = 4		/*!< Dilithium mode 4, K=6 and L=5 */
+} qsc_dilithium_modes;
+
+/*!
+* \def QSC_DILITHIUM_MODE2_SIGNATURE_SIZE
+* \brief The byte size of the mode 2 signature array
+*/
+#define QSC_DILITHIUM_MODE2_SIGNATURE_SIZE 2044
+
+/*!
+* \def QSC_DILITHIUM_MODE2_PRIVATEKEY_SIZE
+* \brief The byte size of the mode 2 secret private-key array
+*/
+#define QSC_DILITHIUM_MODE2_PRIVATEKEY_SIZE 2800
+
+/*!
+* \def QSC_DILITHIUM_MODE2_PUBLICKEY_SIZE
+* \brief The byte size of the mode 2 public-key array
+*/
+#define QSC_DILITHIUM_MODE2_PUBLICKEY_SIZE 1184
+
+/*!
+* \def QSC_DILITHIUM_MODE3_SIGNATURE_SIZE
+* \brief The byte size of the mode 3 signature array
+*/
+#define QSC_DILITHIUM_MODE3_SIGNATURE_SIZE 2701
+
+/*!
+* \def QSC_DILITHIUM_MODE3_PRIVATEKEY_SIZE
+* \brief The byte size of the mode 3 secret private-key array
+*/
+#define QSC_DILITHIUM_MODE3_PRIVATEKEY_SIZE 3504
+
+/*!
+* \def QSC_DILITHIUM_MODE3_PUBLICKEY_SIZE
+* \brief The byte size of the mode 3 public-key array
+*/
+#define QSC_DILITHIUM_MODE3_PUBLICKEY_SIZE 1472
+
+/*!
+* \def QSC_DILITHIUM_MODE4_SIGNATURE_SIZE
+* \brief The byte size of the mode 4 signature array
+*/
+#define QSC_DILITHIUM_MODE4_SIGNATURE_SIZE 3366
+
+/*!
+* \def QSC_DILITHIUM_MODE4_PRIVATEKEY_SIZE
+* \brief The byte size of the mode 4 secret private-key array
+*/
+#define QSC_DILITHIUM_MODE4_PRIVATEKEY_SIZE 3856
+
+/*!
+* \def QSC_DILITHIUM_MODE4_PUBLICKEY_SIZE
+* \brief The byte size of the mode 4 public-key array
+*/
+#define QSC_DILITHIUM_MODE4_PUBLICKEY_SIZE 1760
+
+/*!
+* \def QSC_DILITHIUM_SIGNATURE_MAX_SIZE
+* \brief The largest signature array of any mode
+*/
+#define QSC_DILITHIUM_SIGNATURE_MAX_SIZE QSC_DILITHIUM_MODE4_SIGNATURE_SIZE
+
+/*!
+* \def QSC_DILITHIUM_PRIVATEKEY_MAX_SIZE
+* \brief The largest private-key array of any mode
+*/
+#define QSC_DILITHIUM_PRIVATEKEY_MAX_SIZE QSC_DILITHIUM_MODE4_PRIVATEKEY_SIZE
+
+/*!
+* \def QSC_DILITHIUM_PUBLICKEY_MAX_SIZE
+* \brief The largest public-key array of any mode
+*/
+#define QSC_DILITHIUM_PUBLICKEY_MAX_SIZE QSC_DILITHIUM_MODE4_PUBLICKEY_SIZE
 
 #if defined(QSC_DILITHIUM_S1N256Q8380417)
 
@@ -135,6 +219,66 @@
 */
 #define QSC_DILITHIUM_ALGNAME "DILITHIUM"
 
+/*!
+* \def QSC_DILITHIUM_PREPARED_MATRIX_SIZE
+* \brief The number of coefficients in a prepared public matrix, sized for the largest parameter set
+*/
+#define QSC_DILITHIUM_PREPARED_MATRIX_SIZE (6 * 5 * 256)
+
+/*!
+* \def QSC_DILITHIUM_PREPARED_VECTORK_SIZE
+* \brief The number of coefficients in a prepared key vector of length K, sized for the largest parameter set
+*/
+#define QSC_DILITHIUM_PREPARED_VECTORK_SIZE (6 * 256)
+
+/*!
+* \def QSC_DILITHIUM_PREPARED_VECTORL_SIZE
+* \brief The number of coefficients in a prepared key vector of length L, sized for the largest parameter set
+*/
+#define QSC_DILITHIUM_PREPARED_VECTORL_SIZE (5 * 256)
+
+/*!
+* \struct qsc_dilithium_prepared_privatekey
+* \brief A private key expanded for repeated signing. \n
+* Holds the matrix sampled from the key seed and the secret vectors in the NTT domain,
+* so signing skips the unpacking, matrix expansion and transforms and runs only the per-message rejection loop.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint32_t mat[QSC_DILITHIUM_PREPARED_MATRIX_SIZE];	/*!< The expanded public matrix */
+	uint32_t s1[QSC_DILITHIUM_PREPARED_VECTORL_SIZE];	/*!< The secret vector s1 in the NTT domain */
+	uint32_t s2[QSC_DILITHIUM_PREPARED_VECTORK_SIZE];	/*!< The secret vector s2 in the NTT domain */
+	uint32_t t0[QSC_DILITHIUM_PREPARED_VECTORK_SIZE];	/*!< The low bits of t in the NTT domain */
+	uint8_t key[32];									/*!< The signing seed */
+	uint8_t tr[48];										/*!< The hash of the public key */
+	qsc_dilithium_modes mode;							/*!< The Dilithium security mode */
+} qsc_dilithium_prepared_privatekey;
+
+/*!
+* \struct qsc_dilithium_prepared_publickey
+* \brief A public key expanded for repeated verification. \n
+* Holds the matrix sampled from the key seed, t1 scaled and in the NTT domain, and the public key hash,
+* so verification skips the unpacking, matrix expansion, transform and hashing of the key.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint32_t mat[QSC_DILITHIUM_PREPARED_MATRIX_SIZE];	/*!< The expanded public matrix */
+	uint32_t t1[QSC_DILITHIUM_PREPARED_VECTORK_SIZE];	/*!< The public vector t1 * 2^d in the NTT domain */
+	uint8_t tr[48];										/*!< The hash of the public key */
+	qsc_dilithium_modes mode;							/*!< The Dilithium security mode */
+} qsc_dilithium_prepared_publickey;
+
+/*!
+* \struct qsc_dilithium_stream_state
+* \brief The message state of a streaming signature or verification. \n
+* The message is hashed as it arrives, so a large message is never copied or held in memory.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_keccak_state kstate;							/*!< The message hash state */
+	qsc_dilithium_modes mode;							/*!< The Dilithium security mode */
+} qsc_dilithium_stream_state;
+
 /**
 * \brief Generates a Dilithium public/private key-pair.
 *
@@ -160,6 +304,37 @@ QSC_EXPORT_API void qsc_dilithium_generate_keypair(uint8_t* publickey, uint8_t*
 */
 QSC_EXPORT_API void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Expand a private key for repeated signing.
+*
+* \warning The prepared private key holds secret material; erase it with qsc_dilithium_prepared_privatekey_dispose.
+*
+* \param psk: [struct] The output prepared private key
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_prepare_privatekey(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey);
+
+/**
+* \brief Erase a prepared private key
+*
+* \param psk: [struct] The prepared private key
+*/
+QSC_EXPORT_API void qsc_dilithium_prepared_privatekey_dispose(qsc_dilithium_prepared_privatekey* psk);
+
+/**
+* \brief Signs a message with a prepared private key; the signed message is identical to qsc_dilithium_sign with the same key.
+*
+* \warning Signature array must be sized to the size of the message plus QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signedmsg: Pointer to the signed-message array
+* \param smsglen: [const] Pointer to the signed message length
+* \param message: Pointer to the message array
+* \param msglen: The message length
+* \param psk: [const][struct] The prepared private key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_prepared(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t));
+
 /**
 * \brief Verifies a signature-message pair with the public key.
 *
@@ -172,4 +347,267 @@ QSC_EXPORT_API void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, cons
 */
 QSC_EXPORT_API bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Expand a public key for repeated verification.
+*
+* \param ppk: [struct] The output prepared public key
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_prepare_publickey(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey);
+
+/**
+* \brief Verifies a signature-message pair with a prepared public key.
+*
+* \param message: Pointer to the message array to be signed
+* \param msglen: Pointer to the message length
+* \param signedmsg: [const] Pointer to the signed message array
+* \param smsglen: The signed message length
+* \param ppk: [const][struct] The prepared public key
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_prepared(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk);
+
+/**
+* \brief Verifies a batch of signature-message pairs from one signer. \n
+* The signatures are spread over the threads of qsc_parallel_state_for, each item is verified independently.
+*
+* \warning Each message array is used as a work buffer and must be at least as long as its signed message.
+*
+* \param valid: Pointer to an array receiving count verification results
+* \param messages: Pointer to count output message arrays
+* \param msglens: Pointer to an array receiving count message lengths
+* \param signedmsgs: [const] Pointer to count signed message arrays
+* \param smsglens: [const] Pointer to count signed message lengths
+* \param count: The number of signed messages
+* \param ppk: [const][struct] The prepared public key
+* \return Returns the number of signatures that verified successfully
+*/
+QSC_EXPORT_API size_t qsc_dilithium_verify_batch(bool* valid, uint8_t* const* messages, size_t* msglens, const uint8_t* const* signedmsgs, const size_t* smsglens, size_t count, const qsc_dilithium_prepared_publickey* ppk);
+
+/**
+* \brief Signs a message and returns the signature alone; the message is neither copied nor modified. \n
+* The signature is identical to the leading QSC_DILITHIUM_SIGNATURE_SIZE bytes of the qsc_dilithium_sign output.
+*
+* \warning Signature array must be sized to QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signature: Pointer to the output signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature over a message with the public key.
+*
+* \warning Signature array must be sized to QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signature: [const] Pointer to the signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Starts a streaming signature in the default security mode.
+* Long form api: must be used in conjunction with the sign update and sign finalize functions.
+*
+* \param ctx: [struct] The stream state
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_initialize(qsc_dilithium_stream_state* ctx, const uint8_t* privatekey);
+
+/**
+* \brief Adds a block of message to a streaming signature; can be called any number of times.
+*
+* \param ctx: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_update(qsc_dilithium_stream_state* ctx, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Completes a streaming signature in the mode the stream was initialized with, and erases the stream state. \n
+* The signature is identical to qsc_dilithium_sign_detached over the concatenated message blocks.
+*
+* \warning Signature array must be sized to the signature size of the stream mode.
+*
+* \param ctx: [struct] The stream state
+* \param signature: Pointer to the output signature array
+* \param privatekey: [const] Pointer to the private signature-key array used to initialize the stream
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_finalize(qsc_dilithium_stream_state* ctx, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Starts a streaming verification in the default security mode.
+* Long form api: must be used in conjunction with the verify update and verify finalize functions.
+*
+* \param ctx: [struct] The stream state
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_verify_initialize(qsc_dilithium_stream_state* ctx, const uint8_t* publickey);
+
+/**
+* \brief Adds a block of message to a streaming verification; can be called any number of times.
+*
+* \param ctx: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_dilithium_verify_update(qsc_dilithium_stream_state* ctx, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Completes a streaming verification of a detached signature in the mode the stream was initialized with, and erases the stream state.
+*
+* \warning Signature array must be sized to the signature size of the stream mode.
+*
+* \param ctx: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param publickey: [const] Pointer to the public verification-key array used to initialize the stream
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_finalize(qsc_dilithium_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Generates a Dilithium public/private key-pair of the selected security mode.
+*
+* \warning Arrays must be sized for the mode, see qsc_dilithium_publickey_size and qsc_dilithium_privatekey_size.
+*
+* \param publickey: Pointer to the public verification-key array
+* \param privatekey: Pointer to the private signature-key array
+* \param rng_generate: Pointer to the random generator
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_generate_keypair_ex(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode);
+
+/**
+* \brief Signs a message with a private-key of the selected security mode; returns the signature followed by the message.
+*
+* \warning Signature array must be sized to the size of the message plus qsc_dilithium_signature_size.
+*
+* \param signedmsg: Pointer to the signed-message array
+* \param smsglen: [const] Pointer to the signed message length
+* \param message: Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param rng_generate: Pointer to the random generator
+* \param mode: The Dilithium security mode
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_ex(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode);
+
+/**
+* \brief Verifies a signature-message pair with a public key of the selected security mode.
+*
+* \param message: Pointer to the message array to be signed
+* \param msglen: Pointer to the message length
+* \param signedmsg: [const] Pointer to the signed message array
+* \param smsglen: The signed message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \param mode: The Dilithium security mode
+* \return Returns true for success, false on a failed verification or an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_ex(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey, qsc_dilithium_modes mode);
+
+/**
+* \brief Expand a private key of the selected security mode for repeated signing. \n
+* The prepared key records its mode; qsc_dilithium_sign_prepared signs in that mode.
+*
+* \warning The prepared private key holds secret material; erase it with qsc_dilithium_prepared_privatekey_dispose.
+*
+* \param psk: [struct] The output prepared private key
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_prepare_privatekey_ex(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey, qsc_dilithium_modes mode);
+
+/**
+* \brief Expand a public key of the selected security mode for repeated verification. \n
+* The prepared key records its mode; qsc_dilithium_verify_prepared and qsc_dilithium_verify_batch verify in that mode.
+*
+* \param ppk: [struct] The output prepared public key
+* \param publickey: [const] Pointer to the public verification-key array
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_prepare_publickey_ex(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey, qsc_dilithium_modes mode);
+
+/**
+* \brief Signs a message with a private-key of the selected security mode and returns the signature alone.
+*
+* \warning Signature array must be sized to qsc_dilithium_signature_size of the mode.
+*
+* \param signature: Pointer to the output signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param rng_generate: Pointer to the random generator
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode, the smallest signature size of the signature array is cleared
+*/
+QSC_EXPORT_API bool qsc_dilithium_sign_detached_ex(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_dilithium_modes mode);
+
+/**
+* \brief Verifies a detached signature over a message with a public key of the selected security mode.
+*
+* \param signature: [const] Pointer to the signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \param mode: The Dilithium security mode
+* \return Returns true for success, false on a failed verification or an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_detached_ex(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey, qsc_dilithium_modes mode);
+
+/**
+* \brief Starts a streaming signature in the selected security mode. \n
+* The stream state records the mode; qsc_dilithium_sign_update and qsc_dilithium_sign_finalize continue in that mode.
+*
+* \param ctx: [struct] The stream state
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_sign_initialize_ex(qsc_dilithium_stream_state* ctx, const uint8_t* privatekey, qsc_dilithium_modes mode);
+
+/**
+* \brief Starts a streaming verification in the selected security mode. \n
+* The stream state records the mode; qsc_dilithium_verify_update and qsc_dilithium_verify_finalize continue in that mode.
+*
+* \param ctx: [struct] The stream state
+* \param publickey: [const] Pointer to the public verification-key array
+* \param mode: The Dilithium security mode
+* \return Returns false for an unknown mode
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_initialize_ex(qsc_dilithium_stream_state* ctx, const uint8_t* publickey, qsc_dilithium_modes mode);
+
+/**
+* \brief Returns the signature byte size of a security mode
+*
+* \param mode: The Dilithium security mode
+* \return The signature size, or zero for an unknown mode
+*/
+QSC_EXPORT_API size_t qsc_dilithium_signature_size(qsc_dilithium_modes mode);
+
+/**
+* \brief Returns the private-key byte size of a security mode
+*
+* \param mode: The Dilithium security mode
+* \return The private-key size, or zero for an unknown mode
+*/
+QSC_EXPORT_API size_t qsc_dilithium_privatekey_size(qsc_dilithium_modes mode);
+
+/**
+* \brief Returns the public-key byte size of a security mode
+*
+* \param mode: The Dilithium security mode
+* \return The public-key size, or zero for an unknown mode
+*/
+QSC_EXPORT_API size_t qsc_dilithium_publickey_size(qsc_dilithium_modes mode);
+
 #endif
@@ -1,11 +1,14 @@
 #include "dilithiumbase.h"
+#include "memutils.h"
 #include "sha3.h"
+#if defined(QSC_SYSTEM_HAS_AVX2)
+#	include <immintrin.h>
+#endif
 
 /* params.h */
 
 #define DILITHIUM_POLT1_SIZE_PACKED ((QSC_DILITHIUM_N * (DILITHIUM_QBITS - QSC_DILITHIUM_D)) / 8)
 #define DILITHIUM_POLT0_SIZE_PACKED ((QSC_DILITHIUM_N * QSC_DILITHIUM_D) / 8)
-#define DILITHIUM_POLETA_SIZE_PACKED ((QSC_DILITHIUM_N * QSC_DILITHIUM_SETABITS) / 8)
 #define DILITHIUM_POLZ_SIZE_PACKED ((QSC_DILITHIUM_N * (DILITHIUM_QBITS - 3)) / 8)
 #define DILITHIUM_POLW1_SIZE_PACKED ((QSC_DILITHIUM_N * 4) / 8)
 #define DILITHIUM_QBITS 23
@@ -15,24 +18,6 @@
  /* -q^(-1) mod 2^32 */
 #define DILITHIUM_QINV 4236238847U
 
-/*!
-\def DILITHIUM_PUBLICKEY_SIZE
-* Read Only: The public key size in bytes
-*/
-#define DILITHIUM_PUBLICKEY_SIZE (QSC_DILITHIUM_SEED_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLT1_SIZE_PACKED)
-
-/*!
-\def DILITHIUM_SECRETKEY_SIZE
-* Read Only: The private key size in bytes
-*/
-#define DILITHIUM_SECRETKEY_SIZE (2 * QSC_DILITHIUM_SEED_SIZE + (QSC_DILITHIUM_L + QSC_DILITHIUM_K) * DILITHIUM_POLETA_SIZE_PACKED + QSC_DILITHIUM_CRH_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLT0_SIZE_PACKED)
-
-/*!
-\def DILITHIUM_SIGNATURE_SIZE
-* Read Only: The signature size in bytes
-*/
-#define DILITHIUM_SIGNATURE_SIZE (QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED + (QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K) + (QSC_DILITHIUM_N / 8 + 8))
-
 /* qsc_dilithium_ntt.c */
 
 /* Roots of unity in order needed by forward qsc_dilithium_ntt */
@@ -109,8 +94,349 @@ static const uint32_t zetas_inv[QSC_DILITHIUM_N] =
 	0x0078C1DDUL, 0x000D5ED8UL, 0x000BDEE8UL, 0x007C41BDUL, 0x0007EAFDUL, 0x0027CEFEUL, 0x007F7B0AUL, 0x00000000UL
 };
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static __m256i dilithium_montmul_avx2(__m256i a, __m256i b)
+{
+	const __m256i q = _mm256_set1_epi32(QSC_DILITHIUM_Q);
+	const __m256i qinv = _mm256_set1_epi32((int32_t)DILITHIUM_QINV);
+	__m256i pe;
+	__m256i po;
+	__m256i te;
+	__m256i to;
+
+	/* full 64-bit products of the even and odd words, reduced as in qsc_dilithium_montgomery_reduce */
+	pe = _mm256_mul_epu32(a, b);
+	po = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+	te = _mm256_mul_epu32(_mm256_mul_epu32(pe, qinv), q);
+	to = _mm256_mul_epu32(_mm256_mul_epu32(po, qinv), q);
+	pe = _mm256_srli_epi64(_mm256_add_epi64(pe, te), 32);
+	po = _mm256_add_epi64(po, to);
+
+	return _mm256_blend_epi32(pe, po, 0xAA);
+}
+
+static void dilithium_ntt_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta)
+{
+	const __m256i q2 = _mm256_set1_epi32(2 * QSC_DILITHIUM_Q);
+	__m256i t;
+
+	t = dilithium_montmul_avx2(zeta, *b);
+	*b = _mm256_sub_epi32(_mm256_add_epi32(*a, q2), t);
+	*a = _mm256_add_epi32(*a, t);
+}
+
+static void dilithium_invntt_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta)
+{
+	const __m256i q256 = _mm256_set1_epi32(256 * QSC_DILITHIUM_Q);
+	__m256i t;
+
+	t = *a;
+	*a = _mm256_add_epi32(t, *b);
+	*b = dilithium_montmul_avx2(zeta, _mm256_sub_epi32(_mm256_add_epi32(t, q256), *b));
+}
+
+static void dilithium_interleave4_avx2(__m256i* a, __m256i* b)
+{
+	__m256i t;
+
+	/* swap the upper half of a with the lower half of b; self-inverse */
+	t = *a;
+	*a = _mm256_permute2x128_si256(t, *b, 0x20);
+	*b = _mm256_permute2x128_si256(t, *b, 0x31);
+}
+
+static void dilithium_interleave2_avx2(__m256i* a, __m256i* b)
+{
+	__m256i t;
+
+	/* swap the odd 64-bit words of a with the even words of b; self-inverse */
+	t = *a;
+	*a = _mm256_unpacklo_epi64(t, *b);
+	*b = _mm256_unpackhi_epi64(t, *b);
+}
+
+static __m256i dilithium_zetas4_avx2(const uint32_t* zetas)
+{
+	/* one zeta per 128-bit lane */
+	const __m256i idx = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+
+	return _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(_mm_loadl_epi64((const __m128i*)zetas)), idx);
+}
+
+static __m256i dilithium_zetas2_avx2(const uint32_t* zetas)
+{
+	/* zeta order matches the lane layout produced by dilithium_interleave2_avx2 */
+	const __m256i idx = _mm256_setr_epi32(0, 0, 2, 2, 1, 1, 3, 3);
+
+	return _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)zetas)), idx);
+}
+
+static __m256i dilithium_zetas1_avx2(const uint32_t* zetas)
+{
+	/* zeta order matches the word layout of a shuffled dilithium_interleave2_avx2 */
+	const __m256i idx = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+	return _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)zetas), idx);
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static __m512i dilithium_montmul_avx512(__m512i a, __m512i b)
+{
+	const __m512i q = _mm512_set1_epi32(QSC_DILITHIUM_Q);
+	const __m512i qinv = _mm512_set1_epi32((int32_t)DILITHIUM_QINV);
+	__m512i pe;
+	__m512i po;
+	__m512i te;
+	__m512i to;
+
+	pe = _mm512_mul_epu32(a, b);
+	po = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+	te = _mm512_mul_epu32(_mm512_mul_epu32(pe, qinv), q);
+	to = _mm512_mul_epu32(_mm512_mul_epu32(po, qinv), q);
+	pe = _mm512_srli_epi64(_mm512_add_epi64(pe, te), 32);
+	po = _mm512_add_epi64(po, to);
+
+	return _mm512_mask_blend_epi32(0xAAAAU, pe, po);
+}
+
+static void dilithium_ntt_upper_avx512(uint32_t* p)
+{
+	const __m512i q2 = _mm512_set1_epi32(2 * QSC_DILITHIUM_Q);
+	__m512i a[QSC_DILITHIUM_N / 16];
+	__m512i t;
+	__m512i z;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t start;
+
+	for (i = 0; i < QSC_DILITHIUM_N / 16; ++i)
+	{
+		a[i] = _mm512_loadu_si512((const void*)(p + (i * 16)));
+	}
+
+	k = 1;
+
+	/* butterfly distances of 128 to 16 coefficients, zetas 1 to 15 */
+	for (len = 8; len >= 1; len >>= 1)
+	{
+		for (start = 0; start < QSC_DILITHIUM_N / 16; start += 2 * len)
+		{
+			z = _mm512_set1_epi32((int32_t)zetas[k]);
+			++k;
+
+			for (j = start; j < start + len; ++j)
+			{
+				t = dilithium_montmul_avx512(z, a[j + len]);
+				a[j + len] = _mm512_sub_epi32(_mm512_add_epi32(a[j], q2), t);
+				a[j] = _mm512_add_epi32(a[j], t);
+			}
+		}
+	}
+
+	for (i = 0; i < QSC_DILITHIUM_N / 16; ++i)
+	{
+		_mm512_storeu_si512((void*)(p + (i * 16)), a[i]);
+	}
+}
+
+static void dilithium_invntt_upper_avx512(uint32_t* p, uint32_t f)
+{
+	const __m512i q256 = _mm512_set1_epi32(256 * QSC_DILITHIUM_Q);
+	__m512i a[QSC_DILITHIUM_N / 16];
+	__m512i t;
+	__m512i z;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t start;
+
+	for (i = 0; i < QSC_DILITHIUM_N / 16; ++i)
+	{
+		a[i] = _mm512_loadu_si512((const void*)(p + (i * 16)));
+	}
+
+	k = 240;
+
+	/* butterfly distances of 16 to 128 coefficients, zetas 240 to 254 */
+	for (len = 1; len <= 8; len <<= 1)
+	{
+		for (start = 0; start < QSC_DILITHIUM_N / 16; start += 2 * len)
+		{
+			z = _mm512_set1_epi32((int32_t)zetas_inv[k]);
+			++k;
+
+			for (j = start; j < start + len; ++j)
+			{
+				t = a[j];
+				a[j] = _mm512_add_epi32(t, a[j + len]);
+				a[j + len] = dilithium_montmul_avx512(z, _mm512_sub_epi32(_mm512_add_epi32(t, q256), a[j + len]));
+			}
+		}
+	}
+
+	z = _mm512_set1_epi32((int32_t)f);
+
+	for (i = 0; i < QSC_DILITHIUM_N / 16; ++i)
+	{
+		_mm512_storeu_si512((void*)(p + (i * 16)), dilithium_montmul_avx512(a[i], z));
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void dilithium_ntt_avx2(uint32_t* p)
+{
+	__m256i a[QSC_DILITHIUM_N / 8];
+	__m256i z;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t start;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	/* the 16-lane pass covers the distances of 128 to 16 coefficients */
+	dilithium_ntt_upper_avx512(p);
+	k = 16;
+	len = 1;
+#else
+	k = 1;
+	len = 16;
+#endif
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		a[i] = _mm256_loadu_si256((const __m256i*)(p + (i * 8)));
+	}
+
+	/* butterfly distances down to 8 coefficients span whole vectors */
+	for (; len >= 1; len >>= 1)
+	{
+		for (start = 0; start < QSC_DILITHIUM_N / 8; start += 2 * len)
+		{
+			z = _mm256_set1_epi32((int32_t)zetas[k]);
+			++k;
+
+			for (j = start; j < start + len; ++j)
+			{
+				dilithium_ntt_butterfly_avx2(&a[j], &a[j + len], z);
+			}
+		}
+	}
+
+	/* distances of 4, 2 and 1 coefficients regroup vector pairs so butterfly partners align */
+	for (i = 0; i < QSC_DILITHIUM_N / 8; i += 2)
+	{
+		dilithium_interleave4_avx2(&a[i], &a[i + 1]);
+		dilithium_ntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas4_avx2(zetas + 32 + i));
+		dilithium_interleave4_avx2(&a[i], &a[i + 1]);
+
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		dilithium_ntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas2_avx2(zetas + 64 + (2 * i)));
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		dilithium_ntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas1_avx2(zetas + 128 + (4 * i)));
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+
+		_mm256_storeu_si256((__m256i*)(p + (i * 8)), a[i]);
+		_mm256_storeu_si256((__m256i*)(p + ((i + 1) * 8)), a[i + 1]);
+	}
+}
+
+static void dilithium_invntt_avx2(uint32_t* p, uint32_t f)
+{
+	__m256i a[QSC_DILITHIUM_N / 8];
+	__m256i z;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t lenmax;
+	size_t start;
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; i += 2)
+	{
+		a[i] = _mm256_loadu_si256((const __m256i*)(p + (i * 8)));
+		a[i + 1] = _mm256_loadu_si256((const __m256i*)(p + ((i + 1) * 8)));
+
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		dilithium_invntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas1_avx2(zetas_inv + (4 * i)));
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+		dilithium_invntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas2_avx2(zetas_inv + 128 + (2 * i)));
+		dilithium_interleave2_avx2(&a[i], &a[i + 1]);
+
+		dilithium_interleave4_avx2(&a[i], &a[i + 1]);
+		dilithium_invntt_butterfly_avx2(&a[i], &a[i + 1], dilithium_zetas4_avx2(zetas_inv + 192 + i));
+		dilithium_interleave4_avx2(&a[i], &a[i + 1]);
+	}
+
+	k = 224;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	/* the 16-lane pass covers the distances of 16 to 128 coefficients */
+	lenmax = 1;
+#else
+	lenmax = 16;
+#endif
+
+	for (len = 1; len <= lenmax; len <<= 1)
+	{
+		for (start = 0; start < QSC_DILITHIUM_N / 8; start += 2 * len)
+		{
+			z = _mm256_set1_epi32((int32_t)zetas_inv[k]);
+			++k;
+
+			for (j = start; j < start + len; ++j)
+			{
+				dilithium_invntt_butterfly_avx2(&a[j], &a[j + len], z);
+			}
+		}
+	}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)(p + (i * 8)), a[i]);
+	}
+
+	dilithium_invntt_upper_avx512(p, f);
+#else
+	z = _mm256_set1_epi32((int32_t)f);
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)(p + (i * 8)), dilithium_montmul_avx2(a[i], z));
+	}
+#endif
+}
+
+#endif
+
 void qsc_dilithium_ntt(uint32_t p[QSC_DILITHIUM_N])
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	dilithium_ntt_avx2(p);
+#else
 	size_t j;
 	size_t k;
 	size_t len;
@@ -135,11 +461,15 @@ void qsc_dilithium_ntt(uint32_t p[QSC_DILITHIUM_N])
 			}
 		}
 	}
+#endif
 }
 
 void qsc_dilithium_invntt_frominvmont(uint32_t p[QSC_DILITHIUM_N])
 {
 	const uint32_t F = (((uint64_t)DILITHIUM_MONT * DILITHIUM_MONT % QSC_DILITHIUM_Q) * (QSC_DILITHIUM_Q - 1) % QSC_DILITHIUM_Q) * ((uint32_t)(QSC_DILITHIUM_Q - 1) >> 8) % QSC_DILITHIUM_Q;
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	dilithium_invntt_avx2(p, F);
+#else
 	size_t j;
 	size_t k;
 	size_t len;
@@ -170,6 +500,7 @@ void qsc_dilithium_invntt_frominvmont(uint32_t p[QSC_DILITHIUM_N])
 	{
 		p[j] = qsc_dilithium_montgomery_reduce((uint64_t)F * p[j]);
 	}
+#endif
 }
 
 /* qsc_dilithium_poly.c */
@@ -248,10 +579,26 @@ void qsc_dilithium_poly_pointwise_invmontgomery(qsc_dilithium_poly* c, const qsc
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	for (i = 0; i < QSC_DILITHIUM_N; i += 16)
+	{
+		_mm512_storeu_si512((void*)(c->coeffs + i), dilithium_montmul_avx512(
+			_mm512_loadu_si512((const void*)(a->coeffs + i)),
+			_mm512_loadu_si512((const void*)(b->coeffs + i))));
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	for (i = 0; i < QSC_DILITHIUM_N; i += 8)
+	{
+		_mm256_storeu_si256((__m256i*)(c->coeffs + i), dilithium_montmul_avx2(
+			_mm256_loadu_si256((const __m256i*)(a->coeffs + i)),
+			_mm256_loadu_si256((const __m256i*)(b->coeffs + i))));
+	}
+#else
 	for (i = 0; i < QSC_DILITHIUM_N; ++i)
 	{
 		c->coeffs[i] = qsc_dilithium_montgomery_reduce((uint64_t)a->coeffs[i] * b->coeffs[i]);
 	}
+#endif
 }
 
 void qsc_dilithium_poly_power2round(qsc_dilithium_poly* a1, qsc_dilithium_poly* a0, const qsc_dilithium_poly* a)
@@ -345,6 +692,18 @@ int32_t qsc_dilithium_poly_chknorm(const qsc_dilithium_poly* a, uint32_t B)
 **************************************************/
 static uint32_t rej_uniform(uint32_t* a, uint32_t len, const uint8_t* buf, size_t buflen)
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	const __m256i bound = _mm256_set1_epi32(QSC_DILITHIUM_Q);
+	const __m256i mask = _mm256_set1_epi32(0x007FFFFFL);
+	const __m256i pidx = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+	const __m256i bidx = _mm256_setr_epi8(
+		0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+		0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	uint32_t tmp[8];
+	__m256i v;
+	uint32_t good;
+	size_t i;
+#endif
 	size_t pos;
 	size_t ctr;
 	uint32_t t;
@@ -352,6 +711,26 @@ static uint32_t rej_uniform(uint32_t* a, uint32_t len, const uint8_t* buf, size_
 	ctr = 0;
 	pos = 0;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	/* unpack and test 8 candidates from 24 bytes, then compact the accepted lanes without branching */
+	while (ctr + 8 <= len && pos + 32 <= buflen)
+	{
+		v = _mm256_loadu_si256((const __m256i*)(buf + pos));
+		v = _mm256_permutevar8x32_epi32(v, pidx);
+		v = _mm256_and_si256(_mm256_shuffle_epi8(v, bidx), mask);
+		good = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bound, v)));
+		_mm256_storeu_si256((__m256i*)tmp, v);
+
+		for (i = 0; i < 8; ++i)
+		{
+			a[ctr] = tmp[i];
+			ctr += (good >> i) & 1U;
+		}
+
+		pos += 24;
+	}
+#endif
+
 	while (ctr < len && pos + 3 <= buflen)
 	{
 		t = buf[pos];
@@ -418,10 +797,11 @@ void qsc_dilithium_poly_uniform(qsc_dilithium_poly* a, const uint8_t seed[QSC_DI
 }
 
 /*************************************************
-* Name:        rej_eta
+* Name:        rej_gamma1m1
 *
-* Description: Sample uniformly random coefficients in [-QSC_DILITHIUM_ETA, QSC_DILITHIUM_ETA] by
-*              performing rejection sampling using array of random bytes.
+* Description: Sample uniformly random coefficients
+*              in [-(QSC_DILITHIUM_GAMMA1 - 1), QSC_DILITHIUM_GAMMA1 - 1] by performing rejection sampling
+*              using array of random bytes.
 *
 * Arguments:   - uint32_t *a: pointer to output array (allocated)
 *              - uint32_t len: number of coefficients to be sampled
@@ -431,10 +811,10 @@ void qsc_dilithium_poly_uniform(qsc_dilithium_poly* a, const uint8_t seed[QSC_DI
 * Returns number of sampled coefficients. Can be smaller than len if not enough
 * random bytes were given.
 **************************************************/
-static uint32_t rej_eta(uint32_t* a, uint32_t len, const uint8_t* buf, size_t buflen)
+static uint32_t rej_gamma1m1(uint32_t* a, uint32_t len, const uint8_t* buf, size_t buflen)
 {
-#if QSC_DILITHIUM_ETA > 7
-#error "rej_eta() assumes QSC_DILITHIUM_ETA <= 7"
+#if QSC_DILITHIUM_GAMMA1 > (1 << 19)
+#error "rej_gamma1m1() assumes QSC_DILITHIUM_GAMMA1 - 1 fits in 19 bits"
 #endif
 
 	size_t ctr;
@@ -445,27 +825,28 @@ static uint32_t rej_eta(uint32_t* a, uint32_t len, const uint8_t* buf, size_t bu
 	ctr = 0;
 	pos = 0;
 
-	while (ctr < len && pos < buflen)
+	while (ctr < len && pos + 5 <= buflen)
 	{
-#if QSC_DILITHIUM_ETA <= 3
-		t0 = buf[pos] & 0x07;
-		t1 = buf[pos] >> 5;
-		++pos;
-#else
-		t0 = buf[pos] & 0x0FU;
-		t1 = buf[pos] >> 4;
-		++pos;
-#endif
+		t0 = buf[pos];
+		t0 |= (uint32_t)buf[pos + 1] << 8;
+		t0 |= (uint32_t)buf[pos + 2] << 16;
+		t0 &= 0x000FFFFFUL;
+
+		t1 = buf[pos + 2] >> 4;
+		t1 |= (uint32_t)buf[pos + 3] << 4;
+		t1 |= (uint32_t)buf[pos + 4] << 12;
+
+		pos += 5;
 
-		if (t0 <= 2 * QSC_DILITHIUM_ETA)
+		if (t0 <= (2 * QSC_DILITHIUM_GAMMA1) - 2)
 		{
-			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - t0;
+			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_GAMMA1 - 1 - t0;
 			++ctr;
 		}
 
-		if (t1 <= 2 * QSC_DILITHIUM_ETA && ctr < len)
+		if (t1 <= (2 * QSC_DILITHIUM_GAMMA1) - 2 && ctr < len)
 		{
-			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - t1;
+			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_GAMMA1 - 1 - t1;
 			++ctr;
 		}
 	}
@@ -473,220 +854,224 @@ static uint32_t rej_eta(uint32_t* a, uint32_t len, const uint8_t* buf, size_t bu
 	return (uint32_t)ctr;
 }
 
-void qsc_dilithium_poly_uniform_eta(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_SEED_SIZE], uint16_t nonce)
+void qsc_dilithium_poly_uniform_gamma1m1(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_CRH_SIZE], uint16_t nonce)
 {
-	const size_t NBLKS = ((QSC_DILITHIUM_N / 2 * (1U << QSC_DILITHIUM_SETABITS)) / (2 * QSC_DILITHIUM_ETA + 1) + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE;
-	uint8_t buf[(((QSC_DILITHIUM_N / 2 * (1U << QSC_DILITHIUM_SETABITS)) / (2 * QSC_DILITHIUM_ETA + 1) + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE) * QSC_KECCAK_128_RATE];
+	const size_t NBLKS = (641 + QSC_KECCAK_256_RATE) / QSC_KECCAK_256_RATE;
+	uint8_t buf[(((641 + QSC_KECCAK_256_RATE) / QSC_KECCAK_256_RATE) * QSC_KECCAK_256_RATE) + 4];
 	qsc_keccak_state kstate;
-	uint8_t tmps[QSC_DILITHIUM_SEED_SIZE + 2];
+	uint8_t tmps[QSC_DILITHIUM_CRH_SIZE + 2];
 	size_t buflen;
 	size_t i;
+	size_t off;
 	uint32_t ctr;
 
-	buflen = NBLKS * QSC_KECCAK_128_RATE;
-
 	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
 	{
 		kstate.state[i] = 0;
 	}
 
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
 	{
 		tmps[i] = seed[i];
 	}
 
-	tmps[QSC_DILITHIUM_SEED_SIZE] = (uint8_t)nonce;
-	tmps[QSC_DILITHIUM_SEED_SIZE + 1] = nonce >> 8;
-	qsc_shake_initialize(&kstate, keccak_rate_128, tmps, QSC_DILITHIUM_SEED_SIZE + 2);
-	qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, NBLKS);
+	tmps[QSC_DILITHIUM_CRH_SIZE] = (uint8_t)nonce;
+	tmps[QSC_DILITHIUM_CRH_SIZE + 1] = nonce >> 8;
+	qsc_shake_initialize(&kstate, keccak_rate_256, tmps, QSC_DILITHIUM_CRH_SIZE + 2);
+	qsc_shake_squeezeblocks(&kstate, keccak_rate_256, buf, NBLKS);
+	buflen = NBLKS * QSC_KECCAK_256_RATE;
 
-	ctr = rej_eta(a->coeffs, QSC_DILITHIUM_N, buf, buflen);
+	ctr = rej_gamma1m1(a->coeffs, QSC_DILITHIUM_N, buf, buflen);
 
 	while (ctr < QSC_DILITHIUM_N)
 	{
-		qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, 1);
-		ctr += rej_eta(a->coeffs + ctr, QSC_DILITHIUM_N - ctr, buf, QSC_KECCAK_128_RATE);
-	}
-}
+		off = buflen % 5;
 
-/*************************************************
-* Name:        rej_gamma1m1
-*
-* Description: Sample uniformly random coefficients
-*              in [-(QSC_DILITHIUM_GAMMA1 - 1), QSC_DILITHIUM_GAMMA1 - 1] by performing rejection sampling
-*              using array of random bytes.
-*
-* Arguments:   - uint32_t *a: pointer to output array (allocated)
-*              - uint32_t len: number of coefficients to be sampled
-*              - const uint8_t *buf: array of random bytes
-*              - uint32_t buflen: length of array of random bytes
-*
-* Returns number of sampled coefficients. Can be smaller than len if not enough
-* random bytes were given.
-**************************************************/
-static uint32_t rej_gamma1m1(uint32_t* a, uint32_t len, const uint8_t* buf, size_t buflen)
-{
-#if QSC_DILITHIUM_GAMMA1 > (1 << 19)
-#error "rej_gamma1m1() assumes QSC_DILITHIUM_GAMMA1 - 1 fits in 19 bits"
+		for (i = 0; i < off; ++i)
+		{
+			buf[i] = buf[buflen - off + i];
+		}
+
+		buflen = QSC_KECCAK_256_RATE + off;
+		qsc_shake_squeezeblocks(&kstate, keccak_rate_256, buf + off, 1);
+		ctr += rej_gamma1m1(a->coeffs + ctr, QSC_DILITHIUM_N - ctr, buf, buflen);
+	}
+}
+
+/*!
+\def DILITHIUM_XOF_LANES
+* Read Only: The number of polynomials sampled per Keccak pass
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define DILITHIUM_XOF_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define DILITHIUM_XOF_LANES 4
+#else
+#	define DILITHIUM_XOF_LANES 1
 #endif
 
-	size_t ctr;
-	size_t pos;
-	uint32_t t0;
-	uint32_t t1;
+/*!
+\def DILITHIUM_UNIFORM_NBLOCKS
+* Read Only: The number of SHAKE-128 blocks squeezed for a uniform polynomial
+*/
+#define DILITHIUM_UNIFORM_NBLOCKS ((769 + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE)
 
-	ctr = 0;
-	pos = 0;
+/*!
+\def DILITHIUM_UNIFORM_GAMMA1M1_NBLOCKS
+* Read Only: The number of SHAKE-256 blocks squeezed for a polynomial with coefficients in [-(gamma1 - 1), gamma1 - 1]
+*/
+#define DILITHIUM_UNIFORM_GAMMA1M1_NBLOCKS ((641 + QSC_KECCAK_256_RATE) / QSC_KECCAK_256_RATE)
 
-	while (ctr < len && pos + 5 <= buflen)
-	{
-		t0 = buf[pos];
-		t0 |= (uint32_t)buf[pos + 1] << 8;
-		t0 |= (uint32_t)buf[pos + 2] << 16;
-		t0 &= 0x000FFFFFUL;
+/*!
+\def DILITHIUM_SAMPLE_BUFFER_SIZE
+* Read Only: The per-lane squeeze size in bytes; the uniform sampler needs the largest buffer
+*/
+#define DILITHIUM_SAMPLE_BUFFER_SIZE (DILITHIUM_UNIFORM_NBLOCKS * QSC_KECCAK_128_RATE)
 
-		t1 = buf[pos + 2] >> 4;
-		t1 |= (uint32_t)buf[pos + 3] << 4;
-		t1 |= (uint32_t)buf[pos + 4] << 12;
+typedef uint32_t (*dilithium_rejection_sampler)(uint32_t*, uint32_t, const uint8_t*, size_t);
 
-		pos += 5;
+static void dilithium_xof_lanes(uint8_t buf[][DILITHIUM_SAMPLE_BUFFER_SIZE], size_t outlen, uint8_t seeds[][QSC_DILITHIUM_CRH_SIZE + 2], size_t seedlen, size_t count, keccak_rate rate)
+{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	size_t i;
+#endif
+	size_t k;
 
-		if (t0 <= (2 * QSC_DILITHIUM_GAMMA1) - 2)
+	k = 0;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (count == 8)
+	{
+		if (rate == keccak_rate_128)
 		{
-			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_GAMMA1 - 1 - t0;
-			++ctr;
+			shake128x8(buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7], outlen,
+				seeds[0], seeds[1], seeds[2], seeds[3], seeds[4], seeds[5], seeds[6], seeds[7], seedlen);
+		}
+		else
+		{
+			shake256x8(buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7], outlen,
+				seeds[0], seeds[1], seeds[2], seeds[3], seeds[4], seeds[5], seeds[6], seeds[7], seedlen);
 		}
 
-		if (t1 <= (2 * QSC_DILITHIUM_GAMMA1) - 2 && ctr < len)
+		k = 8;
+	}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	/* a vector pass costs less than two single lanes, so pad a short group with copies of its first seed */
+	for (; k + 1 < count; k += 4)
+	{
+		for (i = count; i < k + 4; ++i)
 		{
-			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_GAMMA1 - 1 - t1;
-			++ctr;
+			qsc_memutils_copy(seeds[i], seeds[k], seedlen);
+		}
+
+		if (rate == keccak_rate_128)
+		{
+			shake128x4(buf[k], buf[k + 1], buf[k + 2], buf[k + 3], outlen,
+				seeds[k], seeds[k + 1], seeds[k + 2], seeds[k + 3], seedlen);
+		}
+		else
+		{
+			shake256x4(buf[k], buf[k + 1], buf[k + 2], buf[k + 3], outlen,
+				seeds[k], seeds[k + 1], seeds[k + 2], seeds[k + 3], seedlen);
 		}
 	}
+#endif
 
-	return (uint32_t)ctr;
+	for (; k < count; ++k)
+	{
+		if (rate == keccak_rate_128)
+		{
+			qsc_shake128_compute(buf[k], outlen, seeds[k], seedlen);
+		}
+		else
+		{
+			qsc_shake256_compute(buf[k], outlen, seeds[k], seedlen);
+		}
+	}
 }
 
-void qsc_dilithium_poly_uniform_gamma1m1(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_CRH_SIZE], uint16_t nonce)
+static void dilithium_sample_resume(qsc_dilithium_poly* a, uint32_t ctr, const uint8_t* buf, const uint8_t* seed, size_t seedlen,
+	keccak_rate rate, size_t nblocks, size_t grain, dilithium_rejection_sampler rej)
 {
-	const size_t NBLKS = (641 + QSC_KECCAK_256_RATE) / QSC_KECCAK_256_RATE;
-	uint8_t buf[(((641 + QSC_KECCAK_256_RATE) / QSC_KECCAK_256_RATE) * QSC_KECCAK_256_RATE) + 4];
+	uint8_t tmp[QSC_KECCAK_128_RATE + 4];
 	qsc_keccak_state kstate;
-	uint8_t tmps[QSC_DILITHIUM_CRH_SIZE + 2];
 	size_t buflen;
 	size_t i;
 	size_t off;
-	uint32_t ctr;
 
+	/* the batched squeeze ran short; regenerate the lane and continue its stream one block at a time */
 	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
 	{
 		kstate.state[i] = 0;
 	}
 
-	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
+	qsc_shake_initialize(&kstate, rate, seed, seedlen);
+
+	for (i = 0; i < nblocks; ++i)
 	{
-		tmps[i] = seed[i];
+		qsc_shake_squeezeblocks(&kstate, rate, tmp, 1);
 	}
 
-	tmps[QSC_DILITHIUM_CRH_SIZE] = (uint8_t)nonce;
-	tmps[QSC_DILITHIUM_CRH_SIZE + 1] = nonce >> 8;
-	qsc_shake_initialize(&kstate, keccak_rate_256, tmps, QSC_DILITHIUM_CRH_SIZE + 2);
-	qsc_shake_squeezeblocks(&kstate, keccak_rate_256, buf, NBLKS);
-	buflen = NBLKS * QSC_KECCAK_256_RATE;
+	/* an incomplete candidate at the end of a buffer carries into the next block */
+	buflen = nblocks * (size_t)rate;
+	off = buflen % grain;
 
-	ctr = rej_gamma1m1(a->coeffs, QSC_DILITHIUM_N, buf, buflen);
+	for (i = 0; i < off; ++i)
+	{
+		tmp[i] = buf[buflen - off + i];
+	}
 
 	while (ctr < QSC_DILITHIUM_N)
 	{
-		off = buflen % 5;
+		qsc_shake_squeezeblocks(&kstate, rate, tmp + off, 1);
+		buflen = (size_t)rate + off;
+		ctr += rej(a->coeffs + ctr, QSC_DILITHIUM_N - ctr, tmp, buflen);
+		off = buflen % grain;
 
 		for (i = 0; i < off; ++i)
 		{
-			buf[i] = buf[buflen - off + i];
+			tmp[i] = tmp[buflen - off + i];
 		}
-
-		buflen = QSC_KECCAK_256_RATE + off;
-		qsc_shake_squeezeblocks(&kstate, keccak_rate_256, buf + off, 1);
-		ctr += rej_gamma1m1(a->coeffs + ctr, QSC_DILITHIUM_N - ctr, buf, buflen);
 	}
 }
 
-void qsc_dilithium_polyeta_pack(uint8_t* r, const qsc_dilithium_poly* a)
+static void dilithium_sample_batch(qsc_dilithium_poly* const* a, const uint16_t* nonces, size_t count, const uint8_t* seed, size_t seedlen,
+	keccak_rate rate, size_t nblocks, size_t grain, dilithium_rejection_sampler rej)
 {
-#if 2 * QSC_DILITHIUM_ETA >= 16
-#	error "qsc_dilithium_polyeta_pack() assumes 2*QSC_DILITHIUM_ETA < 16"
-#endif
-	size_t i;
-	uint8_t t[8];
-
-#if (2 * QSC_DILITHIUM_ETA) <= 7
-
-	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
-	{
-		t[0] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i)];
-		t[1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 1];
-		t[2] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 2];
-		t[3] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 3];
-		t[4] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 4];
-		t[5] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 5];
-		t[6] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 6];
-		t[7] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 7];
-
-		r[(3 * i)] = (t[0] >> 0) | (t[1] << 3) | (t[2] << 6);
-		r[(3 * i) + 1] = (t[2] >> 2) | (t[3] << 1) | (t[4] << 4) | (t[5] << 7);
-		r[(3 * i) + 2] = (t[5] >> 1) | (t[6] << 2) | (t[7] << 5);
-	}
-
-#else
+	uint8_t buf[DILITHIUM_XOF_LANES][DILITHIUM_SAMPLE_BUFFER_SIZE];
+	uint8_t seeds[DILITHIUM_XOF_LANES][QSC_DILITHIUM_CRH_SIZE + 2];
+	size_t k;
+	size_t n;
+	size_t pos;
+	uint32_t ctr;
 
-	for (i = 0; i < QSC_DILITHIUM_N / 2; ++i)
+	/* the polynomials are drawn in batches, one Keccak lane per polynomial; each lane's stream matches the single sampler */
+	for (pos = 0; pos < count; pos += n)
 	{
-		t[0] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(2 * i)];
-		t[1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(2 * i) + 1];
-		r[i] = t[0] | (uint8_t)(t[1] << 4);
-	}
-
-#endif
-}
+		n = count - pos;
+		n = (n > DILITHIUM_XOF_LANES) ? DILITHIUM_XOF_LANES : n;
 
-void qsc_dilithium_polyeta_unpack(qsc_dilithium_poly* r, const uint8_t* a)
-{
-	size_t i;
-
-#if (2 * QSC_DILITHIUM_ETA) <= 7
+		for (k = 0; k < n; ++k)
+		{
+			qsc_memutils_copy(seeds[k], seed, seedlen);
+			seeds[k][seedlen] = (uint8_t)nonces[pos + k];
+			seeds[k][seedlen + 1] = (uint8_t)(nonces[pos + k] >> 8);
+		}
 
-	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
-	{
-		r->coeffs[(8 * i)] = a[3 * i] & 0x07;
-		r->coeffs[(8 * i) + 1] = (a[3 * i] >> 3) & 0x07;
-		r->coeffs[(8 * i) + 2] = ((a[3 * i] >> 6) | (a[(3 * i) + 1] << 2)) & 0x07;
-		r->coeffs[(8 * i) + 3] = (a[(3 * i) + 1] >> 1) & 0x07;
-		r->coeffs[(8 * i) + 4] = (a[(3 * i) + 1] >> 4) & 0x07;
-		r->coeffs[(8 * i) + 5] = ((a[(3 * i) + 1] >> 7) | (a[(3 * i) + 2] << 1)) & 0x07;
-		r->coeffs[(8 * i) + 6] = (a[(3 * i) + 2] >> 2) & 0x07;
-		r->coeffs[(8 * i) + 7] = (a[(3 * i) + 2] >> 5) & 0x07;
-
-		r->coeffs[(8 * i)] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i)];
-		r->coeffs[(8 * i) + 1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 1];
-		r->coeffs[(8 * i) + 2] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 2];
-		r->coeffs[(8 * i) + 3] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 3];
-		r->coeffs[(8 * i) + 4] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 4];
-		r->coeffs[(8 * i) + 5] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 5];
-		r->coeffs[(8 * i) + 6] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 6];
-		r->coeffs[(8 * i) + 7] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 7];
-	}
+		dilithium_xof_lanes(buf, nblocks * (size_t)rate, seeds, seedlen + 2, n, rate);
 
-#else
+		for (k = 0; k < n; ++k)
+		{
+			ctr = rej(a[pos + k]->coeffs, QSC_DILITHIUM_N, buf[k], nblocks * (size_t)rate);
 
-	for (i = 0; i < QSC_DILITHIUM_N / 2; ++i)
-	{
-		r->coeffs[(2 * i)] = a[i] & 0x0Fu;
-		r->coeffs[(2 * i) + 1] = a[i] >> 4;
-		r->coeffs[(2 * i)] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[2 * i];
-		r->coeffs[(2 * i) + 1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(2 * i) + 1];
+			if (ctr < QSC_DILITHIUM_N)
+			{
+				dilithium_sample_resume(a[pos + k], ctr, buf[k], seeds[k], seedlen + 2, rate, nblocks, grain, rej);
+			}
+		}
 	}
-
-#endif
 }
 
 void qsc_dilithium_polyt1_pack(uint8_t* r, const qsc_dilithium_poly* a)
@@ -837,1055 +1222,146 @@ void qsc_dilithium_polyw1_pack(uint8_t* r, const qsc_dilithium_poly* a)
 	}
 }
 
-/* polyvec.c */
+/* reduce.c */
 
-void qsc_dilithium_polyvecl_freeze(qsc_dilithium_polyvecl* v)
+uint32_t qsc_dilithium_montgomery_reduce(uint64_t a)
 {
-	size_t i;
+	uint64_t t;
 
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_poly_freeze(&v->vec[i]);
-	}
+	t = a * DILITHIUM_QINV;
+	t &= (1ULL << 32) - 1;
+	t *= QSC_DILITHIUM_Q;
+	t = a + t;
+	t >>= 32;
+
+	return (uint32_t)t;
 }
 
-void qsc_dilithium_polyvecl_add(qsc_dilithium_polyvecl* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
+uint32_t qsc_dilithium_reduce32(uint32_t a)
 {
-	size_t i;
+	uint32_t t;
 
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
-	}
+	t = a & 0x007FFFFFUL;
+	a >>= 23;
+	t += (a << 13) - a;
+
+	return t;
 }
 
-void qsc_dilithium_polyvecl_ntt(qsc_dilithium_polyvecl* v)
+uint32_t qsc_dilithium_csubq(uint32_t a)
 {
-	size_t i;
+	a -= QSC_DILITHIUM_Q;
+	a += (uint32_t)((int32_t)a >> 31) & (uint32_t)QSC_DILITHIUM_Q;
 
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_poly_ntt(&v->vec[i]);
-	}
+	return a;
 }
 
-void qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(qsc_dilithium_poly* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
+uint32_t qsc_dilithium_freeze(uint32_t a)
 {
-	qsc_dilithium_poly t;
-	size_t i;
 
-	qsc_dilithium_poly_pointwise_invmontgomery(w, &u->vec[0], &v->vec[0]);
+	a = qsc_dilithium_reduce32(a);
+	a = qsc_dilithium_csubq(a);
 
-	for (i = 1; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_poly_pointwise_invmontgomery(&t, &u->vec[i], &v->vec[i]);
-		qsc_dilithium_poly_add(w, w, &t);
-	}
+	return a;
 }
 
-int32_t qsc_dilithium_polyvecl_chknorm(const qsc_dilithium_polyvecl* v, uint32_t bound)
-{
-	size_t i;
-	int32_t r;
+/* rounding.c */
 
-	r = 0;
+uint32_t qsc_dilithium_power2round(uint32_t a, uint32_t* a0)
+{
+	int32_t t;
 
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		if (qsc_dilithium_poly_chknorm(&v->vec[i], bound))
-		{
-			r = 1;
-			break;
-		}
-	}
+	/* Centralized remainder mod 2^QSC_DILITHIUM_D */
+	t = a & ((1U << QSC_DILITHIUM_D) - 1);
+	t -= (1U << (QSC_DILITHIUM_D - 1)) + 1;
+	t += (t >> 31) & (1U << QSC_DILITHIUM_D);
+	t -= (1U << (QSC_DILITHIUM_D - 1)) - 1;
+	*a0 = QSC_DILITHIUM_Q + t;
+	a = (a - t) >> QSC_DILITHIUM_D;
 
-	return r;
+	return a;
 }
 
-void qsc_dilithium_polyveck_reduce(qsc_dilithium_polyveck* v)
+uint32_t qsc_dilithium_decompose(uint32_t a, uint32_t* a0)
 {
-	size_t i;
+#if QSC_DILITHIUM_ALPHA != (QSC_DILITHIUM_Q-1)/16
+#error "qsc_dilithium_decompose assumes QSC_DILITHIUM_ALPHA == (QSC_DILITHIUM_Q-1)/16"
+#endif
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_reduce(&v->vec[i]);
-	}
-}
+	int32_t t;
+	int32_t u;
 
-void qsc_dilithium_polyveck_csubq(qsc_dilithium_polyveck* v)
-{
-	size_t i;
+	/* Centralized remainder mod QSC_DILITHIUM_ALPHA */
+	t = a & 0x0007FFFFUL;
+	t += (a >> 19) << 9;
+	t -= QSC_DILITHIUM_ALPHA / 2 + 1;
+	t += (t >> 31) & QSC_DILITHIUM_ALPHA;
+	t -= QSC_DILITHIUM_ALPHA / 2 - 1;
+	a -= t;
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_csubq(&v->vec[i]);
-	}
-}
+	/* Divide by QSC_DILITHIUM_ALPHA (possible to avoid) */
+	u = a - 1;
+	u >>= 31;
+	a = (a >> 19) + 1;
+	a -= u & 1;
 
-void qsc_dilithium_polyveck_freeze(qsc_dilithium_polyveck* v)
-{
-	size_t i;
+	/* Border case */
+	*a0 = QSC_DILITHIUM_Q + t - (a >> 4);
+	a &= 0x0FU;
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_freeze(&v->vec[i]);
-	}
+	return a;
 }
 
-void qsc_dilithium_polyveck_add(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
+uint32_t qsc_dilithium_make_hint(const uint32_t a0, const uint32_t a1)
 {
-	size_t i;
+	uint32_t r;
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	r = 1;
+
+	if (a0 <= QSC_DILITHIUM_GAMMA2 || a0 > QSC_DILITHIUM_Q - QSC_DILITHIUM_GAMMA2 || (a0 == QSC_DILITHIUM_Q - QSC_DILITHIUM_GAMMA2 && a1 == 0))
 	{
-		qsc_dilithium_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
+		r = 0;
 	}
+
+	return r;
 }
 
-void qsc_dilithium_polyveck_sub(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
+uint32_t qsc_dilithium_use_hint(const uint32_t a, const uint32_t hint)
 {
-	size_t i;
+	uint32_t a0;
+	uint32_t a1;
+
+	a1 = qsc_dilithium_decompose(a, &a0);
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	if (hint == 0)
+	{
+		return a1;
+	}
+	else if (a0 > QSC_DILITHIUM_Q)
+	{
+		return (a1 + 1) & 0x0FU;
+	}
+	else
 	{
-		qsc_dilithium_poly_sub(&w->vec[i], &u->vec[i], &v->vec[i]);
+		return (a1 - 1) & 0x0FU;
 	}
 }
 
-void qsc_dilithium_polyveck_shiftl(qsc_dilithium_polyveck* v)
-{
-	size_t i;
+/* security modes */
 
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_shiftl(&v->vec[i]);
-	}
-}
-
-void qsc_dilithium_polyveck_ntt(qsc_dilithium_polyveck* v)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_ntt(&v->vec[i]);
-	}
-}
-
-void qsc_dilithium_polyveck_invntt_montgomery(qsc_dilithium_polyveck* v)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_invntt_montgomery(&v->vec[i]);
-	}
-}
-
-int32_t qsc_dilithium_polyveck_chknorm(const qsc_dilithium_polyveck* v, uint32_t bound)
-{
-	size_t i;
-	int32_t r;
-
-	r = 0;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		if (qsc_dilithium_poly_chknorm(&v->vec[i], bound))
-		{
-			r = 1;
-			break;
-		}
-	}
-
-	return r;
-}
-
-void qsc_dilithium_polyveck_power2round(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_power2round(&v1->vec[i], &v0->vec[i], &v->vec[i]);
-	}
-}
-
-void qsc_dilithium_polyveck_decompose(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_decompose(&v1->vec[i], &v0->vec[i], &v->vec[i]);
-	}
-}
-
-uint32_t qsc_dilithium_polyveck_make_hint(qsc_dilithium_polyveck* h, const qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v1)
-{
-	size_t i;
-	uint32_t s;
-
-	s = 0;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		s += qsc_dilithium_poly_make_hint(&h->vec[i], &v0->vec[i], &v1->vec[i]);
-	}
-
-	return s;
-}
-
-void qsc_dilithium_polyveck_use_hint(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* h)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_use_hint(&w->vec[i], &u->vec[i], &h->vec[i]);
-	}
-}
-
-/* packing.c */
-
-void qsc_dilithium_pack_pk(uint8_t* pk, const uint8_t* rho, const qsc_dilithium_polyveck* t1)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		pk[i] = rho[i];
-	}
-
-	pk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyt1_pack(pk + (i * DILITHIUM_POLT1_SIZE_PACKED), &t1->vec[i]);
-	}
-}
-
-void qsc_dilithium_unpack_pk(uint8_t* rho, qsc_dilithium_polyveck* t1, const uint8_t* pk)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		rho[i] = pk[i];
-	}
-
-	pk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyt1_unpack(&t1->vec[i], pk + (i * DILITHIUM_POLT1_SIZE_PACKED));
-	}
-}
-
-void qsc_dilithium_pack_sk(uint8_t* sk, const uint8_t* rho, const uint8_t* key, const uint8_t* tr, const qsc_dilithium_polyvecl* s1, const qsc_dilithium_polyveck* s2, const qsc_dilithium_polyveck* t0)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		sk[i] = rho[i];
-	}
-
-	sk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		sk[i] = key[i];
-	}
-
-	sk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
-	{
-		sk[i] = tr[i];
-	}
-
-	sk += QSC_DILITHIUM_CRH_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_polyeta_pack(sk + (i * DILITHIUM_POLETA_SIZE_PACKED), &s1->vec[i]);
-	}
-
-	sk += QSC_DILITHIUM_L * DILITHIUM_POLETA_SIZE_PACKED;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyeta_pack(sk + (i * DILITHIUM_POLETA_SIZE_PACKED), &s2->vec[i]);
-	}
-
-	sk += QSC_DILITHIUM_K * DILITHIUM_POLETA_SIZE_PACKED;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyt0_pack(sk + (i * DILITHIUM_POLT0_SIZE_PACKED), &t0->vec[i]);
-	}
-}
-
-void qsc_dilithium_unpack_sk(uint8_t* rho, uint8_t* key, uint8_t* tr, qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, qsc_dilithium_polyveck* t0, const uint8_t* sk)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		rho[i] = sk[i];
-	}
-
-	sk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
-	{
-		key[i] = sk[i];
-	}
-
-	sk += QSC_DILITHIUM_SEED_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
-	{
-		tr[i] = sk[i];
-	}
-
-	sk += QSC_DILITHIUM_CRH_SIZE;
-
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_polyeta_unpack(&s1->vec[i], sk + (i * DILITHIUM_POLETA_SIZE_PACKED));
-	}
-
-	sk += QSC_DILITHIUM_L * DILITHIUM_POLETA_SIZE_PACKED;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyeta_unpack(&s2->vec[i], sk + (i * DILITHIUM_POLETA_SIZE_PACKED));
-	}
-
-	sk += QSC_DILITHIUM_K * DILITHIUM_POLETA_SIZE_PACKED;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyt0_unpack(&t0->vec[i], sk + (i * DILITHIUM_POLT0_SIZE_PACKED));
-	}
-}
-
-void qsc_dilithium_pack_sig(uint8_t* sig, const qsc_dilithium_polyvecl* z, const qsc_dilithium_polyveck* h, const qsc_dilithium_poly* c)
-{
-	size_t i;
-	size_t j;
-	size_t k;
-	uint64_t mask;
-	uint64_t signs;
-
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_polyz_pack(sig + (i * DILITHIUM_POLZ_SIZE_PACKED), &z->vec[i]);
-	}
-
-	sig += QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED;
-
-	/* Encode h */
-	k = 0;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		for (j = 0; j < QSC_DILITHIUM_N; ++j)
-		{
-			if (h->vec[i].coeffs[j] != 0)
-			{
-				sig[k] = (uint8_t)j;
-				++k;
-			}
-		}
-
-		sig[QSC_DILITHIUM_OMEGA + i] = (uint8_t)k;
-	}
-
-	while (k < QSC_DILITHIUM_OMEGA)
-	{
-		sig[k] = 0;
-		++k;
-	}
-
-	sig += QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K;
-
-	/* Encode c */
-	signs = 0;
-	mask = 1;
-
-	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
-	{
-		sig[i] = 0;
-
-		for (j = 0; j < 8; ++j)
-		{
-			if (c->coeffs[(8 * i) + j] != 0)
-			{
-				sig[i] |= (1U << j);
-
-				if (c->coeffs[(8 * i) + j] == (QSC_DILITHIUM_Q - 1))
-				{
-					signs |= mask;
-				}
-
-				mask <<= 1;
-			}
-		}
-	}
-
-	sig += QSC_DILITHIUM_N / 8;
-
-	for (i = 0; i < 8; ++i)
-	{
-		sig[i] = (uint8_t)(signs >> (8 * i));
-	}
-}
-
-int32_t qsc_dilithium_unpack_sig(qsc_dilithium_polyvecl* z, qsc_dilithium_polyveck* h, qsc_dilithium_poly* c, const uint8_t* sig)
-{
-	uint64_t signs;
-	size_t i;
-	size_t j;
-	size_t k;
-	int32_t ret;
-
-	ret = 0;
-
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_polyz_unpack(&z->vec[i], sig + (i * DILITHIUM_POLZ_SIZE_PACKED));
-	}
-
-	sig += QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED;
-
-	/* Decode h */
-	k = 0;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		for (j = 0; j < QSC_DILITHIUM_N; ++j)
-		{
-			h->vec[i].coeffs[j] = 0;
-		}
-
-		if (sig[QSC_DILITHIUM_OMEGA + i] < k || sig[QSC_DILITHIUM_OMEGA + i] > QSC_DILITHIUM_OMEGA)
-		{
-			ret = 1;
-			break;
-		}
-
-		for (j = k; j < sig[QSC_DILITHIUM_OMEGA + i]; ++j)
-		{
-			/* Coefficients are ordered for strong unforgeability */
-			if (j > k && sig[j] <= sig[j - 1])
-			{
-				ret = 1;
-				break;
-			}
-
-			h->vec[i].coeffs[sig[j]] = 1;
-		}
-
-		if (ret != 0)
-		{
-			break;
-		}
-
-		k = sig[QSC_DILITHIUM_OMEGA + i];
-	}
-
-	if (ret == 0)
-	{
-		/* Extra indices are zero for strong unforgeability */
-		for (j = k; j < QSC_DILITHIUM_OMEGA; ++j)
-		{
-			if (sig[j])
-			{
-				ret = 1;
-				break;
-			}
-		}
-
-		if (ret == 0)
-		{
-			sig += QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K;
-
-			/* Decode c */
-			for (i = 0; i < QSC_DILITHIUM_N; ++i)
-			{
-				c->coeffs[i] = 0;
-			}
-
-			signs = 0;
-
-			for (i = 0; i < 8; ++i)
-			{
-				signs |= (uint64_t)sig[(QSC_DILITHIUM_N / 8) + i] << (8 * i);
-			}
-
-			/* Extra sign bits are zero for strong unforgeability */
-			if (signs >> 60)
-			{
-				ret = 1;
-			}
-
-			if (ret == 0)
-			{
-				for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
-				{
-					for (j = 0; j < 8; ++j)
-					{
-						if ((uint8_t)(sig[i] >> j) & 0x01U)
-						{
-							c->coeffs[(8 * i) + j] = 1;
-							c->coeffs[(8 * i) + j] ^= (uint32_t)(~(signs & 1ULL) + 1) & (1UL ^ (uint32_t)(QSC_DILITHIUM_Q - 1));
-							signs >>= 1;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	return ret;
-}
-
-/* reduce.c */
-
-uint32_t qsc_dilithium_montgomery_reduce(uint64_t a)
-{
-	uint64_t t;
-
-	t = a * DILITHIUM_QINV;
-	t &= (1ULL << 32) - 1;
-	t *= QSC_DILITHIUM_Q;
-	t = a + t;
-	t >>= 32;
+/* each mode is compiled from the same source with its dimensions and an _m<mode> symbol suffix */
+#define DILITHIUM_NAMESPACE_CONCAT(x, m) x##_m##m
+#define DILITHIUM_NAMESPACE_EXPAND(x, m) DILITHIUM_NAMESPACE_CONCAT(x, m)
+#define DILITHIUM_NAMESPACE(x) DILITHIUM_NAMESPACE_EXPAND(x, DILITHIUM_MODE)
 
-	return (uint32_t)t;
-}
-
-uint32_t qsc_dilithium_reduce32(uint32_t a)
-{
-	uint32_t t;
-
-	t = a & 0x007FFFFFUL;
-	a >>= 23;
-	t += (a << 13) - a;
-
-	return t;
-}
-
-uint32_t qsc_dilithium_csubq(uint32_t a)
-{
-	a -= QSC_DILITHIUM_Q;
-	a += (uint32_t)((int32_t)a >> 31) & (uint32_t)QSC_DILITHIUM_Q;
-
-	return a;
-}
-
-uint32_t qsc_dilithium_freeze(uint32_t a)
-{
-
-	a = qsc_dilithium_reduce32(a);
-	a = qsc_dilithium_csubq(a);
-
-	return a;
-}
-
-/* rounding.c */
-
-uint32_t qsc_dilithium_power2round(uint32_t a, uint32_t* a0)
-{
-	int32_t t;
-
-	/* Centralized remainder mod 2^QSC_DILITHIUM_D */
-	t = a & ((1U << QSC_DILITHIUM_D) - 1);
-	t -= (1U << (QSC_DILITHIUM_D - 1)) + 1;
-	t += (t >> 31) & (1U << QSC_DILITHIUM_D);
-	t -= (1U << (QSC_DILITHIUM_D - 1)) - 1;
-	*a0 = QSC_DILITHIUM_Q + t;
-	a = (a - t) >> QSC_DILITHIUM_D;
-
-	return a;
-}
-
-uint32_t qsc_dilithium_decompose(uint32_t a, uint32_t* a0)
-{
-#if QSC_DILITHIUM_ALPHA != (QSC_DILITHIUM_Q-1)/16
-#error "qsc_dilithium_decompose assumes QSC_DILITHIUM_ALPHA == (QSC_DILITHIUM_Q-1)/16"
-#endif
-
-	int32_t t;
-	int32_t u;
-
-	/* Centralized remainder mod QSC_DILITHIUM_ALPHA */
-	t = a & 0x0007FFFFUL;
-	t += (a >> 19) << 9;
-	t -= QSC_DILITHIUM_ALPHA / 2 + 1;
-	t += (t >> 31) & QSC_DILITHIUM_ALPHA;
-	t -= QSC_DILITHIUM_ALPHA / 2 - 1;
-	a -= t;
-
-	/* Divide by QSC_DILITHIUM_ALPHA (possible to avoid) */
-	u = a - 1;
-	u >>= 31;
-	a = (a >> 19) + 1;
-	a -= u & 1;
-
-	/* Border case */
-	*a0 = QSC_DILITHIUM_Q + t - (a >> 4);
-	a &= 0x0FU;
-
-	return a;
-}
-
-uint32_t qsc_dilithium_make_hint(const uint32_t a0, const uint32_t a1)
-{
-	uint32_t r;
-
-	r = 1;
-
-	if (a0 <= QSC_DILITHIUM_GAMMA2 || a0 > QSC_DILITHIUM_Q - QSC_DILITHIUM_GAMMA2 || (a0 == QSC_DILITHIUM_Q - QSC_DILITHIUM_GAMMA2 && a1 == 0))
-	{
-		r = 0;
-	}
-
-	return r;
-}
-
-uint32_t qsc_dilithium_use_hint(const uint32_t a, const uint32_t hint)
-{
-	uint32_t a0;
-	uint32_t a1;
-
-	a1 = qsc_dilithium_decompose(a, &a0);
-
-	if (hint == 0)
-	{
-		return a1;
-	}
-	else if (a0 > QSC_DILITHIUM_Q)
-	{
-		return (a1 + 1) & 0x0FU;
-	}
-	else
-	{
-		return (a1 - 1) & 0x0FU;
-	}
-}
-
-/* sign.c */
-
-void expand_mat(qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], const uint8_t rho[QSC_DILITHIUM_SEED_SIZE])
-{
-	size_t i;
-	size_t j;
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		for (j = 0; j < QSC_DILITHIUM_L; ++j)
-		{
-			qsc_dilithium_poly_uniform(&mat[i].vec[j], rho, (uint16_t)((i << 8) + j));
-		}
-	}
-}
-
-void challenge(qsc_dilithium_poly* c, const uint8_t mu[QSC_DILITHIUM_CRH_SIZE], const qsc_dilithium_polyveck *w1)
-{
-	uint8_t inbuf[QSC_DILITHIUM_CRH_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLW1_SIZE_PACKED];
-	uint8_t outbuf[QSC_KECCAK_256_RATE];
-	qsc_keccak_state kstate;
-	uint64_t signs;
-	size_t b;
-	size_t i;
-	size_t pos;
+#define DILITHIUM_MODE 2
+#include "dilithiumbasek.h"
+#undef DILITHIUM_MODE
 
-	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
-	{
-		kstate.state[i] = 0;
-	}
-
-	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
-	{
-		inbuf[i] = mu[i];
-	}
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyw1_pack(inbuf + QSC_DILITHIUM_CRH_SIZE + (i * DILITHIUM_POLW1_SIZE_PACKED), &w1->vec[i]);
-	}
-
-	qsc_shake_initialize(&kstate, keccak_rate_256, inbuf, sizeof(inbuf));
-	qsc_shake_squeezeblocks(&kstate, keccak_rate_256, outbuf, 1);
-	signs = 0;
-
-	for (i = 0; i < 8; ++i)
-	{
-		signs |= (uint64_t)outbuf[i] << 8 * i;
-	}
-
-	pos = 8;
-
-	for (i = 0; i < QSC_DILITHIUM_N; ++i)
-	{
-		c->coeffs[i] = 0;
-	}
-
-	for (i = 196; i < 256; ++i)
-	{
-		do
-		{
-			if (pos >= QSC_KECCAK_256_RATE)
-			{
-				qsc_shake_squeezeblocks(&kstate, keccak_rate_256, outbuf, 1);
-				pos = 0;
-			}
-
-			b = (size_t)outbuf[pos];
-			++pos;
-		}
-		while (b > i);
-
-		c->coeffs[i] = c->coeffs[b];
-		c->coeffs[b] = 1;
-		c->coeffs[b] ^= (uint32_t)(~(signs & 1) + 1) & (1 ^ (QSC_DILITHIUM_Q - 1));
-		signs >>= 1;
-	}
-}
-
-void qsc_dilithium_ksm_generate(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t))
-{
-	const uint8_t* key;
-	const uint8_t* rho;
-	const uint8_t* rhoprime;
-	uint8_t seedbuf[3 * QSC_DILITHIUM_SEED_SIZE];
-	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
-	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
-	qsc_dilithium_polyvecl s1;
-	qsc_dilithium_polyvecl s1hat;
-	qsc_dilithium_polyveck s2;
-	qsc_dilithium_polyveck t;
-	qsc_dilithium_polyveck t0;
-	qsc_dilithium_polyveck t1;
-	size_t i;
-	uint16_t nonce;
-
-	/* Expand 32 bytes of randomness into rho, rhoprime and key */
-	rng_generate(seedbuf, 3 * QSC_DILITHIUM_SEED_SIZE);
-	rho = seedbuf;
-	rhoprime = seedbuf + QSC_DILITHIUM_SEED_SIZE;
-	key = seedbuf + (2 * QSC_DILITHIUM_SEED_SIZE);
-
-	/* Expand matrix */
-	expand_mat(mat, rho);
-	nonce = 0;
-
-	/* Sample short vectors s1 and s2 */
-	for (i = 0; i < QSC_DILITHIUM_L; ++i)
-	{
-		qsc_dilithium_poly_uniform_eta(&s1.vec[i], rhoprime, nonce);
-		++nonce;
-	}
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_poly_uniform_eta(&s2.vec[i], rhoprime, nonce);
-		++nonce;
-	}
-
-	/* Matrix-vector multiplication */
-	s1hat = s1;
-	qsc_dilithium_polyvecl_ntt(&s1hat);
-
-	for (i = 0; i < QSC_DILITHIUM_K; ++i)
-	{
-		qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&t.vec[i], &mat[i], &s1hat);
-		qsc_dilithium_poly_reduce(&t.vec[i]);
-		qsc_dilithium_poly_invntt_montgomery(&t.vec[i]);
-	}
-
-	/* Add error vector s2 */
-	qsc_dilithium_polyveck_add(&t, &t, &s2);
-
-	/* Extract t1 and write public key */
-	qsc_dilithium_polyveck_freeze(&t);
-	qsc_dilithium_polyveck_power2round(&t1, &t0, &t);
-	qsc_dilithium_pack_pk(publickey, rho, &t1);
-
-	/* Compute CRH(rho, t1) and write secret key */
-	qsc_shake256_compute(tr, QSC_DILITHIUM_CRH_SIZE, publickey, DILITHIUM_PUBLICKEY_SIZE);
-	qsc_dilithium_pack_sk(secretkey, rho, key, tr, &s1, &s2, &t0);
-}
-
-void qsc_dilithium_ksm_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
-{
-	uint8_t seedbuf[2 * QSC_DILITHIUM_SEED_SIZE + 3 * QSC_DILITHIUM_CRH_SIZE];
-	uint8_t* rho;
-	uint8_t* tr;
-	uint8_t* key;
-	uint8_t* mu;
-	uint8_t* rhoprime;
-	uint16_t nonce = 0;
-	qsc_dilithium_poly c;
-	qsc_dilithium_poly chat;
-	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
-	qsc_dilithium_polyvecl s1;
-	qsc_dilithium_polyvecl y;
-	qsc_dilithium_polyvecl yhat;
-	qsc_dilithium_polyvecl z;
-	qsc_dilithium_polyveck t0;
-	qsc_dilithium_polyveck s2;
-	qsc_dilithium_polyveck w;
-	qsc_dilithium_polyveck w1;
-	qsc_dilithium_polyveck w0;
-	qsc_dilithium_polyveck h;
-	qsc_dilithium_polyveck cs2;
-	qsc_dilithium_polyveck ct0;
-	size_t i;
-	uint32_t n;
-	int32_t nrej;
-
-	rho = seedbuf;
-	tr = rho + QSC_DILITHIUM_SEED_SIZE;
-	key = tr + QSC_DILITHIUM_CRH_SIZE;
-	mu = key + QSC_DILITHIUM_SEED_SIZE;
-	rhoprime = mu + QSC_DILITHIUM_CRH_SIZE;
-	qsc_dilithium_unpack_sk(rho, key, tr, &s1, &s2, &t0, privatekey);
-
-	/* Copy tr and message into the signedmsg buffer,
-	 * backwards since message and signedmsg can be equal in SUPERCOP API */
-	for (i = 1; i <= msglen; ++i)
-	{
-		signedmsg[DILITHIUM_SIGNATURE_SIZE + msglen - i] = message[msglen - i];
-	}
-
-	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
-	{
-		signedmsg[DILITHIUM_SIGNATURE_SIZE - QSC_DILITHIUM_CRH_SIZE + i] = tr[i];
-	}
-
-	/* Compute CRH(tr, msg) */
-	qsc_shake256_compute(mu, QSC_DILITHIUM_CRH_SIZE, signedmsg + DILITHIUM_SIGNATURE_SIZE - QSC_DILITHIUM_CRH_SIZE, QSC_DILITHIUM_CRH_SIZE + msglen);
-
-#ifdef RANDOMIZED_SIGNING
-	rng_generate(rhoprime, QSC_DILITHIUM_CRH_SIZE);
-#else
-	qsc_shake256_compute(rhoprime, QSC_DILITHIUM_CRH_SIZE, key, QSC_DILITHIUM_SEED_SIZE + QSC_DILITHIUM_CRH_SIZE);
-#endif
-
-	/* Expand matrix and transform vectors */
-	expand_mat(mat, rho);
-	qsc_dilithium_polyvecl_ntt(&s1);
-	qsc_dilithium_polyveck_ntt(&s2);
-	qsc_dilithium_polyveck_ntt(&t0);
-	nrej = 1;
-
-	while (nrej != 0)
-	{
-		/* Sample intermediate vector y */
-		for (i = 0; i < QSC_DILITHIUM_L; ++i)
-		{
-			qsc_dilithium_poly_uniform_gamma1m1(&y.vec[i], rhoprime, nonce++);
-		}
-
-		/* Matrix-vector multiplication */
-		yhat = y;
-		qsc_dilithium_polyvecl_ntt(&yhat);
-
-		for (i = 0; i < QSC_DILITHIUM_K; ++i)
-		{
-			qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&w.vec[i], &mat[i], &yhat);
-			qsc_dilithium_poly_reduce(&w.vec[i]);
-			qsc_dilithium_poly_invntt_montgomery(&w.vec[i]);
-		}
-
-		/* Decompose w and call the random oracle */
-		qsc_dilithium_polyveck_csubq(&w);
-		qsc_dilithium_polyveck_decompose(&w1, &w0, &w);
-		challenge(&c, mu, &w1);
-		chat = c;
-		qsc_dilithium_poly_ntt(&chat);
-
-		/* Check that subtracting cs2 does not change high bits of w and low bits
-		 * do not reveal secret information */
-		for (i = 0; i < QSC_DILITHIUM_K; ++i)
-		{
-			qsc_dilithium_poly_pointwise_invmontgomery(&cs2.vec[i], &chat, &s2.vec[i]);
-			qsc_dilithium_poly_invntt_montgomery(&cs2.vec[i]);
-		}
-
-		qsc_dilithium_polyveck_sub(&w0, &w0, &cs2);
-		qsc_dilithium_polyveck_freeze(&w0);
-
-		if (qsc_dilithium_polyveck_chknorm(&w0, QSC_DILITHIUM_GAMMA2 - QSC_DILITHIUM_BETA) != 0)
-		{
-			continue;
-		}
-
-		/* Compute z, reject if it reveals secret */
-		for (i = 0; i < QSC_DILITHIUM_L; ++i)
-		{
-			qsc_dilithium_poly_pointwise_invmontgomery(&z.vec[i], &chat, &s1.vec[i]);
-			qsc_dilithium_poly_invntt_montgomery(&z.vec[i]);
-		}
-
-		qsc_dilithium_polyvecl_add(&z, &z, &y);
-		qsc_dilithium_polyvecl_freeze(&z);
-
-		if (qsc_dilithium_polyvecl_chknorm(&z, QSC_DILITHIUM_GAMMA1 - QSC_DILITHIUM_BETA) != 0)
-		{
-			continue;
-		}
-
-		/* Compute hints for w1 */
-		for (i = 0; i < QSC_DILITHIUM_K; ++i)
-		{
-			qsc_dilithium_poly_pointwise_invmontgomery(&ct0.vec[i], &chat, &t0.vec[i]);
-			qsc_dilithium_poly_invntt_montgomery(&ct0.vec[i]);
-		}
-
-		qsc_dilithium_polyveck_csubq(&ct0);
-
-		if (qsc_dilithium_polyveck_chknorm(&ct0, QSC_DILITHIUM_GAMMA2) != 0)
-		{
-			continue;
-		}
-
-		qsc_dilithium_polyveck_add(&w0, &w0, &ct0);
-		qsc_dilithium_polyveck_csubq(&w0);
-		n = qsc_dilithium_polyveck_make_hint(&h, &w0, &w1);
-
-		if (n > QSC_DILITHIUM_OMEGA)
-		{
-			continue;
-		}
-
-		/* Write signature */
-		qsc_dilithium_pack_sig(signedmsg, &z, &h, &c);
-		*smsglen = msglen + DILITHIUM_SIGNATURE_SIZE;
-		nrej = 0;
-	}
-}
-
-bool qsc_dilithium_ksm_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
-{
-	uint8_t rho[QSC_DILITHIUM_SEED_SIZE];
-	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
-	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
-	qsc_dilithium_polyvecl z;
-	qsc_dilithium_polyveck t1;
-	qsc_dilithium_polyveck w1;
-	qsc_dilithium_polyveck h;
-	qsc_dilithium_polyveck tmp1;
-	qsc_dilithium_polyveck tmp2;
-	qsc_dilithium_poly c;
-	qsc_dilithium_poly chat;
-	qsc_dilithium_poly cp;
-	size_t i;
-	int32_t bsig;
-
-	bsig = 0;
-
-	if (smsglen < DILITHIUM_SIGNATURE_SIZE)
-	{
-		bsig = -1;
-	}
-
-	if (bsig == 0)
-	{
-		*msglen = smsglen - DILITHIUM_SIGNATURE_SIZE;
-		qsc_dilithium_unpack_pk(rho, &t1, publickey);
-
-		if (qsc_dilithium_unpack_sig(&z, &h, &c, signedmsg) != 0)
-		{
-			bsig = -1;
-		}
+#define DILITHIUM_MODE 3
+#include "dilithiumbasek.h"
+#undef DILITHIUM_MODE
 
-		if (bsig == 0)
-		{
-			if (qsc_dilithium_polyvecl_chknorm(&z, QSC_DILITHIUM_GAMMA1 - QSC_DILITHIUM_BETA) != 0)
-			{
-				bsig = -1;
-			}
-
-			if (bsig == 0)
-			{
-				/* Compute CRH(CRH(rho, t1), msg) using message as "playground" buffer */
-				if (signedmsg != message)
-				{
-					for (i = 0; i < *msglen; ++i)
-					{
-						message[DILITHIUM_SIGNATURE_SIZE + i] = signedmsg[DILITHIUM_SIGNATURE_SIZE + i];
-					}
-				}
-
-				qsc_shake256_compute((uint8_t*)message + (DILITHIUM_SIGNATURE_SIZE - QSC_DILITHIUM_CRH_SIZE), QSC_DILITHIUM_CRH_SIZE, publickey, DILITHIUM_PUBLICKEY_SIZE);
-				qsc_shake256_compute(mu, QSC_DILITHIUM_CRH_SIZE, (uint8_t*)message + (DILITHIUM_SIGNATURE_SIZE - QSC_DILITHIUM_CRH_SIZE), QSC_DILITHIUM_CRH_SIZE + *msglen);
-
-				/* Matrix-vector multiplication; compute Az - c2^dt1 */
-				expand_mat(mat, rho);
-				qsc_dilithium_polyvecl_ntt(&z);
-
-				for (i = 0; i < QSC_DILITHIUM_K; ++i)
-				{
-					qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&tmp1.vec[i], &mat[i], &z);
-				}
-
-				chat = c;
-				qsc_dilithium_poly_ntt(&chat);
-				qsc_dilithium_polyveck_shiftl(&t1);
-				qsc_dilithium_polyveck_ntt(&t1);
-
-				for (i = 0; i < QSC_DILITHIUM_K; ++i)
-				{
-					qsc_dilithium_poly_pointwise_invmontgomery(&tmp2.vec[i], &chat, &t1.vec[i]);
-				}
-
-				qsc_dilithium_polyveck_sub(&tmp1, &tmp1, &tmp2);
-				qsc_dilithium_polyveck_reduce(&tmp1);
-				qsc_dilithium_polyveck_invntt_montgomery(&tmp1);
-
-				/* Reconstruct w1 */
-				qsc_dilithium_polyveck_csubq(&tmp1);
-				qsc_dilithium_polyveck_use_hint(&w1, &tmp1, &h);
-
-				/* Call random oracle and verify challenge */
-				challenge(&cp, mu, &w1);
-
-				for (i = 0; i < QSC_DILITHIUM_N; ++i)
-				{
-					if (c.coeffs[i] != cp.coeffs[i])
-					{
-						bsig = -1;
-						break;
-					}
-				}
-
-				if (bsig == 0)
-				{
-					/* All good, copy msg, return 0 */
-					for (i = 0; i < *msglen; ++i)
-					{
-						message[i] = signedmsg[DILITHIUM_SIGNATURE_SIZE + i];
-					}
-				}
-			}
-		}
-	}
-
-	if (bsig != 0)
-	{
-		*msglen = 0;
-
-		for (i = 0; i < smsglen; ++i)
-		{
-			message[i] = 0;
-		}
-	}
-
-	return (bsig == 0);
-}
+#define DILITHIUM_MODE 4
+#include "dilithiumbasek.h"
+#undef DILITHIUM_MODE
@@ -21,9 +21,16 @@
 #define QSC_DILITHIUMBASE_H
 
 #include "common.h"
+#include "dilithium.h"
+#include "sha3.h"
 
 /* params.h */
 
+/*!
+\def QCX_DILITHIUM_MODE
+* Read Only: The default security mode, selected in common.h. \n
+* All three modes are compiled, the default mode serves the fixed-size api in dilithium.h.
+*/
 #if defined(QSC_DILITHIUM_S1N256Q8380417)
 #	define QCX_DILITHIUM_MODE 2
 #elif defined(QSC_DILITHIUM_S2N256Q8380417)
@@ -43,38 +50,6 @@
 #define QSC_DILITHIUM_GAMMA2 (QSC_DILITHIUM_GAMMA1 / 2)
 #define QSC_DILITHIUM_ALPHA (2 * QSC_DILITHIUM_GAMMA2)
 
-#if (QCX_DILITHIUM_MODE == 1)
-#	define QSC_DILITHIUM_K 3
-#	define QSC_DILITHIUM_L 2
-#	define QSC_DILITHIUM_ETA 7
-#	define QSC_DILITHIUM_SETABITS 4
-#	define QSC_DILITHIUM_BETA 375
-#	define QSC_DILITHIUM_OMEGA 64
-#elif (QCX_DILITHIUM_MODE == 2)
-#	define QSC_DILITHIUM_K 4
-#	define QSC_DILITHIUM_L 3
-#	define QSC_DILITHIUM_ETA 6
-#	define QSC_DILITHIUM_SETABITS 4
-#	define QSC_DILITHIUM_BETA 325
-#	define QSC_DILITHIUM_OMEGA 80
-#elif (QCX_DILITHIUM_MODE == 3)
-#	define QSC_DILITHIUM_K 5
-#	define QSC_DILITHIUM_L 4
-#	define QSC_DILITHIUM_ETA 5
-#	define QSC_DILITHIUM_SETABITS 4
-#	define QSC_DILITHIUM_BETA 275
-#	define QSC_DILITHIUM_OMEGA 96
-#elif (QCX_DILITHIUM_MODE == 4)
-#	define QSC_DILITHIUM_K 6
-#	define QSC_DILITHIUM_L 5
-#	define QSC_DILITHIUM_ETA 3
-#	define QSC_DILITHIUM_SETABITS 3
-#	define QSC_DILITHIUM_BETA 175
-#	define QSC_DILITHIUM_OMEGA 120
-#else
-#	error the dilithium mode is invalid!
-#endif
-
 /* qsc_dilithium_ntt.h */
 
 /*************************************************
@@ -289,19 +264,6 @@ int32_t  qsc_dilithium_poly_chknorm(const qsc_dilithium_poly* a, uint32_t B);
 **************************************************/
 void qsc_dilithium_poly_uniform(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_SEED_SIZE], uint16_t nonce);
 
-/*************************************************
-* Name:        qsc_dilithium_poly_uniform_eta
-*
-* Description: Sample polynomial with uniformly random coefficients
-*              in [-QSC_DILITHIUM_ETA,QSC_DILITHIUM_ETA] by performing rejection sampling using the
-*              output stream from SHAKE256(seed|nonce).
-*
-* Arguments:   - qsc_dilithium_poly *a: pointer to output polynomial
-*              - const uint8_t seed[]: byte array with seed of length
-*                                            QSC_DILITHIUM_SEED_SIZE
-*              - uint16_t nonce: 2-byte nonce
-**************************************************/
-void qsc_dilithium_poly_uniform_eta(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_SEED_SIZE], uint16_t nonce);
 
 /*************************************************
 * Name:        qsc_dilithium_poly_uniform_gamma1m1
@@ -317,28 +279,7 @@ void qsc_dilithium_poly_uniform_eta(qsc_dilithium_poly* a, const uint8_t seed[QS
 **************************************************/
 void qsc_dilithium_poly_uniform_gamma1m1(qsc_dilithium_poly* a, const uint8_t seed[QSC_DILITHIUM_CRH_SIZE], uint16_t nonce);
 
-/*************************************************
-* Name:        qsc_dilithium_polyeta_pack
-*
-* Description: Bit-pack polynomial with coefficients in [-QSC_DILITHIUM_ETA,QSC_DILITHIUM_ETA].
-*              Input coefficients are assumed to lie in [QSC_DILITHIUM_Q-QSC_DILITHIUM_ETA,QSC_DILITHIUM_Q+QSC_DILITHIUM_ETA].
-*
-* Arguments:   - uint8_t *r: pointer to output byte array with at least
-*                                  DILITHIUM_POLETA_SIZE_PACKED bytes
-*              - const qsc_dilithium_poly *a: pointer to input polynomial
-**************************************************/
-void qsc_dilithium_polyeta_pack(uint8_t* r, const qsc_dilithium_poly* a);
 
-/*************************************************
-* Name:        qsc_dilithium_polyeta_unpack
-*
-* Description: Unpack polynomial with coefficients in [-QSC_DILITHIUM_ETA,QSC_DILITHIUM_ETA].
-*              Output coefficients lie in [QSC_DILITHIUM_Q-QSC_DILITHIUM_ETA,QSC_DILITHIUM_Q+QSC_DILITHIUM_ETA].
-*
-* Arguments:   - qsc_dilithium_poly *r: pointer to output polynomial
-*              - const uint8_t *a: byte array with bit-packed polynomial
-**************************************************/
-void qsc_dilithium_polyeta_unpack(qsc_dilithium_poly* r, const uint8_t* a);
 
 /*************************************************
 * Name:        qsc_dilithium_polyt1_pack
@@ -423,321 +364,6 @@ void qsc_dilithium_polyz_unpack(qsc_dilithium_poly* r, const uint8_t* a);
 **************************************************/
 void qsc_dilithium_polyw1_pack(uint8_t* r, const qsc_dilithium_poly* a);
 
-/* polyvec.h */
-
-/* Vectors of polynomials of length QSC_DILITHIUM_L */
-typedef struct
-{
-	qsc_dilithium_poly vec[QSC_DILITHIUM_L];
-} qsc_dilithium_polyvecl;
-
-/* Vectors of polynomials of length QSC_DILITHIUM_K */
-typedef struct
-{
-	qsc_dilithium_poly vec[QSC_DILITHIUM_K];
-} qsc_dilithium_polyveck;
-
-/*************************************************
-* Name:        qsc_dilithium_polyvecl_freeze
-*
-* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_L
-*              to standard representatives.
-*
-* Arguments:   - qsc_dilithium_polyvecl *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyvecl_freeze(qsc_dilithium_polyvecl* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyvecl_add
-*
-* Description: Add vectors of polynomials of length QSC_DILITHIUM_L.
-*              No modular reduction is performed.
-*
-* Arguments:   - qsc_dilithium_polyvecl *w: pointer to output vector
-*              - const qsc_dilithium_polyvecl *u: pointer to first summand
-*              - const qsc_dilithium_polyvecl *v: pointer to second summand
-**************************************************/
-void qsc_dilithium_polyvecl_add(qsc_dilithium_polyvecl* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyvecl_ntt
-*
-* Description: Forward NTT of all polynomials in vector of length QSC_DILITHIUM_L. Output
-*              coefficients can be up to 16*QSC_DILITHIUM_Q larger than input coefficients.
-*
-* Arguments:   - qsc_dilithium_polyvecl *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyvecl_ntt(qsc_dilithium_polyvecl* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyvecl_pointwise_acc_invmontgomery
-*
-* Description: Pointwise multiply vectors of polynomials of length QSC_DILITHIUM_L, multiply
-*              resulting vector by 2^{-32} and add (accumulate) polynomials
-*              in it. Input/output vectors are in NTT domain representation.
-*              Input coefficients are assumed to be less than 22*QSC_DILITHIUM_Q. Output
-*              coeffcient are less than 2*QSC_DILITHIUM_L*QSC_DILITHIUM_Q.
-*
-* Arguments:   - qsc_dilithium_poly *w: output polynomial
-*              - const qsc_dilithium_polyvecl *u: pointer to first input vector
-*              - const qsc_dilithium_polyvecl *v: pointer to second input vector
-**************************************************/
-void qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(qsc_dilithium_poly* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyvecl_chknorm
-*
-* Description: Check infinity norm of polynomials in vector of length QSC_DILITHIUM_L.
-*              Assumes input coefficients to be standard representatives.
-*
-* Arguments:   - const qsc_dilithium_polyvecl *v: pointer to vector
-*              - uint32_t B: norm bound
-*
-* Returns 0 if norm of all polynomials is strictly smaller than B and 1
-* otherwise.
-**************************************************/
-int32_t qsc_dilithium_polyvecl_chknorm(const qsc_dilithium_polyvecl* v, uint32_t B);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_reduce
-*
-* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_K
-*              to representatives in [0,2*QSC_DILITHIUM_Q[.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_reduce(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_csubq
-*
-* Description: For all coefficients of polynomials in vector of length QSC_DILITHIUM_K
-*              subtract QSC_DILITHIUM_Q if coefficient is bigger than QSC_DILITHIUM_Q.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_csubq(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_freeze
-*
-* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_K
-*              to standard representatives.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_freeze(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_add
-*
-* Description: Add vectors of polynomials of length QSC_DILITHIUM_K.
-*              No modular reduction is performed.
-*
-* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector
-*              - const qsc_dilithium_polyveck *u: pointer to first summand
-*              - const qsc_dilithium_polyveck *v: pointer to second summand
-**************************************************/
-void qsc_dilithium_polyveck_add(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_sub
-*
-* Description: Subtract vectors of polynomials of length QSC_DILITHIUM_K.
-*              Assumes coefficients of polynomials in second input vector
-*              to be less than 2*QSC_DILITHIUM_Q. No modular reduction is performed.
-*
-* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector
-*              - const qsc_dilithium_polyveck *u: pointer to first input vector
-*              - const qsc_dilithium_polyveck *v: pointer to second input vector to be
-*                                   subtracted from first input vector
-**************************************************/
-void qsc_dilithium_polyveck_sub(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_shiftl
-*
-* Description: Multiply vector of polynomials of Length QSC_DILITHIUM_K by 2^QSC_DILITHIUM_D without modular
-*              reduction. Assumes input coefficients to be less than 2^{32-QSC_DILITHIUM_D}.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_shiftl(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_ntt
-*
-* Description: Forward NTT of all polynomials in vector of length QSC_DILITHIUM_K. Output
-*              coefficients can be up to 16*QSC_DILITHIUM_Q larger than input coefficients.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_ntt(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_invntt_montgomery
-*
-* Description: Inverse NTT and multiplication by 2^{32} of polynomials
-*              in vector of length QSC_DILITHIUM_K. Input coefficients need to be less
-*              than 2*QSC_DILITHIUM_Q.
-*
-* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
-**************************************************/
-void qsc_dilithium_polyveck_invntt_montgomery(qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_chknorm
-*
-* Description: Check infinity norm of polynomials in vector of length QSC_DILITHIUM_K.
-*              Assumes input coefficients to be standard representatives.
-*
-* Arguments:   - const qsc_dilithium_polyveck *v: pointer to vector
-*              - uint32_t B: norm bound
-*
-* Returns 0 if norm of all polynomials are strictly smaller than B and 1
-* otherwise.
-**************************************************/
-int32_t qsc_dilithium_polyveck_chknorm(const qsc_dilithium_polyveck* v, uint32_t B);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_power2round
-*
-* Description: For all coefficients a of polynomials in vector of length QSC_DILITHIUM_K,
-*              compute a0, a1 such that a mod QSC_DILITHIUM_Q = a1*2^QSC_DILITHIUM_D + a0
-*              with -2^{QSC_DILITHIUM_D-1} < a0 <= 2^{QSC_DILITHIUM_D-1}. Assumes coefficients to be
-*              standard representatives.
-*
-* Arguments:   - qsc_dilithium_polyveck *v1: pointer to output vector of polynomials with
-*                              coefficients a1
-*              - qsc_dilithium_polyveck *v0: pointer to output vector of polynomials with
-*                              coefficients QSC_DILITHIUM_Q + a0
-*              - const qsc_dilithium_polyveck *v: pointer to input vector
-**************************************************/
-void qsc_dilithium_polyveck_power2round(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_decompose
-*
-* Description: For all coefficients a of polynomials in vector of length QSC_DILITHIUM_K,
-*              compute high and low bits a0, a1 such a mod QSC_DILITHIUM_Q = a1*QSC_DILITHIUM_ALPHA + a0
-*              with -QSC_DILITHIUM_ALPHA/2 < a0 <= QSC_DILITHIUM_ALPHA/2 except a1 = (QSC_DILITHIUM_Q-1)/QSC_DILITHIUM_ALPHA where we
-*              set a1 = 0 and -QSC_DILITHIUM_ALPHA/2 <= a0 = a mod QSC_DILITHIUM_Q - QSC_DILITHIUM_Q < 0.
-*              Assumes coefficients to be standard representatives.
-*
-* Arguments:   - qsc_dilithium_polyveck *v1: pointer to output vector of polynomials with
-*                              coefficients a1
-*              - qsc_dilithium_polyveck *v0: pointer to output vector of polynomials with
-*                              coefficients QSC_DILITHIUM_Q + a0
-*              - const qsc_dilithium_polyveck *v: pointer to input vector
-**************************************************/
-void qsc_dilithium_polyveck_decompose(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_make_hint
-*
-* Description: Compute hint vector.
-*
-* Arguments:   - qsc_dilithium_polyveck *h: pointer to output vector
-*              - const qsc_dilithium_polyveck *v0: pointer to low part of input vector
-*              - const qsc_dilithium_polyveck *v1: pointer to high part of input vector
-*
-* Returns number of 1 bits.
-**************************************************/
-uint32_t qsc_dilithium_polyveck_make_hint(qsc_dilithium_polyveck* h, const qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v1);
-
-/*************************************************
-* Name:        qsc_dilithium_polyveck_use_hint
-*
-* Description: Use hint vector to correct the high bits of input vector.
-*
-* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector of polynomials with
-*                             corrected high bits
-*              - const qsc_dilithium_polyveck *u: pointer to input vector
-*              - const qsc_dilithium_polyveck *h: pointer to input hint vector
-**************************************************/
-void qsc_dilithium_polyveck_use_hint(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* v, const qsc_dilithium_polyveck* h);
-
-/* packing.h */
-
-/*************************************************
-* Name:        qsc_dilithium_pack_pk
-*
-* Description: Bit-pack public key pk = (rho, t1).
-*
-* Arguments:   - uint8_t pk[]: output byte array
-*              - const uint8_t rho[]: byte array containing rho
-*              - const qsc_dilithium_polyveck *t1: pointer to vector t1
-**************************************************/
-void qsc_dilithium_pack_pk(uint8_t* pk, const uint8_t* rho, const qsc_dilithium_polyveck* t1);
-
-/*************************************************
-* Name:        qsc_dilithium_unpack_pk
-*
-* Description: Unpack public key pk = (rho, t1).
-*
-* Arguments:   - const uint8_t rho[]: output byte array for rho
-*              - const qsc_dilithium_polyveck *t1: pointer to output vector t1
-*              - uint8_t pk[]: byte array containing bit-packed pk
-**************************************************/
-void qsc_dilithium_unpack_pk(uint8_t* rho, qsc_dilithium_polyveck* t1, const uint8_t* pk);
-
-/*************************************************
-* Name:        qsc_dilithium_pack_sk
-*
-* Description: Bit-pack secret key sk = (rho, key, tr, s1, s2, t0).
-*
-* Arguments:   - uint8_t sk[]: output byte array
-*              - const uint8_t rho[]: byte array containing rho
-*              - const uint8_t key[]: byte array containing key
-*              - const uint8_t tr[]: byte array containing tr
-*              - const qsc_dilithium_polyvecl *s1: pointer to vector s1
-*              - const qsc_dilithium_polyveck *s2: pointer to vector s2
-*              - const qsc_dilithium_polyveck *t0: pointer to vector t0
-**************************************************/
-void qsc_dilithium_pack_sk(uint8_t* sk, const uint8_t* rho, const uint8_t* key, const uint8_t* tr, const qsc_dilithium_polyvecl* s1, const qsc_dilithium_polyveck* s2, const qsc_dilithium_polyveck* t0);
-
-/*************************************************
-* Name:        qsc_dilithium_unpack_sk
-*
-* Description: Unpack secret key sk = (rho, key, tr, s1, s2, t0).
-*
-* Arguments:   - const uint8_t rho[]: output byte array for rho
-*              - const uint8_t key[]: output byte array for key
-*              - const uint8_t tr[]: output byte array for tr
-*              - const qsc_dilithium_polyvecl *s1: pointer to output vector s1
-*              - const qsc_dilithium_polyveck *s2: pointer to output vector s2
-*              - const qsc_dilithium_polyveck *r0: pointer to output vector t0
-*              - uint8_t sk[]: byte array containing bit-packed sk
-**************************************************/
-void qsc_dilithium_unpack_sk(uint8_t* rho, uint8_t* key, uint8_t* tr, qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, qsc_dilithium_polyveck* t0, const uint8_t* sk);
-
-/*************************************************
-* Name:        qsc_dilithium_pack_sig
-*
-* Description: Bit-pack signature sig = (z, h, c).
-*
-* Arguments:   - uint8_t sig[]: output byte array
-*              - const qsc_dilithium_polyvecl *z: pointer to vector z
-*              - const qsc_dilithium_polyveck *h: pointer to hint vector h
-*              - const qsc_dilithium_poly *c: pointer to challenge polynomial
-**************************************************/
-void qsc_dilithium_pack_sig(uint8_t* sig, const qsc_dilithium_polyvecl* z, const qsc_dilithium_polyveck* h, const qsc_dilithium_poly* c);
-
-/*************************************************
-* Name:        qsc_dilithium_unpack_sig
-*
-* Description: Unpack signature sig = (z, h, c).
-*
-* Arguments:   - qsc_dilithium_polyvecl *z: pointer to output vector z
-*              - qsc_dilithium_polyveck *h: pointer to output hint vector h
-*              - qsc_dilithium_poly *c: pointer to output challenge polynomial
-*              - const uint8_t sig[]: byte array containing
-*                bit-packed signature
-*
-* Returns 1 in case of malformed signature; otherwise 0.
-**************************************************/
-int32_t qsc_dilithium_unpack_sig(qsc_dilithium_polyvecl* z, qsc_dilithium_polyveck* h, qsc_dilithium_poly* c, const uint8_t* sig);
-
 /* reduce.h */
 
 /*************************************************
@@ -847,6 +473,8 @@ uint32_t qsc_dilithium_use_hint(const uint32_t a, const uint32_t hint);
 
 /* sign.h */
 
+/* each function below has one instantiation per security mode: _m2, _m3 and _m4 */
+
 /**
 * \brief Generates a Dilithium public/private key-pair.
 * Arrays must be sized to DILITHIUM_PUBLICKEY_SIZE and SPHINCS_SECRETKEY_SIZE.
@@ -854,7 +482,9 @@ uint32_t qsc_dilithium_use_hint(const uint32_t a, const uint32_t hint);
 * \param publickey The public verification key
 * \param secretkey The private signature key
 */
-void qsc_dilithium_ksm_generate(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_generate_m2(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_generate_m3(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_generate_m4(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t));
 
 /**
 * \brief Takes the message as input and returns an array containing the signature followed by the message.
@@ -865,7 +495,54 @@ void qsc_dilithium_ksm_generate(uint8_t* publickey, uint8_t* secretkey, void (*r
 * \param msglen The message length
 * \param privatekey The private signature key
 */
-void qsc_dilithium_ksm_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_m2(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_m3(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_m4(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Starts a detached signature; absorbs the public key hash held in the private key into the message state.
+* The message is added to the state with qsc_shake_update at the 256-bit rate.
+*
+* \param kstate The message hash state
+* \param privatekey The private signature key
+*/
+void qsc_dilithium_ksm_sign_initialize_m2(qsc_keccak_state* kstate, const uint8_t* privatekey);
+void qsc_dilithium_ksm_sign_initialize_m3(qsc_keccak_state* kstate, const uint8_t* privatekey);
+void qsc_dilithium_ksm_sign_initialize_m4(qsc_keccak_state* kstate, const uint8_t* privatekey);
+
+/**
+* \brief Completes the message hash and writes the detached signature.
+*
+* \param kstate The message hash state
+* \param signature The output signature
+* \param privatekey The private signature key
+*/
+void qsc_dilithium_ksm_sign_finalize_m2(qsc_keccak_state* kstate, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_finalize_m3(qsc_keccak_state* kstate, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_finalize_m4(qsc_keccak_state* kstate, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Unpacks a private key, expands its matrix and transforms its secret vectors for repeated signing.
+*
+* \param psk The output prepared private key
+* \param privatekey The private signature key
+*/
+void qsc_dilithium_ksm_prepare_sk_m2(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey);
+void qsc_dilithium_ksm_prepare_sk_m3(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey);
+void qsc_dilithium_ksm_prepare_sk_m4(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey);
+
+/**
+* \brief Signs a message with a prepared private key; the output is identical to qsc_dilithium_ksm_sign.
+*
+* \param signedmsg The signed message
+* \param smsglen The signed message length
+* \param message The message to be signed
+* \param msglen The message length
+* \param psk The prepared private key
+*/
+void qsc_dilithium_ksm_sign_prepared_m2(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_prepared_m3(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_dilithium_ksm_sign_prepared_m4(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t));
 
 /**
 * \brief Verifies a signature-message pair with the public key.
@@ -877,7 +554,56 @@ void qsc_dilithium_ksm_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t*
 * \param publickey The public verification key
 * \return Returns true for success
 */
-bool qsc_dilithium_ksm_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
+bool qsc_dilithium_ksm_verify_m2(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
+bool qsc_dilithium_ksm_verify_m3(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
+bool qsc_dilithium_ksm_verify_m4(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
+
+/**
+* \brief Starts the verification of a detached signature; absorbs the public key hash into the message state.
+* The message is added to the state with qsc_shake_update at the 256-bit rate.
+*
+* \param kstate The message hash state
+* \param publickey The public verification key
+*/
+void qsc_dilithium_ksm_verify_initialize_m2(qsc_keccak_state* kstate, const uint8_t* publickey);
+void qsc_dilithium_ksm_verify_initialize_m3(qsc_keccak_state* kstate, const uint8_t* publickey);
+void qsc_dilithium_ksm_verify_initialize_m4(qsc_keccak_state* kstate, const uint8_t* publickey);
+
+/**
+* \brief Completes the message hash and verifies the detached signature.
+*
+* \param kstate The message hash state
+* \param signature The signature
+* \param publickey The public verification key
+* \return Returns true for success
+*/
+bool qsc_dilithium_ksm_verify_finalize_m2(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey);
+bool qsc_dilithium_ksm_verify_finalize_m3(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey);
+bool qsc_dilithium_ksm_verify_finalize_m4(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Unpacks a public key, expands its matrix and transforms t1 for repeated verification.
+*
+* \param ppk The output prepared public key
+* \param publickey The public verification key
+*/
+void qsc_dilithium_ksm_prepare_pk_m2(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey);
+void qsc_dilithium_ksm_prepare_pk_m3(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey);
+void qsc_dilithium_ksm_prepare_pk_m4(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey);
+
+/**
+* \brief Verifies a signature-message pair with a prepared public key.
+*
+* \param message The message to be signed
+* \param msglen The message length
+* \param signedmsg The signed message
+* \param smsglen The signed message length
+* \param ppk The prepared public key
+* \return Returns true for success
+*/
+bool qsc_dilithium_ksm_verify_prepared_m2(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk);
+bool qsc_dilithium_ksm_verify_prepared_m3(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk);
+bool qsc_dilithium_ksm_verify_prepared_m4(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1751 @@
+/* The GPL version 3 License (GPLv3)
+*
+* Copyright (c) 2020 Digital Freedom Defence Inc.
+* This file is part of the QSC Cryptographic library
+*
+* This program is free software : you can redistribute it and / or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+* The mode dependent half of the Dilithium implementation. \n
+* This is not a public header; dilithiumbase.c includes it once for each security mode,
+* with DILITHIUM_MODE defined as 2, 3 or 4. Every symbol below is renamed through DILITHIUM_NAMESPACE,
+* so each mode receives its own vector, packing and signature functions,
+* with the vector dimensions, eta and the hint bound fixed at compile time.
+*/
+
+#if !defined(DILITHIUM_MODE) || !defined(DILITHIUM_NAMESPACE)
+#	error dilithiumbasek.h is included by dilithiumbase.c with DILITHIUM_MODE and DILITHIUM_NAMESPACE defined
+#endif
+
+/* params.h */
+
+#if (DILITHIUM_MODE == 2)
+#	define QSC_DILITHIUM_K 4
+#	define QSC_DILITHIUM_L 3
+#	define QSC_DILITHIUM_ETA 6
+#	define QSC_DILITHIUM_SETABITS 4
+#	define QSC_DILITHIUM_BETA 325
+#	define QSC_DILITHIUM_OMEGA 80
+#elif (DILITHIUM_MODE == 3)
+#	define QSC_DILITHIUM_K 5
+#	define QSC_DILITHIUM_L 4
+#	define QSC_DILITHIUM_ETA 5
+#	define QSC_DILITHIUM_SETABITS 4
+#	define QSC_DILITHIUM_BETA 275
+#	define QSC_DILITHIUM_OMEGA 96
+#elif (DILITHIUM_MODE == 4)
+#	define QSC_DILITHIUM_K 6
+#	define QSC_DILITHIUM_L 5
+#	define QSC_DILITHIUM_ETA 3
+#	define QSC_DILITHIUM_SETABITS 3
+#	define QSC_DILITHIUM_BETA 175
+#	define QSC_DILITHIUM_OMEGA 120
+#else
+#	error the dilithium mode is invalid!
+#endif
+
+#define DILITHIUM_POLETA_SIZE_PACKED ((QSC_DILITHIUM_N * QSC_DILITHIUM_SETABITS) / 8)
+
+/*!
+\def DILITHIUM_PUBLICKEY_SIZE
+* Read Only: The public key size in bytes
+*/
+#define DILITHIUM_PUBLICKEY_SIZE (QSC_DILITHIUM_SEED_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLT1_SIZE_PACKED)
+
+/*!
+\def DILITHIUM_SECRETKEY_SIZE
+* Read Only: The private key size in bytes
+*/
+#define DILITHIUM_SECRETKEY_SIZE (2 * QSC_DILITHIUM_SEED_SIZE + (QSC_DILITHIUM_L + QSC_DILITHIUM_K) * DILITHIUM_POLETA_SIZE_PACKED + QSC_DILITHIUM_CRH_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLT0_SIZE_PACKED)
+
+/*!
+\def DILITHIUM_SIGNATURE_SIZE
+* Read Only: The signature size in bytes
+*/
+#define DILITHIUM_SIGNATURE_SIZE (QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED + (QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K) + (QSC_DILITHIUM_N / 8 + 8))
+
+/* symbol names */
+
+#define rej_eta DILITHIUM_NAMESPACE(rej_eta)
+#define qsc_dilithium_polyeta_pack DILITHIUM_NAMESPACE(qsc_dilithium_polyeta_pack)
+#define qsc_dilithium_polyeta_unpack DILITHIUM_NAMESPACE(qsc_dilithium_polyeta_unpack)
+#define qsc_dilithium_polyvecl DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl)
+#define qsc_dilithium_polyveck DILITHIUM_NAMESPACE(qsc_dilithium_polyveck)
+#define qsc_dilithium_polyvecl_freeze DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl_freeze)
+#define qsc_dilithium_polyvecl_add DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl_add)
+#define qsc_dilithium_polyvecl_ntt DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl_ntt)
+#define qsc_dilithium_polyvecl_pointwise_acc_invmontgomery DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl_pointwise_acc_invmontgomery)
+#define qsc_dilithium_polyvecl_chknorm DILITHIUM_NAMESPACE(qsc_dilithium_polyvecl_chknorm)
+#define qsc_dilithium_polyveck_reduce DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_reduce)
+#define qsc_dilithium_polyveck_csubq DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_csubq)
+#define qsc_dilithium_polyveck_freeze DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_freeze)
+#define qsc_dilithium_polyveck_add DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_add)
+#define qsc_dilithium_polyveck_sub DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_sub)
+#define qsc_dilithium_polyveck_shiftl DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_shiftl)
+#define qsc_dilithium_polyveck_ntt DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_ntt)
+#define qsc_dilithium_polyveck_invntt_montgomery DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_invntt_montgomery)
+#define qsc_dilithium_polyveck_chknorm DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_chknorm)
+#define qsc_dilithium_polyveck_power2round DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_power2round)
+#define qsc_dilithium_polyveck_decompose DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_decompose)
+#define qsc_dilithium_polyveck_make_hint DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_make_hint)
+#define qsc_dilithium_polyveck_use_hint DILITHIUM_NAMESPACE(qsc_dilithium_polyveck_use_hint)
+#define qsc_dilithium_pack_pk DILITHIUM_NAMESPACE(qsc_dilithium_pack_pk)
+#define qsc_dilithium_unpack_pk DILITHIUM_NAMESPACE(qsc_dilithium_unpack_pk)
+#define qsc_dilithium_pack_sk DILITHIUM_NAMESPACE(qsc_dilithium_pack_sk)
+#define qsc_dilithium_unpack_sk DILITHIUM_NAMESPACE(qsc_dilithium_unpack_sk)
+#define qsc_dilithium_pack_sig DILITHIUM_NAMESPACE(qsc_dilithium_pack_sig)
+#define qsc_dilithium_unpack_sig DILITHIUM_NAMESPACE(qsc_dilithium_unpack_sig)
+#define expand_mat DILITHIUM_NAMESPACE(expand_mat)
+#define challenge DILITHIUM_NAMESPACE(challenge)
+#define qsc_dilithium_ksm_generate DILITHIUM_NAMESPACE(qsc_dilithium_ksm_generate)
+#define ksm_message_hash DILITHIUM_NAMESPACE(ksm_message_hash)
+#define ksm_sign_mu DILITHIUM_NAMESPACE(ksm_sign_mu)
+#define ksm_sign_expanded DILITHIUM_NAMESPACE(ksm_sign_expanded)
+#define ksm_expand_sk DILITHIUM_NAMESPACE(ksm_expand_sk)
+#define qsc_dilithium_ksm_sign DILITHIUM_NAMESPACE(qsc_dilithium_ksm_sign)
+#define qsc_dilithium_ksm_sign_initialize DILITHIUM_NAMESPACE(qsc_dilithium_ksm_sign_initialize)
+#define qsc_dilithium_ksm_sign_finalize DILITHIUM_NAMESPACE(qsc_dilithium_ksm_sign_finalize)
+#define qsc_dilithium_ksm_prepare_sk DILITHIUM_NAMESPACE(qsc_dilithium_ksm_prepare_sk)
+#define qsc_dilithium_ksm_sign_prepared DILITHIUM_NAMESPACE(qsc_dilithium_ksm_sign_prepared)
+#define ksm_verify_unpack DILITHIUM_NAMESPACE(ksm_verify_unpack)
+#define ksm_verify_mu DILITHIUM_NAMESPACE(ksm_verify_mu)
+#define ksm_verify_expanded DILITHIUM_NAMESPACE(ksm_verify_expanded)
+#define ksm_verify_reject DILITHIUM_NAMESPACE(ksm_verify_reject)
+#define ksm_expand_pk DILITHIUM_NAMESPACE(ksm_expand_pk)
+#define qsc_dilithium_ksm_verify DILITHIUM_NAMESPACE(qsc_dilithium_ksm_verify)
+#define qsc_dilithium_ksm_prepare_pk DILITHIUM_NAMESPACE(qsc_dilithium_ksm_prepare_pk)
+#define qsc_dilithium_ksm_verify_prepared DILITHIUM_NAMESPACE(qsc_dilithium_ksm_verify_prepared)
+#define qsc_dilithium_ksm_verify_initialize DILITHIUM_NAMESPACE(qsc_dilithium_ksm_verify_initialize)
+#define qsc_dilithium_ksm_verify_finalize DILITHIUM_NAMESPACE(qsc_dilithium_ksm_verify_finalize)
+
+/* poly.c */
+
+/*!
+\def DILITHIUM_UNIFORM_ETA_NBLOCKS
+* Read Only: The number of SHAKE-128 blocks squeezed for a polynomial with coefficients in [-eta, eta]
+*/
+#define DILITHIUM_UNIFORM_ETA_NBLOCKS (((QSC_DILITHIUM_N / 2 * (1U << QSC_DILITHIUM_SETABITS)) / (2 * QSC_DILITHIUM_ETA + 1) + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE)
+
+/*************************************************
+* Name:        rej_eta
+*
+* Description: Sample uniformly random coefficients in [-QSC_DILITHIUM_ETA, QSC_DILITHIUM_ETA] by
+*              performing rejection sampling using array of random bytes.
+*
+* Arguments:   - uint32_t *a: pointer to output array (allocated)
+*              - uint32_t len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - uint32_t buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static uint32_t rej_eta(uint32_t* a, uint32_t len, const uint8_t* buf, size_t buflen)
+{
+#if QSC_DILITHIUM_ETA > 7
+#error "rej_eta() assumes QSC_DILITHIUM_ETA <= 7"
+#endif
+
+	size_t ctr;
+	size_t pos;
+	uint32_t t0;
+	uint32_t t1;
+
+	ctr = 0;
+	pos = 0;
+
+	while (ctr < len && pos < buflen)
+	{
+#if QSC_DILITHIUM_ETA <= 3
+		t0 = buf[pos] & 0x07;
+		t1 = buf[pos] >> 5;
+		++pos;
+#else
+		t0 = buf[pos] & 0x0FU;
+		t1 = buf[pos] >> 4;
+		++pos;
+#endif
+
+		if (t0 <= 2 * QSC_DILITHIUM_ETA)
+		{
+			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - t0;
+			++ctr;
+		}
+
+		if (t1 <= 2 * QSC_DILITHIUM_ETA && ctr < len)
+		{
+			a[ctr] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - t1;
+			++ctr;
+		}
+	}
+
+	return (uint32_t)ctr;
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyeta_pack
+*
+* Description: Bit-pack polynomial with coefficients in [-QSC_DILITHIUM_ETA,QSC_DILITHIUM_ETA].
+*              Input coefficients are assumed to lie in [QSC_DILITHIUM_Q-QSC_DILITHIUM_ETA,QSC_DILITHIUM_Q+QSC_DILITHIUM_ETA].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                                  DILITHIUM_POLETA_SIZE_PACKED bytes
+*              - const qsc_dilithium_poly *a: pointer to input polynomial
+**************************************************/
+static void qsc_dilithium_polyeta_pack(uint8_t* r, const qsc_dilithium_poly* a)
+{
+#if 2 * QSC_DILITHIUM_ETA >= 16
+#	error "qsc_dilithium_polyeta_pack() assumes 2*QSC_DILITHIUM_ETA < 16"
+#endif
+	size_t i;
+	uint8_t t[8];
+
+#if (2 * QSC_DILITHIUM_ETA) <= 7
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		t[0] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i)];
+		t[1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 1];
+		t[2] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 2];
+		t[3] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 3];
+		t[4] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 4];
+		t[5] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 5];
+		t[6] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 6];
+		t[7] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(8 * i) + 7];
+
+		r[(3 * i)] = (t[0] >> 0) | (t[1] << 3) | (t[2] << 6);
+		r[(3 * i) + 1] = (t[2] >> 2) | (t[3] << 1) | (t[4] << 4) | (t[5] << 7);
+		r[(3 * i) + 2] = (t[5] >> 1) | (t[6] << 2) | (t[7] << 5);
+	}
+
+#else
+
+	for (i = 0; i < QSC_DILITHIUM_N / 2; ++i)
+	{
+		t[0] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(2 * i)];
+		t[1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - a->coeffs[(2 * i) + 1];
+		r[i] = t[0] | (uint8_t)(t[1] << 4);
+	}
+
+#endif
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyeta_unpack
+*
+* Description: Unpack polynomial with coefficients in [-QSC_DILITHIUM_ETA,QSC_DILITHIUM_ETA].
+*              Output coefficients lie in [QSC_DILITHIUM_Q-QSC_DILITHIUM_ETA,QSC_DILITHIUM_Q+QSC_DILITHIUM_ETA].
+*
+* Arguments:   - qsc_dilithium_poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+static void qsc_dilithium_polyeta_unpack(qsc_dilithium_poly* r, const uint8_t* a)
+{
+	size_t i;
+
+#if (2 * QSC_DILITHIUM_ETA) <= 7
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		r->coeffs[(8 * i)] = a[3 * i] & 0x07;
+		r->coeffs[(8 * i) + 1] = (a[3 * i] >> 3) & 0x07;
+		r->coeffs[(8 * i) + 2] = ((a[3 * i] >> 6) | (a[(3 * i) + 1] << 2)) & 0x07;
+		r->coeffs[(8 * i) + 3] = (a[(3 * i) + 1] >> 1) & 0x07;
+		r->coeffs[(8 * i) + 4] = (a[(3 * i) + 1] >> 4) & 0x07;
+		r->coeffs[(8 * i) + 5] = ((a[(3 * i) + 1] >> 7) | (a[(3 * i) + 2] << 1)) & 0x07;
+		r->coeffs[(8 * i) + 6] = (a[(3 * i) + 2] >> 2) & 0x07;
+		r->coeffs[(8 * i) + 7] = (a[(3 * i) + 2] >> 5) & 0x07;
+
+		r->coeffs[(8 * i)] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i)];
+		r->coeffs[(8 * i) + 1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 1];
+		r->coeffs[(8 * i) + 2] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 2];
+		r->coeffs[(8 * i) + 3] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 3];
+		r->coeffs[(8 * i) + 4] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 4];
+		r->coeffs[(8 * i) + 5] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 5];
+		r->coeffs[(8 * i) + 6] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 6];
+		r->coeffs[(8 * i) + 7] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(8 * i) + 7];
+	}
+
+#else
+
+	for (i = 0; i < QSC_DILITHIUM_N / 2; ++i)
+	{
+		r->coeffs[(2 * i)] = a[i] & 0x0Fu;
+		r->coeffs[(2 * i) + 1] = a[i] >> 4;
+		r->coeffs[(2 * i)] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[2 * i];
+		r->coeffs[(2 * i) + 1] = QSC_DILITHIUM_Q + QSC_DILITHIUM_ETA - r->coeffs[(2 * i) + 1];
+	}
+
+#endif
+}
+
+/* polyvec.c */
+
+/* Vectors of polynomials of length QSC_DILITHIUM_L */
+typedef struct
+{
+	qsc_dilithium_poly vec[QSC_DILITHIUM_L];
+} qsc_dilithium_polyvecl;
+
+/* Vectors of polynomials of length QSC_DILITHIUM_K */
+typedef struct
+{
+	qsc_dilithium_poly vec[QSC_DILITHIUM_K];
+} qsc_dilithium_polyveck;
+
+/*************************************************
+* Name:        qsc_dilithium_polyvecl_freeze
+*
+* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_L
+*              to standard representatives.
+*
+* Arguments:   - qsc_dilithium_polyvecl *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyvecl_freeze(qsc_dilithium_polyvecl* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_poly_freeze(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyvecl_add
+*
+* Description: Add vectors of polynomials of length QSC_DILITHIUM_L.
+*              No modular reduction is performed.
+*
+* Arguments:   - qsc_dilithium_polyvecl *w: pointer to output vector
+*              - const qsc_dilithium_polyvecl *u: pointer to first summand
+*              - const qsc_dilithium_polyvecl *v: pointer to second summand
+**************************************************/
+static void qsc_dilithium_polyvecl_add(qsc_dilithium_polyvecl* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyvecl_ntt
+*
+* Description: Forward NTT of all polynomials in vector of length QSC_DILITHIUM_L. Output
+*              coefficients can be up to 16*QSC_DILITHIUM_Q larger than input coefficients.
+*
+* Arguments:   - qsc_dilithium_polyvecl *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyvecl_ntt(qsc_dilithium_polyvecl* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_poly_ntt(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyvecl_pointwise_acc_invmontgomery
+*
+* Description: Pointwise multiply vectors of polynomials of length QSC_DILITHIUM_L, multiply
+*              resulting vector by 2^{-32} and add (accumulate) polynomials
+*              in it. Input/output vectors are in NTT domain representation.
+*              Input coefficients are assumed to be less than 22*QSC_DILITHIUM_Q. Output
+*              coeffcient are less than 2*QSC_DILITHIUM_L*QSC_DILITHIUM_Q.
+*
+* Arguments:   - qsc_dilithium_poly *w: output polynomial
+*              - const qsc_dilithium_polyvecl *u: pointer to first input vector
+*              - const qsc_dilithium_polyvecl *v: pointer to second input vector
+**************************************************/
+static void qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(qsc_dilithium_poly* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	__m512i acc;
+	size_t i;
+	size_t j;
+
+	/* the products are summed in a register, one pass over the output */
+	for (j = 0; j < QSC_DILITHIUM_N; j += 16)
+	{
+		acc = _mm512_setzero_si512();
+
+		for (i = 0; i < QSC_DILITHIUM_L; ++i)
+		{
+			acc = _mm512_add_epi32(acc, dilithium_montmul_avx512(
+				_mm512_loadu_si512((const void*)(u->vec[i].coeffs + j)),
+				_mm512_loadu_si512((const void*)(v->vec[i].coeffs + j))));
+		}
+
+		_mm512_storeu_si512((void*)(w->coeffs + j), acc);
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i acc;
+	size_t i;
+	size_t j;
+
+	/* the products are summed in a register, one pass over the output */
+	for (j = 0; j < QSC_DILITHIUM_N; j += 8)
+	{
+		acc = _mm256_setzero_si256();
+
+		for (i = 0; i < QSC_DILITHIUM_L; ++i)
+		{
+			acc = _mm256_add_epi32(acc, dilithium_montmul_avx2(
+				_mm256_loadu_si256((const __m256i*)(u->vec[i].coeffs + j)),
+				_mm256_loadu_si256((const __m256i*)(v->vec[i].coeffs + j))));
+		}
+
+		_mm256_storeu_si256((__m256i*)(w->coeffs + j), acc);
+	}
+#else
+	qsc_dilithium_poly t;
+	size_t i;
+
+	qsc_dilithium_poly_pointwise_invmontgomery(w, &u->vec[0], &v->vec[0]);
+
+	for (i = 1; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_poly_pointwise_invmontgomery(&t, &u->vec[i], &v->vec[i]);
+		qsc_dilithium_poly_add(w, w, &t);
+	}
+#endif
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyvecl_chknorm
+*
+* Description: Check infinity norm of polynomials in vector of length QSC_DILITHIUM_L.
+*              Assumes input coefficients to be standard representatives.
+*
+* Arguments:   - const qsc_dilithium_polyvecl *v: pointer to vector
+*              - uint32_t B: norm bound
+*
+* Returns 0 if norm of all polynomials is strictly smaller than B and 1
+* otherwise.
+**************************************************/
+static int32_t qsc_dilithium_polyvecl_chknorm(const qsc_dilithium_polyvecl* v, uint32_t bound)
+{
+	size_t i;
+	int32_t r;
+
+	r = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		if (qsc_dilithium_poly_chknorm(&v->vec[i], bound))
+		{
+			r = 1;
+			break;
+		}
+	}
+
+	return r;
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_reduce
+*
+* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_K
+*              to representatives in [0,2*QSC_DILITHIUM_Q[.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_reduce(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_reduce(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_csubq
+*
+* Description: For all coefficients of polynomials in vector of length QSC_DILITHIUM_K
+*              subtract QSC_DILITHIUM_Q if coefficient is bigger than QSC_DILITHIUM_Q.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_csubq(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_csubq(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_freeze
+*
+* Description: Reduce coefficients of polynomials in vector of length QSC_DILITHIUM_K
+*              to standard representatives.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_freeze(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_freeze(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_add
+*
+* Description: Add vectors of polynomials of length QSC_DILITHIUM_K.
+*              No modular reduction is performed.
+*
+* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector
+*              - const qsc_dilithium_polyveck *u: pointer to first summand
+*              - const qsc_dilithium_polyveck *v: pointer to second summand
+**************************************************/
+static void qsc_dilithium_polyveck_add(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_sub
+*
+* Description: Subtract vectors of polynomials of length QSC_DILITHIUM_K.
+*              Assumes coefficients of polynomials in second input vector
+*              to be less than 2*QSC_DILITHIUM_Q. No modular reduction is performed.
+*
+* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector
+*              - const qsc_dilithium_polyveck *u: pointer to first input vector
+*              - const qsc_dilithium_polyveck *v: pointer to second input vector to be
+*                                   subtracted from first input vector
+**************************************************/
+static void qsc_dilithium_polyveck_sub(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_sub(&w->vec[i], &u->vec[i], &v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_shiftl
+*
+* Description: Multiply vector of polynomials of Length QSC_DILITHIUM_K by 2^QSC_DILITHIUM_D without modular
+*              reduction. Assumes input coefficients to be less than 2^{32-QSC_DILITHIUM_D}.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_shiftl(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_shiftl(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_ntt
+*
+* Description: Forward NTT of all polynomials in vector of length QSC_DILITHIUM_K. Output
+*              coefficients can be up to 16*QSC_DILITHIUM_Q larger than input coefficients.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_ntt(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_ntt(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_invntt_montgomery
+*
+* Description: Inverse NTT and multiplication by 2^{32} of polynomials
+*              in vector of length QSC_DILITHIUM_K. Input coefficients need to be less
+*              than 2*QSC_DILITHIUM_Q.
+*
+* Arguments:   - qsc_dilithium_polyveck *v: pointer to input/output vector
+**************************************************/
+static void qsc_dilithium_polyveck_invntt_montgomery(qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_invntt_montgomery(&v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_chknorm
+*
+* Description: Check infinity norm of polynomials in vector of length QSC_DILITHIUM_K.
+*              Assumes input coefficients to be standard representatives.
+*
+* Arguments:   - const qsc_dilithium_polyveck *v: pointer to vector
+*              - uint32_t B: norm bound
+*
+* Returns 0 if norm of all polynomials are strictly smaller than B and 1
+* otherwise.
+**************************************************/
+static int32_t qsc_dilithium_polyveck_chknorm(const qsc_dilithium_polyveck* v, uint32_t bound)
+{
+	size_t i;
+	int32_t r;
+
+	r = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		if (qsc_dilithium_poly_chknorm(&v->vec[i], bound))
+		{
+			r = 1;
+			break;
+		}
+	}
+
+	return r;
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_power2round
+*
+* Description: For all coefficients a of polynomials in vector of length QSC_DILITHIUM_K,
+*              compute a0, a1 such that a mod QSC_DILITHIUM_Q = a1*2^QSC_DILITHIUM_D + a0
+*              with -2^{QSC_DILITHIUM_D-1} < a0 <= 2^{QSC_DILITHIUM_D-1}. Assumes coefficients to be
+*              standard representatives.
+*
+* Arguments:   - qsc_dilithium_polyveck *v1: pointer to output vector of polynomials with
+*                              coefficients a1
+*              - qsc_dilithium_polyveck *v0: pointer to output vector of polynomials with
+*                              coefficients QSC_DILITHIUM_Q + a0
+*              - const qsc_dilithium_polyveck *v: pointer to input vector
+**************************************************/
+static void qsc_dilithium_polyveck_power2round(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_power2round(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_decompose
+*
+* Description: For all coefficients a of polynomials in vector of length QSC_DILITHIUM_K,
+*              compute high and low bits a0, a1 such a mod QSC_DILITHIUM_Q = a1*QSC_DILITHIUM_ALPHA + a0
+*              with -QSC_DILITHIUM_ALPHA/2 < a0 <= QSC_DILITHIUM_ALPHA/2 except a1 = (QSC_DILITHIUM_Q-1)/QSC_DILITHIUM_ALPHA where we
+*              set a1 = 0 and -QSC_DILITHIUM_ALPHA/2 <= a0 = a mod QSC_DILITHIUM_Q - QSC_DILITHIUM_Q < 0.
+*              Assumes coefficients to be standard representatives.
+*
+* Arguments:   - qsc_dilithium_polyveck *v1: pointer to output vector of polynomials with
+*                              coefficients a1
+*              - qsc_dilithium_polyveck *v0: pointer to output vector of polynomials with
+*                              coefficients QSC_DILITHIUM_Q + a0
+*              - const qsc_dilithium_polyveck *v: pointer to input vector
+**************************************************/
+static void qsc_dilithium_polyveck_decompose(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_decompose(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_make_hint
+*
+* Description: Compute hint vector.
+*
+* Arguments:   - qsc_dilithium_polyveck *h: pointer to output vector
+*              - const qsc_dilithium_polyveck *v0: pointer to low part of input vector
+*              - const qsc_dilithium_polyveck *v1: pointer to high part of input vector
+*
+* Returns number of 1 bits.
+**************************************************/
+static uint32_t qsc_dilithium_polyveck_make_hint(qsc_dilithium_polyveck* h, const qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v1)
+{
+	size_t i;
+	uint32_t s;
+
+	s = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		s += qsc_dilithium_poly_make_hint(&h->vec[i], &v0->vec[i], &v1->vec[i]);
+	}
+
+	return s;
+}
+
+/*************************************************
+* Name:        qsc_dilithium_polyveck_use_hint
+*
+* Description: Use hint vector to correct the high bits of input vector.
+*
+* Arguments:   - qsc_dilithium_polyveck *w: pointer to output vector of polynomials with
+*                             corrected high bits
+*              - const qsc_dilithium_polyveck *u: pointer to input vector
+*              - const qsc_dilithium_polyveck *h: pointer to input hint vector
+**************************************************/
+static void qsc_dilithium_polyveck_use_hint(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* h)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_use_hint(&w->vec[i], &u->vec[i], &h->vec[i]);
+	}
+}
+
+/* packing.c */
+
+/*************************************************
+* Name:        qsc_dilithium_pack_pk
+*
+* Description: Bit-pack public key pk = (rho, t1).
+*
+* Arguments:   - uint8_t pk[]: output byte array
+*              - const uint8_t rho[]: byte array containing rho
+*              - const qsc_dilithium_polyveck *t1: pointer to vector t1
+**************************************************/
+static void qsc_dilithium_pack_pk(uint8_t* pk, const uint8_t* rho, const qsc_dilithium_polyveck* t1)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		pk[i] = rho[i];
+	}
+
+	pk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyt1_pack(pk + (i * DILITHIUM_POLT1_SIZE_PACKED), &t1->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_unpack_pk
+*
+* Description: Unpack public key pk = (rho, t1).
+*
+* Arguments:   - const uint8_t rho[]: output byte array for rho
+*              - const qsc_dilithium_polyveck *t1: pointer to output vector t1
+*              - uint8_t pk[]: byte array containing bit-packed pk
+**************************************************/
+static void qsc_dilithium_unpack_pk(uint8_t* rho, qsc_dilithium_polyveck* t1, const uint8_t* pk)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		rho[i] = pk[i];
+	}
+
+	pk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyt1_unpack(&t1->vec[i], pk + (i * DILITHIUM_POLT1_SIZE_PACKED));
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_pack_sk
+*
+* Description: Bit-pack secret key sk = (rho, key, tr, s1, s2, t0).
+*
+* Arguments:   - uint8_t sk[]: output byte array
+*              - const uint8_t rho[]: byte array containing rho
+*              - const uint8_t key[]: byte array containing key
+*              - const uint8_t tr[]: byte array containing tr
+*              - const qsc_dilithium_polyvecl *s1: pointer to vector s1
+*              - const qsc_dilithium_polyveck *s2: pointer to vector s2
+*              - const qsc_dilithium_polyveck *t0: pointer to vector t0
+**************************************************/
+static void qsc_dilithium_pack_sk(uint8_t* sk, const uint8_t* rho, const uint8_t* key, const uint8_t* tr, const qsc_dilithium_polyvecl* s1, const qsc_dilithium_polyveck* s2, const qsc_dilithium_polyveck* t0)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		sk[i] = rho[i];
+	}
+
+	sk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		sk[i] = key[i];
+	}
+
+	sk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
+	{
+		sk[i] = tr[i];
+	}
+
+	sk += QSC_DILITHIUM_CRH_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_polyeta_pack(sk + (i * DILITHIUM_POLETA_SIZE_PACKED), &s1->vec[i]);
+	}
+
+	sk += QSC_DILITHIUM_L * DILITHIUM_POLETA_SIZE_PACKED;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyeta_pack(sk + (i * DILITHIUM_POLETA_SIZE_PACKED), &s2->vec[i]);
+	}
+
+	sk += QSC_DILITHIUM_K * DILITHIUM_POLETA_SIZE_PACKED;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyt0_pack(sk + (i * DILITHIUM_POLT0_SIZE_PACKED), &t0->vec[i]);
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_unpack_sk
+*
+* Description: Unpack secret key sk = (rho, key, tr, s1, s2, t0).
+*
+* Arguments:   - const uint8_t rho[]: output byte array for rho
+*              - const uint8_t key[]: output byte array for key
+*              - const uint8_t tr[]: output byte array for tr
+*              - const qsc_dilithium_polyvecl *s1: pointer to output vector s1
+*              - const qsc_dilithium_polyveck *s2: pointer to output vector s2
+*              - const qsc_dilithium_polyveck *r0: pointer to output vector t0
+*              - uint8_t sk[]: byte array containing bit-packed sk
+**************************************************/
+static void qsc_dilithium_unpack_sk(uint8_t* rho, uint8_t* key, uint8_t* tr, qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, qsc_dilithium_polyveck* t0, const uint8_t* sk)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		rho[i] = sk[i];
+	}
+
+	sk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_SEED_SIZE; ++i)
+	{
+		key[i] = sk[i];
+	}
+
+	sk += QSC_DILITHIUM_SEED_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
+	{
+		tr[i] = sk[i];
+	}
+
+	sk += QSC_DILITHIUM_CRH_SIZE;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_polyeta_unpack(&s1->vec[i], sk + (i * DILITHIUM_POLETA_SIZE_PACKED));
+	}
+
+	sk += QSC_DILITHIUM_L * DILITHIUM_POLETA_SIZE_PACKED;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyeta_unpack(&s2->vec[i], sk + (i * DILITHIUM_POLETA_SIZE_PACKED));
+	}
+
+	sk += QSC_DILITHIUM_K * DILITHIUM_POLETA_SIZE_PACKED;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyt0_unpack(&t0->vec[i], sk + (i * DILITHIUM_POLT0_SIZE_PACKED));
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_pack_sig
+*
+* Description: Bit-pack signature sig = (z, h, c).
+*
+* Arguments:   - uint8_t sig[]: output byte array
+*              - const qsc_dilithium_polyvecl *z: pointer to vector z
+*              - const qsc_dilithium_polyveck *h: pointer to hint vector h
+*              - const qsc_dilithium_poly *c: pointer to challenge polynomial
+**************************************************/
+static void qsc_dilithium_pack_sig(uint8_t* sig, const qsc_dilithium_polyvecl* z, const qsc_dilithium_polyveck* h, const qsc_dilithium_poly* c)
+{
+	size_t i;
+	size_t j;
+	size_t k;
+	uint64_t mask;
+	uint64_t signs;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_polyz_pack(sig + (i * DILITHIUM_POLZ_SIZE_PACKED), &z->vec[i]);
+	}
+
+	sig += QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED;
+
+	/* Encode h */
+	k = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		for (j = 0; j < QSC_DILITHIUM_N; ++j)
+		{
+			if (h->vec[i].coeffs[j] != 0)
+			{
+				sig[k] = (uint8_t)j;
+				++k;
+			}
+		}
+
+		sig[QSC_DILITHIUM_OMEGA + i] = (uint8_t)k;
+	}
+
+	while (k < QSC_DILITHIUM_OMEGA)
+	{
+		sig[k] = 0;
+		++k;
+	}
+
+	sig += QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K;
+
+	/* Encode c */
+	signs = 0;
+	mask = 1;
+
+	for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+	{
+		sig[i] = 0;
+
+		for (j = 0; j < 8; ++j)
+		{
+			if (c->coeffs[(8 * i) + j] != 0)
+			{
+				sig[i] |= (1U << j);
+
+				if (c->coeffs[(8 * i) + j] == (QSC_DILITHIUM_Q - 1))
+				{
+					signs |= mask;
+				}
+
+				mask <<= 1;
+			}
+		}
+	}
+
+	sig += QSC_DILITHIUM_N / 8;
+
+	for (i = 0; i < 8; ++i)
+	{
+		sig[i] = (uint8_t)(signs >> (8 * i));
+	}
+}
+
+/*************************************************
+* Name:        qsc_dilithium_unpack_sig
+*
+* Description: Unpack signature sig = (z, h, c).
+*
+* Arguments:   - qsc_dilithium_polyvecl *z: pointer to output vector z
+*              - qsc_dilithium_polyveck *h: pointer to output hint vector h
+*              - qsc_dilithium_poly *c: pointer to output challenge polynomial
+*              - const uint8_t sig[]: byte array containing
+*                bit-packed signature
+*
+* Returns 1 in case of malformed signature; otherwise 0.
+**************************************************/
+static int32_t qsc_dilithium_unpack_sig(qsc_dilithium_polyvecl* z, qsc_dilithium_polyveck* h, qsc_dilithium_poly* c, const uint8_t* sig)
+{
+	uint64_t signs;
+	size_t i;
+	size_t j;
+	size_t k;
+	int32_t ret;
+
+	ret = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		qsc_dilithium_polyz_unpack(&z->vec[i], sig + (i * DILITHIUM_POLZ_SIZE_PACKED));
+	}
+
+	sig += QSC_DILITHIUM_L * DILITHIUM_POLZ_SIZE_PACKED;
+
+	/* Decode h */
+	k = 0;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		for (j = 0; j < QSC_DILITHIUM_N; ++j)
+		{
+			h->vec[i].coeffs[j] = 0;
+		}
+
+		if (sig[QSC_DILITHIUM_OMEGA + i] < k || sig[QSC_DILITHIUM_OMEGA + i] > QSC_DILITHIUM_OMEGA)
+		{
+			ret = 1;
+			break;
+		}
+
+		for (j = k; j < sig[QSC_DILITHIUM_OMEGA + i]; ++j)
+		{
+			/* Coefficients are ordered for strong unforgeability */
+			if (j > k && sig[j] <= sig[j - 1])
+			{
+				ret = 1;
+				break;
+			}
+
+			h->vec[i].coeffs[sig[j]] = 1;
+		}
+
+		if (ret != 0)
+		{
+			break;
+		}
+
+		k = sig[QSC_DILITHIUM_OMEGA + i];
+	}
+
+	if (ret == 0)
+	{
+		/* Extra indices are zero for strong unforgeability */
+		for (j = k; j < QSC_DILITHIUM_OMEGA; ++j)
+		{
+			if (sig[j])
+			{
+				ret = 1;
+				break;
+			}
+		}
+
+		if (ret == 0)
+		{
+			sig += QSC_DILITHIUM_OMEGA + QSC_DILITHIUM_K;
+
+			/* Decode c */
+			for (i = 0; i < QSC_DILITHIUM_N; ++i)
+			{
+				c->coeffs[i] = 0;
+			}
+
+			signs = 0;
+
+			for (i = 0; i < 8; ++i)
+			{
+				signs |= (uint64_t)sig[(QSC_DILITHIUM_N / 8) + i] << (8 * i);
+			}
+
+			/* Extra sign bits are zero for strong unforgeability */
+			if (signs >> 60)
+			{
+				ret = 1;
+			}
+
+			if (ret == 0)
+			{
+				for (i = 0; i < QSC_DILITHIUM_N / 8; ++i)
+				{
+					for (j = 0; j < 8; ++j)
+					{
+						if ((uint8_t)(sig[i] >> j) & 0x01U)
+						{
+							c->coeffs[(8 * i) + j] = 1;
+							c->coeffs[(8 * i) + j] ^= (uint32_t)(~(signs & 1ULL) + 1) & (1UL ^ (uint32_t)(QSC_DILITHIUM_Q - 1));
+							signs >>= 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+/* sign.c */
+
+static void expand_mat(qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], const uint8_t rho[QSC_DILITHIUM_SEED_SIZE])
+{
+	qsc_dilithium_poly* pa[QSC_DILITHIUM_K * QSC_DILITHIUM_L];
+	uint16_t nonces[QSC_DILITHIUM_K * QSC_DILITHIUM_L];
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		for (j = 0; j < QSC_DILITHIUM_L; ++j)
+		{
+			pa[(i * QSC_DILITHIUM_L) + j] = &mat[i].vec[j];
+			nonces[(i * QSC_DILITHIUM_L) + j] = (uint16_t)((i << 8) + j);
+		}
+	}
+
+	dilithium_sample_batch(pa, nonces, QSC_DILITHIUM_K * QSC_DILITHIUM_L, rho, QSC_DILITHIUM_SEED_SIZE,
+		keccak_rate_128, DILITHIUM_UNIFORM_NBLOCKS, 3, rej_uniform);
+}
+
+static void challenge(qsc_dilithium_poly* c, const uint8_t mu[QSC_DILITHIUM_CRH_SIZE], const qsc_dilithium_polyveck *w1)
+{
+	uint8_t inbuf[QSC_DILITHIUM_CRH_SIZE + QSC_DILITHIUM_K * DILITHIUM_POLW1_SIZE_PACKED];
+	uint8_t outbuf[QSC_KECCAK_256_RATE];
+	qsc_keccak_state kstate;
+	uint64_t signs;
+	size_t b;
+	size_t i;
+	size_t pos;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		kstate.state[i] = 0;
+	}
+
+	for (i = 0; i < QSC_DILITHIUM_CRH_SIZE; ++i)
+	{
+		inbuf[i] = mu[i];
+	}
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyw1_pack(inbuf + QSC_DILITHIUM_CRH_SIZE + (i * DILITHIUM_POLW1_SIZE_PACKED), &w1->vec[i]);
+	}
+
+	qsc_shake_initialize(&kstate, keccak_rate_256, inbuf, sizeof(inbuf));
+	qsc_shake_squeezeblocks(&kstate, keccak_rate_256, outbuf, 1);
+	signs = 0;
+
+	for (i = 0; i < 8; ++i)
+	{
+		signs |= (uint64_t)outbuf[i] << 8 * i;
+	}
+
+	pos = 8;
+
+	for (i = 0; i < QSC_DILITHIUM_N; ++i)
+	{
+		c->coeffs[i] = 0;
+	}
+
+	for (i = 196; i < 256; ++i)
+	{
+		do
+		{
+			if (pos >= QSC_KECCAK_256_RATE)
+			{
+				qsc_shake_squeezeblocks(&kstate, keccak_rate_256, outbuf, 1);
+				pos = 0;
+			}
+
+			b = (size_t)outbuf[pos];
+			++pos;
+		}
+		while (b > i);
+
+		c->coeffs[i] = c->coeffs[b];
+		c->coeffs[b] = 1;
+		c->coeffs[b] ^= (uint32_t)(~(signs & 1) + 1) & (1 ^ (QSC_DILITHIUM_Q - 1));
+		signs >>= 1;
+	}
+}
+
+void qsc_dilithium_ksm_generate(uint8_t* publickey, uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t))
+{
+	const uint8_t* key;
+	const uint8_t* rho;
+	const uint8_t* rhoprime;
+	uint8_t seedbuf[3 * QSC_DILITHIUM_SEED_SIZE];
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
+	qsc_dilithium_polyvecl s1;
+	qsc_dilithium_polyvecl s1hat;
+	qsc_dilithium_polyveck s2;
+	qsc_dilithium_polyveck t;
+	qsc_dilithium_polyveck t0;
+	qsc_dilithium_polyveck t1;
+	qsc_dilithium_poly* ps[QSC_DILITHIUM_L + QSC_DILITHIUM_K];
+	uint16_t nonces[QSC_DILITHIUM_L + QSC_DILITHIUM_K];
+	size_t i;
+
+	/* Expand 32 bytes of randomness into rho, rhoprime and key */
+	rng_generate(seedbuf, 3 * QSC_DILITHIUM_SEED_SIZE);
+	rho = seedbuf;
+	rhoprime = seedbuf + QSC_DILITHIUM_SEED_SIZE;
+	key = seedbuf + (2 * QSC_DILITHIUM_SEED_SIZE);
+
+	/* Expand matrix */
+	expand_mat(mat, rho);
+
+	/* Sample short vectors s1 and s2 */
+	for (i = 0; i < QSC_DILITHIUM_L; ++i)
+	{
+		ps[i] = &s1.vec[i];
+	}
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		ps[QSC_DILITHIUM_L + i] = &s2.vec[i];
+	}
+
+	for (i = 0; i < QSC_DILITHIUM_L + QSC_DILITHIUM_K; ++i)
+	{
+		nonces[i] = (uint16_t)i;
+	}
+
+	dilithium_sample_batch(ps, nonces, QSC_DILITHIUM_L + QSC_DILITHIUM_K, rhoprime, QSC_DILITHIUM_SEED_SIZE,
+		keccak_rate_128, DILITHIUM_UNIFORM_ETA_NBLOCKS, 1, rej_eta);
+
+	/* Matrix-vector multiplication */
+	s1hat = s1;
+	qsc_dilithium_polyvecl_ntt(&s1hat);
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&t.vec[i], &mat[i], &s1hat);
+		qsc_dilithium_poly_reduce(&t.vec[i]);
+		qsc_dilithium_poly_invntt_montgomery(&t.vec[i]);
+	}
+
+	/* Add error vector s2 */
+	qsc_dilithium_polyveck_add(&t, &t, &s2);
+
+	/* Extract t1 and write public key */
+	qsc_dilithium_polyveck_freeze(&t);
+	qsc_dilithium_polyveck_power2round(&t1, &t0, &t);
+	qsc_dilithium_pack_pk(publickey, rho, &t1);
+
+	/* Compute CRH(rho, t1) and write secret key */
+	qsc_shake256_compute(tr, QSC_DILITHIUM_CRH_SIZE, publickey, DILITHIUM_PUBLICKEY_SIZE);
+	qsc_dilithium_pack_sk(secretkey, rho, key, tr, &s1, &s2, &t0);
+}
+
+static void ksm_message_hash(qsc_keccak_state* kstate, const uint8_t* tr)
+{
+	/* mu = CRH(tr, msg); the key hash is absorbed first so the message can follow in any number of updates */
+	qsc_keccak_dispose(kstate);
+	qsc_shake_update(kstate, keccak_rate_256, tr, QSC_DILITHIUM_CRH_SIZE);
+}
+
+static void ksm_sign_mu(uint8_t* signature, const uint8_t* mu, const qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], const qsc_dilithium_polyvecl* s1,
+	const qsc_dilithium_polyveck* s2, const qsc_dilithium_polyveck* t0, const uint8_t* key, void (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t keymu[QSC_DILITHIUM_SEED_SIZE + QSC_DILITHIUM_CRH_SIZE];
+	uint8_t rhoprime[QSC_DILITHIUM_CRH_SIZE];
+	uint16_t nonce = 0;
+	qsc_dilithium_poly c;
+	qsc_dilithium_poly chat;
+	qsc_dilithium_polyvecl y;
+	qsc_dilithium_polyvecl yhat;
+	qsc_dilithium_polyvecl z;
+	qsc_dilithium_polyveck w;
+	qsc_dilithium_polyveck w1;
+	qsc_dilithium_polyveck w0;
+	qsc_dilithium_polyveck h;
+	qsc_dilithium_polyveck cs2;
+	qsc_dilithium_polyveck ct0;
+	qsc_dilithium_poly* py[QSC_DILITHIUM_L];
+	uint16_t nonces[QSC_DILITHIUM_L];
+	size_t i;
+	uint32_t n;
+	int32_t nrej;
+
+	/* the per-message randomness is derived from key || mu */
+	qsc_memutils_copy(keymu, key, QSC_DILITHIUM_SEED_SIZE);
+	qsc_memutils_copy(keymu + QSC_DILITHIUM_SEED_SIZE, mu, QSC_DILITHIUM_CRH_SIZE);
+
+#ifdef RANDOMIZED_SIGNING
+	rng_generate(rhoprime, QSC_DILITHIUM_CRH_SIZE);
+#else
+	(void)rng_generate;
+	qsc_shake256_compute(rhoprime, QSC_DILITHIUM_CRH_SIZE, keymu, QSC_DILITHIUM_SEED_SIZE + QSC_DILITHIUM_CRH_SIZE);
+#endif
+
+	nrej = 1;
+
+	while (nrej != 0)
+	{
+		/* Sample intermediate vector y */
+		for (i = 0; i < QSC_DILITHIUM_L; ++i)
+		{
+			py[i] = &y.vec[i];
+			nonces[i] = nonce;
+			++nonce;
+		}
+
+		dilithium_sample_batch(py, nonces, QSC_DILITHIUM_L, rhoprime, QSC_DILITHIUM_CRH_SIZE,
+			keccak_rate_256, DILITHIUM_UNIFORM_GAMMA1M1_NBLOCKS, 5, rej_gamma1m1);
+
+		/* Matrix-vector multiplication */
+		yhat = y;
+		qsc_dilithium_polyvecl_ntt(&yhat);
+
+		for (i = 0; i < QSC_DILITHIUM_K; ++i)
+		{
+			qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&w.vec[i], &mat[i], &yhat);
+			qsc_dilithium_poly_reduce(&w.vec[i]);
+			qsc_dilithium_poly_invntt_montgomery(&w.vec[i]);
+		}
+
+		/* Decompose w and call the random oracle */
+		qsc_dilithium_polyveck_csubq(&w);
+		qsc_dilithium_polyveck_decompose(&w1, &w0, &w);
+		challenge(&c, mu, &w1);
+		chat = c;
+		qsc_dilithium_poly_ntt(&chat);
+
+		/* Check that subtracting cs2 does not change high bits of w and low bits
+		 * do not reveal secret information */
+		for (i = 0; i < QSC_DILITHIUM_K; ++i)
+		{
+			qsc_dilithium_poly_pointwise_invmontgomery(&cs2.vec[i], &chat, &s2->vec[i]);
+			qsc_dilithium_poly_invntt_montgomery(&cs2.vec[i]);
+		}
+
+		qsc_dilithium_polyveck_sub(&w0, &w0, &cs2);
+		qsc_dilithium_polyveck_freeze(&w0);
+
+		if (qsc_dilithium_polyveck_chknorm(&w0, QSC_DILITHIUM_GAMMA2 - QSC_DILITHIUM_BETA) != 0)
+		{
+			continue;
+		}
+
+		/* Compute z, reject if it reveals secret */
+		for (i = 0; i < QSC_DILITHIUM_L; ++i)
+		{
+			qsc_dilithium_poly_pointwise_invmontgomery(&z.vec[i], &chat, &s1->vec[i]);
+			qsc_dilithium_poly_invntt_montgomery(&z.vec[i]);
+		}
+
+		qsc_dilithium_polyvecl_add(&z, &z, &y);
+		qsc_dilithium_polyvecl_freeze(&z);
+
+		if (qsc_dilithium_polyvecl_chknorm(&z, QSC_DILITHIUM_GAMMA1 - QSC_DILITHIUM_BETA) != 0)
+		{
+			continue;
+		}
+
+		/* Compute hints for w1 */
+		for (i = 0; i < QSC_DILITHIUM_K; ++i)
+		{
+			qsc_dilithium_poly_pointwise_invmontgomery(&ct0.vec[i], &chat, &t0->vec[i]);
+			qsc_dilithium_poly_invntt_montgomery(&ct0.vec[i]);
+		}
+
+		qsc_dilithium_polyveck_csubq(&ct0);
+
+		if (qsc_dilithium_polyveck_chknorm(&ct0, QSC_DILITHIUM_GAMMA2) != 0)
+		{
+			continue;
+		}
+
+		qsc_dilithium_polyveck_add(&w0, &w0, &ct0);
+		qsc_dilithium_polyveck_csubq(&w0);
+		n = qsc_dilithium_polyveck_make_hint(&h, &w0, &w1);
+
+		if (n > QSC_DILITHIUM_OMEGA)
+		{
+			continue;
+		}
+
+		/* Write signature */
+		qsc_dilithium_pack_sig(signature, &z, &h, &c);
+		nrej = 0;
+	}
+}
+
+static void ksm_sign_expanded(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K],
+	const qsc_dilithium_polyvecl* s1, const qsc_dilithium_polyveck* s2, const qsc_dilithium_polyveck* t0, const uint8_t* key, const uint8_t* tr, void (*rng_generate)(uint8_t*, size_t))
+{
+	qsc_keccak_state kstate;
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+	size_t i;
+
+	/* Compute CRH(tr, msg) before the message is moved */
+	ksm_message_hash(&kstate, tr);
+	qsc_shake_update(&kstate, keccak_rate_256, message, msglen);
+	qsc_shake_finalize(&kstate, keccak_rate_256, mu, QSC_DILITHIUM_CRH_SIZE);
+
+	/* Copy the message into the signedmsg buffer,
+	 * backwards since message and signedmsg can be equal in SUPERCOP API */
+	for (i = 1; i <= msglen; ++i)
+	{
+		signedmsg[DILITHIUM_SIGNATURE_SIZE + msglen - i] = message[msglen - i];
+	}
+
+	ksm_sign_mu(signedmsg, mu, mat, s1, s2, t0, key, rng_generate);
+	*smsglen = msglen + DILITHIUM_SIGNATURE_SIZE;
+}
+
+static void ksm_expand_sk(qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, qsc_dilithium_polyveck* t0,
+	uint8_t* key, uint8_t* tr, const uint8_t* privatekey)
+{
+	uint8_t rho[QSC_DILITHIUM_SEED_SIZE];
+
+	/* the matrix and secret vectors are stored ready for the rejection loop */
+	qsc_dilithium_unpack_sk(rho, key, tr, s1, s2, t0, privatekey);
+	expand_mat(mat, rho);
+	qsc_dilithium_polyvecl_ntt(s1);
+	qsc_dilithium_polyveck_ntt(s2);
+	qsc_dilithium_polyveck_ntt(t0);
+}
+
+void qsc_dilithium_ksm_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t key[QSC_DILITHIUM_SEED_SIZE];
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
+	qsc_dilithium_polyvecl s1;
+	qsc_dilithium_polyveck s2;
+	qsc_dilithium_polyveck t0;
+
+	ksm_expand_sk(mat, &s1, &s2, &t0, key, tr, privatekey);
+	ksm_sign_expanded(signedmsg, smsglen, message, msglen, mat, &s1, &s2, &t0, key, tr, rng_generate);
+}
+
+void qsc_dilithium_ksm_sign_initialize(qsc_keccak_state* kstate, const uint8_t* privatekey)
+{
+	/* tr follows rho and key in the packed private key */
+	ksm_message_hash(kstate, privatekey + (2 * QSC_DILITHIUM_SEED_SIZE));
+}
+
+void qsc_dilithium_ksm_sign_finalize(qsc_keccak_state* kstate, uint8_t* signature, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t key[QSC_DILITHIUM_SEED_SIZE];
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
+	qsc_dilithium_polyvecl s1;
+	qsc_dilithium_polyveck s2;
+	qsc_dilithium_polyveck t0;
+
+	qsc_shake_finalize(kstate, keccak_rate_256, mu, QSC_DILITHIUM_CRH_SIZE);
+	ksm_expand_sk(mat, &s1, &s2, &t0, key, tr, privatekey);
+	ksm_sign_mu(signature, mu, mat, &s1, &s2, &t0, key, rng_generate);
+}
+
+#if (QSC_DILITHIUM_K * QSC_DILITHIUM_L * QSC_DILITHIUM_N) > QSC_DILITHIUM_PREPARED_MATRIX_SIZE
+#	error "the prepared private key is too small for this parameter set"
+#endif
+
+void qsc_dilithium_ksm_prepare_sk(qsc_dilithium_prepared_privatekey* psk, const uint8_t* privatekey)
+{
+	ksm_expand_sk((qsc_dilithium_polyvecl*)psk->mat, (qsc_dilithium_polyvecl*)psk->s1, (qsc_dilithium_polyveck*)psk->s2,
+		(qsc_dilithium_polyveck*)psk->t0, psk->key, psk->tr, privatekey);
+}
+
+void qsc_dilithium_ksm_sign_prepared(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_prepared_privatekey* psk, void (*rng_generate)(uint8_t*, size_t))
+{
+	ksm_sign_expanded(signedmsg, smsglen, message, msglen, (const qsc_dilithium_polyvecl*)psk->mat, (const qsc_dilithium_polyvecl*)psk->s1,
+		(const qsc_dilithium_polyveck*)psk->s2, (const qsc_dilithium_polyveck*)psk->t0, psk->key, psk->tr, rng_generate);
+}
+
+static bool ksm_verify_unpack(qsc_dilithium_polyvecl* z, qsc_dilithium_polyveck* h, qsc_dilithium_poly* c, const uint8_t* signature, size_t siglen)
+{
+	bool res;
+
+	/* the length, encoding, and norm checks are done before the public key is expanded */
+	res = (siglen >= DILITHIUM_SIGNATURE_SIZE && qsc_dilithium_unpack_sig(z, h, c, signature) == 0 &&
+		qsc_dilithium_polyvecl_chknorm(z, QSC_DILITHIUM_GAMMA1 - QSC_DILITHIUM_BETA) == 0);
+
+	return res;
+}
+
+static bool ksm_verify_mu(qsc_dilithium_polyvecl* z, const qsc_dilithium_polyveck* h, const qsc_dilithium_poly* c, const uint8_t* mu,
+	const qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], const qsc_dilithium_polyveck* t1)
+{
+	qsc_dilithium_polyveck w1;
+	qsc_dilithium_polyveck tmp1;
+	qsc_dilithium_polyveck tmp2;
+	qsc_dilithium_poly chat;
+	qsc_dilithium_poly cp;
+	size_t i;
+	bool res;
+
+	res = true;
+
+	/* Matrix-vector multiplication; compute Az - c2^dt1 */
+	qsc_dilithium_polyvecl_ntt(z);
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_polyvecl_pointwise_acc_invmontgomery(&tmp1.vec[i], &mat[i], z);
+	}
+
+	chat = *c;
+	qsc_dilithium_poly_ntt(&chat);
+
+	for (i = 0; i < QSC_DILITHIUM_K; ++i)
+	{
+		qsc_dilithium_poly_pointwise_invmontgomery(&tmp2.vec[i], &chat, &t1->vec[i]);
+	}
+
+	qsc_dilithium_polyveck_sub(&tmp1, &tmp1, &tmp2);
+	qsc_dilithium_polyveck_reduce(&tmp1);
+	qsc_dilithium_polyveck_invntt_montgomery(&tmp1);
+
+	/* Reconstruct w1 */
+	qsc_dilithium_polyveck_csubq(&tmp1);
+	qsc_dilithium_polyveck_use_hint(&w1, &tmp1, h);
+
+	/* Call random oracle and verify challenge */
+	challenge(&cp, mu, &w1);
+
+	for (i = 0; i < QSC_DILITHIUM_N; ++i)
+	{
+		if (c->coeffs[i] != cp.coeffs[i])
+		{
+			res = false;
+			break;
+		}
+	}
+
+	return res;
+}
+
+static bool ksm_verify_expanded(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, qsc_dilithium_polyvecl* z,
+	const qsc_dilithium_polyveck* h, const qsc_dilithium_poly* c, const qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], const qsc_dilithium_polyveck* t1, const uint8_t* tr)
+{
+	qsc_keccak_state kstate;
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+	size_t i;
+	bool res;
+
+	*msglen = smsglen - DILITHIUM_SIGNATURE_SIZE;
+
+	/* Compute CRH(CRH(rho, t1), msg) directly over the signed message */
+	ksm_message_hash(&kstate, tr);
+	qsc_shake_update(&kstate, keccak_rate_256, signedmsg + DILITHIUM_SIGNATURE_SIZE, *msglen);
+	qsc_shake_finalize(&kstate, keccak_rate_256, mu, QSC_DILITHIUM_CRH_SIZE);
+
+	res = ksm_verify_mu(z, h, c, mu, mat, t1);
+
+	if (res == true)
+	{
+		/* All good, copy msg */
+		for (i = 0; i < *msglen; ++i)
+		{
+			message[i] = signedmsg[DILITHIUM_SIGNATURE_SIZE + i];
+		}
+	}
+
+	return res;
+}
+
+static void ksm_verify_reject(uint8_t* message, size_t* msglen, size_t smsglen)
+{
+	size_t i;
+
+	*msglen = 0;
+
+	for (i = 0; i < smsglen; ++i)
+	{
+		message[i] = 0;
+	}
+}
+
+static void ksm_expand_pk(qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K], qsc_dilithium_polyveck* t1, uint8_t* tr, const uint8_t* publickey)
+{
+	uint8_t rho[QSC_DILITHIUM_SEED_SIZE];
+
+	/* the matrix, t1 * 2^d in the NTT domain, and CRH(rho, t1) depend only on the public key */
+	qsc_dilithium_unpack_pk(rho, t1, publickey);
+	expand_mat(mat, rho);
+	qsc_dilithium_polyveck_shiftl(t1);
+	qsc_dilithium_polyveck_ntt(t1);
+	qsc_shake256_compute(tr, QSC_DILITHIUM_CRH_SIZE, publickey, DILITHIUM_PUBLICKEY_SIZE);
+}
+
+bool qsc_dilithium_ksm_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
+{
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
+	qsc_dilithium_polyvecl z;
+	qsc_dilithium_polyveck h;
+	qsc_dilithium_polyveck t1;
+	qsc_dilithium_poly c;
+	bool res;
+
+	res = false;
+
+	/* the public key is only expanded for a well-formed signed message */
+	if (ksm_verify_unpack(&z, &h, &c, signedmsg, smsglen) == true)
+	{
+		ksm_expand_pk(mat, &t1, tr, publickey);
+		res = ksm_verify_expanded(message, msglen, signedmsg, smsglen, &z, &h, &c, mat, &t1, tr);
+	}
+
+	if (res == false)
+	{
+		ksm_verify_reject(message, msglen, smsglen);
+	}
+
+	return res;
+}
+
+void qsc_dilithium_ksm_prepare_pk(qsc_dilithium_prepared_publickey* ppk, const uint8_t* publickey)
+{
+	ksm_expand_pk((qsc_dilithium_polyvecl*)ppk->mat, (qsc_dilithium_polyveck*)ppk->t1, ppk->tr, publickey);
+}
+
+bool qsc_dilithium_ksm_verify_prepared(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_prepared_publickey* ppk)
+{
+	qsc_dilithium_polyvecl z;
+	qsc_dilithium_polyveck h;
+	qsc_dilithium_poly c;
+	bool res;
+
+	res = false;
+
+	if (ksm_verify_unpack(&z, &h, &c, signedmsg, smsglen) == true)
+	{
+		res = ksm_verify_expanded(message, msglen, signedmsg, smsglen, &z, &h, &c, (const qsc_dilithium_polyvecl*)ppk->mat,
+			(const qsc_dilithium_polyveck*)ppk->t1, ppk->tr);
+	}
+
+	if (res == false)
+	{
+		ksm_verify_reject(message, msglen, smsglen);
+	}
+
+	return res;
+}
+
+void qsc_dilithium_ksm_verify_initialize(qsc_keccak_state* kstate, const uint8_t* publickey)
+{
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+
+	qsc_shake256_compute(tr, QSC_DILITHIUM_CRH_SIZE, publickey, DILITHIUM_PUBLICKEY_SIZE);
+	ksm_message_hash(kstate, tr);
+}
+
+bool qsc_dilithium_ksm_verify_finalize(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey)
+{
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+	qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];
+	qsc_dilithium_polyvecl z;
+	qsc_dilithium_polyveck h;
+	qsc_dilithium_polyveck t1;
+	qsc_dilithium_poly c;
+	bool res;
+
+	res = false;
+	qsc_shake_finalize(kstate, keccak_rate_256, mu, QSC_DILITHIUM_CRH_SIZE);
+
+	if (ksm_verify_unpack(&z, &h, &c, signature, DILITHIUM_SIGNATURE_SIZE) == true)
+	{
+		ksm_expand_pk(mat, &t1, tr, publickey);
+		res = ksm_verify_mu(&z, &h, &c, mu, mat, &t1);
+	}
+
+	return res;
+}
+
+#undef rej_eta
+#undef qsc_dilithium_polyeta_pack
+#undef qsc_dilithium_polyeta_unpack
+#undef qsc_dilithium_polyvecl
+#undef qsc_dilithium_polyveck
+#undef qsc_dilithium_polyvecl_freeze
+#undef qsc_dilithium_polyvecl_add
+#undef qsc_dilithium_polyvecl_ntt
+#undef qsc_dilithium_polyvecl_pointwise_acc_invmontgomery
+#undef qsc_dilithium_polyvecl_chknorm
+#undef qsc_dilithium_polyveck_reduce
+#undef qsc_dilithium_polyveck_csubq
+#undef qsc_dilithium_polyveck_freeze
+#undef qsc_dilithium_polyveck_add
+#undef qsc_dilithium_polyveck_sub
+#undef qsc_dilithium_polyveck_shiftl
+#undef qsc_dilithium_polyveck_ntt
+#undef qsc_dilithium_polyveck_invntt_montgomery
+#undef qsc_dilithium_polyveck_chknorm
+#undef qsc_dilithium_polyveck_power2round
+#undef qsc_dilithium_polyveck_decompose
+#undef qsc_dilithium_polyveck_make_hint
+#undef qsc_dilithium_polyveck_use_hint
+#undef qsc_dilithium_pack_pk
+#undef qsc_dilithium_unpack_pk
+#undef qsc_dilithium_pack_sk
+#undef qsc_dilithium_unpack_sk
+#undef qsc_dilithium_pack_sig
+#undef qsc_dilithium_unpack_sig
+#undef expand_mat
+#undef challenge
+#undef qsc_dilithium_ksm_generate
+#undef ksm_message_hash
+#undef ksm_sign_mu
+#undef ksm_sign_expanded
+#undef ksm_expand_sk
+#undef qsc_dilithium_ksm_sign
+#undef qsc_dilithium_ksm_sign_initialize
+#undef qsc_dilithium_ksm_sign_finalize
+#undef qsc_dilithium_ksm_prepare_sk
+#undef qsc_dilithium_ksm_sign_prepared
+#undef ksm_verify_unpack
+#undef ksm_verify_mu
+#undef ksm_verify_expanded
+#undef ksm_verify_reject
+#undef ksm_expand_pk
+#undef qsc_dilithium_ksm_verify
+#undef qsc_dilithium_ksm_prepare_pk
+#undef qsc_dilithium_ksm_verify_prepared
+#undef qsc_dilithium_ksm_verify_initialize
+#undef qsc_dilithium_ksm_verify_finalize
+#undef QSC_DILITHIUM_K
+#undef QSC_DILITHIUM_L
+#undef QSC_DILITHIUM_ETA
+#undef QSC_DILITHIUM_SETABITS
+#undef QSC_DILITHIUM_BETA
+#undef QSC_DILITHIUM_OMEGA
+#undef DILITHIUM_POLETA_SIZE_PACKED
+#undef DILITHIUM_PUBLICKEY_SIZE
+#undef DILITHIUM_SECRETKEY_SIZE
+#undef DILITHIUM_SIGNATURE_SIZE
+#undef DILITHIUM_UNIFORM_ETA_NBLOCKS
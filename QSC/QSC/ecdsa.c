@@ -29,3 +29,36 @@ bool qsc_ecdsa_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg
 
 	return (ret == 0);
 }
+
+void qsc_ecdsa_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey)
+{
+	qsc_ed25519_sign_detached(signature, message, msglen, privatekey);
+}
+
+bool qsc_ecdsa_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	int32_t ret;
+
+	ret = qsc_ed25519_verify_detached(signature, message, msglen, publickey);
+
+	return (ret == 0);
+}
+
+void qsc_ecdsa_verify_initialize(qsc_ecdsa_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	qsc_ed25519_verify_initialize(&ctx->hstate, signature, publickey);
+}
+
+void qsc_ecdsa_verify_update(qsc_ecdsa_stream_state* ctx, const uint8_t* message, size_t msglen)
+{
+	qsc_sha512_update(&ctx->hstate, message, msglen);
+}
+
+bool qsc_ecdsa_verify_finalize(qsc_ecdsa_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	int32_t ret;
+
+	ret = qsc_ed25519_verify_finalize(&ctx->hstate, signature, publickey);
+
+	return (ret == 0);
+}
@@ -73,6 +73,7 @@
 #define QSC_ECDSA_H
 
 #include "common.h"
+#include "sha2.h"
 
 #if defined(QSC_ECDSA_S1EC25519)
 
@@ -110,6 +111,16 @@
 */
 #define QSC_ECDSA_ALGNAME "ECDSA"
 
+/*!
+* \struct qsc_ecdsa_stream_state
+* \brief The message state of a streaming verification. \n
+* The message is hashed as it arrives, so a large message is never copied or held in memory.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_sha512_state hstate;							/*!< The message hash state */
+} qsc_ecdsa_stream_state;
+
 /**
 * \brief Generates a ECDSA public/private key-pair.
 *
@@ -158,4 +169,58 @@ QSC_EXPORT_API void qsc_ecdsa_sign(uint8_t* signedmsg, size_t* smsglen, const ui
 */
 QSC_EXPORT_API bool qsc_ecdsa_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns the signature alone; the message is neither copied nor modified.
+*
+* \warning Signature array must be sized to QSC_ECDSA_SIGNATURE_SIZE. \n
+* The message is read twice, once for the nonce and once for the challenge hash,
+* so signing has no streaming form; verification does.
+*
+* \param signature: Pointer to the output signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_ecdsa_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey);
+
+/**
+* \brief Verifies a detached signature over a message with the public key.
+*
+* \param signature: [const] Pointer to the signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_ecdsa_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Starts a streaming verification of a detached signature.
+* Long form api: must be used in conjunction with the verify update and verify finalize functions.
+*
+* \param ctx: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_ecdsa_verify_initialize(qsc_ecdsa_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Adds a block of message to a streaming verification; can be called any number of times.
+*
+* \param ctx: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_ecdsa_verify_update(qsc_ecdsa_stream_state* ctx, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Completes a streaming verification and erases the stream state.
+*
+* \param ctx: [struct] The stream state
+* \param signature: [const] Pointer to the signature array used to initialize the stream
+* \param publickey: [const] Pointer to the public verification-key array used to initialize the stream
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_ecdsa_verify_finalize(qsc_ecdsa_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
 #endif
@@ -59,10 +59,8 @@ static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m,
 	return 0;
 }
 
-static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* pk)
+static bool ecdsa_ed25519_verify_hram(const uint8_t* sig, uint8_t* h, const uint8_t* pk)
 {
-	qsc_sha512_state ctx;
-	uint8_t h[64] = { 0 };
 	uint8_t rcheck[32] = { 0 };
 	ge25519_p3 A;
 	ge25519_p2 R;
@@ -89,11 +87,6 @@ static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t ml
 
 	if (res == true)
 	{
-		qsc_sha512_initialize(&ctx);
-		qsc_sha512_update(&ctx, sig, 32);
-		qsc_sha512_update(&ctx, pk, 32);
-		qsc_sha512_update(&ctx, m, mlen);
-		qsc_sha512_finalize(&ctx, h);
 		sc25519_reduce(h);
 
 		ge25519_double_scalarmult_vartime(&R, h, &A, sig + 32);
@@ -108,6 +101,20 @@ static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t ml
 	return res;
 }
 
+static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+	qsc_sha512_state ctx;
+	uint8_t h[64] = { 0 };
+	bool res;
+
+	qsc_ed25519_verify_initialize(&ctx, sig, pk);
+	qsc_sha512_update(&ctx, m, mlen);
+	qsc_sha512_finalize(&ctx, h);
+	res = ecdsa_ed25519_verify_hram(sig, h, pk);
+
+	return res;
+}
+
 /* public api */
 
 void qsc_ed25519_keypair(uint8_t* publickey, uint8_t* privatekey, uint8_t* seed)
@@ -193,3 +200,40 @@ int32_t qsc_ed25519_verify(uint8_t* message, size_t* msglen, const uint8_t* sign
 
 	return res;
 }
+
+int32_t qsc_ed25519_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey)
+{
+	int32_t res;
+
+	res = ecdsa_ed25519_sign(signature, NULL, message, msglen, privatekey);
+
+	return res;
+}
+
+int32_t qsc_ed25519_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	int32_t res;
+
+	res = (ecdsa_ed25519_verify(signature, message, msglen, publickey) == true) ? 0 : -1;
+
+	return res;
+}
+
+void qsc_ed25519_verify_initialize(qsc_sha512_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	/* h = H(R || A || M) */
+	qsc_sha512_initialize(ctx);
+	qsc_sha512_update(ctx, signature, 32);
+	qsc_sha512_update(ctx, publickey, 32);
+}
+
+int32_t qsc_ed25519_verify_finalize(qsc_sha512_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	uint8_t h[64] = { 0 };
+	int32_t res;
+
+	qsc_sha512_finalize(ctx, h);
+	res = (ecdsa_ed25519_verify_hram(signature, h, publickey) == true) ? 0 : -1;
+
+	return res;
+}
@@ -34,6 +34,7 @@
 #define QSC_ECDSABASE_H
 
 #include "common.h"
+#include "sha2.h"
 
 /**
 * \brief Combine and external public key with an internal private key to produce a shared secret
@@ -70,4 +71,46 @@ int32_t qsc_ed25519_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* mes
 */
 int32_t qsc_ed25519_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns the 64 byte signature alone.
+*
+* \param signature The output signature
+* \param message The message to be signed
+* \param msglen The message length
+* \param privatekey The private signature key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey);
+
+/**
+* \brief Verifies a detached signature over a message with the public key.
+*
+* \param signature The signature
+* \param message The message
+* \param msglen The message length
+* \param publickey The public verification key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Starts the verification of a detached signature; absorbs R and the public key into the message hash.
+* The message is added to the state with qsc_sha512_update.
+*
+* \param ctx The message hash state
+* \param signature The signature
+* \param publickey The public verification key
+*/
+void qsc_ed25519_verify_initialize(qsc_sha512_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Completes the message hash and verifies the detached signature.
+*
+* \param ctx The message hash state
+* \param signature The signature
+* \param publickey The public verification key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519_verify_finalize(qsc_sha512_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
 #endif
\ No newline at end of file
@@ -1,5 +1,20 @@
 #include "kyber.h"
 #include "kyberbase.h"
+#include "memutils.h"
+
+#if (QSC_KYBER_K == 2)
+#	define kyber_kem_dec qsc_kyber_crypto_kem_dec_k2
+#	define kyber_kem_enc qsc_kyber_crypto_kem_enc_k2
+#	define kyber_kem_keypair qsc_kyber_crypto_kem_keypair_k2
+#elif (QSC_KYBER_K == 3)
+#	define kyber_kem_dec qsc_kyber_crypto_kem_dec_k3
+#	define kyber_kem_enc qsc_kyber_crypto_kem_enc_k3
+#	define kyber_kem_keypair qsc_kyber_crypto_kem_keypair_k3
+#else
+#	define kyber_kem_dec qsc_kyber_crypto_kem_dec_k4
+#	define kyber_kem_enc qsc_kyber_crypto_kem_enc_k4
+#	define kyber_kem_keypair qsc_kyber_crypto_kem_keypair_k4
+#endif
 
 bool qsc_kyber_decapsulate(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey)
 {
@@ -9,7 +24,7 @@ bool qsc_kyber_decapsulate(uint8_t* secret, const uint8_t* ciphertext, const uin
 
 	bool res;
 
-	res = qsc_kyber_crypto_kem_dec(secret, ciphertext, privatekey);
+	res = kyber_kem_dec(secret, ciphertext, privatekey);
 
 	return res;
 }
@@ -21,7 +36,7 @@ void qsc_kyber_encapsulate(uint8_t* secret, uint8_t* ciphertext, const uint8_t*
 	assert(publickey != NULL);
 	assert(rng_generate != NULL);
 
-	qsc_kyber_crypto_kem_enc(ciphertext, secret, publickey, rng_generate);
+	kyber_kem_enc(ciphertext, secret, publickey, rng_generate);
 }
 
 void qsc_kyber_generate_keypair(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
@@ -30,5 +45,306 @@ void qsc_kyber_generate_keypair(uint8_t* publickey, uint8_t* privatekey, void (*
 	assert(privatekey != NULL);
 	assert(rng_generate != NULL);
 
-	qsc_kyber_crypto_kem_keypair(publickey, privatekey, rng_generate);
-}
\ No newline at end of file
+	kyber_kem_keypair(publickey, privatekey, rng_generate);
+}
+
+bool qsc_kyber_decapsulate_ex(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey, qsc_kyber_parameters params)
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(privatekey != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (params == KYBER512)
+	{
+		res = qsc_kyber_crypto_kem_dec_k2(secret, ciphertext, privatekey);
+	}
+	else if (params == KYBER768)
+	{
+		res = qsc_kyber_crypto_kem_dec_k3(secret, ciphertext, privatekey);
+	}
+	else if (params == KYBER1024)
+	{
+		res = qsc_kyber_crypto_kem_dec_k4(secret, ciphertext, privatekey);
+	}
+
+	return res;
+}
+
+bool qsc_kyber_encapsulate_ex(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publickey, void (*rng_generate)(uint8_t*, size_t), qsc_kyber_parameters params)
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(publickey != NULL);
+	assert(rng_generate != NULL);
+
+	bool res;
+
+	res = true;
+
+	if (params == KYBER512)
+	{
+		qsc_kyber_crypto_kem_enc_k2(ciphertext, secret, publickey, rng_generate);
+	}
+	else if (params == KYBER768)
+	{
+		qsc_kyber_crypto_kem_enc_k3(ciphertext, secret, publickey, rng_generate);
+	}
+	else if (params == KYBER1024)
+	{
+		qsc_kyber_crypto_kem_enc_k4(ciphertext, secret, publickey, rng_generate);
+	}
+	else
+	{
+		/* never hand back an unwritten secret; the cipher-text is cleared to the smallest set size */
+		qsc_memutils_clear(secret, QSC_KYBER_SHAREDSECRET_SIZE);
+		qsc_memutils_clear(ciphertext, QSC_KYBER512_CIPHERTEXT_SIZE);
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_kyber_generate_keypair_ex(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_kyber_parameters params)
+{
+	assert(publickey != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	bool res;
+
+	res = true;
+
+	if (params == KYBER512)
+	{
+		qsc_kyber_crypto_kem_keypair_k2(publickey, privatekey, rng_generate);
+	}
+	else if (params == KYBER768)
+	{
+		qsc_kyber_crypto_kem_keypair_k3(publickey, privatekey, rng_generate);
+	}
+	else if (params == KYBER1024)
+	{
+		qsc_kyber_crypto_kem_keypair_k4(publickey, privatekey, rng_generate);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+size_t qsc_kyber_ciphertext_size(qsc_kyber_parameters params)
+{
+	size_t len;
+
+	len = (params == KYBER512) ? QSC_KYBER512_CIPHERTEXT_SIZE :
+		(params == KYBER768) ? QSC_KYBER768_CIPHERTEXT_SIZE :
+		(params == KYBER1024) ? QSC_KYBER1024_CIPHERTEXT_SIZE : 0;
+
+	return len;
+}
+
+size_t qsc_kyber_privatekey_size(qsc_kyber_parameters params)
+{
+	size_t len;
+
+	len = (params == KYBER512) ? QSC_KYBER512_PRIVATEKEY_SIZE :
+		(params == KYBER768) ? QSC_KYBER768_PRIVATEKEY_SIZE :
+		(params == KYBER1024) ? QSC_KYBER1024_PRIVATEKEY_SIZE : 0;
+
+	return len;
+}
+
+size_t qsc_kyber_publickey_size(qsc_kyber_parameters params)
+{
+	size_t len;
+
+	len = (params == KYBER512) ? QSC_KYBER512_PUBLICKEY_SIZE :
+		(params == KYBER768) ? QSC_KYBER768_PUBLICKEY_SIZE :
+		(params == KYBER1024) ? QSC_KYBER1024_PUBLICKEY_SIZE : 0;
+
+	return len;
+}
+
+bool qsc_kyber_prepare_publickey(qsc_kyber_prepared_publickey* ppk, const uint8_t* publickey, qsc_kyber_parameters params)
+{
+	assert(ppk != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = true;
+	ppk->params = params;
+
+	if (params == KYBER512)
+	{
+		qsc_kyber_crypto_kem_prepare_pk_k2(ppk, publickey);
+	}
+	else if (params == KYBER768)
+	{
+		qsc_kyber_crypto_kem_prepare_pk_k3(ppk, publickey);
+	}
+	else if (params == KYBER1024)
+	{
+		qsc_kyber_crypto_kem_prepare_pk_k4(ppk, publickey);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_kyber_prepare_privatekey(qsc_kyber_prepared_privatekey* psk, const uint8_t* privatekey, qsc_kyber_parameters params)
+{
+	assert(psk != NULL);
+	assert(privatekey != NULL);
+
+	bool res;
+
+	res = true;
+	psk->ppk.params = params;
+
+	if (params == KYBER512)
+	{
+		qsc_kyber_crypto_kem_prepare_sk_k2(psk, privatekey);
+	}
+	else if (params == KYBER768)
+	{
+		qsc_kyber_crypto_kem_prepare_sk_k3(psk, privatekey);
+	}
+	else if (params == KYBER1024)
+	{
+		qsc_kyber_crypto_kem_prepare_sk_k4(psk, privatekey);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+void qsc_kyber_prepared_privatekey_dispose(qsc_kyber_prepared_privatekey* psk)
+{
+	if (psk != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)psk->skpv, sizeof(psk->skpv));
+		qsc_memutils_clear(psk->z, sizeof(psk->z));
+		qsc_memutils_clear((uint8_t*)psk->ppk.at, sizeof(psk->ppk.at));
+		qsc_memutils_clear((uint8_t*)psk->ppk.pkpv, sizeof(psk->ppk.pkpv));
+		qsc_memutils_clear(psk->ppk.pkhash, sizeof(psk->ppk.pkhash));
+		psk->ppk.params = (qsc_kyber_parameters)0;
+	}
+}
+
+bool qsc_kyber_encapsulate_prepared(uint8_t* secret, uint8_t* ciphertext, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(ppk != NULL);
+	assert(rng_generate != NULL);
+
+	bool res;
+
+	res = true;
+
+	if (ppk->params == KYBER512)
+	{
+		qsc_kyber_crypto_kem_enc_prepared_k2(ciphertext, secret, ppk, rng_generate);
+	}
+	else if (ppk->params == KYBER768)
+	{
+		qsc_kyber_crypto_kem_enc_prepared_k3(ciphertext, secret, ppk, rng_generate);
+	}
+	else if (ppk->params == KYBER1024)
+	{
+		qsc_kyber_crypto_kem_enc_prepared_k4(ciphertext, secret, ppk, rng_generate);
+	}
+	else
+	{
+		/* an unprepared or disposed key; never hand back an unwritten secret */
+		qsc_memutils_clear(secret, QSC_KYBER_SHAREDSECRET_SIZE);
+		res = false;
+	}
+
+	return res;
+}
+
+bool qsc_kyber_decapsulate_prepared(uint8_t* secret, const uint8_t* ciphertext, const qsc_kyber_prepared_privatekey* psk)
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(psk != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (psk->ppk.params == KYBER512)
+	{
+		res = qsc_kyber_crypto_kem_dec_prepared_k2(secret, ciphertext, psk);
+	}
+	else if (psk->ppk.params == KYBER768)
+	{
+		res = qsc_kyber_crypto_kem_dec_prepared_k3(secret, ciphertext, psk);
+	}
+	else if (psk->ppk.params == KYBER1024)
+	{
+		res = qsc_kyber_crypto_kem_dec_prepared_k4(secret, ciphertext, psk);
+	}
+
+	return res;
+}
+
+size_t qsc_kyber_decapsulate_batch(uint8_t* secrets, bool* valid, const uint8_t* ciphertexts, size_t count, const uint8_t* privatekey, qsc_kyber_parameters params)
+{
+	assert(secrets != NULL);
+	assert(ciphertexts != NULL);
+	assert(privatekey != NULL);
+
+	qsc_kyber_prepared_privatekey psk;
+	size_t res;
+
+	res = 0;
+
+	if (qsc_kyber_prepare_privatekey(&psk, privatekey, params) == true)
+	{
+		res = qsc_kyber_decapsulate_prepared_batch(secrets, valid, ciphertexts, count, &psk);
+		qsc_kyber_prepared_privatekey_dispose(&psk);
+	}
+
+	return res;
+}
+
+size_t qsc_kyber_decapsulate_prepared_batch(uint8_t* secrets, bool* valid, const uint8_t* ciphertexts, size_t count, const qsc_kyber_prepared_privatekey* psk)
+{
+	assert(secrets != NULL);
+	assert(ciphertexts != NULL);
+	assert(psk != NULL);
+
+	size_t res;
+
+	res = 0;
+
+	if (psk->ppk.params == KYBER512)
+	{
+		res = qsc_kyber_crypto_kem_dec_batch_k2(secrets, valid, ciphertexts, count, psk);
+	}
+	else if (psk->ppk.params == KYBER768)
+	{
+		res = qsc_kyber_crypto_kem_dec_batch_k3(secrets, valid, ciphertexts, count, psk);
+	}
+	else if (psk->ppk.params == KYBER1024)
+	{
+		res = qsc_kyber_crypto_kem_dec_batch_k4(secrets, valid, ciphertexts, count, psk);
+	}
+
+	return res;
+}
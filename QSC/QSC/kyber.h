@@ -63,6 +63,89 @@
 
 #include "common.h"
 
+/*!
+* \enum qsc_kyber_parameters
+* \brief The Kyber parameter sets selectable at runtime
+*/
+QSC_EXPORT_API typedef enum
+{
+	KYBER512 = 1,	/*!< The Kyber-512 parameter set, K=2 */
+	KYBER768 = 2,	/*!< The Kyber-768 parameter set, K=3 */
+	KYBER1024 = 3	/*!< The Kyber-1024 parameter set, K=4 */
+} qsc_kyber_parameters;
+
+/*!
+* \def QSC_KYBER512_CIPHERTEXT_SIZE
+* \brief The byte size of the Kyber-512 cipher-text array
+*/
+#define QSC_KYBER512_CIPHERTEXT_SIZE 736
+
+/*!
+* \def QSC_KYBER512_PRIVATEKEY_SIZE
+* \brief The byte size of the Kyber-512 secret private-key array
+*/
+#define QSC_KYBER512_PRIVATEKEY_SIZE 1632
+
+/*!
+* \def QSC_KYBER512_PUBLICKEY_SIZE
+* \brief The byte size of the Kyber-512 public-key array
+*/
+#define QSC_KYBER512_PUBLICKEY_SIZE 800
+
+/*!
+* \def QSC_KYBER768_CIPHERTEXT_SIZE
+* \brief The byte size of the Kyber-768 cipher-text array
+*/
+#define QSC_KYBER768_CIPHERTEXT_SIZE 1088
+
+/*!
+* \def QSC_KYBER768_PRIVATEKEY_SIZE
+* \brief The byte size of the Kyber-768 secret private-key array
+*/
+#define QSC_KYBER768_PRIVATEKEY_SIZE 2400
+
+/*!
+* \def QSC_KYBER768_PUBLICKEY_SIZE
+* \brief The byte size of the Kyber-768 public-key array
+*/
+#define QSC_KYBER768_PUBLICKEY_SIZE 1184
+
+/*!
+* \def QSC_KYBER1024_CIPHERTEXT_SIZE
+* \brief The byte size of the Kyber-1024 cipher-text array
+*/
+#define QSC_KYBER1024_CIPHERTEXT_SIZE 1568
+
+/*!
+* \def QSC_KYBER1024_PRIVATEKEY_SIZE
+* \brief The byte size of the Kyber-1024 secret private-key array
+*/
+#define QSC_KYBER1024_PRIVATEKEY_SIZE 3168
+
+/*!
+* \def QSC_KYBER1024_PUBLICKEY_SIZE
+* \brief The byte size of the Kyber-1024 public-key array
+*/
+#define QSC_KYBER1024_PUBLICKEY_SIZE 1568
+
+/*!
+* \def QSC_KYBER_CIPHERTEXT_MAX_SIZE
+* \brief The largest cipher-text array of any parameter set
+*/
+#define QSC_KYBER_CIPHERTEXT_MAX_SIZE QSC_KYBER1024_CIPHERTEXT_SIZE
+
+/*!
+* \def QSC_KYBER_PRIVATEKEY_MAX_SIZE
+* \brief The largest private-key array of any parameter set
+*/
+#define QSC_KYBER_PRIVATEKEY_MAX_SIZE QSC_KYBER1024_PRIVATEKEY_SIZE
+
+/*!
+* \def QSC_KYBER_PUBLICKEY_MAX_SIZE
+* \brief The largest public-key array of any parameter set
+*/
+#define QSC_KYBER_PUBLICKEY_MAX_SIZE QSC_KYBER1024_PUBLICKEY_SIZE
+
 #if defined(QSC_KYBER_S1Q3329N256)
 
 /*!
@@ -139,6 +222,44 @@
 */
 #define QSC_KYBER_ALGNAME "KYBER"
 
+/*!
+* \def QSC_KYBER_PREPARED_MATRIX_SIZE
+* \brief The number of coefficients in a prepared public matrix, sized for the largest parameter set
+*/
+#define QSC_KYBER_PREPARED_MATRIX_SIZE (4 * 4 * 256)
+
+/*!
+* \def QSC_KYBER_PREPARED_VECTOR_SIZE
+* \brief The number of coefficients in a prepared key vector, sized for the largest parameter set
+*/
+#define QSC_KYBER_PREPARED_VECTOR_SIZE (4 * 256)
+
+/*!
+* \struct qsc_kyber_prepared_publickey
+* \brief A public key expanded for repeated encapsulation. \n
+* Holds the transposed matrix sampled from the key seed and the decoded public vector,
+* so encapsulation skips the unpacking, matrix generation and public-key hash.
+*/
+QSC_EXPORT_API typedef struct
+{
+	int16_t at[QSC_KYBER_PREPARED_MATRIX_SIZE];		/*!< The transposed public matrix */
+	int16_t pkpv[QSC_KYBER_PREPARED_VECTOR_SIZE];	/*!< The public key vector in the NTT domain */
+	uint8_t pkhash[QSC_KYBER_SHAREDSECRET_SIZE];	/*!< The SHA3-256 hash of the public key */
+	qsc_kyber_parameters params;					/*!< The Kyber parameter set */
+} qsc_kyber_prepared_publickey;
+
+/*!
+* \struct qsc_kyber_prepared_privatekey
+* \brief A private key expanded for repeated decapsulation. \n
+* Holds the decoded secret vector, the rejection value, and the expanded public key used by the re-encryption check.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_kyber_prepared_publickey ppk;				/*!< The expanded public key */
+	int16_t skpv[QSC_KYBER_PREPARED_VECTOR_SIZE];	/*!< The secret key vector in the NTT domain */
+	uint8_t z[QSC_KYBER_SHAREDSECRET_SIZE];			/*!< The pseudo-random output on rejection */
+} qsc_kyber_prepared_privatekey;
+
 /**
 * \brief Decapsulates the shared secret for given cipher-text using a private-key
 *
@@ -174,4 +295,147 @@ QSC_EXPORT_API void qsc_kyber_encapsulate(uint8_t* secret, uint8_t* ciphertext,
 */
 QSC_EXPORT_API void qsc_kyber_generate_keypair(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Decapsulates the shared secret for given cipher-text using a private-key of the selected parameter set
+*
+* \warning The cipher-text and private-key arrays must be sized for the parameter set, see qsc_kyber_ciphertext_size.
+*
+* \param secret: Pointer to a shared secret key, an array of QSC_KYBER_SHAREDSECRET_SIZE
+* \param ciphertext: [const] Pointer to the cipher-text array
+* \param privatekey: [const] Pointer to the private-key array
+* \param params: The Kyber parameter set
+* \return Returns true for success, false on a failed decapsulation or an unknown parameter set
+*/
+QSC_EXPORT_API bool qsc_kyber_decapsulate_ex(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey, qsc_kyber_parameters params);
+
+/**
+* \brief Generates cipher-text and encapsulates a shared secret key using a public-key of the selected parameter set
+*
+* \warning The cipher-text and public-key arrays must be sized for the parameter set, see qsc_kyber_ciphertext_size.
+*
+* \param secret: Pointer to the shared secret array, a uint8_t array of QSC_KYBER_SHAREDSECRET_SIZE
+* \param ciphertext: Pointer to the cipher-text array
+* \param publickey: [const] Pointer to the public-key array
+* \param rng_generate: A pointer to the random generator
+* \param params: The Kyber parameter set
+* \return Returns false for an unknown parameter set; the secret and the first QSC_KYBER512_CIPHERTEXT_SIZE bytes of the cipher-text are cleared
+*/
+QSC_EXPORT_API bool qsc_kyber_encapsulate_ex(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publickey, void (*rng_generate)(uint8_t*, size_t), qsc_kyber_parameters params);
+
+/**
+* \brief Generates public and private key of the selected parameter set
+*
+* \warning Arrays must be sized for the parameter set, see qsc_kyber_publickey_size and qsc_kyber_privatekey_size.
+*
+* \param publickey: Pointer to the output public-key array
+* \param privatekey: Pointer to output private-key array
+* \param rng_generate: A pointer to the random generator
+* \param params: The Kyber parameter set
+* \return Returns false for an unknown parameter set
+*/
+QSC_EXPORT_API bool qsc_kyber_generate_keypair_ex(uint8_t* publickey, uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t), qsc_kyber_parameters params);
+
+/**
+* \brief Returns the cipher-text byte size of a parameter set
+*
+* \param params: The Kyber parameter set
+* \return The cipher-text size, or zero for an unknown parameter set
+*/
+QSC_EXPORT_API size_t qsc_kyber_ciphertext_size(qsc_kyber_parameters params);
+
+/**
+* \brief Returns the private-key byte size of a parameter set
+*
+* \param params: The Kyber parameter set
+* \return The private-key size, or zero for an unknown parameter set
+*/
+QSC_EXPORT_API size_t qsc_kyber_privatekey_size(qsc_kyber_parameters params);
+
+/**
+* \brief Returns the public-key byte size of a parameter set
+*
+* \param params: The Kyber parameter set
+* \return The public-key size, or zero for an unknown parameter set
+*/
+QSC_EXPORT_API size_t qsc_kyber_publickey_size(qsc_kyber_parameters params);
+
+/**
+* \brief Expands a public key for repeated encapsulation
+*
+* \param ppk: [struct] The output prepared public key
+* \param publickey: [const] Pointer to the public-key array
+* \param params: The Kyber parameter set
+* \return Returns false for an unknown parameter set
+*/
+QSC_EXPORT_API bool qsc_kyber_prepare_publickey(qsc_kyber_prepared_publickey* ppk, const uint8_t* publickey, qsc_kyber_parameters params);
+
+/**
+* \brief Expands a private key for repeated decapsulation
+*
+* \warning The prepared private key holds secret material; erase it with qsc_kyber_prepared_privatekey_dispose.
+*
+* \param psk: [struct] The output prepared private key
+* \param privatekey: [const] Pointer to the private-key array
+* \param params: The Kyber parameter set
+* \return Returns false for an unknown parameter set
+*/
+QSC_EXPORT_API bool qsc_kyber_prepare_privatekey(qsc_kyber_prepared_privatekey* psk, const uint8_t* privatekey, qsc_kyber_parameters params);
+
+/**
+* \brief Erase a prepared private key
+*
+* \param psk: [struct] The prepared private key
+*/
+QSC_EXPORT_API void qsc_kyber_prepared_privatekey_dispose(qsc_kyber_prepared_privatekey* psk);
+
+/**
+* \brief Generates cipher-text and encapsulates a shared secret key using a prepared public-key
+*
+* \warning Ciphertext array must be sized for the parameter set of the prepared key.
+*
+* \param secret: Pointer to the shared secret array, a uint8_t array of QSC_KYBER_SHAREDSECRET_SIZE
+* \param ciphertext: Pointer to the cipher-text array
+* \param ppk: [const][struct] The prepared public key
+* \param rng_generate: A pointer to the random generator
+* \return Returns false if the prepared key holds an unknown parameter set, the secret is cleared
+*/
+QSC_EXPORT_API bool qsc_kyber_encapsulate_prepared(uint8_t* secret, uint8_t* ciphertext, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Decapsulates the shared secret for given cipher-text using a prepared private-key
+*
+* \param secret: Pointer to a shared secret key, an array of QSC_KYBER_SHAREDSECRET_SIZE
+* \param ciphertext: [const] Pointer to the cipher-text array
+* \param psk: [const][struct] The prepared private key
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_kyber_decapsulate_prepared(uint8_t* secret, const uint8_t* ciphertext, const qsc_kyber_prepared_privatekey* psk);
+
+/**
+* \brief Decapsulates the shared secrets of a batch of cipher-texts encapsulated to one private-key. \n
+* The private key is expanded once for the batch, and the re-encryption of each group of four
+* cipher-texts shares the SHAKE-256 passes of its noise sampling and key derivation.
+*
+* \param secrets: Pointer to the output shared secrets, count consecutive arrays of QSC_KYBER_SHAREDSECRET_SIZE
+* \param valid: Pointer to an optional array receiving count decapsulation results, may be NULL
+* \param ciphertexts: [const] Pointer to count consecutive cipher-text arrays of the parameter set size
+* \param count: The number of cipher-texts
+* \param privatekey: [const] Pointer to the private-key array
+* \param params: The Kyber parameter set
+* \return Returns the number of cipher-texts that decapsulated successfully, zero for an unknown parameter set
+*/
+QSC_EXPORT_API size_t qsc_kyber_decapsulate_batch(uint8_t* secrets, bool* valid, const uint8_t* ciphertexts, size_t count, const uint8_t* privatekey, qsc_kyber_parameters params);
+
+/**
+* \brief Decapsulates the shared secrets of a batch of cipher-texts using a prepared private-key
+*
+* \param secrets: Pointer to the output shared secrets, count consecutive arrays of QSC_KYBER_SHAREDSECRET_SIZE
+* \param valid: Pointer to an optional array receiving count decapsulation results, may be NULL
+* \param ciphertexts: [const] Pointer to count consecutive cipher-text arrays of the parameter set size
+* \param count: The number of cipher-texts
+* \param psk: [const][struct] The prepared private key
+* \return Returns the number of cipher-texts that decapsulated successfully
+*/
+QSC_EXPORT_API size_t qsc_kyber_decapsulate_prepared_batch(uint8_t* secrets, bool* valid, const uint8_t* ciphertexts, size_t count, const qsc_kyber_prepared_privatekey* psk);
+
 #endif
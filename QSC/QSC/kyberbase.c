@@ -1,6 +1,10 @@
 #include "kyberbase.h"
 #include "intutils.h"
+#include "memutils.h"
 #include "sha3.h"
+#if defined(QSC_SYSTEM_HAS_AVX2)
+#	include <immintrin.h>
+#endif
 
 /* params.h */
 
@@ -32,435 +36,478 @@
 #define KYBER_INDCPA_MSGBYTES QSC_KYBER_SYMBYTES
 
 
-/*!
-\def KYBER_POLYVECBYTES
-* Read Only: The base size of the compressed public key polynolial
-*/
-#if QSC_KYBER_K == 2
-#define KYBER_POLYVECBASEBYTES 320
-#elif QSC_KYBER_K == 3
-#define KYBER_POLYVECBASEBYTES 320
-#elif QSC_KYBER_K == 4
-#define KYBER_POLYVECBASEBYTES 352
-#endif
+/* 2^16 % Q */
+#define KYBER_MONT 2285
 
-/*!
-\def KYBER_POLYCOMPRESSEDBYTES
-* Read Only: The ciphertext compressed byte size
-*/
-#if QSC_KYBER_K == 2
-#define KYBER_POLYCOMPRESSEDBYTES 96
-#elif QSC_KYBER_K == 3
-#define KYBER_POLYCOMPRESSEDBYTES 128
-#elif QSC_KYBER_K == 4
-#define KYBER_POLYCOMPRESSEDBYTES 160
-#endif
+/* q^(-1) mod 2^16 */
+#define KYBER_QINV 62209
 
-/*!
-\def KYBER_POLYVECCOMPRESSEDBYTES
-* Read Only: The base size of the public key
-*/
-#define KYBER_POLYVECCOMPRESSEDBYTES (QSC_KYBER_K * KYBER_POLYVECBASEBYTES)
+/* indcpa.c */
 
 /*!
-\def KYBER_POLYVECBYTES
-* Read Only: The base size of the secret key
+\def KYBER_GEN_MATRIX_NBLOCKS
+* Read Only: The number of SHAKE-128 blocks squeezed per polynomial, 530 is the expected number of required bytes
 */
-#define KYBER_POLYVECBYTES (QSC_KYBER_K * KYBER_POLYBYTES)
+#define KYBER_GEN_MATRIX_NBLOCKS ((530 + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE)
 
 /*!
-\def KYBER_INDCPA_PUBLICKEYBYTES
-* Read Only: The base INDCPA formatted public key size in bytes
+\def KYBER_GEN_MATRIX_LANES
+* Read Only: The number of matrix polynomials sampled per Keccak pass
 */
-#define KYBER_INDCPA_PUBLICKEYBYTES (KYBER_POLYVECBYTES + QSC_KYBER_SYMBYTES)
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define KYBER_GEN_MATRIX_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define KYBER_GEN_MATRIX_LANES 4
+#else
+#	define KYBER_GEN_MATRIX_LANES 1
+#endif
 
-/*!
-\def KYBER_INDCPA_SECRETKEYBYTES
-* Read Only: The base INDCPA formatted private key size in bytes
-*/
-#define KYBER_INDCPA_SECRETKEYBYTES (KYBER_POLYVECBYTES)
+static uint32_t rej_uniform(uint16_t *r, uint32_t len, const uint8_t* buf, uint32_t buflen)
+{
+	uint32_t ctr;
+	uint32_t pos;
+	uint16_t val;
 
-/*!
-\def KYBER_INDCPA_BYTES
-* Read Only: The size of the INDCPA formatted output cipher-text
-*/
-#define KYBER_INDCPA_BYTES (KYBER_POLYVECCOMPRESSEDBYTES + KYBER_POLYCOMPRESSEDBYTES)
+	ctr = 0;
+	pos = 0;
 
-/*!
-\def KYBER_PUBLICKEY_SIZE
-* Read Only: The public key size in bytes
-*/
-#define KYBER_PUBLICKEY_SIZE (KYBER_INDCPA_PUBLICKEYBYTES)
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	const __m256i bound = _mm256_set1_epi16((int16_t)(19 * QSC_KYBER_Q - 1));
+	const __m256i q = _mm256_set1_epi16(QSC_KYBER_Q);
+	uint16_t tmp[16];
+	__m256i m;
+	__m256i v;
+	uint32_t mask;
+	size_t i;
 
-/*!
-\def KYBER_INDCPA_SECRETKEYBYTES
-* Read Only: The base INDCPA formatted secret key size in bytes
-*/
-#define KYBER_SECRETKEY_SIZE (KYBER_INDCPA_SECRETKEYBYTES +  KYBER_INDCPA_PUBLICKEYBYTES + 2 * QSC_KYBER_SYMBYTES)
+	/* test and reduce 16 candidates at once, then compact the accepted lanes without branching */
+	while (ctr + 16 <= len && pos + 32 <= buflen)
+	{
+		v = _mm256_loadu_si256((const __m256i*)(buf + pos));
+		m = _mm256_cmpeq_epi16(_mm256_min_epu16(v, bound), v);
+		v = _mm256_sub_epi16(v, _mm256_mullo_epi16(_mm256_srli_epi16(v, 12), q));
+		_mm256_storeu_si256((__m256i*)tmp, v);
+		mask = (uint32_t)_mm256_movemask_epi8(m);
 
-/*!
-\def KYBER_CIPHERTEXT_SIZE
-* Read Only: The cipher-text size in bytes
-*/
-#define KYBER_CIPHERTEXT_SIZE KYBER_INDCPA_BYTES
+		for (i = 0; i < 16; ++i)
+		{
+			r[ctr] = tmp[i];
+			ctr += (mask >> (2 * i)) & 1U;
+		}
 
-/* 2^16 % Q */
-#define KYBER_MONT 2285
+		pos += 32;
+	}
+#endif
 
-/* q^(-1) mod 2^16 */
-#define KYBER_QINV 62209
+	while (ctr < len && pos + 2 <= buflen)
+	{
+		val = buf[pos] | ((uint16_t)buf[pos + 1] << 8U);
+		pos += 2;
 
-/* indcpa.c */
+		if (val < 19 * QSC_KYBER_Q)
+		{
+			// Barrett reduction
+			val -= (val >> 12) * QSC_KYBER_Q;
+			r[ctr] = val;
+			++ctr;
+		}
+	}
 
-static void pack_pk(uint8_t* r, qsc_kyber_polyvec* pk, const uint8_t* seed)
+	return ctr;
+}
+
+static void gen_matrix_resume(qsc_kyber_poly* a, uint32_t ctr, const uint8_t* extseed)
 {
+	uint8_t buf[QSC_KECCAK_128_RATE];
+	qsc_keccak_state kstate;
 	size_t i;
 
-	qsc_kyber_polyvec_tobytes(r, pk);
+	/* the batched squeeze ran short; regenerate the lane and continue its stream one block at a time */
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		kstate.state[i] = 0;
+	}
 
-	for (i = 0; i < QSC_KYBER_SYMBYTES; ++i)
+	qsc_shake_initialize(&kstate, keccak_rate_128, extseed, QSC_KYBER_SYMBYTES + 2);
+
+	for (i = 0; i < KYBER_GEN_MATRIX_NBLOCKS; ++i)
+	{
+		qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, 1);
+	}
+
+	while (ctr < QSC_KYBER_N)
 	{
-		r[i + KYBER_POLYVECBYTES] = seed[i];
+		qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, 1);
+		ctr += rej_uniform(a->coeffs + ctr, QSC_KYBER_N - ctr, buf, QSC_KECCAK_128_RATE);
 	}
 }
 
-static void unpack_pk(qsc_kyber_polyvec* pk, uint8_t* seed, const uint8_t* packedpk)
+static void getnoise_batch(qsc_kyber_poly** r, size_t count, const uint8_t* seed, uint8_t nonce)
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_kyber_poly tmp[2];
+#endif
 	size_t i;
 
-	qsc_kyber_polyvec_frombytes(pk, packedpk);
+	/* polynomials are drawn four per SHAKE-256 pass with consecutive nonces */
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		qsc_kyber_poly_getnoise4(r[i], r[i + 1], r[i + 2], r[i + 3], seed, nonce, (uint8_t)(nonce + 1), (uint8_t)(nonce + 2), (uint8_t)(nonce + 3));
+		nonce += 4;
+	}
 
-	for (i = 0; i < QSC_KYBER_SYMBYTES; ++i)
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	/* a vector pass costs less than two single lanes, so pad a short tail with scratch outputs */
+	if (count - i > 1)
+	{
+		qsc_kyber_poly_getnoise4(r[i], r[i + 1], (count - i > 2) ? r[i + 2] : &tmp[0], &tmp[1],
+			seed, nonce, (uint8_t)(nonce + 1), (uint8_t)(nonce + 2), (uint8_t)(nonce + 3));
+		i = count;
+	}
+#endif
+
+	for (; i < count; ++i)
 	{
-		seed[i] = packedpk[i + KYBER_POLYVECBYTES];
+		qsc_kyber_poly_getnoise(r[i], seed, nonce);
+		++nonce;
 	}
 }
 
-static void pack_sk(uint8_t* r, qsc_kyber_polyvec* sk)
+/* qsc_kyber_ntt.c */
+
+int16_t qsc_kyber_zetas[128] =
+{
+	0x08EDU, 0x0A0BU, 0x0B9AU, 0x0714U, 0x05D5U, 0x058EU, 0x011FU, 0x00CAU, 0x0C56U, 0x026EU, 0x0629U, 0x00B6U, 0x03C2U, 0x084FU, 0x073FU, 0x05BCU,
+	0x023DU, 0x07D4U, 0x0108U, 0x017FU, 0x09C4U, 0x05B2U, 0x06BFU, 0x0C7FU, 0x0A58U, 0x03F9U, 0x02DCU, 0x0260U, 0x06FBU, 0x019BU, 0x0C34U, 0x06DEU,
+	0x04C7U, 0x028CU, 0x0AD9U, 0x03F7U, 0x07F4U, 0x05D3U, 0x0BE7U, 0x06F9U, 0x0204U, 0x0CF9U, 0x0BC1U, 0x0A67U, 0x06AFU, 0x0877U, 0x007EU, 0x05BDU,
+	0x09ACU, 0x0CA7U, 0x0BF2U, 0x033EU, 0x006BU, 0x0774U, 0x0C0AU, 0x094AU, 0x0B73U, 0x03C1U, 0x071DU, 0x0A2CU, 0x01C0U, 0x08D8U, 0x02A5U, 0x0806U,
+	0x08B2U, 0x01AEU, 0x022BU, 0x034BU, 0x081EU, 0x0367U, 0x060EU, 0x0069U, 0x01A6U, 0x024BU, 0x00B1U, 0x0C16U, 0x0BDEU, 0x0B35U, 0x0626U, 0x0675U,
+	0x0C0BU, 0x030AU, 0x0487U, 0x0C6EU, 0x09F8U, 0x05CBU, 0x0AA7U, 0x045FU, 0x06CBU, 0x0284U, 0x0999U, 0x015DU, 0x01A2U, 0x0149U, 0x0C65U, 0x0CB6U,
+	0x0331U, 0x0449U, 0x025BU, 0x0262U, 0x052AU, 0x07FCU, 0x0748U, 0x0180U, 0x0842U, 0x0C79U, 0x04C2U, 0x07CAU, 0x0997U, 0x00DCU, 0x085EU, 0x0686U,
+	0x0860U, 0x0707U, 0x0803U, 0x031AU, 0x071BU, 0x09ABU, 0x099BU, 0x01DEU, 0x0C95U, 0x0BCDU, 0x03E4U, 0x03DFU, 0x03BEU, 0x074DU, 0x05F2U, 0x065CU
+};
+
+int16_t zetas_inv[128] =
+{
+	0x06A5U, 0x070FU, 0x05B4U, 0x0943U, 0x0922U, 0x091DU, 0x0134U, 0x006CU, 0x0B23U, 0x0366U, 0x0356U, 0x05E6U, 0x09E7U, 0x04FEU, 0x05FAU, 0x04A1U,
+	0x067BU, 0x04A3U, 0x0C25U, 0x036AU, 0x0537U, 0x083FU, 0x0088U, 0x04BFU, 0x0B81U, 0x05B9U, 0x0505U, 0x07D7U, 0x0A9FU, 0x0AA6U, 0x08B8U, 0x09D0U,
+	0x004BU, 0x009CU, 0x0BB8U, 0x0B5FU, 0x0BA4U, 0x0368U, 0x0A7DU, 0x0636U, 0x08A2U, 0x025AU, 0x0736U, 0x0309U, 0x0093U, 0x087AU, 0x09F7U, 0x00F6U,
+	0x068CU, 0x06DBU, 0x01CCU, 0x0123U, 0x00EBU, 0x0C50U, 0x0AB6U, 0x0B5BU, 0x0C98U, 0x06F3U, 0x099AU, 0x04E3U, 0x09B6U, 0x0AD6U, 0x0B53U, 0x044FU,
+	0x04FBU, 0x0A5CU, 0x0429U, 0x0B41U, 0x02D5U, 0x05E4U, 0x0940U, 0x018EU, 0x03B7U, 0x00F7U, 0x058DU, 0x0C96U, 0x09C3U, 0x010FU, 0x005AU, 0x0355U,
+	0x0744U, 0x0C83U, 0x048AU, 0x0652U, 0x029AU, 0x0140U, 0x0008U, 0x0AFDU, 0x0608U, 0x011AU, 0x072EU, 0x050DU, 0x090AU, 0x0228U, 0x0A75U, 0x083AU,
+	0x0623U, 0x00CDU, 0x0B66U, 0x0606U, 0x0AA1U, 0x0A25U, 0x0908U, 0x02A9U, 0x0082U, 0x0642U, 0x074FU, 0x033DU, 0x0B82U, 0x0BF9U, 0x052DU, 0x0AC4U,
+	0x0745U, 0x05C2U, 0x04B2U, 0x093FU, 0x0C4BU, 0x06D8U, 0x0A93U, 0x00ABU, 0x0C37U, 0x0BE2U, 0x0773U, 0x072CU, 0x05EDU, 0x0167U, 0x02F6U, 0x05A1U
+};
+
+static int16_t fqmul(int16_t a, int16_t b)
 {
-	qsc_kyber_polyvec_tobytes(r, sk);
+	return qsc_kyber_montgomery_reduce((int32_t)a * b);
 }
 
-static void unpack_sk(qsc_kyber_polyvec* sk, const uint8_t* packedsk)
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static __m256i kyber_fqmul_avx2(__m256i a, __m256i b)
 {
-	qsc_kyber_polyvec_frombytes(sk, packedsk);
+	const __m256i q = _mm256_set1_epi16(QSC_KYBER_Q);
+	const __m256i qinv = _mm256_set1_epi16((int16_t)KYBER_QINV);
+	__m256i hi;
+	__m256i lo;
+
+	/* Montgomery reduction on the split product; the low halves cancel exactly */
+	lo = _mm256_mullo_epi16(a, b);
+	hi = _mm256_mulhi_epi16(a, b);
+	lo = _mm256_mullo_epi16(lo, qinv);
+	lo = _mm256_mulhi_epi16(lo, q);
+
+	return _mm256_sub_epi16(hi, lo);
 }
 
-static void pack_ciphertext(uint8_t* r, qsc_kyber_polyvec* b, qsc_kyber_poly *v)
+static __m256i kyber_barrett_avx2(__m256i a)
 {
-	qsc_kyber_polyvec_compress(r, b);
-	qsc_kyber_poly_compress(r + KYBER_POLYVECCOMPRESSEDBYTES, v);
+	const __m256i q = _mm256_set1_epi16(QSC_KYBER_Q);
+	const __m256i v = _mm256_set1_epi16((int16_t)((1U << 26) / QSC_KYBER_Q + 1));
+	__m256i t;
+
+	/* (a * v) >> 26 taken as the high product half shifted by 10 */
+	t = _mm256_mulhi_epi16(a, v);
+	t = _mm256_srai_epi16(t, 10);
+	t = _mm256_mullo_epi16(t, q);
+
+	return _mm256_sub_epi16(a, t);
 }
 
-static void unpack_ciphertext(qsc_kyber_polyvec* b, qsc_kyber_poly *v, const uint8_t* c)
+static void kyber_ntt_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta)
 {
-	qsc_kyber_polyvec_decompress(b, c);
-	qsc_kyber_poly_decompress(v, c + KYBER_POLYVECCOMPRESSEDBYTES);
+	__m256i t;
+
+	t = kyber_fqmul_avx2(zeta, *b);
+	*b = _mm256_sub_epi16(*a, t);
+	*a = _mm256_add_epi16(*a, t);
 }
 
-static uint32_t rej_uniform(uint16_t *r, uint32_t len, const uint8_t* buf, uint32_t buflen)
+static void kyber_invntt_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta)
 {
-	uint32_t ctr;
-	uint32_t pos;
-	uint16_t val;
+	__m256i t;
 
-	ctr = 0;
-	pos = 0;
+	t = *a;
+	*a = kyber_barrett_avx2(_mm256_add_epi16(t, *b));
+	*b = kyber_fqmul_avx2(zeta, _mm256_sub_epi16(t, *b));
+}
 
-	while (ctr < len && pos + 2 <= buflen)
-	{
-		val = buf[pos] | ((uint16_t)buf[pos + 1] << 8U);
-		pos += 2;
+static void kyber_interleave8_avx2(__m256i* a, __m256i* b)
+{
+	__m256i t;
 
-		if (val < 19 * QSC_KYBER_Q)
-		{
-			// Barrett reduction
-			val -= (val >> 12) * QSC_KYBER_Q;
-			r[ctr] = val;
-			++ctr;
-		}
-	}
+	/* swap the upper half of a with the lower half of b; self-inverse */
+	t = *a;
+	*a = _mm256_permute2x128_si256(t, *b, 0x20);
+	*b = _mm256_permute2x128_si256(t, *b, 0x31);
+}
 
-	return ctr;
+static void kyber_interleave4_avx2(__m256i* a, __m256i* b)
+{
+	__m256i t;
+
+	/* swap the odd 64-bit words of a with the even words of b; self-inverse */
+	t = *a;
+	*a = _mm256_unpacklo_epi64(t, *b);
+	*b = _mm256_unpackhi_epi64(t, *b);
 }
 
-void gen_matrix(qsc_kyber_polyvec* a, const uint8_t* seed, int32_t transposed)
+static __m256i kyber_zetas8_avx2(const int16_t* zetas)
 {
-	/* 530 is expected number of required bytes */
-	const uint32_t maxnblocks = (530 + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE;
-	uint8_t buf[QSC_KECCAK_128_RATE * ((530 + QSC_KECCAK_128_RATE) / QSC_KECCAK_128_RATE) + 1];
-	qsc_keccak_state kstate;
-	uint8_t extseed[QSC_KYBER_SYMBYTES + 2];
-	size_t i;
-	size_t j;
-	size_t k;
-	uint32_t ctr;
+	/* one zeta per 128-bit lane */
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi16(zetas[0])), _mm_set1_epi16(zetas[1]), 1);
+}
 
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		for (j = 0; j < QSC_KYBER_K; ++j)
-		{
+static __m256i kyber_zetas4_avx2(const int16_t* zetas)
+{
+	/* zeta order matches the lane layout produced by kyber_interleave4_avx2 */
+	const __m256i idx = _mm256_setr_epi8(
+		0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5,
+		2, 3, 2, 3, 2, 3, 2, 3, 6, 7, 6, 7, 6, 7, 6, 7);
+	__m256i z;
 
-			for (k = 0; k < QSC_KYBER_SYMBYTES; ++k)
-			{
-				extseed[k] = seed[k];
-			}
+	z = _mm256_broadcastsi128_si256(_mm_loadl_epi64((const __m128i*)zetas));
 
-			if (transposed)
-			{
-				extseed[k] = (uint8_t)i;
-				++k;
-				extseed[k] = (uint8_t)j;
-			}
-			else
-			{
-				extseed[k] = (uint8_t)j;
-				++k;
-				extseed[k] = (uint8_t)i;
-			}
+	return _mm256_shuffle_epi8(z, idx);
+}
 
-			for (k = 0; k < QSC_KECCAK_STATE_SIZE; ++k)
-			{
-				kstate.state[k] = 0;
-			}
+static __m256i kyber_zetas2_avx2(const int16_t* zetas)
+{
+	/* zeta order matches the 32-bit word layout of a shuffled kyber_interleave4_avx2 */
+	const __m256i idx = _mm256_setr_epi8(
+		0, 1, 0, 1, 2, 3, 2, 3, 8, 9, 8, 9, 10, 11, 10, 11,
+		4, 5, 4, 5, 6, 7, 6, 7, 12, 13, 12, 13, 14, 15, 14, 15);
+	__m256i z;
 
-			qsc_shake_initialize(&kstate, keccak_rate_128, extseed, QSC_KYBER_SYMBYTES + 2);
-			qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, maxnblocks);
-			ctr = rej_uniform(a[i].vec[j].coeffs, QSC_KYBER_N, buf, maxnblocks * QSC_KECCAK_128_RATE);
+	z = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)zetas));
 
-			while (ctr < QSC_KYBER_N)
-			{
-				qsc_shake_squeezeblocks(&kstate, keccak_rate_128, buf, 1);
-				ctr += rej_uniform(a[i].vec[j].coeffs + ctr, QSC_KYBER_N - ctr, buf, QSC_KECCAK_128_RATE);
-			}
-		}
-	}
+	return _mm256_shuffle_epi8(z, idx);
 }
 
-void qsc_kyber_indcpa_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
+static void kyber_ntt_avx2(uint16_t* r)
 {
-	qsc_kyber_polyvec a[QSC_KYBER_K];
-	qsc_kyber_polyvec e;
-	qsc_kyber_polyvec pkpv;
-	qsc_kyber_polyvec skpv;
-	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
-	const uint8_t* publicseed = buf;
-	const uint8_t* noiseseed = buf + QSC_KYBER_SYMBYTES;
+	__m256i a[QSC_KYBER_N / 16];
+	__m256i z;
 	size_t i;
-	uint8_t nonce;
-
-	nonce = 0;
-	rng_generate(buf, QSC_KYBER_SYMBYTES);
-	qsc_sha3_compute512(buf, buf, QSC_KYBER_SYMBYTES);
-
-	gen_matrix(a, publicseed, 0);
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t start;
 
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_getnoise(skpv.vec + i, noiseseed, nonce);
-		++nonce;
-	}
-	for (i = 0; i < QSC_KYBER_K; ++i)
+	for (i = 0; i < QSC_KYBER_N / 16; ++i)
 	{
-		qsc_kyber_poly_getnoise(e.vec + i, noiseseed, nonce);
-		++nonce;
+		a[i] = _mm256_loadu_si256((const __m256i*)(r + (i * 16)));
 	}
 
-	qsc_kyber_polyvec_ntt(&skpv);
-	qsc_kyber_polyvec_ntt(&e);
+	k = 1;
 
-	/* matrix-vector multiplication */
-	for (i = 0; i < QSC_KYBER_K; ++i)
+	/* butterfly distances of 128 to 16 coefficients span whole vectors */
+	for (len = 8; len >= 1; len >>= 1)
 	{
-		qsc_kyber_polyvec_pointwise_acc(&pkpv.vec[i], &a[i], &skpv);
-		qsc_kyber_poly_frommont(&pkpv.vec[i]);
+		for (start = 0; start < QSC_KYBER_N / 16; start += 2 * len)
+		{
+			z = _mm256_set1_epi16(qsc_kyber_zetas[k]);
+			++k;
+
+			for (j = start; j < start + len; ++j)
+			{
+				kyber_ntt_butterfly_avx2(&a[j], &a[j + len], z);
+			}
+		}
 	}
 
-	qsc_kyber_polyvec_add(&pkpv, &pkpv, &e);
-	qsc_kyber_polyvec_reduce(&pkpv);
+	/* distances of 8, 4 and 2 coefficients regroup vector pairs so butterfly partners align */
+	for (i = 0; i < QSC_KYBER_N / 16; i += 2)
+	{
+		kyber_interleave8_avx2(&a[i], &a[i + 1]);
+		kyber_ntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas8_avx2(qsc_kyber_zetas + 16 + i));
+		kyber_interleave8_avx2(&a[i], &a[i + 1]);
 
-	pack_sk(sk, &skpv);
-	pack_pk(pk, &pkpv, publicseed);
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		kyber_ntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas4_avx2(qsc_kyber_zetas + 32 + (2 * i)));
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		kyber_ntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas2_avx2(qsc_kyber_zetas + 64 + (4 * i)));
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+
+		_mm256_storeu_si256((__m256i*)(r + (i * 16)), a[i]);
+		_mm256_storeu_si256((__m256i*)(r + ((i + 1) * 16)), a[i + 1]);
+	}
 }
 
-void qsc_kyber_indcpa_enc(uint8_t* c, const uint8_t* m, const uint8_t* pk, const uint8_t* coins)
+static void kyber_invntt_avx2(uint16_t* r)
 {
-	uint8_t seed[QSC_KYBER_SYMBYTES];
-	qsc_kyber_polyvec at[QSC_KYBER_K];
-	qsc_kyber_polyvec bp;
-	qsc_kyber_polyvec sp;
-	qsc_kyber_polyvec pkpv;
-	qsc_kyber_polyvec ep;
-	qsc_kyber_poly k;
-	qsc_kyber_poly epp;
-	qsc_kyber_poly v;
+	__m256i a[QSC_KYBER_N / 16];
+	__m256i z;
 	size_t i;
-	uint8_t nonce;
-
-	nonce = 0;
-	unpack_pk(&pkpv, seed, pk);
-	qsc_kyber_poly_frommsg(&k, m);
-	gen_matrix(at, seed, 1);
+	size_t j;
+	size_t k;
+	size_t len;
+	size_t start;
 
-	for (i = 0; i < QSC_KYBER_K; ++i)
+	for (i = 0; i < QSC_KYBER_N / 16; i += 2)
 	{
-		qsc_kyber_poly_getnoise(sp.vec + i, coins, nonce);
-		++nonce;
-	}
+		a[i] = _mm256_loadu_si256((const __m256i*)(r + (i * 16)));
+		a[i + 1] = _mm256_loadu_si256((const __m256i*)(r + ((i + 1) * 16)));
 
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_getnoise(ep.vec + i, coins, nonce);
-		++nonce;
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		kyber_invntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas2_avx2(zetas_inv + (4 * i)));
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		a[i] = _mm256_shuffle_epi32(a[i], 0xD8);
+		a[i + 1] = _mm256_shuffle_epi32(a[i + 1], 0xD8);
+
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+		kyber_invntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas4_avx2(zetas_inv + 64 + (2 * i)));
+		kyber_interleave4_avx2(&a[i], &a[i + 1]);
+
+		kyber_interleave8_avx2(&a[i], &a[i + 1]);
+		kyber_invntt_butterfly_avx2(&a[i], &a[i + 1], kyber_zetas8_avx2(zetas_inv + 96 + i));
+		kyber_interleave8_avx2(&a[i], &a[i + 1]);
 	}
 
-	qsc_kyber_poly_getnoise(&epp, coins, nonce++);
-	qsc_kyber_polyvec_ntt(&sp);
+	k = 112;
 
-	/* matrix-vector multiplication */
-	for (i = 0; i < QSC_KYBER_K; ++i)
+	for (len = 1; len <= 8; len <<= 1)
 	{
-		qsc_kyber_polyvec_pointwise_acc(&bp.vec[i], &at[i], &sp);
-	}
+		for (start = 0; start < QSC_KYBER_N / 16; start += 2 * len)
+		{
+			z = _mm256_set1_epi16(zetas_inv[k]);
+			++k;
 
-	qsc_kyber_polyvec_pointwise_acc(&v, &pkpv, &sp);
-	qsc_kyber_polyvec_invntt(&bp);
-	qsc_kyber_poly_invntt(&v);
+			for (j = start; j < start + len; ++j)
+			{
+				kyber_invntt_butterfly_avx2(&a[j], &a[j + len], z);
+			}
+		}
+	}
 
-	qsc_kyber_polyvec_add(&bp, &bp, &ep);
-	qsc_kyber_poly_add(&v, &v, &epp);
-	qsc_kyber_poly_add(&v, &v, &k);
-	qsc_kyber_polyvec_reduce(&bp);
-	qsc_kyber_poly_reduce(&v);
+	z = _mm256_set1_epi16(zetas_inv[127]);
 
-	pack_ciphertext(c, &bp, &v);
+	for (i = 0; i < QSC_KYBER_N / 16; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)(r + (i * 16)), kyber_fqmul_avx2(a[i], z));
+	}
 }
 
-void qsc_kyber_indcpa_dec(uint8_t* m, const uint8_t* c, const uint8_t* sk)
+static __m256i kyber_basemul_zetas_avx2(const int16_t* zetas)
 {
-	qsc_kyber_polyvec bp;
-	qsc_kyber_polyvec skpv;
-	qsc_kyber_poly v;
-	qsc_kyber_poly mp;
-
-	unpack_ciphertext(&bp, &v, c);
-	unpack_sk(&skpv, sk);
-
-	qsc_kyber_polyvec_ntt(&bp);
-	qsc_kyber_polyvec_pointwise_acc(&mp, &skpv, &bp);
-	qsc_kyber_poly_invntt(&mp);
+	/* zeta and -zeta on the odd coefficient of each pair, zero on the even */
+	const __m256i idx = _mm256_setr_epi8(
+		0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3,
+		4, 5, 4, 5, 4, 5, 4, 5, 6, 7, 6, 7, 6, 7, 6, 7);
+	const __m256i sgn = _mm256_setr_epi16(0, 1, 0, -1, 0, 1, 0, -1, 0, 1, 0, -1, 0, 1, 0, -1);
+	__m256i z;
 
-	qsc_kyber_poly_sub(&mp, &v, &mp);
-	qsc_kyber_poly_reduce(&mp);
+	z = _mm256_broadcastsi128_si256(_mm_loadl_epi64((const __m128i*)zetas));
+	z = _mm256_shuffle_epi8(z, idx);
 
-	qsc_kyber_poly_tomsg(m, &mp);
+	return _mm256_sign_epi16(z, sgn);
 }
 
-/* kem.h */
-
-void qsc_kyber_crypto_kem_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
+static __m256i kyber_basemul_avx2(__m256i a, __m256i b, __m256i zeta)
 {
-	size_t i;
+	__m256i p;
+	__m256i q;
+	__m256i r0;
+	__m256i r1;
 
-	qsc_kyber_indcpa_keypair(pk, sk, rng_generate);
+	/* p = (a0b0, a1b1), q = (a0b1, a1b0) for each coefficient pair */
+	p = kyber_fqmul_avx2(a, b);
+	b = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(b, 0xB1), 0xB1);
+	q = kyber_fqmul_avx2(a, b);
 
-	for (i = 0; i < KYBER_INDCPA_PUBLICKEYBYTES; ++i)
-	{
-		sk[i + KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
-	}
+	/* r0 = a1b1 * zeta + a0b0 in the even lanes, r1 = a0b1 + a1b0 in the odd lanes */
+	r0 = _mm256_add_epi16(p, _mm256_srli_epi32(kyber_fqmul_avx2(p, zeta), 16));
+	r1 = _mm256_add_epi16(q, _mm256_slli_epi32(q, 16));
 
-	qsc_sha3_compute256(sk + KYBER_SECRETKEY_SIZE - 2 * QSC_KYBER_SYMBYTES, pk, KYBER_PUBLICKEY_SIZE);
-	/* Value z for pseudo-random output on reject */
-	rng_generate(sk + KYBER_SECRETKEY_SIZE - QSC_KYBER_SYMBYTES, QSC_KYBER_SYMBYTES);
+	return _mm256_blend_epi16(r0, r1, 0xAA);
 }
 
-void qsc_kyber_crypto_kem_enc(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t))
-{
-	/* Will contain key, coins */
-	uint8_t  kr[2 * QSC_KYBER_SYMBYTES];
-	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
-
-	rng_generate(buf, QSC_KYBER_SYMBYTES);
-	/* Don't release system RNG output */
-	qsc_sha3_compute256(buf, buf, QSC_KYBER_SYMBYTES);
-	/* Multitarget countermeasure for coins + contributory KEM */
-	qsc_sha3_compute256(buf + QSC_KYBER_SYMBYTES, pk, KYBER_PUBLICKEY_SIZE);
-	qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
-	/* coins are in kr+QSC_KYBER_SYMBYTES */
-	qsc_kyber_indcpa_enc(ct, buf, pk, kr + QSC_KYBER_SYMBYTES);
-	/* overwrite coins in kr with H(c) */
-	qsc_sha3_compute256(kr + QSC_KYBER_SYMBYTES, ct, KYBER_CIPHERTEXT_SIZE);
-	/* hash concatenation of pre-k and H(c) to k */
-	qsc_shake256_compute(ss, QSC_KYBER_SYMBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
-}
+#endif
 
-bool qsc_kyber_crypto_kem_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk)
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static __m512i kyber_fqmul_avx512(__m512i a, __m512i b)
 {
-	uint8_t cmp[KYBER_CIPHERTEXT_SIZE];
-	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
-	/* Will contain key, coins */
-	uint8_t kr[2 * QSC_KYBER_SYMBYTES];
-	const uint8_t* pk = sk + KYBER_INDCPA_SECRETKEYBYTES;
-	size_t i;
-	int32_t fail;
+	const __m512i q = _mm512_set1_epi16(QSC_KYBER_Q);
+	const __m512i qinv = _mm512_set1_epi16((int16_t)KYBER_QINV);
+	__m512i hi;
+	__m512i lo;
 
-	qsc_kyber_indcpa_dec(buf, ct, sk);
+	lo = _mm512_mullo_epi16(a, b);
+	hi = _mm512_mulhi_epi16(a, b);
+	lo = _mm512_mullo_epi16(lo, qinv);
+	lo = _mm512_mulhi_epi16(lo, q);
 
-	/* Multitarget countermeasure for coins + contributory KEM */
-	for (i = 0; i < QSC_KYBER_SYMBYTES; ++i)
-	{
-		/* Save hash by storing H(pk) in sk */
-		buf[QSC_KYBER_SYMBYTES + i] = sk[(KYBER_SECRETKEY_SIZE - (2 * QSC_KYBER_SYMBYTES)) + i];
-	}
+	return _mm512_sub_epi16(hi, lo);
+}
 
-	qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
-	/* coins are in kr+QSC_KYBER_SYMBYTES */
-	qsc_kyber_indcpa_enc(cmp, buf, pk, kr + QSC_KYBER_SYMBYTES);
+static __m512i kyber_barrett_avx512(__m512i a)
+{
+	const __m512i q = _mm512_set1_epi16(QSC_KYBER_Q);
+	const __m512i v = _mm512_set1_epi16((int16_t)((1U << 26) / QSC_KYBER_Q + 1));
+	__m512i t;
 
-	fail = qsc_intutils_verify(ct, cmp, KYBER_CIPHERTEXT_SIZE);
-	/* overwrite coins in kr with H(c) */
-	qsc_sha3_compute256(kr + QSC_KYBER_SYMBYTES, ct, KYBER_CIPHERTEXT_SIZE);
-	/* Overwrite pre-k with z on re-encryption failure */
-	qsc_intutils_cmov(kr, sk + KYBER_SECRETKEY_SIZE - QSC_KYBER_SYMBYTES, QSC_KYBER_SYMBYTES, (uint8_t)fail);
-	/* hash concatenation of pre-k and H(c) to k */
-	qsc_shake256_compute(ss, QSC_KYBER_SYMBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+	t = _mm512_mulhi_epi16(a, v);
+	t = _mm512_srai_epi16(t, 10);
+	t = _mm512_mullo_epi16(t, q);
 
-	return (bool)(fail == 0);
+	return _mm512_sub_epi16(a, t);
 }
 
-/* qsc_kyber_ntt.c */
-
-int16_t qsc_kyber_zetas[128] =
+static __m512i kyber_basemul_avx512(__m512i a, __m512i b, __m512i zeta)
 {
-	0x08EDU, 0x0A0BU, 0x0B9AU, 0x0714U, 0x05D5U, 0x058EU, 0x011FU, 0x00CAU, 0x0C56U, 0x026EU, 0x0629U, 0x00B6U, 0x03C2U, 0x084FU, 0x073FU, 0x05BCU,
-	0x023DU, 0x07D4U, 0x0108U, 0x017FU, 0x09C4U, 0x05B2U, 0x06BFU, 0x0C7FU, 0x0A58U, 0x03F9U, 0x02DCU, 0x0260U, 0x06FBU, 0x019BU, 0x0C34U, 0x06DEU,
-	0x04C7U, 0x028CU, 0x0AD9U, 0x03F7U, 0x07F4U, 0x05D3U, 0x0BE7U, 0x06F9U, 0x0204U, 0x0CF9U, 0x0BC1U, 0x0A67U, 0x06AFU, 0x0877U, 0x007EU, 0x05BDU,
-	0x09ACU, 0x0CA7U, 0x0BF2U, 0x033EU, 0x006BU, 0x0774U, 0x0C0AU, 0x094AU, 0x0B73U, 0x03C1U, 0x071DU, 0x0A2CU, 0x01C0U, 0x08D8U, 0x02A5U, 0x0806U,
-	0x08B2U, 0x01AEU, 0x022BU, 0x034BU, 0x081EU, 0x0367U, 0x060EU, 0x0069U, 0x01A6U, 0x024BU, 0x00B1U, 0x0C16U, 0x0BDEU, 0x0B35U, 0x0626U, 0x0675U,
-	0x0C0BU, 0x030AU, 0x0487U, 0x0C6EU, 0x09F8U, 0x05CBU, 0x0AA7U, 0x045FU, 0x06CBU, 0x0284U, 0x0999U, 0x015DU, 0x01A2U, 0x0149U, 0x0C65U, 0x0CB6U,
-	0x0331U, 0x0449U, 0x025BU, 0x0262U, 0x052AU, 0x07FCU, 0x0748U, 0x0180U, 0x0842U, 0x0C79U, 0x04C2U, 0x07CAU, 0x0997U, 0x00DCU, 0x085EU, 0x0686U,
-	0x0860U, 0x0707U, 0x0803U, 0x031AU, 0x071BU, 0x09ABU, 0x099BU, 0x01DEU, 0x0C95U, 0x0BCDU, 0x03E4U, 0x03DFU, 0x03BEU, 0x074DU, 0x05F2U, 0x065CU
-};
+	__m512i p;
+	__m512i q;
+	__m512i r0;
+	__m512i r1;
 
-int16_t zetas_inv[128] =
-{
-	0x06A5U, 0x070FU, 0x05B4U, 0x0943U, 0x0922U, 0x091DU, 0x0134U, 0x006CU, 0x0B23U, 0x0366U, 0x0356U, 0x05E6U, 0x09E7U, 0x04FEU, 0x05FAU, 0x04A1U,
-	0x067BU, 0x04A3U, 0x0C25U, 0x036AU, 0x0537U, 0x083FU, 0x0088U, 0x04BFU, 0x0B81U, 0x05B9U, 0x0505U, 0x07D7U, 0x0A9FU, 0x0AA6U, 0x08B8U, 0x09D0U,
-	0x004BU, 0x009CU, 0x0BB8U, 0x0B5FU, 0x0BA4U, 0x0368U, 0x0A7DU, 0x0636U, 0x08A2U, 0x025AU, 0x0736U, 0x0309U, 0x0093U, 0x087AU, 0x09F7U, 0x00F6U,
-	0x068CU, 0x06DBU, 0x01CCU, 0x0123U, 0x00EBU, 0x0C50U, 0x0AB6U, 0x0B5BU, 0x0C98U, 0x06F3U, 0x099AU, 0x04E3U, 0x09B6U, 0x0AD6U, 0x0B53U, 0x044FU,
-	0x04FBU, 0x0A5CU, 0x0429U, 0x0B41U, 0x02D5U, 0x05E4U, 0x0940U, 0x018EU, 0x03B7U, 0x00F7U, 0x058DU, 0x0C96U, 0x09C3U, 0x010FU, 0x005AU, 0x0355U,
-	0x0744U, 0x0C83U, 0x048AU, 0x0652U, 0x029AU, 0x0140U, 0x0008U, 0x0AFDU, 0x0608U, 0x011AU, 0x072EU, 0x050DU, 0x090AU, 0x0228U, 0x0A75U, 0x083AU,
-	0x0623U, 0x00CDU, 0x0B66U, 0x0606U, 0x0AA1U, 0x0A25U, 0x0908U, 0x02A9U, 0x0082U, 0x0642U, 0x074FU, 0x033DU, 0x0B82U, 0x0BF9U, 0x052DU, 0x0AC4U,
-	0x0745U, 0x05C2U, 0x04B2U, 0x093FU, 0x0C4BU, 0x06D8U, 0x0A93U, 0x00ABU, 0x0C37U, 0x0BE2U, 0x0773U, 0x072CU, 0x05EDU, 0x0167U, 0x02F6U, 0x05A1U
-};
+	p = kyber_fqmul_avx512(a, b);
+	b = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(b, 0xB1), 0xB1);
+	q = kyber_fqmul_avx512(a, b);
 
-static int16_t fqmul(int16_t a, int16_t b)
-{
-	return qsc_kyber_montgomery_reduce((int32_t)a * b);
+	r0 = _mm512_add_epi16(p, _mm512_srli_epi32(kyber_fqmul_avx512(p, zeta), 16));
+	r1 = _mm512_add_epi16(q, _mm512_slli_epi32(q, 16));
+
+	return _mm512_mask_blend_epi16(0xAAAAAAAAUL, r0, r1);
 }
 
+#endif
+
 void qsc_kyber_ntt(uint16_t* r)
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	kyber_ntt_avx2(r);
+#else
 	uint32_t j;
 	uint32_t k;
 	uint32_t len;
@@ -485,10 +532,14 @@ void qsc_kyber_ntt(uint16_t* r)
 			}
 		}
 	}
+#endif
 }
 
 void qsc_kyber_invntt(uint16_t* r)
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	kyber_invntt_avx2(r);
+#else
 	uint32_t j;
 	uint32_t k;
 	uint32_t len;
@@ -519,6 +570,7 @@ void qsc_kyber_invntt(uint16_t* r)
 	{
 		r[j] = (uint16_t)fqmul((int16_t)r[j], zetas_inv[127]);
 	}
+#endif
 }
 
 void qsc_kyber_basemul(uint16_t r[2], const uint16_t a[2], const uint16_t b[2], int16_t zeta)
@@ -534,6 +586,41 @@ void qsc_kyber_basemul(uint16_t r[2], const uint16_t a[2], const uint16_t b[2],
 
 void qsc_kyber_cbd(qsc_kyber_poly* r, const uint8_t* buf)
 {
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	const __m256i m55 = _mm256_set1_epi8(0x55);
+	const __m256i m33 = _mm256_set1_epi8(0x33);
+	const __m256i m0f = _mm256_set1_epi8(0x0F);
+	const __m256i m03 = _mm256_set1_epi8(0x03);
+	__m256i f0;
+	__m256i f1;
+	__m256i hi;
+	__m256i lo;
+	size_t i;
+
+	/* 32 bytes give 64 coefficients, one coefficient per nibble */
+	for (i = 0; i < QSC_KYBER_N / 64; ++i)
+	{
+		f0 = _mm256_loadu_si256((const __m256i*)(buf + (i * 32)));
+		f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 1), m55);
+		f0 = _mm256_add_epi8(_mm256_and_si256(f0, m55), f1);
+
+		/* a - b + 3 in each nibble, kept positive so no borrow crosses a nibble */
+		f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 2), m33);
+		f0 = _mm256_and_si256(f0, m33);
+		f0 = _mm256_sub_epi8(_mm256_add_epi8(f0, m33), f1);
+
+		/* low nibbles are the even coefficients, high nibbles the odd */
+		f1 = _mm256_sub_epi8(_mm256_and_si256(_mm256_srli_epi16(f0, 4), m0f), m03);
+		f0 = _mm256_sub_epi8(_mm256_and_si256(f0, m0f), m03);
+		lo = _mm256_unpacklo_epi8(f0, f1);
+		hi = _mm256_unpackhi_epi8(f0, f1);
+
+		_mm256_storeu_si256((__m256i*)(r->coeffs + (i * 64)), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(lo)));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + (i * 64) + 16), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(hi)));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + (i * 64) + 32), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(lo, 1)));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + (i * 64) + 48), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(hi, 1)));
+	}
+#else
 	uint32_t d;
 	uint32_t t;
 	int16_t a;
@@ -554,108 +641,6 @@ void qsc_kyber_cbd(qsc_kyber_poly* r, const uint8_t* buf)
 			r->coeffs[(8 * i) + j] = (uint16_t)(a - b);
 		}
 	}
-}
-
-void qsc_kyber_poly_compress(uint8_t* r, qsc_kyber_poly* a)
-{
-	uint8_t t[8];
-	size_t i;
-	size_t j;
-	size_t k;
-
-	k = 0;
-	qsc_kyber_poly_csubq(a);
-
-#if (KYBER_POLYCOMPRESSEDBYTES == 96)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		for (j = 0; j < 8; ++j)
-		{
-			t[j] = ((((uint32_t)a->coeffs[i + j] << 3U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 7U;
-		}
-
-		r[k] = t[0] | (t[1] << 3U) | (t[2] << 6U);
-		r[k + 1] = (t[2] >> 2U) | (t[3] << 1U) | (t[4] << 4U) | (t[5] << 7U);
-		r[k + 2] = (t[5] >> 1U) | (t[6] << 2U) | (t[7] << 5U);
-		k += 3;
-	}
-#elif (KYBER_POLYCOMPRESSEDBYTES == 128)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		for (j = 0; j < 8; ++j)
-		{
-			/* jgu -false possible overflow */
-			/*lint -e661 -e662 */
-			t[j] = ((((uint32_t)a->coeffs[i + j] << 4U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 15U;
-		}
-
-		r[k] = (uint8_t)(t[0] | (t[1] << 4U));
-		r[k + 1] = (uint8_t)(t[2] | (t[3] << 4U));
-		r[k + 2] = (uint8_t)(t[4] | (t[5] << 4U));
-		r[k + 3] = (uint8_t)(t[6] | (t[7] << 4U));
-		k += 4;
-	}
-#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		for (j = 0; j < 8; ++j)
-		{
-			t[j] = ((((uint32_t)a->coeffs[i + j] << 5U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 31U;
-		}
-
-		r[k] = (uint8_t)(t[0] | (t[1] << 5U));
-		r[k + 1] = (uint8_t)((t[1] >> 3U) | (t[2] << 2U) | (t[3] << 7U));
-		r[k + 2] = (uint8_t)((t[3] >> 1U) | (t[4] << 4U));
-		r[k + 3] = (uint8_t)((t[4] >> 4U) | (t[5] << 1U) | (t[6] << 6U));
-		r[k + 4] = (uint8_t)((t[6] >> 2U) | (t[7] << 3U));
-		k += 5;
-	}
-#endif
-}
-
-void qsc_kyber_poly_decompress(qsc_kyber_poly* r, const uint8_t* a)
-{
-	size_t i;
-
-#if (KYBER_POLYCOMPRESSEDBYTES == 96)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		r->coeffs[i] = (((a[0] & 7U) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 1] = ((((a[0] >> 3U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 2] = ((((a[0] >> 6U) | ((a[1] << 2U) & 4U)) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 3] = ((((a[1] >> 1U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 4] = ((((a[1] >> 4U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 5] = ((((a[1] >> 7U) | ((a[2] << 1U) & 6U)) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 6] = ((((a[2] >> 2U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
-		r->coeffs[i + 7] = ((((a[2] >> 5U)) * QSC_KYBER_Q) + 4) >> 3U;
-		a += 3;
-	}
-#elif (KYBER_POLYCOMPRESSEDBYTES == 128)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		r->coeffs[i] = (((a[0] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 1] = (((a[0] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 2] = (((a[1] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 3] = (((a[1] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 4] = (((a[2] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 5] = (((a[2] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 6] = (((a[3] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
-		r->coeffs[i + 7] = (((a[3] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
-		a += 4;
-	}
-#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
-	for (i = 0; i < QSC_KYBER_N; i += 8)
-	{
-		r->coeffs[i] = (((a[0] & 31U) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 1] = ((((a[0] >> 5U) | ((a[1] & 3U) << 3U)) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 2] = ((((a[1] >> 2U) & 31U) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 3] = ((((a[1] >> 7U) | ((a[2] & 15U) << 1U)) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 4] = ((((a[2] >> 4U) | ((a[3] & 1U) << 4U)) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 5] = ((((a[3] >> 1U) & 31U) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 6] = ((((a[3] >> 6U) | ((a[4] & 7U) << 2U)) * QSC_KYBER_Q) + 16) >> 5U;
-		r->coeffs[i + 7] = (((a[4] >> 3U) * QSC_KYBER_Q) + 16) >> 5U;
-		a += 5;
-	}
 #endif
 }
 
@@ -705,6 +690,50 @@ void qsc_kyber_poly_getnoise(qsc_kyber_poly* r, const uint8_t* seed, uint8_t non
 	qsc_kyber_cbd(r, buf);
 }
 
+static void getnoise_x4(qsc_kyber_poly* r0, qsc_kyber_poly* r1, qsc_kyber_poly* r2, qsc_kyber_poly* r3,
+	const uint8_t* seed0, const uint8_t* seed1, const uint8_t* seed2, const uint8_t* seed3,
+	uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3)
+{
+	uint8_t buf[4][QSC_KYBER_ETA * QSC_KYBER_N / 4];
+	uint8_t extkey[4][QSC_KYBER_SYMBYTES + 1];
+
+	qsc_memutils_copy(extkey[0], seed0, QSC_KYBER_SYMBYTES);
+	qsc_memutils_copy(extkey[1], seed1, QSC_KYBER_SYMBYTES);
+	qsc_memutils_copy(extkey[2], seed2, QSC_KYBER_SYMBYTES);
+	qsc_memutils_copy(extkey[3], seed3, QSC_KYBER_SYMBYTES);
+
+	extkey[0][QSC_KYBER_SYMBYTES] = nonce0;
+	extkey[1][QSC_KYBER_SYMBYTES] = nonce1;
+	extkey[2][QSC_KYBER_SYMBYTES] = nonce2;
+	extkey[3][QSC_KYBER_SYMBYTES] = nonce3;
+
+	shake256x4(buf[0], buf[1], buf[2], buf[3], sizeof(buf[0]), extkey[0], extkey[1], extkey[2], extkey[3], sizeof(extkey[0]));
+
+	qsc_kyber_cbd(r0, buf[0]);
+	qsc_kyber_cbd(r1, buf[1]);
+	qsc_kyber_cbd(r2, buf[2]);
+	qsc_kyber_cbd(r3, buf[3]);
+}
+
+void qsc_kyber_poly_getnoise4(qsc_kyber_poly* r0, qsc_kyber_poly* r1, qsc_kyber_poly* r2, qsc_kyber_poly* r3,
+	const uint8_t* seed, uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3)
+{
+	getnoise_x4(r0, r1, r2, r3, seed, seed, seed, seed, nonce0, nonce1, nonce2, nonce3);
+}
+
+/* draws count polynomials for each of four seeds, one SHAKE-256 pass per nonce across the seeds;
+lane l receives r[(l * count) + j] with nonce j, identical to getnoise_batch over that seed alone */
+static void getnoise_lanes4(qsc_kyber_poly** r, size_t count, const uint8_t* seed0, const uint8_t* seed1, const uint8_t* seed2, const uint8_t* seed3)
+{
+	size_t j;
+
+	for (j = 0; j < count; ++j)
+	{
+		getnoise_x4(r[j], r[count + j], r[(2 * count) + j], r[(3 * count) + j], seed0, seed1, seed2, seed3,
+			(uint8_t)j, (uint8_t)j, (uint8_t)j, (uint8_t)j);
+	}
+}
+
 void qsc_kyber_poly_ntt(qsc_kyber_poly* r)
 {
 	qsc_kyber_ntt(r->coeffs);
@@ -720,11 +749,23 @@ void qsc_kyber_poly_basemul(qsc_kyber_poly* r, const qsc_kyber_poly* a, const qs
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i av;
+	__m256i bv;
+
+	for (i = 0; i < QSC_KYBER_N / 16; ++i)
+	{
+		av = _mm256_loadu_si256((const __m256i*)(a->coeffs + (i * 16)));
+		bv = _mm256_loadu_si256((const __m256i*)(b->coeffs + (i * 16)));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + (i * 16)), kyber_basemul_avx2(av, bv, kyber_basemul_zetas_avx2(qsc_kyber_zetas + 64 + (i * 4))));
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N / 4; ++i)
 	{
 		qsc_kyber_basemul(r->coeffs + (4 * i), a->coeffs + (4 * i), b->coeffs + (4 * i), qsc_kyber_zetas[64 + i]);
 		qsc_kyber_basemul(r->coeffs + (4 * i) + 2, a->coeffs + (4U * i) + 2, b->coeffs + (4U * i) + 2, -qsc_kyber_zetas[64 + i]);
 	}
+#endif
 }
 
 void qsc_kyber_poly_frommont(qsc_kyber_poly* r)
@@ -732,50 +773,117 @@ void qsc_kyber_poly_frommont(qsc_kyber_poly* r)
 	const int16_t f = (1ULL << 32) % QSC_KYBER_Q;
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	const __m256i fv = _mm256_set1_epi16(f);
+	__m256i t;
+
+	/* inputs are Barrett reduced, so the signed product matches the unsigned scalar form */
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		t = _mm256_loadu_si256((const __m256i*)(r->coeffs + i));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), kyber_fqmul_avx2(t, fv));
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N; ++i)
 	{
 		r->coeffs[i] = (uint16_t)qsc_kyber_montgomery_reduce((int32_t)r->coeffs[i] * f);
 	}
+#endif
 }
 
 void qsc_kyber_poly_reduce(qsc_kyber_poly* r)
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	__m512i t;
+
+	for (i = 0; i < QSC_KYBER_N; i += 32)
+	{
+		t = _mm512_loadu_si512((const __m512i*)(r->coeffs + i));
+		_mm512_storeu_si512((__m512i*)(r->coeffs + i), kyber_barrett_avx512(t));
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i t;
+
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		t = _mm256_loadu_si256((const __m256i*)(r->coeffs + i));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), kyber_barrett_avx2(t));
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N; ++i)
 	{
 		r->coeffs[i] = (uint16_t)qsc_kyber_barrett_reduce((int16_t)r->coeffs[i]);
 	}
+#endif
 }
 
 void qsc_kyber_poly_csubq(qsc_kyber_poly* r)
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	const __m256i q = _mm256_set1_epi16(QSC_KYBER_Q);
+	__m256i t;
+
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		t = _mm256_loadu_si256((const __m256i*)(r->coeffs + i));
+		t = _mm256_sub_epi16(t, q);
+		t = _mm256_add_epi16(t, _mm256_and_si256(_mm256_srai_epi16(t, 15), q));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), t);
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N; ++i)
 	{
 		r->coeffs[i] = (uint16_t)qsc_kyber_csubq((int16_t)r->coeffs[i]);
 	}
+#endif
 }
 
 void qsc_kyber_poly_add(qsc_kyber_poly* r, const qsc_kyber_poly* a, const qsc_kyber_poly* b)
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i av;
+	__m256i bv;
+
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		av = _mm256_loadu_si256((const __m256i*)(a->coeffs + i));
+		bv = _mm256_loadu_si256((const __m256i*)(b->coeffs + i));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), _mm256_add_epi16(av, bv));
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N; ++i)
 	{
 		r->coeffs[i] = a->coeffs[i] + b->coeffs[i];
 	}
+#endif
 }
 
 void qsc_kyber_poly_sub(qsc_kyber_poly* r, const qsc_kyber_poly* a, const qsc_kyber_poly* b)
 {
 	size_t i;
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i av;
+	__m256i bv;
+
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		av = _mm256_loadu_si256((const __m256i*)(a->coeffs + i));
+		bv = _mm256_loadu_si256((const __m256i*)(b->coeffs + i));
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), _mm256_sub_epi16(av, bv));
+	}
+#else
 	for (i = 0; i < QSC_KYBER_N; ++i)
 	{
 		r->coeffs[i] = a->coeffs[i] - b->coeffs[i];
 	}
+#endif
 }
 
 void qsc_kyber_poly_frommsg(qsc_kyber_poly* r, const uint8_t msg[QSC_KYBER_SYMBYTES])
@@ -816,199 +924,6 @@ void qsc_kyber_poly_tomsg(uint8_t msg[QSC_KYBER_SYMBYTES], qsc_kyber_poly* a)
 	}
 }
 
-/* polyvec.c */
-
-void qsc_kyber_polyvec_compress(uint8_t* r, qsc_kyber_polyvec* a)
-{
-	size_t i;
-	size_t j;
-	size_t k;
-
-	qsc_kyber_polyvec_csubq(a);
-
-#if (KYBER_POLYVECBASEBYTES == 352)
-
-	uint16_t t[8];
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		for (j = 0; j < QSC_KYBER_N / 8; ++j)
-		{
-			for (k = 0; k < 8; ++k)
-			{
-				t[k] = ((((uint32_t)a->vec[i].coeffs[(8 * j) + k] << 11) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 0x7FF;
-			}
-
-			r[11 * j] = t[0] & 0xFF;
-			r[(11 * j) + 1] = (t[0] >> 8) | ((t[1] & 0x1F) << 3);
-			r[(11 * j) + 2] = (t[1] >> 5) | ((t[2] & 0x03) << 6);
-			r[(11 * j) + 3] = (t[2] >> 2) & 0xFF;
-			r[(11 * j) + 4] = (t[2] >> 10) | ((t[3] & 0x7F) << 1);
-			r[(11 * j) + 5] = (t[3] >> 7) | ((t[4] & 0x0F) << 4);
-			r[(11 * j) + 6] = (t[4] >> 4) | ((t[5] & 0x01) << 7);
-			r[(11 * j) + 7] = (t[5] >> 1) & 0xff;
-			r[(11 * j) + 8] = (t[5] >> 9) | ((t[6] & 0x3F) << 2);
-			r[(11 * j) + 9] = (t[6] >> 6) | ((t[7] & 0x07) << 5);
-			r[(11 * j) + 10] = (t[7] >> 3);
-		}
-
-		r += KYBER_POLYVECBASEBYTES;
-	}
-
-#elif (KYBER_POLYVECBASEBYTES == 320)
-
-	uint16_t t[4];
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		for (j = 0; j < QSC_KYBER_N / 4; ++j)
-		{
-			for (k = 0; k < 4; ++k)
-			{
-				t[k] = ((((uint32_t)a->vec[i].coeffs[(4 * j) + k] << 10) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 0x3FFU;
-			}
-
-			r[5 * j] = (uint8_t)(t[0] & 0xFFU);
-			r[(5 * j) + 1] = (uint8_t)((t[0] >> 8U) | ((t[1] & 0x3FU) << 2U));
-			r[(5 * j) + 2] = (uint8_t)((t[1] >> 6U) | ((t[2] & 0x0FU) << 4U));
-			r[(5 * j) + 3] = (uint8_t)((t[2] >> 4U) | ((t[3] & 0x03U) << 6U));
-			r[(5 * j) + 4] = (uint8_t)((t[3] >> 2U));
-		}
-
-		r += KYBER_POLYVECBASEBYTES;
-	}
-
-#endif
-}
-
-void qsc_kyber_polyvec_decompress(qsc_kyber_polyvec* r, const uint8_t* a)
-{
-	size_t i;
-	size_t j;
-
-#if (KYBER_POLYVECBASEBYTES == 352)
-
-	for (i = 0; i < QSC_KYBER_K; i++)
-	{
-		for (j = 0; j < QSC_KYBER_N / 8; j++)
-		{
-			r->vec[i].coeffs[(8 * j)] = (((a[(11 * j)] | (((uint32_t)a[(11 * j) + 1] & 0x07) << 8)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 1] = ((((a[(11 * j) + 1] >> 3) | (((uint32_t)a[(11 * j) + 2] & 0x3F) << 5)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 2] = ((((a[(11 * j) + 2] >> 6) | (((uint32_t)a[(11 * j) + 3] & 0xFF) << 2) | (((uint32_t)a[(11 * j) + 4] & 0x01) << 10)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 3] = ((((a[(11 * j) + 4] >> 1) | (((uint32_t)a[(11 * j) + 5] & 0x0F) << 7)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 4] = ((((a[(11 * j) + 5] >> 4) | (((uint32_t)a[(11 * j) + 6] & 0x7F) << 4)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 5] = ((((a[(11 * j) + 6] >> 7) | (((uint32_t)a[(11 * j) + 7] & 0xFF) << 1) | (((uint32_t)a[(11 * j) + 8] & 0x03) << 9)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 6] = ((((a[(11 * j) + 8] >> 2) | (((uint32_t)a[(11 * j) + 9] & 0x1F) << 6)) * QSC_KYBER_Q) + 1024) >> 11;
-			r->vec[i].coeffs[(8 * j) + 7] = ((((a[(11 * j) + 9] >> 5) | (((uint32_t)a[(11 * j) + 10] & 0xFF) << 3)) * QSC_KYBER_Q) + 1024) >> 11;
-		}
-
-		a += KYBER_POLYVECBASEBYTES;
-	}
-
-#elif (KYBER_POLYVECBASEBYTES == 320)
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		for (j = 0; j < QSC_KYBER_N / 4; ++j)
-		{
-			r->vec[i].coeffs[4 * j] = (((a[5 * j] | (((uint32_t)a[(5 * j) + 1] & 0x03U) << 8U)) * QSC_KYBER_Q) + 512) >> 10U;
-			r->vec[i].coeffs[(4 * j) + 1] = ((((a[(5 * j) + 1] >> 2U) | (((uint32_t)a[(5 * j) + 2] & 0x0FU) << 6U)) * QSC_KYBER_Q) + 512) >> 10U;
-			r->vec[i].coeffs[(4 * j) + 2] = ((((a[(5 * j) + 2] >> 4U) | (((uint32_t)a[(5 * j) + 3] & 0x3FU) << 4U)) * QSC_KYBER_Q) + 512) >> 10U;
-			r->vec[i].coeffs[(4 * j) + 3] = ((((a[(5 * j) + 3] >> 6U) | (((uint32_t)a[(5 * j) + 4] & 0xFFU) << 2U)) * QSC_KYBER_Q) + 512) >> 10U;
-		}
-
-		a += KYBER_POLYVECBASEBYTES;
-	}
-
-#endif
-}
-
-void qsc_kyber_polyvec_tobytes(uint8_t* r, qsc_kyber_polyvec* a)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_tobytes(r + (i * KYBER_POLYBYTES), &a->vec[i]);
-	}
-}
-
-void qsc_kyber_polyvec_frombytes(qsc_kyber_polyvec* r, const uint8_t* a)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_frombytes(&r->vec[i], a + (i * KYBER_POLYBYTES));
-	}
-}
-
-void qsc_kyber_polyvec_ntt(qsc_kyber_polyvec* r)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_ntt(&r->vec[i]);
-	}
-}
-
-void qsc_kyber_polyvec_invntt(qsc_kyber_polyvec* r)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_invntt(&r->vec[i]);
-	}
-}
-
-void qsc_kyber_polyvec_pointwise_acc(qsc_kyber_poly* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b)
-{
-	qsc_kyber_poly t;
-	size_t i;
-
-	qsc_kyber_poly_basemul(r, &a->vec[0], &b->vec[0]);
-
-	for (i = 1; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_basemul(&t, &a->vec[i], &b->vec[i]);
-		qsc_kyber_poly_add(r, r, &t);
-	}
-
-	qsc_kyber_poly_reduce(r);
-}
-
-void qsc_kyber_polyvec_reduce(qsc_kyber_polyvec* r)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_reduce(&r->vec[i]);
-	}
-}
-
-void qsc_kyber_polyvec_csubq(qsc_kyber_polyvec* r)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_csubq(&r->vec[i]);
-	}
-}
-
-void qsc_kyber_polyvec_add(qsc_kyber_polyvec* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b)
-{
-	size_t i;
-
-	for (i = 0; i < QSC_KYBER_K; ++i)
-	{
-		qsc_kyber_poly_add(&r->vec[i], &a->vec[i], &b->vec[i]);
-	}
-}
-
 /* reduce.c */
 
 int16_t qsc_kyber_montgomery_reduce(int32_t a)
@@ -1042,4 +957,22 @@ int16_t qsc_kyber_csubq(int16_t a)
 	a += (a >> 15U) & QSC_KYBER_Q;
 
 	return a;
-}
\ No newline at end of file
+}
+/* parameter sets */
+
+/* each set is compiled from the same source with its K dimension and a _k<K> symbol suffix */
+#define KYBER_NAMESPACE_CONCAT(x, k) x##_k##k
+#define KYBER_NAMESPACE_EXPAND(x, k) KYBER_NAMESPACE_CONCAT(x, k)
+#define KYBER_NAMESPACE(x) KYBER_NAMESPACE_EXPAND(x, KYBER_K)
+
+#define KYBER_K 2
+#include "kyberbasek.h"
+#undef KYBER_K
+
+#define KYBER_K 3
+#include "kyberbasek.h"
+#undef KYBER_K
+
+#define KYBER_K 4
+#include "kyberbasek.h"
+#undef KYBER_K
@@ -21,7 +21,13 @@
 #define QSC_KYBERBASE_H
 
 #include "common.h"
+#include "kyber.h"
 
+/*!
+\def QSC_KYBER_K
+* Read Only: The K dimension of the default parameter set, selected in common.h. \n
+* All three parameter sets are compiled, the default set serves the fixed-size api in kyber.h.
+*/
 #if defined(QSC_KYBER_S1Q3329N256)
 #	define QSC_KYBER_K 2
 #elif defined(QSC_KYBER_S2Q3329N256)
@@ -62,63 +68,100 @@
 */
 #define QSC_KYBER_SYMBYTES 32
 
-/* indcpa.h */
+/* kem.h */
 
 /**
-* \brief Decryption function of the CPA-secure public-key encryption scheme underlying Kyber.
+* \brief Generates shared secret for given cipher text and private key. \n
+* One instantiation per parameter set: _k2 for Kyber-512, _k3 for Kyber-768, and _k4 for Kyber-1024.
 *
-* \param m Pointer to output decrypted message
-* \param c Pointer to input ciphertext
-* \param sk Pointer to input secret key
+* \param ss Pointer to output shared secret (an already allocated array of KYBER_SECRET_BYTES bytes)
+* \param ct Pointer to input cipher text (an already allocated array of KYBER_CIPHERTEXT_SIZE bytes)
+* \param sk Pointer to input private key (an already allocated array of KYBER_SECRETKEY_SIZE bytes)
+* \return Returns true for success
 */
-void qsc_kyber_indcpa_dec(uint8_t* m, const uint8_t* c, const uint8_t* sk);
+bool qsc_kyber_crypto_kem_dec_k2(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+bool qsc_kyber_crypto_kem_dec_k3(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+bool qsc_kyber_crypto_kem_dec_k4(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
 
 /**
-* \brief Encryption function of the CPA-secure public-key encryption scheme underlying Kyber.
+* \brief Generates cipher text and shared secret for given public key. \n
+* One instantiation per parameter set: _k2 for Kyber-512, _k3 for Kyber-768, and _k4 for Kyber-1024.
 *
-* \param c Pointer to output ciphertext
-* \param m Pointer to input message (of length KYBER_KEYBYTES bytes)
-* \param pk Pointer to input public key
-* \param coins Pointer to input random coins used as seed to deterministically generate all randomness
+* \param ct Pointer to output cipher text (an already allocated array of KYBER_CIPHERTEXT_SIZE bytes)
+* \param ss Pointer to output shared secret (an already allocated array of KYBER_BYTES bytes)
+* \param pk Pointer to input public key (an already allocated array of KYBER_PUBLICKEY_SIZE bytes)
 */
-void qsc_kyber_indcpa_enc(uint8_t* c, const uint8_t* m, const uint8_t* pk, const uint8_t* coins);
+void qsc_kyber_crypto_kem_enc_k2(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_enc_k3(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_enc_k4(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t));
 
 /**
-* \brief Generates public and private key for the CPA-secure public-key encryption scheme underlying Kyber.
+* \brief Generates public and private key for the CCA-Secure Kyber key encapsulation mechanism. \n
+* One instantiation per parameter set: _k2 for Kyber-512, _k3 for Kyber-768, and _k4 for Kyber-1024.
 *
-* \param pk Pointer to output public key
-* \param sk Pointer to output private key
+* \param pk Pointer to output public key (an already allocated array of KYBER_PUBLICKEY_SIZE bytes)
+* \param sk Pointer to output private key (an already allocated array of KYBER_SECRETKEY_SIZE bytes)
 */
-void qsc_kyber_indcpa_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_keypair_k2(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_keypair_k3(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_keypair_k4(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t));
 
-/* kem.h */
+/**
+* \brief Expands a public key; samples the transposed matrix and decodes the public vector.
+*
+* \param ppk Pointer to the output prepared public key
+* \param pk Pointer to input public key (an already allocated array of KYBER_PUBLICKEY_SIZE bytes)
+*/
+void qsc_kyber_crypto_kem_prepare_pk_k2(qsc_kyber_prepared_publickey* ppk, const uint8_t* pk);
+void qsc_kyber_crypto_kem_prepare_pk_k3(qsc_kyber_prepared_publickey* ppk, const uint8_t* pk);
+void qsc_kyber_crypto_kem_prepare_pk_k4(qsc_kyber_prepared_publickey* ppk, const uint8_t* pk);
 
 /**
-* \brief Generates shared secret for given cipher text and private key
+* \brief Expands a private key; decodes the secret vector and expands the embedded public key.
 *
-* \param ss Pointer to output shared secret (an already allocated array of KYBER_SECRET_BYTES bytes)
-* \param ct Pointer to input cipher text (an already allocated array of KYBER_CIPHERTEXT_SIZE bytes)
+* \param psk Pointer to the output prepared private key
 * \param sk Pointer to input private key (an already allocated array of KYBER_SECRETKEY_SIZE bytes)
-* \return Returns true for success
 */
-bool qsc_kyber_crypto_kem_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+void qsc_kyber_crypto_kem_prepare_sk_k2(qsc_kyber_prepared_privatekey* psk, const uint8_t* sk);
+void qsc_kyber_crypto_kem_prepare_sk_k3(qsc_kyber_prepared_privatekey* psk, const uint8_t* sk);
+void qsc_kyber_crypto_kem_prepare_sk_k4(qsc_kyber_prepared_privatekey* psk, const uint8_t* sk);
 
 /**
-* \brief Generates cipher text and shared secret for given public key
+* \brief Generates cipher text and shared secret with a prepared public key.
 *
 * \param ct Pointer to output cipher text (an already allocated array of KYBER_CIPHERTEXT_SIZE bytes)
 * \param ss Pointer to output shared secret (an already allocated array of KYBER_BYTES bytes)
-* \param pk Pointer to input public key (an already allocated array of KYBER_PUBLICKEY_SIZE bytes)
+* \param ppk Pointer to the prepared public key
 */
-void qsc_kyber_crypto_kem_enc(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_enc_prepared_k2(uint8_t* ct, uint8_t* ss, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_enc_prepared_k3(uint8_t* ct, uint8_t* ss, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t));
+void qsc_kyber_crypto_kem_enc_prepared_k4(uint8_t* ct, uint8_t* ss, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t));
 
 /**
-* \brief Generates public and private key for the CCA-Secure Kyber key encapsulation mechanism
+* \brief Generates shared secret for given cipher text with a prepared private key.
 *
-* \param pk Pointer to output public key (an already allocated array of KYBER_PUBLICKEY_SIZE bytes)
-* \param sk Pointer to output private key (an already allocated array of KYBER_SECRETKEY_SIZE bytes)
+* \param ss Pointer to output shared secret (an already allocated array of KYBER_SECRET_BYTES bytes)
+* \param ct Pointer to input cipher text (an already allocated array of KYBER_CIPHERTEXT_SIZE bytes)
+* \param psk Pointer to the prepared private key
+* \return Returns true for success
 */
-void qsc_kyber_crypto_kem_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t));
+bool qsc_kyber_crypto_kem_dec_prepared_k2(uint8_t* ss, const uint8_t* ct, const qsc_kyber_prepared_privatekey* psk);
+bool qsc_kyber_crypto_kem_dec_prepared_k3(uint8_t* ss, const uint8_t* ct, const qsc_kyber_prepared_privatekey* psk);
+bool qsc_kyber_crypto_kem_dec_prepared_k4(uint8_t* ss, const uint8_t* ct, const qsc_kyber_prepared_privatekey* psk);
+
+/**
+* \brief Generates the shared secrets for a batch of cipher texts with a prepared private key.
+*
+* \param ss Pointer to the output shared secrets, count arrays of KYBER_SECRET_BYTES bytes
+* \param valid Pointer to an optional array of count decapsulation results, may be NULL
+* \param ct Pointer to the input cipher texts, count arrays of KYBER_CIPHERTEXT_SIZE bytes
+* \param count The number of cipher texts
+* \param psk Pointer to the prepared private key
+* \return Returns the number of cipher texts that decapsulated successfully
+*/
+size_t qsc_kyber_crypto_kem_dec_batch_k2(uint8_t* ss, bool* valid, const uint8_t* ct, size_t count, const qsc_kyber_prepared_privatekey* psk);
+size_t qsc_kyber_crypto_kem_dec_batch_k3(uint8_t* ss, bool* valid, const uint8_t* ct, size_t count, const qsc_kyber_prepared_privatekey* psk);
+size_t qsc_kyber_crypto_kem_dec_batch_k4(uint8_t* ss, bool* valid, const uint8_t* ct, size_t count, const qsc_kyber_prepared_privatekey* psk);
 
 /* ntt.h */
 
@@ -180,23 +223,6 @@ typedef struct
 */
 void qsc_kyber_cbd(qsc_kyber_poly* r, const uint8_t* buf);
 
-/**
-* \brief Compression and subsequent serialization of a polynomial.
-*
-* \param r Pointer to output byte array
-* \param a Pointer to input polynomial
-*/
-void qsc_kyber_poly_compress(uint8_t* r, qsc_kyber_poly* a);
-
-/**
-* \brief De-serialization and subsequent decompression of a polynomial;
-* approximate inverse of qsc_kyber_poly_compress.
-*
-* \param r Pointer to output polynomial
-* \param a Pointer to input byte array
-*/
-void qsc_kyber_poly_decompress(qsc_kyber_poly* r, const uint8_t* a);
-
 /**
 * \brief Serialization of a polynomial
 *
@@ -239,6 +265,24 @@ void qsc_kyber_poly_tomsg(uint8_t msg[QSC_KYBER_SYMBYTES], qsc_kyber_poly *a);
 */
 void qsc_kyber_poly_getnoise(qsc_kyber_poly* r, const uint8_t* seed, uint8_t nonce);
 
+/**
+* \brief Sample four polynomials deterministically from a seed and four nonces,
+* drawing the four SHAKE-256 outputs in a single parallel pass (shake256x4).
+* Each output is identical to qsc_kyber_poly_getnoise with the same nonce.
+*
+* \param r0 Pointer to the first output polynomial
+* \param r1 Pointer to the second output polynomial
+* \param r2 Pointer to the third output polynomial
+* \param r3 Pointer to the fourth output polynomial
+* \param seed Pointer to input seed
+* \param nonce0 one-byte nonce of the first polynomial
+* \param nonce1 one-byte nonce of the second polynomial
+* \param nonce2 one-byte nonce of the third polynomial
+* \param nonce3 one-byte nonce of the fourth polynomial
+*/
+void qsc_kyber_poly_getnoise4(qsc_kyber_poly* r0, qsc_kyber_poly* r1, qsc_kyber_poly* r2, qsc_kyber_poly* r3,
+	const uint8_t* seed, uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3);
+
 /**
 * \brief Computes negacyclic number-theoretic transform (NTT) of a polynomial in place;
 * inputs assumed to be in normal order, output in bitreversed order.
@@ -304,101 +348,6 @@ void qsc_kyber_poly_frommont(qsc_kyber_poly* r);
 */
 void qsc_kyber_poly_basemul(qsc_kyber_poly* r, const qsc_kyber_poly* a, const qsc_kyber_poly* b);
 
-/* polyvec.h */
-
-/**
-* \struct qsc_kyber_polyvec
-* \brief Contains a K sized vector of qsc_kyber_poly structures
-*
-* \var qsc_kyber_polyvec::vec
-* The polynomial vector array
-*/
-typedef struct
-{
-	qsc_kyber_poly vec[QSC_KYBER_K];
-} qsc_kyber_polyvec;
-
-/**
-* \brief Compress and serialize vector of polynomials.
-*
-* \param r Pointer to output byte array
-* \param a Pointer to input vector of polynomials
-*/
-void qsc_kyber_polyvec_compress(uint8_t* r, qsc_kyber_polyvec* a);
-
-/**
-* \brief De-serialize and decompress vector of polynomials;
-* approximate inverse of qsc_kyber_polyvec_compress.
-*
-* \param r Pointer to output vector of polynomials
-* \param a Pointer to input byte array
-*/
-void qsc_kyber_polyvec_decompress(qsc_kyber_polyvec* r, const uint8_t* a);
-
-/**
-* \brief Serialize a vector of polynomials.
-*
-* \param r Pointer to output byte array
-* \param a Pointer to input vector of polynomials
-*/
-void qsc_kyber_polyvec_tobytes(uint8_t* r, qsc_kyber_polyvec* a);
-
-/**
-* \brief De-serialize vector of polynomials; inverse of qsc_kyber_polyvec_tobytes.
-*
-* \param r Pointer to output byte array
-* \param a Pointer to input vector of polynomials
-*/
-void qsc_kyber_polyvec_frombytes(qsc_kyber_polyvec* r, const uint8_t* a);
-
-/**
-* \brief Apply forward NTT to all elements of a vector of polynomials.
-*
-* \param r Pointer to in/output vector of polynomials
-*/
-void qsc_kyber_polyvec_ntt(qsc_kyber_polyvec* r);
-
-/**
-* \brief Apply inverse NTT to all elements of a vector of polynomials.
-*
-* \param r Pointer to in/output vector of polynomials
-*/
-void qsc_kyber_polyvec_invntt(qsc_kyber_polyvec* r);
-
-/**
-* \brief Pointwise multiply elements of a and b and accumulate into r.
-*
-* \param r Pointer to output polynomial
-* \param a Pointer to first input vector of polynomials
-* \param b Pointer to second input vector of polynomials
-*/
-void qsc_kyber_polyvec_pointwise_acc(qsc_kyber_poly* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b);
-
-/**
-* \brief Add vectors of polynomials.
-*
-* \param r Pointer to output vector of polynomials
-* \param a Pointer to first input vector of polynomials
-* \param b Pointer to second input vector of polynomials
-*/
-void qsc_kyber_polyvec_add(qsc_kyber_polyvec* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b);
-
-/**
-* \brief Applies Barrett reduction to each coefficient
-*  of each element of a vector of polynomials
-*
-* \param r Pointer to in/output vector of polynomials
-*/
-void qsc_kyber_polyvec_reduce(qsc_kyber_polyvec* r);
-
-/**
-* \brief Applies conditional subtraction of q to each coefficient
-* of each element of a vector of polynomials.
-*
-* \param r Pointer to in/output vector of polynomials
-*/
-void qsc_kyber_polyvec_csubq(qsc_kyber_polyvec *r);
-
 /* reduce.h */
 
 /**
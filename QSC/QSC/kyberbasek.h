@@ -0,0 +1,1107 @@
+/* The GPL version 3 License (GPLv3)
+*
+* Copyright (c) 2020 Digital Freedom Defence Inc.
+* This file is part of the QSC Cryptographic library
+*
+* This program is free software : you can redistribute it and / or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+* The parameter-set dependent half of the Kyber implementation. \n
+* This is not a public header; kyberbase.c includes it once for each parameter set,
+* with KYBER_K defined as 2, 3 or 4. Every symbol below is renamed through KYBER_NAMESPACE,
+* so each set receives its own polynomial-vector, IND-CPA and KEM functions,
+* with the vector dimension and the compression widths fixed at compile time.
+*/
+
+#if !defined(KYBER_K) || !defined(KYBER_NAMESPACE)
+#	error kyberbasek.h is included by kyberbase.c with KYBER_K and KYBER_NAMESPACE defined
+#endif
+
+/* params.h */
+
+/*!
+\def KYBER_POLYVECBYTES
+* Read Only: The base size of the compressed public key polynolial
+*/
+#if KYBER_K == 2
+#define KYBER_POLYVECBASEBYTES 320
+#elif KYBER_K == 3
+#define KYBER_POLYVECBASEBYTES 320
+#elif KYBER_K == 4
+#define KYBER_POLYVECBASEBYTES 352
+#endif
+
+/*!
+\def KYBER_POLYCOMPRESSEDBYTES
+* Read Only: The ciphertext compressed byte size
+*/
+#if KYBER_K == 2
+#define KYBER_POLYCOMPRESSEDBYTES 96
+#elif KYBER_K == 3
+#define KYBER_POLYCOMPRESSEDBYTES 128
+#elif KYBER_K == 4
+#define KYBER_POLYCOMPRESSEDBYTES 160
+#endif
+
+/*!
+\def KYBER_POLYVECCOMPRESSEDBYTES
+* Read Only: The base size of the public key
+*/
+#define KYBER_POLYVECCOMPRESSEDBYTES (KYBER_K * KYBER_POLYVECBASEBYTES)
+
+/*!
+\def KYBER_POLYVECBYTES
+* Read Only: The base size of the secret key
+*/
+#define KYBER_POLYVECBYTES (KYBER_K * KYBER_POLYBYTES)
+
+/*!
+\def KYBER_INDCPA_PUBLICKEYBYTES
+* Read Only: The base INDCPA formatted public key size in bytes
+*/
+#define KYBER_INDCPA_PUBLICKEYBYTES (KYBER_POLYVECBYTES + QSC_KYBER_SYMBYTES)
+
+/*!
+\def KYBER_INDCPA_SECRETKEYBYTES
+* Read Only: The base INDCPA formatted private key size in bytes
+*/
+#define KYBER_INDCPA_SECRETKEYBYTES (KYBER_POLYVECBYTES)
+
+/*!
+\def KYBER_INDCPA_BYTES
+* Read Only: The size of the INDCPA formatted output cipher-text
+*/
+#define KYBER_INDCPA_BYTES (KYBER_POLYVECCOMPRESSEDBYTES + KYBER_POLYCOMPRESSEDBYTES)
+
+/*!
+\def KYBER_PUBLICKEY_SIZE
+* Read Only: The public key size in bytes
+*/
+#define KYBER_PUBLICKEY_SIZE (KYBER_INDCPA_PUBLICKEYBYTES)
+
+/*!
+\def KYBER_INDCPA_SECRETKEYBYTES
+* Read Only: The base INDCPA formatted secret key size in bytes
+*/
+#define KYBER_SECRETKEY_SIZE (KYBER_INDCPA_SECRETKEYBYTES +  KYBER_INDCPA_PUBLICKEYBYTES + 2 * QSC_KYBER_SYMBYTES)
+
+/*!
+\def KYBER_CIPHERTEXT_SIZE
+* Read Only: The cipher-text size in bytes
+*/
+#define KYBER_CIPHERTEXT_SIZE KYBER_INDCPA_BYTES
+
+/* symbol names */
+
+#define qsc_kyber_polyvec_compress KYBER_NAMESPACE(qsc_kyber_polyvec_compress)
+#define qsc_kyber_polyvec_decompress KYBER_NAMESPACE(qsc_kyber_polyvec_decompress)
+#define qsc_kyber_polyvec_tobytes KYBER_NAMESPACE(qsc_kyber_polyvec_tobytes)
+#define qsc_kyber_polyvec_frombytes KYBER_NAMESPACE(qsc_kyber_polyvec_frombytes)
+#define qsc_kyber_polyvec_ntt KYBER_NAMESPACE(qsc_kyber_polyvec_ntt)
+#define qsc_kyber_polyvec_invntt KYBER_NAMESPACE(qsc_kyber_polyvec_invntt)
+#define qsc_kyber_polyvec_pointwise_acc KYBER_NAMESPACE(qsc_kyber_polyvec_pointwise_acc)
+#define qsc_kyber_polyvec_reduce KYBER_NAMESPACE(qsc_kyber_polyvec_reduce)
+#define qsc_kyber_polyvec_csubq KYBER_NAMESPACE(qsc_kyber_polyvec_csubq)
+#define qsc_kyber_polyvec_add KYBER_NAMESPACE(qsc_kyber_polyvec_add)
+#define qsc_kyber_poly_compress KYBER_NAMESPACE(qsc_kyber_poly_compress)
+#define qsc_kyber_poly_decompress KYBER_NAMESPACE(qsc_kyber_poly_decompress)
+#define qsc_kyber_polyvec KYBER_NAMESPACE(qsc_kyber_polyvec)
+#define pack_pk KYBER_NAMESPACE(pack_pk)
+#define unpack_pk KYBER_NAMESPACE(unpack_pk)
+#define pack_sk KYBER_NAMESPACE(pack_sk)
+#define unpack_sk KYBER_NAMESPACE(unpack_sk)
+#define pack_ciphertext KYBER_NAMESPACE(pack_ciphertext)
+#define unpack_ciphertext KYBER_NAMESPACE(unpack_ciphertext)
+#define gen_matrix KYBER_NAMESPACE(gen_matrix)
+#define qsc_kyber_indcpa_keypair KYBER_NAMESPACE(qsc_kyber_indcpa_keypair)
+#define qsc_kyber_indcpa_enc KYBER_NAMESPACE(qsc_kyber_indcpa_enc)
+#define qsc_kyber_indcpa_dec KYBER_NAMESPACE(qsc_kyber_indcpa_dec)
+#define qsc_kyber_crypto_kem_keypair KYBER_NAMESPACE(qsc_kyber_crypto_kem_keypair)
+#define qsc_kyber_crypto_kem_enc KYBER_NAMESPACE(qsc_kyber_crypto_kem_enc)
+#define qsc_kyber_crypto_kem_dec KYBER_NAMESPACE(qsc_kyber_crypto_kem_dec)
+#define expand_pk KYBER_NAMESPACE(expand_pk)
+#define indcpa_enc_sampled KYBER_NAMESPACE(indcpa_enc_sampled)
+#define qsc_kyber_crypto_kem_dec_batch KYBER_NAMESPACE(qsc_kyber_crypto_kem_dec_batch)
+#define kem_enc_expanded KYBER_NAMESPACE(kem_enc_expanded)
+#define kem_dec_expanded KYBER_NAMESPACE(kem_dec_expanded)
+#define qsc_kyber_crypto_kem_prepare_pk KYBER_NAMESPACE(qsc_kyber_crypto_kem_prepare_pk)
+#define qsc_kyber_crypto_kem_prepare_sk KYBER_NAMESPACE(qsc_kyber_crypto_kem_prepare_sk)
+#define qsc_kyber_crypto_kem_enc_prepared KYBER_NAMESPACE(qsc_kyber_crypto_kem_enc_prepared)
+#define qsc_kyber_crypto_kem_dec_prepared KYBER_NAMESPACE(qsc_kyber_crypto_kem_dec_prepared)
+
+/* poly.c */
+
+/**
+* \brief Compression and subsequent serialization of a polynomial.
+*
+* \param r Pointer to output byte array
+* \param a Pointer to input polynomial
+*/
+static void qsc_kyber_poly_compress(uint8_t* r, qsc_kyber_poly* a)
+{
+	uint8_t t[8];
+	size_t i;
+	size_t j;
+	size_t k;
+
+	k = 0;
+	qsc_kyber_poly_csubq(a);
+
+#if (KYBER_POLYCOMPRESSEDBYTES == 96)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			t[j] = ((((uint32_t)a->coeffs[i + j] << 3U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 7U;
+		}
+
+		r[k] = t[0] | (t[1] << 3U) | (t[2] << 6U);
+		r[k + 1] = (t[2] >> 2U) | (t[3] << 1U) | (t[4] << 4U) | (t[5] << 7U);
+		r[k + 2] = (t[5] >> 1U) | (t[6] << 2U) | (t[7] << 5U);
+		k += 3;
+	}
+#elif (KYBER_POLYCOMPRESSEDBYTES == 128)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			/* jgu -false possible overflow */
+			/*lint -e661 -e662 */
+			t[j] = ((((uint32_t)a->coeffs[i + j] << 4U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 15U;
+		}
+
+		r[k] = (uint8_t)(t[0] | (t[1] << 4U));
+		r[k + 1] = (uint8_t)(t[2] | (t[3] << 4U));
+		r[k + 2] = (uint8_t)(t[4] | (t[5] << 4U));
+		r[k + 3] = (uint8_t)(t[6] | (t[7] << 4U));
+		k += 4;
+	}
+#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			t[j] = ((((uint32_t)a->coeffs[i + j] << 5U) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 31U;
+		}
+
+		r[k] = (uint8_t)(t[0] | (t[1] << 5U));
+		r[k + 1] = (uint8_t)((t[1] >> 3U) | (t[2] << 2U) | (t[3] << 7U));
+		r[k + 2] = (uint8_t)((t[3] >> 1U) | (t[4] << 4U));
+		r[k + 3] = (uint8_t)((t[4] >> 4U) | (t[5] << 1U) | (t[6] << 6U));
+		r[k + 4] = (uint8_t)((t[6] >> 2U) | (t[7] << 3U));
+		k += 5;
+	}
+#endif
+}
+
+/**
+* \brief De-serialization and subsequent decompression of a polynomial;
+* approximate inverse of qsc_kyber_poly_compress.
+*
+* \param r Pointer to output polynomial
+* \param a Pointer to input byte array
+*/
+static void qsc_kyber_poly_decompress(qsc_kyber_poly* r, const uint8_t* a)
+{
+	size_t i;
+
+#if (KYBER_POLYCOMPRESSEDBYTES == 96)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		r->coeffs[i] = (((a[0] & 7U) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 1] = ((((a[0] >> 3U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 2] = ((((a[0] >> 6U) | ((a[1] << 2U) & 4U)) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 3] = ((((a[1] >> 1U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 4] = ((((a[1] >> 4U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 5] = ((((a[1] >> 7U) | ((a[2] << 1U) & 6U)) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 6] = ((((a[2] >> 2U) & 7U) * QSC_KYBER_Q) + 4) >> 3U;
+		r->coeffs[i + 7] = ((((a[2] >> 5U)) * QSC_KYBER_Q) + 4) >> 3U;
+		a += 3;
+	}
+#elif (KYBER_POLYCOMPRESSEDBYTES == 128)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		r->coeffs[i] = (((a[0] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 1] = (((a[0] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 2] = (((a[1] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 3] = (((a[1] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 4] = (((a[2] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 5] = (((a[2] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 6] = (((a[3] & 15U) * QSC_KYBER_Q) + 8) >> 4U;
+		r->coeffs[i + 7] = (((a[3] >> 4U) * QSC_KYBER_Q) + 8) >> 4U;
+		a += 4;
+	}
+#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
+	for (i = 0; i < QSC_KYBER_N; i += 8)
+	{
+		r->coeffs[i] = (((a[0] & 31U) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 1] = ((((a[0] >> 5U) | ((a[1] & 3U) << 3U)) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 2] = ((((a[1] >> 2U) & 31U) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 3] = ((((a[1] >> 7U) | ((a[2] & 15U) << 1U)) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 4] = ((((a[2] >> 4U) | ((a[3] & 1U) << 4U)) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 5] = ((((a[3] >> 1U) & 31U) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 6] = ((((a[3] >> 6U) | ((a[4] & 7U) << 2U)) * QSC_KYBER_Q) + 16) >> 5U;
+		r->coeffs[i + 7] = (((a[4] >> 3U) * QSC_KYBER_Q) + 16) >> 5U;
+		a += 5;
+	}
+#endif
+}
+
+/* polyvec.c */
+
+/**
+* \struct qsc_kyber_polyvec
+* \brief Contains a K sized vector of qsc_kyber_poly structures
+*
+* \var qsc_kyber_polyvec::vec
+* The polynomial vector array
+*/
+typedef struct
+{
+	qsc_kyber_poly vec[KYBER_K];
+} qsc_kyber_polyvec;
+
+/**
+* \brief Applies Barrett reduction to each coefficient
+*  of each element of a vector of polynomials
+*
+* \param r Pointer to in/output vector of polynomials
+*/
+static void qsc_kyber_polyvec_reduce(qsc_kyber_polyvec* r)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_reduce(&r->vec[i]);
+	}
+}
+
+/**
+* \brief Applies conditional subtraction of q to each coefficient
+* of each element of a vector of polynomials.
+*
+* \param r Pointer to in/output vector of polynomials
+*/
+static void qsc_kyber_polyvec_csubq(qsc_kyber_polyvec* r)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_csubq(&r->vec[i]);
+	}
+}
+
+/**
+* \brief Compress and serialize vector of polynomials.
+*
+* \param r Pointer to output byte array
+* \param a Pointer to input vector of polynomials
+*/
+static void qsc_kyber_polyvec_compress(uint8_t* r, qsc_kyber_polyvec* a)
+{
+	size_t i;
+	size_t j;
+	size_t k;
+
+	qsc_kyber_polyvec_csubq(a);
+
+#if (KYBER_POLYVECBASEBYTES == 352)
+
+	uint16_t t[8];
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		for (j = 0; j < QSC_KYBER_N / 8; ++j)
+		{
+			for (k = 0; k < 8; ++k)
+			{
+				t[k] = ((((uint32_t)a->vec[i].coeffs[(8 * j) + k] << 11) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 0x7FF;
+			}
+
+			r[11 * j] = t[0] & 0xFF;
+			r[(11 * j) + 1] = (t[0] >> 8) | ((t[1] & 0x1F) << 3);
+			r[(11 * j) + 2] = (t[1] >> 5) | ((t[2] & 0x03) << 6);
+			r[(11 * j) + 3] = (t[2] >> 2) & 0xFF;
+			r[(11 * j) + 4] = (t[2] >> 10) | ((t[3] & 0x7F) << 1);
+			r[(11 * j) + 5] = (t[3] >> 7) | ((t[4] & 0x0F) << 4);
+			r[(11 * j) + 6] = (t[4] >> 4) | ((t[5] & 0x01) << 7);
+			r[(11 * j) + 7] = (t[5] >> 1) & 0xff;
+			r[(11 * j) + 8] = (t[5] >> 9) | ((t[6] & 0x3F) << 2);
+			r[(11 * j) + 9] = (t[6] >> 6) | ((t[7] & 0x07) << 5);
+			r[(11 * j) + 10] = (t[7] >> 3);
+		}
+
+		r += KYBER_POLYVECBASEBYTES;
+	}
+
+#elif (KYBER_POLYVECBASEBYTES == 320)
+
+	uint16_t t[4];
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		for (j = 0; j < QSC_KYBER_N / 4; ++j)
+		{
+			for (k = 0; k < 4; ++k)
+			{
+				t[k] = ((((uint32_t)a->vec[i].coeffs[(4 * j) + k] << 10) + QSC_KYBER_Q / 2) / QSC_KYBER_Q) & 0x3FFU;
+			}
+
+			r[5 * j] = (uint8_t)(t[0] & 0xFFU);
+			r[(5 * j) + 1] = (uint8_t)((t[0] >> 8U) | ((t[1] & 0x3FU) << 2U));
+			r[(5 * j) + 2] = (uint8_t)((t[1] >> 6U) | ((t[2] & 0x0FU) << 4U));
+			r[(5 * j) + 3] = (uint8_t)((t[2] >> 4U) | ((t[3] & 0x03U) << 6U));
+			r[(5 * j) + 4] = (uint8_t)((t[3] >> 2U));
+		}
+
+		r += KYBER_POLYVECBASEBYTES;
+	}
+
+#endif
+}
+
+/**
+* \brief De-serialize and decompress vector of polynomials;
+* approximate inverse of qsc_kyber_polyvec_compress.
+*
+* \param r Pointer to output vector of polynomials
+* \param a Pointer to input byte array
+*/
+static void qsc_kyber_polyvec_decompress(qsc_kyber_polyvec* r, const uint8_t* a)
+{
+	size_t i;
+	size_t j;
+
+#if (KYBER_POLYVECBASEBYTES == 352)
+
+	for (i = 0; i < KYBER_K; i++)
+	{
+		for (j = 0; j < QSC_KYBER_N / 8; j++)
+		{
+			r->vec[i].coeffs[(8 * j)] = (((a[(11 * j)] | (((uint32_t)a[(11 * j) + 1] & 0x07) << 8)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 1] = ((((a[(11 * j) + 1] >> 3) | (((uint32_t)a[(11 * j) + 2] & 0x3F) << 5)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 2] = ((((a[(11 * j) + 2] >> 6) | (((uint32_t)a[(11 * j) + 3] & 0xFF) << 2) | (((uint32_t)a[(11 * j) + 4] & 0x01) << 10)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 3] = ((((a[(11 * j) + 4] >> 1) | (((uint32_t)a[(11 * j) + 5] & 0x0F) << 7)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 4] = ((((a[(11 * j) + 5] >> 4) | (((uint32_t)a[(11 * j) + 6] & 0x7F) << 4)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 5] = ((((a[(11 * j) + 6] >> 7) | (((uint32_t)a[(11 * j) + 7] & 0xFF) << 1) | (((uint32_t)a[(11 * j) + 8] & 0x03) << 9)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 6] = ((((a[(11 * j) + 8] >> 2) | (((uint32_t)a[(11 * j) + 9] & 0x1F) << 6)) * QSC_KYBER_Q) + 1024) >> 11;
+			r->vec[i].coeffs[(8 * j) + 7] = ((((a[(11 * j) + 9] >> 5) | (((uint32_t)a[(11 * j) + 10] & 0xFF) << 3)) * QSC_KYBER_Q) + 1024) >> 11;
+		}
+
+		a += KYBER_POLYVECBASEBYTES;
+	}
+
+#elif (KYBER_POLYVECBASEBYTES == 320)
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		for (j = 0; j < QSC_KYBER_N / 4; ++j)
+		{
+			r->vec[i].coeffs[4 * j] = (((a[5 * j] | (((uint32_t)a[(5 * j) + 1] & 0x03U) << 8U)) * QSC_KYBER_Q) + 512) >> 10U;
+			r->vec[i].coeffs[(4 * j) + 1] = ((((a[(5 * j) + 1] >> 2U) | (((uint32_t)a[(5 * j) + 2] & 0x0FU) << 6U)) * QSC_KYBER_Q) + 512) >> 10U;
+			r->vec[i].coeffs[(4 * j) + 2] = ((((a[(5 * j) + 2] >> 4U) | (((uint32_t)a[(5 * j) + 3] & 0x3FU) << 4U)) * QSC_KYBER_Q) + 512) >> 10U;
+			r->vec[i].coeffs[(4 * j) + 3] = ((((a[(5 * j) + 3] >> 6U) | (((uint32_t)a[(5 * j) + 4] & 0xFFU) << 2U)) * QSC_KYBER_Q) + 512) >> 10U;
+		}
+
+		a += KYBER_POLYVECBASEBYTES;
+	}
+
+#endif
+}
+
+/**
+* \brief Serialize a vector of polynomials.
+*
+* \param r Pointer to output byte array
+* \param a Pointer to input vector of polynomials
+*/
+static void qsc_kyber_polyvec_tobytes(uint8_t* r, qsc_kyber_polyvec* a)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_tobytes(r + (i * KYBER_POLYBYTES), &a->vec[i]);
+	}
+}
+
+/**
+* \brief De-serialize vector of polynomials; inverse of qsc_kyber_polyvec_tobytes.
+*
+* \param r Pointer to output byte array
+* \param a Pointer to input vector of polynomials
+*/
+static void qsc_kyber_polyvec_frombytes(qsc_kyber_polyvec* r, const uint8_t* a)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_frombytes(&r->vec[i], a + (i * KYBER_POLYBYTES));
+	}
+}
+
+/**
+* \brief Apply forward NTT to all elements of a vector of polynomials.
+*
+* \param r Pointer to in/output vector of polynomials
+*/
+static void qsc_kyber_polyvec_ntt(qsc_kyber_polyvec* r)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_ntt(&r->vec[i]);
+	}
+}
+
+/**
+* \brief Apply inverse NTT to all elements of a vector of polynomials.
+*
+* \param r Pointer to in/output vector of polynomials
+*/
+static void qsc_kyber_polyvec_invntt(qsc_kyber_polyvec* r)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_invntt(&r->vec[i]);
+	}
+}
+
+/**
+* \brief Pointwise multiply elements of a and b and accumulate into r.
+*
+* \param r Pointer to output polynomial
+* \param a Pointer to first input vector of polynomials
+* \param b Pointer to second input vector of polynomials
+*/
+static void qsc_kyber_polyvec_pointwise_acc(qsc_kyber_poly* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	__m512i acc;
+	__m512i z;
+	size_t i;
+	size_t j;
+
+	/* accumulate the products in registers and reduce once per vector */
+	for (i = 0; i < QSC_KYBER_N; i += 32)
+	{
+		z = _mm512_inserti64x4(_mm512_castsi256_si512(kyber_basemul_zetas_avx2(qsc_kyber_zetas + 64 + (i / 4))),
+			kyber_basemul_zetas_avx2(qsc_kyber_zetas + 68 + (i / 4)), 1);
+		acc = kyber_basemul_avx512(_mm512_loadu_si512((const __m512i*)(a->vec[0].coeffs + i)),
+			_mm512_loadu_si512((const __m512i*)(b->vec[0].coeffs + i)), z);
+
+		for (j = 1; j < KYBER_K; ++j)
+		{
+			acc = _mm512_add_epi16(acc, kyber_basemul_avx512(_mm512_loadu_si512((const __m512i*)(a->vec[j].coeffs + i)),
+				_mm512_loadu_si512((const __m512i*)(b->vec[j].coeffs + i)), z));
+		}
+
+		_mm512_storeu_si512((__m512i*)(r->coeffs + i), kyber_barrett_avx512(acc));
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i acc;
+	__m256i z;
+	size_t i;
+	size_t j;
+
+	/* accumulate the products in registers and reduce once per vector */
+	for (i = 0; i < QSC_KYBER_N; i += 16)
+	{
+		z = kyber_basemul_zetas_avx2(qsc_kyber_zetas + 64 + (i / 4));
+		acc = kyber_basemul_avx2(_mm256_loadu_si256((const __m256i*)(a->vec[0].coeffs + i)),
+			_mm256_loadu_si256((const __m256i*)(b->vec[0].coeffs + i)), z);
+
+		for (j = 1; j < KYBER_K; ++j)
+		{
+			acc = _mm256_add_epi16(acc, kyber_basemul_avx2(_mm256_loadu_si256((const __m256i*)(a->vec[j].coeffs + i)),
+				_mm256_loadu_si256((const __m256i*)(b->vec[j].coeffs + i)), z));
+		}
+
+		_mm256_storeu_si256((__m256i*)(r->coeffs + i), kyber_barrett_avx2(acc));
+	}
+#else
+	qsc_kyber_poly t;
+	size_t i;
+
+	qsc_kyber_poly_basemul(r, &a->vec[0], &b->vec[0]);
+
+	for (i = 1; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_basemul(&t, &a->vec[i], &b->vec[i]);
+		qsc_kyber_poly_add(r, r, &t);
+	}
+
+	qsc_kyber_poly_reduce(r);
+#endif
+}
+
+/**
+* \brief Add vectors of polynomials.
+*
+* \param r Pointer to output vector of polynomials
+* \param a Pointer to first input vector of polynomials
+* \param b Pointer to second input vector of polynomials
+*/
+static void qsc_kyber_polyvec_add(qsc_kyber_polyvec* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b)
+{
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_poly_add(&r->vec[i], &a->vec[i], &b->vec[i]);
+	}
+}
+
+/* indcpa.c */
+
+static void pack_pk(uint8_t* r, qsc_kyber_polyvec* pk, const uint8_t* seed)
+{
+	size_t i;
+
+	qsc_kyber_polyvec_tobytes(r, pk);
+
+	for (i = 0; i < QSC_KYBER_SYMBYTES; ++i)
+	{
+		r[i + KYBER_POLYVECBYTES] = seed[i];
+	}
+}
+
+static void unpack_pk(qsc_kyber_polyvec* pk, uint8_t* seed, const uint8_t* packedpk)
+{
+	size_t i;
+
+	qsc_kyber_polyvec_frombytes(pk, packedpk);
+
+	for (i = 0; i < QSC_KYBER_SYMBYTES; ++i)
+	{
+		seed[i] = packedpk[i + KYBER_POLYVECBYTES];
+	}
+}
+
+static void pack_sk(uint8_t* r, qsc_kyber_polyvec* sk)
+{
+	qsc_kyber_polyvec_tobytes(r, sk);
+}
+
+static void unpack_sk(qsc_kyber_polyvec* sk, const uint8_t* packedsk)
+{
+	qsc_kyber_polyvec_frombytes(sk, packedsk);
+}
+
+static void pack_ciphertext(uint8_t* r, qsc_kyber_polyvec* b, qsc_kyber_poly *v)
+{
+	qsc_kyber_polyvec_compress(r, b);
+	qsc_kyber_poly_compress(r + KYBER_POLYVECCOMPRESSEDBYTES, v);
+}
+
+static void unpack_ciphertext(qsc_kyber_polyvec* b, qsc_kyber_poly *v, const uint8_t* c)
+{
+	qsc_kyber_polyvec_decompress(b, c);
+	qsc_kyber_poly_decompress(v, c + KYBER_POLYVECCOMPRESSEDBYTES);
+}
+
+static void gen_matrix(qsc_kyber_polyvec* a, const uint8_t* seed, int32_t transposed)
+{
+	uint8_t buf[KYBER_GEN_MATRIX_LANES][KYBER_GEN_MATRIX_NBLOCKS * QSC_KECCAK_128_RATE];
+	uint8_t extseed[KYBER_GEN_MATRIX_LANES][QSC_KYBER_SYMBYTES + 2];
+	qsc_kyber_poly* pa[KYBER_GEN_MATRIX_LANES];
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t n;
+	size_t pos;
+	uint32_t ctr;
+
+	/* the K x K polynomials are drawn in batches, one SHAKE-128 lane per polynomial */
+	for (pos = 0; pos < KYBER_K * KYBER_K; pos += n)
+	{
+		n = KYBER_K * KYBER_K - pos;
+		n = (n > KYBER_GEN_MATRIX_LANES) ? KYBER_GEN_MATRIX_LANES : n;
+
+		for (k = 0; k < n; ++k)
+		{
+			i = (pos + k) / KYBER_K;
+			j = (pos + k) % KYBER_K;
+			pa[k] = &a[i].vec[j];
+			qsc_memutils_copy(extseed[k], seed, QSC_KYBER_SYMBYTES);
+
+			if (transposed)
+			{
+				extseed[k][QSC_KYBER_SYMBYTES] = (uint8_t)i;
+				extseed[k][QSC_KYBER_SYMBYTES + 1] = (uint8_t)j;
+			}
+			else
+			{
+				extseed[k][QSC_KYBER_SYMBYTES] = (uint8_t)j;
+				extseed[k][QSC_KYBER_SYMBYTES + 1] = (uint8_t)i;
+			}
+		}
+
+		k = 0;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		if (n == 8)
+		{
+			shake128x8(buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7], sizeof(buf[0]),
+				extseed[0], extseed[1], extseed[2], extseed[3], extseed[4], extseed[5], extseed[6], extseed[7], sizeof(extseed[0]));
+			k = 8;
+		}
+#endif
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		for (; k + 4 <= n; k += 4)
+		{
+			shake128x4(buf[k], buf[k + 1], buf[k + 2], buf[k + 3], sizeof(buf[0]),
+				extseed[k], extseed[k + 1], extseed[k + 2], extseed[k + 3], sizeof(extseed[0]));
+		}
+#endif
+
+		for (; k < n; ++k)
+		{
+			qsc_shake128_compute(buf[k], sizeof(buf[0]), extseed[k], sizeof(extseed[0]));
+		}
+
+		for (k = 0; k < n; ++k)
+		{
+			ctr = rej_uniform(pa[k]->coeffs, QSC_KYBER_N, buf[k], sizeof(buf[0]));
+
+			if (ctr < QSC_KYBER_N)
+			{
+				gen_matrix_resume(pa[k], ctr, extseed[k]);
+			}
+		}
+	}
+}
+
+/**
+* \brief Generates public and private key for the CPA-secure public-key encryption scheme underlying Kyber.
+*
+* \param pk Pointer to output public key
+* \param sk Pointer to output private key
+*/
+static void qsc_kyber_indcpa_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
+{
+	qsc_kyber_polyvec a[KYBER_K];
+	qsc_kyber_polyvec e;
+	qsc_kyber_polyvec pkpv;
+	qsc_kyber_polyvec skpv;
+	qsc_kyber_poly* noise[2 * KYBER_K];
+	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+	const uint8_t* publicseed = buf;
+	const uint8_t* noiseseed = buf + QSC_KYBER_SYMBYTES;
+	size_t i;
+
+	rng_generate(buf, QSC_KYBER_SYMBYTES);
+	qsc_sha3_compute512(buf, buf, QSC_KYBER_SYMBYTES);
+
+	gen_matrix(a, publicseed, 0);
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		noise[i] = skpv.vec + i;
+		noise[KYBER_K + i] = e.vec + i;
+	}
+
+	getnoise_batch(noise, 2 * KYBER_K, noiseseed, 0);
+
+	qsc_kyber_polyvec_ntt(&skpv);
+	qsc_kyber_polyvec_ntt(&e);
+
+	/* matrix-vector multiplication */
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_polyvec_pointwise_acc(&pkpv.vec[i], &a[i], &skpv);
+		qsc_kyber_poly_frommont(&pkpv.vec[i]);
+	}
+
+	qsc_kyber_polyvec_add(&pkpv, &pkpv, &e);
+	qsc_kyber_polyvec_reduce(&pkpv);
+
+	pack_sk(sk, &skpv);
+	pack_pk(pk, &pkpv, publicseed);
+}
+
+/**
+* \brief Encryption function of the CPA-secure public-key encryption scheme underlying Kyber,
+* using the expanded public key and noise polynomials that were already sampled.
+*
+* \param c Pointer to output ciphertext
+* \param m Pointer to input message (of length KYBER_KEYBYTES bytes)
+* \param at Pointer to the transposed public matrix
+* \param pkpv Pointer to the public key vector, in the NTT domain
+* \param sp Pointer to the secret noise vector; transformed to the NTT domain in place
+* \param ep Pointer to the error noise vector
+* \param epp Pointer to the error noise polynomial
+*/
+static void indcpa_enc_sampled(uint8_t* c, const uint8_t* m, const qsc_kyber_polyvec* at, const qsc_kyber_polyvec* pkpv,
+	qsc_kyber_polyvec* sp, const qsc_kyber_polyvec* ep, const qsc_kyber_poly* epp)
+{
+	qsc_kyber_polyvec bp;
+	qsc_kyber_poly k;
+	qsc_kyber_poly v;
+	size_t i;
+
+	qsc_kyber_poly_frommsg(&k, m);
+	qsc_kyber_polyvec_ntt(sp);
+
+	/* matrix-vector multiplication */
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		qsc_kyber_polyvec_pointwise_acc(&bp.vec[i], &at[i], sp);
+	}
+
+	qsc_kyber_polyvec_pointwise_acc(&v, pkpv, sp);
+	qsc_kyber_polyvec_invntt(&bp);
+	qsc_kyber_poly_invntt(&v);
+
+	qsc_kyber_polyvec_add(&bp, &bp, ep);
+	qsc_kyber_poly_add(&v, &v, epp);
+	qsc_kyber_poly_add(&v, &v, &k);
+	qsc_kyber_polyvec_reduce(&bp);
+	qsc_kyber_poly_reduce(&v);
+
+	pack_ciphertext(c, &bp, &v);
+}
+
+/**
+* \brief Encryption function of the CPA-secure public-key encryption scheme underlying Kyber,
+* using the expanded public key.
+*
+* \param c Pointer to output ciphertext
+* \param m Pointer to input message (of length KYBER_KEYBYTES bytes)
+* \param at Pointer to the transposed public matrix
+* \param pkpv Pointer to the public key vector, in the NTT domain
+* \param coins Pointer to input random coins used as seed to deterministically generate all randomness
+*/
+static void qsc_kyber_indcpa_enc(uint8_t* c, const uint8_t* m, const qsc_kyber_polyvec* at, const qsc_kyber_polyvec* pkpv, const uint8_t* coins)
+{
+	qsc_kyber_polyvec sp;
+	qsc_kyber_polyvec ep;
+	qsc_kyber_poly epp;
+	qsc_kyber_poly* noise[(2 * KYBER_K) + 1];
+	size_t i;
+
+	for (i = 0; i < KYBER_K; ++i)
+	{
+		noise[i] = sp.vec + i;
+		noise[KYBER_K + i] = ep.vec + i;
+	}
+
+	noise[2 * KYBER_K] = &epp;
+	getnoise_batch(noise, (2 * KYBER_K) + 1, coins, 0);
+	indcpa_enc_sampled(c, m, at, pkpv, &sp, &ep, &epp);
+}
+
+/**
+* \brief Decryption function of the CPA-secure public-key encryption scheme underlying Kyber.
+*
+* \param m Pointer to output decrypted message
+* \param c Pointer to input ciphertext
+* \param skpv Pointer to the secret key vector, in the NTT domain
+*/
+static void qsc_kyber_indcpa_dec(uint8_t* m, const uint8_t* c, const qsc_kyber_polyvec* skpv)
+{
+	qsc_kyber_polyvec bp;
+	qsc_kyber_poly v;
+	qsc_kyber_poly mp;
+
+	unpack_ciphertext(&bp, &v, c);
+
+	qsc_kyber_polyvec_ntt(&bp);
+	qsc_kyber_polyvec_pointwise_acc(&mp, skpv, &bp);
+	qsc_kyber_poly_invntt(&mp);
+
+	qsc_kyber_poly_sub(&mp, &v, &mp);
+	qsc_kyber_poly_reduce(&mp);
+
+	qsc_kyber_poly_tomsg(m, &mp);
+}
+
+/**
+* \brief Expands a packed public key; decodes the public vector and samples the transposed matrix from its seed.
+*
+* \param at Pointer to the output transposed matrix
+* \param pkpv Pointer to the output public key vector
+* \param pk Pointer to the input packed public key
+*/
+static void expand_pk(qsc_kyber_polyvec* at, qsc_kyber_polyvec* pkpv, const uint8_t* pk)
+{
+	uint8_t seed[QSC_KYBER_SYMBYTES];
+
+	unpack_pk(pkpv, seed, pk);
+	gen_matrix(at, seed, 1);
+}
+
+/* kem.h */
+
+static void kem_enc_expanded(uint8_t* ct, uint8_t* ss, const qsc_kyber_polyvec* at, const qsc_kyber_polyvec* pkpv, const uint8_t* pkhash, void (*rng_generate)(uint8_t*, size_t))
+{
+	/* Will contain key, coins */
+	uint8_t  kr[2 * QSC_KYBER_SYMBYTES];
+	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+
+	rng_generate(buf, QSC_KYBER_SYMBYTES);
+	/* Don't release system RNG output */
+	qsc_sha3_compute256(buf, buf, QSC_KYBER_SYMBYTES);
+	/* Multitarget countermeasure for coins + contributory KEM */
+	qsc_memutils_copy(buf + QSC_KYBER_SYMBYTES, pkhash, QSC_KYBER_SYMBYTES);
+	qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+	/* coins are in kr+QSC_KYBER_SYMBYTES */
+	qsc_kyber_indcpa_enc(ct, buf, at, pkpv, kr + QSC_KYBER_SYMBYTES);
+	/* overwrite coins in kr with H(c) */
+	qsc_sha3_compute256(kr + QSC_KYBER_SYMBYTES, ct, KYBER_CIPHERTEXT_SIZE);
+	/* hash concatenation of pre-k and H(c) to k */
+	qsc_shake256_compute(ss, QSC_KYBER_SYMBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+}
+
+static bool kem_dec_expanded(uint8_t* ss, const uint8_t* ct, const qsc_kyber_polyvec* at, const qsc_kyber_polyvec* pkpv,
+	const qsc_kyber_polyvec* skpv, const uint8_t* pkhash, const uint8_t* z)
+{
+	uint8_t cmp[KYBER_CIPHERTEXT_SIZE];
+	uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+	/* Will contain key, coins */
+	uint8_t kr[2 * QSC_KYBER_SYMBYTES];
+	int32_t fail;
+
+	qsc_kyber_indcpa_dec(buf, ct, skpv);
+
+	/* Multitarget countermeasure for coins + contributory KEM */
+	qsc_memutils_copy(buf + QSC_KYBER_SYMBYTES, pkhash, QSC_KYBER_SYMBYTES);
+
+	qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+	/* coins are in kr+QSC_KYBER_SYMBYTES */
+	qsc_kyber_indcpa_enc(cmp, buf, at, pkpv, kr + QSC_KYBER_SYMBYTES);
+
+	fail = qsc_intutils_verify(ct, cmp, KYBER_CIPHERTEXT_SIZE);
+	/* overwrite coins in kr with H(c) */
+	qsc_sha3_compute256(kr + QSC_KYBER_SYMBYTES, ct, KYBER_CIPHERTEXT_SIZE);
+	/* Overwrite pre-k with z on re-encryption failure */
+	qsc_intutils_cmov(kr, z, QSC_KYBER_SYMBYTES, (uint8_t)fail);
+	/* hash concatenation of pre-k and H(c) to k */
+	qsc_shake256_compute(ss, QSC_KYBER_SYMBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+
+	return (bool)(fail == 0);
+}
+
+void qsc_kyber_crypto_kem_keypair(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
+{
+	size_t i;
+
+	qsc_kyber_indcpa_keypair(pk, sk, rng_generate);
+
+	for (i = 0; i < KYBER_INDCPA_PUBLICKEYBYTES; ++i)
+	{
+		sk[i + KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
+	}
+
+	qsc_sha3_compute256(sk + KYBER_SECRETKEY_SIZE - 2 * QSC_KYBER_SYMBYTES, pk, KYBER_PUBLICKEY_SIZE);
+	/* Value z for pseudo-random output on reject */
+	rng_generate(sk + KYBER_SECRETKEY_SIZE - QSC_KYBER_SYMBYTES, QSC_KYBER_SYMBYTES);
+}
+
+void qsc_kyber_crypto_kem_enc(uint8_t* ct, uint8_t* ss, const uint8_t* pk, void (*rng_generate)(uint8_t*, size_t))
+{
+	qsc_kyber_polyvec at[KYBER_K];
+	qsc_kyber_polyvec pkpv;
+	uint8_t pkhash[QSC_KYBER_SYMBYTES];
+
+	qsc_sha3_compute256(pkhash, pk, KYBER_PUBLICKEY_SIZE);
+	expand_pk(at, &pkpv, pk);
+	kem_enc_expanded(ct, ss, at, &pkpv, pkhash, rng_generate);
+}
+
+bool qsc_kyber_crypto_kem_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk)
+{
+	qsc_kyber_polyvec at[KYBER_K];
+	qsc_kyber_polyvec pkpv;
+	qsc_kyber_polyvec skpv;
+	bool res;
+
+	unpack_sk(&skpv, sk);
+	expand_pk(at, &pkpv, sk + KYBER_INDCPA_SECRETKEYBYTES);
+	/* H(pk) and z are stored at the end of the secret key */
+	res = kem_dec_expanded(ss, ct, at, &pkpv, &skpv, sk + KYBER_SECRETKEY_SIZE - (2 * QSC_KYBER_SYMBYTES),
+		sk + KYBER_SECRETKEY_SIZE - QSC_KYBER_SYMBYTES);
+
+	return res;
+}
+
+void qsc_kyber_crypto_kem_prepare_pk(qsc_kyber_prepared_publickey* ppk, const uint8_t* pk)
+{
+	qsc_sha3_compute256(ppk->pkhash, pk, KYBER_PUBLICKEY_SIZE);
+	expand_pk((qsc_kyber_polyvec*)ppk->at, (qsc_kyber_polyvec*)ppk->pkpv, pk);
+}
+
+void qsc_kyber_crypto_kem_prepare_sk(qsc_kyber_prepared_privatekey* psk, const uint8_t* sk)
+{
+	unpack_sk((qsc_kyber_polyvec*)psk->skpv, sk);
+	expand_pk((qsc_kyber_polyvec*)psk->ppk.at, (qsc_kyber_polyvec*)psk->ppk.pkpv, sk + KYBER_INDCPA_SECRETKEYBYTES);
+	qsc_memutils_copy(psk->ppk.pkhash, sk + KYBER_SECRETKEY_SIZE - (2 * QSC_KYBER_SYMBYTES), QSC_KYBER_SYMBYTES);
+	qsc_memutils_copy(psk->z, sk + KYBER_SECRETKEY_SIZE - QSC_KYBER_SYMBYTES, QSC_KYBER_SYMBYTES);
+}
+
+void qsc_kyber_crypto_kem_enc_prepared(uint8_t* ct, uint8_t* ss, const qsc_kyber_prepared_publickey* ppk, void (*rng_generate)(uint8_t*, size_t))
+{
+	kem_enc_expanded(ct, ss, (const qsc_kyber_polyvec*)ppk->at, (const qsc_kyber_polyvec*)ppk->pkpv, ppk->pkhash, rng_generate);
+}
+
+bool qsc_kyber_crypto_kem_dec_prepared(uint8_t* ss, const uint8_t* ct, const qsc_kyber_prepared_privatekey* psk)
+{
+	bool res;
+
+	res = kem_dec_expanded(ss, ct, (const qsc_kyber_polyvec*)psk->ppk.at, (const qsc_kyber_polyvec*)psk->ppk.pkpv,
+		(const qsc_kyber_polyvec*)psk->skpv, psk->ppk.pkhash, psk->z);
+
+	return res;
+}
+
+size_t qsc_kyber_crypto_kem_dec_batch(uint8_t* ss, bool* valid, const uint8_t* ct, size_t count, const qsc_kyber_prepared_privatekey* psk)
+{
+	qsc_kyber_polyvec sp[4];
+	qsc_kyber_polyvec ep[4];
+	qsc_kyber_poly epp[4];
+	qsc_kyber_poly* noise[4 * ((2 * KYBER_K) + 1)];
+	uint8_t cmp[KYBER_CIPHERTEXT_SIZE];
+	uint8_t buf[4][2 * QSC_KYBER_SYMBYTES];
+	/* Will contain key, coins */
+	uint8_t kr[4][2 * QSC_KYBER_SYMBYTES];
+	const qsc_kyber_polyvec* at = (const qsc_kyber_polyvec*)psk->ppk.at;
+	const qsc_kyber_polyvec* pkpv = (const qsc_kyber_polyvec*)psk->ppk.pkpv;
+	const qsc_kyber_polyvec* skpv = (const qsc_kyber_polyvec*)psk->skpv;
+	const uint8_t* pct;
+	size_t i;
+	size_t j;
+	size_t n;
+	size_t passed;
+	int32_t fail;
+	bool res;
+
+	passed = 0;
+
+	for (i = 0; i < 4; ++i)
+	{
+		for (j = 0; j < KYBER_K; ++j)
+		{
+			noise[(i * ((2 * KYBER_K) + 1)) + j] = sp[i].vec + j;
+			noise[(i * ((2 * KYBER_K) + 1)) + KYBER_K + j] = ep[i].vec + j;
+		}
+
+		noise[(i * ((2 * KYBER_K) + 1)) + (2 * KYBER_K)] = &epp[i];
+	}
+
+	/* the re-encryption of four ciphertexts shares each SHAKE-256 pass of the noise sampling and the key derivation */
+	for (n = 0; n + 4 <= count; n += 4)
+	{
+		for (i = 0; i < 4; ++i)
+		{
+			qsc_kyber_indcpa_dec(buf[i], ct + ((n + i) * KYBER_CIPHERTEXT_SIZE), skpv);
+			/* Multitarget countermeasure for coins + contributory KEM */
+			qsc_memutils_copy(buf[i] + QSC_KYBER_SYMBYTES, psk->ppk.pkhash, QSC_KYBER_SYMBYTES);
+			qsc_sha3_compute512(kr[i], buf[i], 2 * QSC_KYBER_SYMBYTES);
+		}
+
+		/* coins are in kr+QSC_KYBER_SYMBYTES */
+		getnoise_lanes4(noise, (2 * KYBER_K) + 1, kr[0] + QSC_KYBER_SYMBYTES, kr[1] + QSC_KYBER_SYMBYTES,
+			kr[2] + QSC_KYBER_SYMBYTES, kr[3] + QSC_KYBER_SYMBYTES);
+
+		for (i = 0; i < 4; ++i)
+		{
+			pct = ct + ((n + i) * KYBER_CIPHERTEXT_SIZE);
+			indcpa_enc_sampled(cmp, buf[i], at, pkpv, &sp[i], &ep[i], &epp[i]);
+
+			fail = qsc_intutils_verify(pct, cmp, KYBER_CIPHERTEXT_SIZE);
+			/* overwrite coins in kr with H(c) */
+			qsc_sha3_compute256(kr[i] + QSC_KYBER_SYMBYTES, pct, KYBER_CIPHERTEXT_SIZE);
+			/* Overwrite pre-k with z on re-encryption failure */
+			qsc_intutils_cmov(kr[i], psk->z, QSC_KYBER_SYMBYTES, (uint8_t)fail);
+
+			if (valid != NULL)
+			{
+				valid[n + i] = (fail == 0);
+			}
+
+			passed += (fail == 0) ? 1 : 0;
+		}
+
+		/* hash concatenation of pre-k and H(c) to k */
+		shake256x4(ss + (n * QSC_KYBER_SYMBYTES), ss + ((n + 1) * QSC_KYBER_SYMBYTES), ss + ((n + 2) * QSC_KYBER_SYMBYTES),
+			ss + ((n + 3) * QSC_KYBER_SYMBYTES), QSC_KYBER_SYMBYTES, kr[0], kr[1], kr[2], kr[3], 2 * QSC_KYBER_SYMBYTES);
+	}
+
+	for (; n < count; ++n)
+	{
+		res = kem_dec_expanded(ss + (n * QSC_KYBER_SYMBYTES), ct + (n * KYBER_CIPHERTEXT_SIZE), at, pkpv, skpv, psk->ppk.pkhash, psk->z);
+
+		if (valid != NULL)
+		{
+			valid[n] = res;
+		}
+
+		passed += (res == true) ? 1 : 0;
+	}
+
+	return passed;
+}
+
+#undef KYBER_POLYVECBASEBYTES
+#undef KYBER_POLYCOMPRESSEDBYTES
+#undef KYBER_POLYVECCOMPRESSEDBYTES
+#undef KYBER_POLYVECBYTES
+#undef KYBER_INDCPA_PUBLICKEYBYTES
+#undef KYBER_INDCPA_SECRETKEYBYTES
+#undef KYBER_INDCPA_BYTES
+#undef KYBER_PUBLICKEY_SIZE
+#undef KYBER_SECRETKEY_SIZE
+#undef KYBER_CIPHERTEXT_SIZE
+#undef qsc_kyber_polyvec_compress
+#undef qsc_kyber_polyvec_decompress
+#undef qsc_kyber_polyvec_tobytes
+#undef qsc_kyber_polyvec_frombytes
+#undef qsc_kyber_polyvec_ntt
+#undef qsc_kyber_polyvec_invntt
+#undef qsc_kyber_polyvec_pointwise_acc
+#undef qsc_kyber_polyvec_reduce
+#undef qsc_kyber_polyvec_csubq
+#undef qsc_kyber_polyvec_add
+#undef qsc_kyber_poly_compress
+#undef qsc_kyber_poly_decompress
+#undef qsc_kyber_polyvec
+#undef pack_pk
+#undef unpack_pk
+#undef pack_sk
+#undef unpack_sk
+#undef pack_ciphertext
+#undef unpack_ciphertext
+#undef gen_matrix
+#undef qsc_kyber_indcpa_keypair
+#undef qsc_kyber_indcpa_enc
+#undef qsc_kyber_indcpa_dec
+#undef qsc_kyber_crypto_kem_keypair
+#undef qsc_kyber_crypto_kem_enc
+#undef qsc_kyber_crypto_kem_dec
+#undef expand_pk
+#undef indcpa_enc_sampled
+#undef qsc_kyber_crypto_kem_dec_batch
+#undef kem_enc_expanded
+#undef kem_dec_expanded
+#undef qsc_kyber_crypto_kem_prepare_pk
+#undef qsc_kyber_crypto_kem_prepare_sk
+#undef qsc_kyber_crypto_kem_enc_prepared
+#undef qsc_kyber_crypto_kem_dec_prepared
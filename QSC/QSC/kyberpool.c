@@ -0,0 +1,339 @@
+#include "kyberpool.h"
+#include "memutils.h"
+#include "secmem.h"
+#include <stdlib.h>
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+/* slot states; a slot moves empty -> filling -> ready on the worker, and ready -> taken -> empty on a caller */
+#define KYBERPOOL_SLOT_EMPTY 0
+#define KYBERPOOL_SLOT_FILLING 1
+#define KYBERPOOL_SLOT_READY 2
+#define KYBERPOOL_SLOT_TAKEN 3
+
+#if !defined(QSC_SYSTEM_OS_WINDOWS)
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	bool pending;
+} kyberpool_signal_state;
+#endif
+
+static bool kyberpool_cas(volatile int32_t* target, int32_t expected, int32_t desired)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	return (InterlockedCompareExchange((volatile LONG*)target, (LONG)desired, (LONG)expected) == (LONG)expected);
+#else
+	return __atomic_compare_exchange_n(target, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static int32_t kyberpool_fetch_add(volatile int32_t* target, int32_t value)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	return (int32_t)InterlockedExchangeAdd((volatile LONG*)target, (LONG)value);
+#else
+	return __atomic_fetch_add(target, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static int32_t kyberpool_load(volatile int32_t* target)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	return (int32_t)InterlockedCompareExchange((volatile LONG*)target, 0, 0);
+#else
+	return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void kyberpool_store(volatile int32_t* target, int32_t value)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	InterlockedExchange((volatile LONG*)target, (LONG)value);
+#else
+	__atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static void* kyberpool_signal_create()
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	/* an auto-reset event; a set that arrives before the worker waits is not lost */
+	return (void*)CreateEvent(NULL, FALSE, FALSE, NULL);
+#else
+	kyberpool_signal_state* sig;
+
+	sig = (kyberpool_signal_state*)malloc(sizeof(kyberpool_signal_state));
+
+	if (sig != NULL)
+	{
+		sig->pending = false;
+
+		if (pthread_mutex_init(&sig->mutex, NULL) != 0)
+		{
+			free(sig);
+			sig = NULL;
+		}
+		else if (pthread_cond_init(&sig->cond, NULL) != 0)
+		{
+			pthread_mutex_destroy(&sig->mutex);
+			free(sig);
+			sig = NULL;
+		}
+	}
+
+	return (void*)sig;
+#endif
+}
+
+static void kyberpool_signal_destroy(void* signal)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	CloseHandle((HANDLE)signal);
+#else
+	kyberpool_signal_state* sig = (kyberpool_signal_state*)signal;
+
+	pthread_cond_destroy(&sig->cond);
+	pthread_mutex_destroy(&sig->mutex);
+	free(sig);
+#endif
+}
+
+static void kyberpool_signal_set(void* signal)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	SetEvent((HANDLE)signal);
+#else
+	kyberpool_signal_state* sig = (kyberpool_signal_state*)signal;
+
+	pthread_mutex_lock(&sig->mutex);
+	sig->pending = true;
+	pthread_cond_signal(&sig->cond);
+	pthread_mutex_unlock(&sig->mutex);
+#endif
+}
+
+static void kyberpool_signal_wait(void* signal)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	WaitForSingleObject((HANDLE)signal, INFINITE);
+#else
+	kyberpool_signal_state* sig = (kyberpool_signal_state*)signal;
+
+	pthread_mutex_lock(&sig->mutex);
+
+	while (sig->pending == false)
+	{
+		pthread_cond_wait(&sig->cond, &sig->mutex);
+	}
+
+	sig->pending = false;
+	pthread_mutex_unlock(&sig->mutex);
+#endif
+}
+
+static void kyberpool_fill(qsc_kyberpool_state* ctx)
+{
+	uint8_t* pk;
+	size_t i;
+
+	/* top the pool up to full once it drops below the low-water mark */
+	for (i = 0; i < ctx->depth && kyberpool_load(&ctx->running) != 0; ++i)
+	{
+		/* only the worker moves a slot out of the empty state */
+		if (kyberpool_cas(&ctx->slots[i], KYBERPOOL_SLOT_EMPTY, KYBERPOOL_SLOT_FILLING) == true)
+		{
+			pk = ctx->keys + (i * (ctx->pklen + ctx->sklen));
+			qsc_kyber_generate_keypair_ex(pk, pk + ctx->pklen, ctx->rng_generate, ctx->params);
+			kyberpool_store(&ctx->slots[i], KYBERPOOL_SLOT_READY);
+			kyberpool_fetch_add(&ctx->ready, 1);
+		}
+	}
+}
+
+static void kyberpool_worker(qsc_kyberpool_state* ctx)
+{
+	while (kyberpool_load(&ctx->running) != 0)
+	{
+		if ((size_t)kyberpool_load(&ctx->ready) < ctx->lowwater)
+		{
+			kyberpool_fill(ctx);
+		}
+		else
+		{
+			/* sleep until a caller takes the pool below the low-water mark, or the pool is disposed */
+			kyberpool_signal_wait(ctx->signal);
+		}
+	}
+}
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+static DWORD WINAPI kyberpool_thread(LPVOID ctx)
+{
+	kyberpool_worker((qsc_kyberpool_state*)ctx);
+
+	return 0;
+}
+#else
+static void* kyberpool_thread(void* ctx)
+{
+	kyberpool_worker((qsc_kyberpool_state*)ctx);
+
+	return NULL;
+}
+#endif
+
+size_t qsc_kyberpool_available(qsc_kyberpool_state* ctx)
+{
+	assert(ctx != NULL);
+
+	return (size_t)kyberpool_load(&ctx->ready);
+}
+
+void qsc_kyberpool_dispose(qsc_kyberpool_state* ctx)
+{
+	if (ctx != NULL)
+	{
+		kyberpool_store(&ctx->running, 0);
+
+		if (ctx->worker != NULL)
+		{
+			kyberpool_signal_set(ctx->signal);
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+			WaitForSingleObject((HANDLE)ctx->worker, INFINITE);
+			CloseHandle((HANDLE)ctx->worker);
+#else
+			pthread_join(*(pthread_t*)ctx->worker, NULL);
+			free(ctx->worker);
+#endif
+			ctx->worker = NULL;
+		}
+
+		if (ctx->signal != NULL)
+		{
+			kyberpool_signal_destroy(ctx->signal);
+			ctx->signal = NULL;
+		}
+
+		if (ctx->keys != NULL)
+		{
+			qsc_secmem_erase(ctx->keys, ctx->keyslen);
+			qsc_secmem_free(ctx->keys, ctx->keyslen);
+			ctx->keys = NULL;
+		}
+
+		qsc_memutils_clear((uint8_t*)ctx->slots, sizeof(ctx->slots));
+		ctx->depth = 0;
+		ctx->keyslen = 0;
+		ctx->lowwater = 0;
+		ctx->ready = 0;
+		ctx->cursor = 0;
+	}
+}
+
+bool qsc_kyberpool_initialize(qsc_kyberpool_state* ctx, size_t depth, size_t lowwater, qsc_kyber_parameters params, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(ctx != NULL);
+	assert(rng_generate != NULL);
+
+	bool res;
+
+	res = false;
+	qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_kyberpool_state));
+
+	ctx->pklen = qsc_kyber_publickey_size(params);
+	ctx->sklen = qsc_kyber_privatekey_size(params);
+
+	if (depth != 0 && depth <= QSC_KYBERPOOL_MAX_DEPTH && lowwater <= depth && ctx->pklen != 0 && rng_generate != NULL)
+	{
+		ctx->depth = depth;
+		ctx->lowwater = (lowwater != 0) ? lowwater : 1;
+		ctx->params = params;
+		ctx->rng_generate = rng_generate;
+		ctx->keyslen = depth * (ctx->pklen + ctx->sklen);
+		ctx->keys = qsc_secmem_alloc(ctx->keyslen);
+		ctx->signal = kyberpool_signal_create();
+
+		if (ctx->keys != NULL && ctx->signal != NULL)
+		{
+			ctx->running = 1;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+			ctx->worker = (void*)CreateThread(NULL, 0, kyberpool_thread, ctx, 0, NULL);
+#else
+			ctx->worker = malloc(sizeof(pthread_t));
+
+			if (ctx->worker != NULL && pthread_create((pthread_t*)ctx->worker, NULL, kyberpool_thread, ctx) != 0)
+			{
+				free(ctx->worker);
+				ctx->worker = NULL;
+			}
+#endif
+
+			res = (ctx->worker != NULL);
+		}
+
+		if (res == false)
+		{
+			qsc_kyberpool_dispose(ctx);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_kyberpool_take(qsc_kyberpool_state* ctx, uint8_t* publickey, uint8_t* privatekey)
+{
+	assert(ctx != NULL);
+	assert(publickey != NULL);
+	assert(privatekey != NULL);
+
+	uint8_t* pk;
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = false;
+
+	if (kyberpool_load(&ctx->ready) > 0)
+	{
+		/* callers start at different slots so concurrent takes rarely contend for the same one */
+		j = (size_t)(uint32_t)kyberpool_fetch_add(&ctx->cursor, 1) % ctx->depth;
+
+		for (i = 0; i < ctx->depth; ++i)
+		{
+			if (kyberpool_cas(&ctx->slots[j], KYBERPOOL_SLOT_READY, KYBERPOOL_SLOT_TAKEN) == true)
+			{
+				pk = ctx->keys + (j * (ctx->pklen + ctx->sklen));
+
+				/* the take that moves the ready count below the low-water mark wakes the worker */
+				if (kyberpool_fetch_add(&ctx->ready, -1) == (int32_t)ctx->lowwater)
+				{
+					kyberpool_signal_set(ctx->signal);
+				}
+
+				qsc_memutils_copy(publickey, pk, ctx->pklen);
+				qsc_memutils_copy(privatekey, pk + ctx->pklen, ctx->sklen);
+				qsc_secmem_erase(pk, ctx->pklen + ctx->sklen);
+				kyberpool_store(&ctx->slots[j], KYBERPOOL_SLOT_EMPTY);
+				res = true;
+				break;
+			}
+
+			j = (j + 1 == ctx->depth) ? 0 : j + 1;
+		}
+	}
+
+	if (res == false)
+	{
+		qsc_kyber_generate_keypair_ex(publickey, privatekey, ctx->rng_generate, ctx->params);
+	}
+
+	return res;
+}
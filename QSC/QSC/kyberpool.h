@@ -0,0 +1,131 @@
+/* The GPL version 3 License (GPLv3)
+*
+* Copyright (c) 2020 Digital Freedom Defence Inc.
+* This file is part of the QSC Cryptographic library
+*
+* This program is free software : you can redistribute it and / or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+*
+* Implementation Details:
+* A pool of pre-generated ephemeral Kyber keypairs
+* Contact: develop@vtdev.com */
+
+/**
+* \file kyberpool.h
+* \brief <b>Kyber ephemeral keypair pool</b> \n
+* Keeps a number of ready Kyber keypairs in locked memory, refilled by a background worker thread,
+* so a key exchange does not wait on key generation.
+*
+* \para <b>Example</b> \n
+* \code
+* qsc_kyberpool_state pool;
+* uint8_t pk[QSC_KYBER768_PUBLICKEY_SIZE];
+* uint8_t sk[QSC_KYBER768_PRIVATEKEY_SIZE];
+*
+* // keep up to 32 keypairs, refill when fewer than 8 remain
+* if (qsc_kyberpool_initialize(&pool, 32, 8, KYBER768, rng_generate) == true)
+* {
+*     // per connection; falls back to generating on the calling thread if the pool is empty
+*     qsc_kyberpool_take(&pool, pk, sk);
+*     ...
+*     qsc_kyberpool_dispose(&pool);
+* }
+* \endcode
+*
+* \remarks
+* A keypair is handed out exactly once, and its slot is erased before it is refilled. \n
+* Taking a keypair never blocks; concurrent callers claim ready slots with an atomic compare-and-swap. \n
+* The worker sleeps on an event while the pool is at or above the low-water mark,
+* and is woken by the take that drops the ready count below it. \n
+* The random generator is called from the worker thread and from the callers of qsc_kyberpool_take,
+* and must be safe for concurrent use, qsc_csp_generate is. \n
+* The slot memory is allocated with qsc_secmem_alloc; it is locked where the platform supports it.
+*/
+
+#ifndef QSC_KYBERPOOL_H
+#define QSC_KYBERPOOL_H
+
+#include "common.h"
+#include "kyber.h"
+
+/*!
+\def QSC_KYBERPOOL_MAX_DEPTH
+* The maximum number of keypairs held by a pool
+*/
+#define QSC_KYBERPOOL_MAX_DEPTH 256
+
+/*! \struct qsc_kyberpool_state
+* Contains the keypair pool state
+*/
+QSC_EXPORT_API typedef struct
+{
+	volatile int32_t slots[QSC_KYBERPOOL_MAX_DEPTH];	/*!< The slot states; empty, filling, ready or taken */
+	uint8_t* keys;										/*!< The locked slot memory, each slot is a public key followed by its private key */
+	void* worker;										/*!< The worker thread handle */
+	void* signal;										/*!< The event that wakes the worker */
+	void (*rng_generate)(uint8_t*, size_t);				/*!< The random generator */
+	size_t depth;										/*!< The number of keypair slots */
+	size_t keyslen;										/*!< The byte size of the slot memory */
+	size_t lowwater;									/*!< The ready count below which the worker refills the pool */
+	size_t pklen;										/*!< The public key size in bytes */
+	size_t sklen;										/*!< The private key size in bytes */
+	volatile int32_t cursor;							/*!< The rotating slot index where callers start their search */
+	volatile int32_t ready;								/*!< The number of ready keypairs */
+	volatile int32_t running;							/*!< The worker run flag */
+	qsc_kyber_parameters params;						/*!< The Kyber parameter set */
+} qsc_kyberpool_state;
+
+/**
+* \brief Returns the number of keypairs that are ready to be taken.
+*
+* \param ctx: [struct] The pool state
+* \return The number of ready keypairs
+*/
+QSC_EXPORT_API size_t qsc_kyberpool_available(qsc_kyberpool_state* ctx);
+
+/**
+* \brief Stop the worker thread, then erase and release the slot memory.
+*
+* \warning The dispose function must be called when disposing of the pool, and after all callers of qsc_kyberpool_take have returned.
+*
+* \param ctx: [struct] The pool state
+*/
+QSC_EXPORT_API void qsc_kyberpool_dispose(qsc_kyberpool_state* ctx);
+
+/**
+* \brief Initialize the pool and start the worker thread; the worker begins filling the pool immediately.
+*
+* \param ctx: [struct] The pool state
+* \param depth: The number of keypairs held, maximum is QSC_KYBERPOOL_MAX_DEPTH
+* \param lowwater: The worker refills the pool to depth when fewer than this many keypairs are ready
+* \param params: The Kyber parameter set of the pooled keypairs
+* \param rng_generate: A pointer to the random generator, it must be safe for concurrent use
+* \return Returns false for invalid arguments, or if the memory or the worker thread could not be created
+*/
+QSC_EXPORT_API bool qsc_kyberpool_initialize(qsc_kyberpool_state* ctx, size_t depth, size_t lowwater, qsc_kyber_parameters params, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Take a keypair from the pool; the slot is erased and handed back to the worker.
+* If no keypair is ready, one is generated on the calling thread.
+*
+* \warning Arrays must be sized for the parameter set of the pool, see qsc_kyber_publickey_size and qsc_kyber_privatekey_size.
+*
+* \param ctx: [struct] The pool state
+* \param publickey: Pointer to the output public-key array
+* \param privatekey: Pointer to output private-key array
+* \return Returns true if the keypair came from the pool, false if it was generated on the calling thread
+*/
+QSC_EXPORT_API bool qsc_kyberpool_take(qsc_kyberpool_state* ctx, uint8_t* publickey, uint8_t* privatekey);
+
+#endif
@@ -1,11 +1,477 @@
 #include "poly1305.h"
 #include "intutils.h"
 
+#if defined(QSC_POLY1305_DONNA64)
+#	define POLY1305_MASK42 0x000003FFFFFFFFFFULL
+#	define POLY1305_MASK44 0x00000FFFFFFFFFFFULL
+#	if defined(QSC_SYSTEM_NATIVE_UINT128)
+		typedef uint128_t poly1305_uint128;
+#		define POLY1305_MUL(out, x, y) out = ((uint128_t)(x) * (y))
+#		define POLY1305_ADD(out, in) out += (in)
+#		define POLY1305_ADDLO(out, in) out += (in)
+#		define POLY1305_SHR(in, shift) ((uint64_t)((in) >> (shift)))
+#		define POLY1305_LO(in) ((uint64_t)(in))
+#	else
+#		include "donna128.h"
+		typedef uint128 poly1305_uint128;
+#		define POLY1305_MUL(out, x, y) out.low = _umul128((x), (y), &out.high)
+#		define POLY1305_ADD(out, in) do { uint64_t t = out.low; out.low += in.low; out.high += (out.low < t) + in.high; } while (0)
+#		define POLY1305_ADDLO(out, in) do { uint64_t t = out.low; out.low += (in); out.high += (out.low < t); } while (0)
+#		define POLY1305_SHR(in, shift) (__shiftright128(in.low, in.high, (shift)))
+#		define POLY1305_LO(in) (in.low)
+#	endif
+#endif
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+#	include "intrinsics.h"
+#	define POLY1305_PARALLEL_SIZE (QSC_POLY1305_PARALLEL_BLOCKS * QSC_POLY1305_BLOCK_SIZE)
+#endif
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+
+static void poly1305_multiply(uint32_t* output, const uint32_t* a, const uint32_t* r)
+{
+	/* output = a * r mod 2^130-5, both operands in radix 2^26 */
+	const uint32_t S0 = r[1] * 5;
+	const uint32_t S1 = r[2] * 5;
+	const uint32_t S2 = r[3] * 5;
+	const uint32_t S3 = r[4] * 5;
+	uint64_t b;
+	uint64_t tp0;
+	uint64_t tp1;
+	uint64_t tp2;
+	uint64_t tp3;
+	uint64_t tp4;
+
+	tp0 = ((uint64_t)a[0] * r[0]) + ((uint64_t)a[1] * S3) + ((uint64_t)a[2] * S2) + ((uint64_t)a[3] * S1) + ((uint64_t)a[4] * S0);
+	tp1 = ((uint64_t)a[0] * r[1]) + ((uint64_t)a[1] * r[0]) + ((uint64_t)a[2] * S3) + ((uint64_t)a[3] * S2) + ((uint64_t)a[4] * S1);
+	tp2 = ((uint64_t)a[0] * r[2]) + ((uint64_t)a[1] * r[1]) + ((uint64_t)a[2] * r[0]) + ((uint64_t)a[3] * S3) + ((uint64_t)a[4] * S2);
+	tp3 = ((uint64_t)a[0] * r[3]) + ((uint64_t)a[1] * r[2]) + ((uint64_t)a[2] * r[1]) + ((uint64_t)a[3] * r[0]) + ((uint64_t)a[4] * S3);
+	tp4 = ((uint64_t)a[0] * r[4]) + ((uint64_t)a[1] * r[3]) + ((uint64_t)a[2] * r[2]) + ((uint64_t)a[3] * r[1]) + ((uint64_t)a[4] * r[0]);
+
+	output[0] = (uint32_t)(tp0 & 0x3FFFFFFUL);
+	b = (tp0 >> 26);
+	tp1 += b;
+	output[1] = (uint32_t)(tp1 & 0x3FFFFFFUL);
+	b = (tp1 >> 26);
+	tp2 += b;
+	output[2] = (uint32_t)(tp2 & 0x3FFFFFFUL);
+	b = (tp2 >> 26);
+	tp3 += b;
+	output[3] = (uint32_t)(tp3 & 0x3FFFFFFUL);
+	b = (tp3 >> 26);
+	tp4 += b;
+	output[4] = (uint32_t)(tp4 & 0x3FFFFFFUL);
+	b = (tp4 >> 26);
+	tp0 = output[0] + (b * 5);
+	output[0] = (uint32_t)(tp0 & 0x3FFFFFFUL);
+	output[1] += (uint32_t)(tp0 >> 26);
+}
+
+#if defined(QSC_POLY1305_DONNA64)
+
+static void poly1305_radix26(uint32_t* output, const uint64_t* input)
+{
+	/* convert three 44-bit limbs to five 26-bit limbs */
+	uint64_t h0;
+	uint64_t h1;
+	uint64_t h2;
+
+	h0 = input[0];
+	h1 = input[1] + (h0 >> 44);
+	h0 &= POLY1305_MASK44;
+	h2 = input[2] + (h1 >> 44);
+	h1 &= POLY1305_MASK44;
+
+	output[0] = (uint32_t)(h0 & 0x3FFFFFFULL);
+	output[1] = (uint32_t)(((h0 >> 26) | (h1 << 18)) & 0x3FFFFFFULL);
+	output[2] = (uint32_t)((h1 >> 8) & 0x3FFFFFFULL);
+	output[3] = (uint32_t)(((h1 >> 34) | (h2 << 10)) & 0x3FFFFFFULL);
+	output[4] = (uint32_t)(h2 >> 16);
+}
+
+static void poly1305_radix44(uint64_t* output, const uint32_t* input)
+{
+	/* convert five 26-bit limbs to three 44-bit limbs; the limbs are added, so a limb at or above 2^26 carries correctly */
+	uint64_t t;
+
+	t = (uint64_t)input[0] + ((uint64_t)input[1] << 26);
+	output[0] = t & POLY1305_MASK44;
+	t = (t >> 44) + ((uint64_t)input[2] << 8) + (((uint64_t)input[3] & 0x3FFULL) << 34);
+	output[1] = t & POLY1305_MASK44;
+	output[2] = (t >> 44) + ((uint64_t)input[3] >> 10) + ((uint64_t)input[4] << 16);
+}
+
+#endif
+
+static void poly1305_compute_powers(qsc_poly1305_state* ctx)
+{
+	uint32_t r[5];
+	size_t i;
+
+	/* rpw[i] = r^(i + 1) */
+#if defined(QSC_POLY1305_DONNA64)
+	poly1305_radix26(r, ctx->r);
+#else
+	memcpy(r, ctx->r, sizeof(r));
+#endif
+	memcpy(ctx->rpw[0], r, sizeof(r));
+
+	for (i = 1; i < QSC_POLY1305_PARALLEL_BLOCKS; ++i)
+	{
+		poly1305_multiply(ctx->rpw[i], ctx->rpw[i - 1], r);
+	}
+
+	ctx->rpwi = true;
+}
+
+static void poly1305_sum_lanes(uint32_t* h, const uint64_t* lanes)
+{
+	uint32_t b;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < 5; ++i)
+	{
+		h[i] = 0;
+
+		for (j = 0; j < QSC_POLY1305_PARALLEL_BLOCKS; ++j)
+		{
+			h[i] += (uint32_t)lanes[(i * QSC_POLY1305_PARALLEL_BLOCKS) + j];
+		}
+	}
+
+	b = h[0] >> 26;
+	h[0] &= 0x3FFFFFFUL;
+	h[1] += b;
+	b = h[1] >> 26;
+	h[1] &= 0x3FFFFFFUL;
+	h[2] += b;
+	b = h[2] >> 26;
+	h[2] &= 0x3FFFFFFUL;
+	h[3] += b;
+	b = h[3] >> 26;
+	h[3] &= 0x3FFFFFFUL;
+	h[4] += b;
+	b = h[4] >> 26;
+	h[4] &= 0x3FFFFFFUL;
+	h[0] += b * 5;
+	b = h[0] >> 26;
+	h[0] &= 0x3FFFFFFUL;
+	h[1] += b;
+	/* the wrapped carry can lift h[1] to 2^26, so finish the chain */
+	b = h[1] >> 26;
+	h[1] &= 0x3FFFFFFUL;
+	h[2] += b;
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void poly1305_load_x512(__m512i* m, const uint8_t* message)
+{
+	const __m512i MASK = _mm512_set1_epi64(0x3FFFFFFLL);
+	const __m512i HIBIT = _mm512_set1_epi64(1LL << 24);
+	const __m512i IDXL = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+	const __m512i IDXH = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+	__m512i a;
+	__m512i b;
+	__m512i hi;
+	__m512i lo;
+
+	/* lane i holds the low and high 64 bits of block i */
+	a = _mm512_loadu_si512((const __m512i*)message);
+	b = _mm512_loadu_si512((const __m512i*)(message + 64));
+	lo = _mm512_permutex2var_epi64(a, IDXL, b);
+	hi = _mm512_permutex2var_epi64(a, IDXH, b);
+
+	m[0] = _mm512_and_si512(lo, MASK);
+	m[1] = _mm512_and_si512(_mm512_srli_epi64(lo, 26), MASK);
+	m[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(lo, 52), _mm512_slli_epi64(hi, 12)), MASK);
+	m[3] = _mm512_and_si512(_mm512_srli_epi64(hi, 14), MASK);
+	m[4] = _mm512_or_si512(_mm512_srli_epi64(hi, 40), HIBIT);
+}
+
+static void poly1305_multiply_x512(__m512i* h, const __m512i* r, const __m512i* s)
+{
+	const __m512i MASK = _mm512_set1_epi64(0x3FFFFFFLL);
+	__m512i c;
+	__m512i d0;
+	__m512i d1;
+	__m512i d2;
+	__m512i d3;
+	__m512i d4;
+
+	d0 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(h[0], r[0]), _mm512_mul_epu32(h[1], s[3])),
+		_mm512_mul_epu32(h[2], s[2])), _mm512_mul_epu32(h[3], s[1])), _mm512_mul_epu32(h[4], s[0]));
+	d1 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(h[0], r[1]), _mm512_mul_epu32(h[1], r[0])),
+		_mm512_mul_epu32(h[2], s[3])), _mm512_mul_epu32(h[3], s[2])), _mm512_mul_epu32(h[4], s[1]));
+	d2 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(h[0], r[2]), _mm512_mul_epu32(h[1], r[1])),
+		_mm512_mul_epu32(h[2], r[0])), _mm512_mul_epu32(h[3], s[3])), _mm512_mul_epu32(h[4], s[2]));
+	d3 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(h[0], r[3]), _mm512_mul_epu32(h[1], r[2])),
+		_mm512_mul_epu32(h[2], r[1])), _mm512_mul_epu32(h[3], r[0])), _mm512_mul_epu32(h[4], s[3]));
+	d4 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(h[0], r[4]), _mm512_mul_epu32(h[1], r[3])),
+		_mm512_mul_epu32(h[2], r[2])), _mm512_mul_epu32(h[3], r[1])), _mm512_mul_epu32(h[4], r[0]));
+
+	c = _mm512_srli_epi64(d0, 26);
+	h[0] = _mm512_and_si512(d0, MASK);
+	d1 = _mm512_add_epi64(d1, c);
+	c = _mm512_srli_epi64(d1, 26);
+	h[1] = _mm512_and_si512(d1, MASK);
+	d2 = _mm512_add_epi64(d2, c);
+	c = _mm512_srli_epi64(d2, 26);
+	h[2] = _mm512_and_si512(d2, MASK);
+	d3 = _mm512_add_epi64(d3, c);
+	c = _mm512_srli_epi64(d3, 26);
+	h[3] = _mm512_and_si512(d3, MASK);
+	d4 = _mm512_add_epi64(d4, c);
+	c = _mm512_srli_epi64(d4, 26);
+	h[4] = _mm512_and_si512(d4, MASK);
+	h[0] = _mm512_add_epi64(h[0], _mm512_add_epi64(c, _mm512_slli_epi64(c, 2)));
+	c = _mm512_srli_epi64(h[0], 26);
+	h[0] = _mm512_and_si512(h[0], MASK);
+	h[1] = _mm512_add_epi64(h[1], c);
+}
+
+static void poly1305_blocks_x512(qsc_poly1305_state* ctx, uint32_t* hs, const uint8_t* message, size_t nblocks)
+{
+	uint64_t lanes[5 * QSC_POLY1305_PARALLEL_BLOCKS];
+	__m512i h[5];
+	__m512i m[5];
+	__m512i r[5];
+	__m512i s[4];
+	__m512i rw[5];
+	__m512i sw[4];
+	size_t i;
+
+	/* r^8 in every lane for the loop, r^8 through r^1 across the lanes for the final step */
+	for (i = 0; i < 5; ++i)
+	{
+		r[i] = _mm512_set1_epi64(ctx->rpw[7][i]);
+		rw[i] = _mm512_set_epi64(ctx->rpw[0][i], ctx->rpw[1][i], ctx->rpw[2][i], ctx->rpw[3][i], 
+			ctx->rpw[4][i], ctx->rpw[5][i], ctx->rpw[6][i], ctx->rpw[7][i]);
+	}
+
+	for (i = 0; i < 4; ++i)
+	{
+		s[i] = _mm512_add_epi64(r[i + 1], _mm512_slli_epi64(r[i + 1], 2));
+		sw[i] = _mm512_add_epi64(rw[i + 1], _mm512_slli_epi64(rw[i + 1], 2));
+	}
+
+	poly1305_load_x512(h, message);
+
+	for (i = 0; i < 5; ++i)
+	{
+		h[i] = _mm512_add_epi64(h[i], _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, hs[i]));
+	}
+
+	message += POLY1305_PARALLEL_SIZE;
+	nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+
+	while (nblocks != 0)
+	{
+		poly1305_multiply_x512(h, r, s);
+		poly1305_load_x512(m, message);
+
+		for (i = 0; i < 5; ++i)
+		{
+			h[i] = _mm512_add_epi64(h[i], m[i]);
+		}
+
+		message += POLY1305_PARALLEL_SIZE;
+		nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+	}
+
+	poly1305_multiply_x512(h, rw, sw);
+
+	for (i = 0; i < 5; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)(lanes + (i * QSC_POLY1305_PARALLEL_BLOCKS)), h[i]);
+	}
+
+	poly1305_sum_lanes(hs, lanes);
+}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+static void poly1305_load_x256(__m256i* m, const uint8_t* message)
+{
+	const __m256i MASK = _mm256_set1_epi64x(0x3FFFFFFLL);
+	const __m256i HIBIT = _mm256_set1_epi64x(1LL << 24);
+	__m256i a;
+	__m256i b;
+	__m256i hi;
+	__m256i lo;
+
+	/* lane i holds the low and high 64 bits of block i */
+	a = _mm256_loadu_si256((const __m256i*)message);
+	b = _mm256_loadu_si256((const __m256i*)(message + 32));
+	lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xD8);
+	hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xD8);
+
+	m[0] = _mm256_and_si256(lo, MASK);
+	m[1] = _mm256_and_si256(_mm256_srli_epi64(lo, 26), MASK);
+	m[2] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), MASK);
+	m[3] = _mm256_and_si256(_mm256_srli_epi64(hi, 14), MASK);
+	m[4] = _mm256_or_si256(_mm256_srli_epi64(hi, 40), HIBIT);
+}
+
+static void poly1305_multiply_x256(__m256i* h, const __m256i* r, const __m256i* s)
+{
+	const __m256i MASK = _mm256_set1_epi64x(0x3FFFFFFLL);
+	__m256i c;
+	__m256i d0;
+	__m256i d1;
+	__m256i d2;
+	__m256i d3;
+	__m256i d4;
+
+	d0 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[0]), _mm256_mul_epu32(h[1], s[3])),
+		_mm256_mul_epu32(h[2], s[2])), _mm256_mul_epu32(h[3], s[1])), _mm256_mul_epu32(h[4], s[0]));
+	d1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[1]), _mm256_mul_epu32(h[1], r[0])),
+		_mm256_mul_epu32(h[2], s[3])), _mm256_mul_epu32(h[3], s[2])), _mm256_mul_epu32(h[4], s[1]));
+	d2 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[2]), _mm256_mul_epu32(h[1], r[1])),
+		_mm256_mul_epu32(h[2], r[0])), _mm256_mul_epu32(h[3], s[3])), _mm256_mul_epu32(h[4], s[2]));
+	d3 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[3]), _mm256_mul_epu32(h[1], r[2])),
+		_mm256_mul_epu32(h[2], r[1])), _mm256_mul_epu32(h[3], r[0])), _mm256_mul_epu32(h[4], s[3]));
+	d4 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[4]), _mm256_mul_epu32(h[1], r[3])),
+		_mm256_mul_epu32(h[2], r[2])), _mm256_mul_epu32(h[3], r[1])), _mm256_mul_epu32(h[4], r[0]));
+
+	c = _mm256_srli_epi64(d0, 26);
+	h[0] = _mm256_and_si256(d0, MASK);
+	d1 = _mm256_add_epi64(d1, c);
+	c = _mm256_srli_epi64(d1, 26);
+	h[1] = _mm256_and_si256(d1, MASK);
+	d2 = _mm256_add_epi64(d2, c);
+	c = _mm256_srli_epi64(d2, 26);
+	h[2] = _mm256_and_si256(d2, MASK);
+	d3 = _mm256_add_epi64(d3, c);
+	c = _mm256_srli_epi64(d3, 26);
+	h[3] = _mm256_and_si256(d3, MASK);
+	d4 = _mm256_add_epi64(d4, c);
+	c = _mm256_srli_epi64(d4, 26);
+	h[4] = _mm256_and_si256(d4, MASK);
+	h[0] = _mm256_add_epi64(h[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+	c = _mm256_srli_epi64(h[0], 26);
+	h[0] = _mm256_and_si256(h[0], MASK);
+	h[1] = _mm256_add_epi64(h[1], c);
+}
+
+static void poly1305_blocks_x256(qsc_poly1305_state* ctx, uint32_t* hs, const uint8_t* message, size_t nblocks)
+{
+	uint64_t lanes[5 * QSC_POLY1305_PARALLEL_BLOCKS];
+	__m256i h[5];
+	__m256i m[5];
+	__m256i r[5];
+	__m256i s[4];
+	__m256i rw[5];
+	__m256i sw[4];
+	size_t i;
+
+	/* r^4 in every lane for the loop, r^4 through r^1 across the lanes for the final step */
+	for (i = 0; i < 5; ++i)
+	{
+		r[i] = _mm256_set1_epi64x(ctx->rpw[3][i]);
+		rw[i] = _mm256_set_epi64x(ctx->rpw[0][i], ctx->rpw[1][i], ctx->rpw[2][i], ctx->rpw[3][i]);
+	}
+
+	for (i = 0; i < 4; ++i)
+	{
+		s[i] = _mm256_add_epi64(r[i + 1], _mm256_slli_epi64(r[i + 1], 2));
+		sw[i] = _mm256_add_epi64(rw[i + 1], _mm256_slli_epi64(rw[i + 1], 2));
+	}
+
+	poly1305_load_x256(h, message);
+
+	for (i = 0; i < 5; ++i)
+	{
+		h[i] = _mm256_add_epi64(h[i], _mm256_set_epi64x(0, 0, 0, hs[i]));
+	}
+
+	message += POLY1305_PARALLEL_SIZE;
+	nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+
+	while (nblocks != 0)
+	{
+		poly1305_multiply_x256(h, r, s);
+		poly1305_load_x256(m, message);
+
+		for (i = 0; i < 5; ++i)
+		{
+			h[i] = _mm256_add_epi64(h[i], m[i]);
+		}
+
+		message += POLY1305_PARALLEL_SIZE;
+		nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+	}
+
+	poly1305_multiply_x256(h, rw, sw);
+
+	for (i = 0; i < 5; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)(lanes + (i * QSC_POLY1305_PARALLEL_BLOCKS)), h[i]);
+	}
+
+	poly1305_sum_lanes(hs, lanes);
+}
+
+#endif
+
 void qsc_poly1305_blockupdate(qsc_poly1305_state* ctx, const uint8_t* message)
 {
 	assert(ctx != NULL);
 	assert(message != NULL);
 
+#if defined(QSC_POLY1305_DONNA64)
+
+	const uint64_t HIBIT = (ctx->fnl != 0) ? 0ULL : (1ULL << 40);
+	poly1305_uint128 d0;
+	poly1305_uint128 d1;
+	poly1305_uint128 d2;
+	poly1305_uint128 d;
+	uint64_t c;
+	uint64_t t0;
+	uint64_t t1;
+
+	t0 = qsc_intutils_le8to64(message);
+	t1 = qsc_intutils_le8to64(message + 8);
+
+	ctx->h[0] += t0 & POLY1305_MASK44;
+	ctx->h[1] += ((t0 >> 44) | (t1 << 20)) & POLY1305_MASK44;
+	ctx->h[2] += ((t1 >> 24) & POLY1305_MASK42) | HIBIT;
+
+	POLY1305_MUL(d0, ctx->h[0], ctx->r[0]);
+	POLY1305_MUL(d, ctx->h[1], ctx->s[1]);
+	POLY1305_ADD(d0, d);
+	POLY1305_MUL(d, ctx->h[2], ctx->s[0]);
+	POLY1305_ADD(d0, d);
+	POLY1305_MUL(d1, ctx->h[0], ctx->r[1]);
+	POLY1305_MUL(d, ctx->h[1], ctx->r[0]);
+	POLY1305_ADD(d1, d);
+	POLY1305_MUL(d, ctx->h[2], ctx->s[1]);
+	POLY1305_ADD(d1, d);
+	POLY1305_MUL(d2, ctx->h[0], ctx->r[2]);
+	POLY1305_MUL(d, ctx->h[1], ctx->r[1]);
+	POLY1305_ADD(d2, d);
+	POLY1305_MUL(d, ctx->h[2], ctx->r[0]);
+	POLY1305_ADD(d2, d);
+
+	c = POLY1305_SHR(d0, 44);
+	ctx->h[0] = POLY1305_LO(d0) & POLY1305_MASK44;
+	POLY1305_ADDLO(d1, c);
+	c = POLY1305_SHR(d1, 44);
+	ctx->h[1] = POLY1305_LO(d1) & POLY1305_MASK44;
+	POLY1305_ADDLO(d2, c);
+	c = POLY1305_SHR(d2, 42);
+	ctx->h[2] = POLY1305_LO(d2) & POLY1305_MASK42;
+	ctx->h[0] += c * 5;
+	c = ctx->h[0] >> 44;
+	ctx->h[0] &= POLY1305_MASK44;
+	ctx->h[1] += c;
+
+#else
+
 	const uint32_t HIBIT = (ctx->fnl != 0) ? 0UL : (1UL << 24);
 	uint64_t b;
 	uint64_t t0;
@@ -50,6 +516,8 @@ void qsc_poly1305_blockupdate(qsc_poly1305_state* ctx, const uint8_t* message)
 	ctx->h[4] = (uint32_t)(tp4 & 0x3FFFFFFUL);
 	b = (tp4 >> 26);
 	ctx->h[0] += (uint32_t)(b * 5);
+
+#endif
 }
 
 void qsc_poly1305_compute(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* key)
@@ -70,11 +538,17 @@ void qsc_poly1305_finalize(qsc_poly1305_state* ctx, uint8_t* output)
 	assert(ctx != NULL);
 	assert(output != NULL);
 
+#if defined(QSC_POLY1305_DONNA64)
+	uint64_t c;
+	uint64_t g0;
+	uint64_t g1;
+	uint64_t g2;
+	uint64_t nc;
+#else
 	uint64_t f0;
 	uint64_t f1;
 	uint64_t f2;
 	uint64_t f3;
-	size_t i;
 	uint32_t b;
 	uint32_t g0;
 	uint32_t g1;
@@ -82,6 +556,8 @@ void qsc_poly1305_finalize(qsc_poly1305_state* ctx, uint8_t* output)
 	uint32_t g3;
 	uint32_t g4;
 	uint32_t nb;
+#endif
+	size_t i;
 
 	if (ctx->rmd)
 	{
@@ -96,6 +572,59 @@ void qsc_poly1305_finalize(qsc_poly1305_state* ctx, uint8_t* output)
 		qsc_poly1305_blockupdate(ctx, ctx->buf);
 	}
 
+#if defined(QSC_POLY1305_DONNA64)
+
+	/* fully carry h */
+	c = ctx->h[1] >> 44;
+	ctx->h[1] &= POLY1305_MASK44;
+	ctx->h[2] += c;
+	c = ctx->h[2] >> 42;
+	ctx->h[2] &= POLY1305_MASK42;
+	ctx->h[0] += c * 5;
+	c = ctx->h[0] >> 44;
+	ctx->h[0] &= POLY1305_MASK44;
+	ctx->h[1] += c;
+	c = ctx->h[1] >> 44;
+	ctx->h[1] &= POLY1305_MASK44;
+	ctx->h[2] += c;
+	c = ctx->h[2] >> 42;
+	ctx->h[2] &= POLY1305_MASK42;
+	ctx->h[0] += c * 5;
+	c = ctx->h[0] >> 44;
+	ctx->h[0] &= POLY1305_MASK44;
+	ctx->h[1] += c;
+
+	/* compute h + -p */
+	g0 = ctx->h[0] + 5;
+	c = g0 >> 44;
+	g0 &= POLY1305_MASK44;
+	g1 = ctx->h[1] + c;
+	c = g1 >> 44;
+	g1 &= POLY1305_MASK44;
+	g2 = ctx->h[2] + c - (1ULL << 42);
+
+	/* select h if h < p, or h + -p if h >= p */
+	c = (g2 >> 63) - 1;
+	nc = ~c;
+	ctx->h[0] = (ctx->h[0] & nc) | (g0 & c);
+	ctx->h[1] = (ctx->h[1] & nc) | (g1 & c);
+	ctx->h[2] = (ctx->h[2] & nc) | (g2 & c);
+
+	/* h = (h + pad) */
+	ctx->h[0] += ctx->k[0] & POLY1305_MASK44;
+	c = ctx->h[0] >> 44;
+	ctx->h[0] &= POLY1305_MASK44;
+	ctx->h[1] += (((ctx->k[0] >> 44) | (ctx->k[1] << 20)) & POLY1305_MASK44) + c;
+	c = ctx->h[1] >> 44;
+	ctx->h[1] &= POLY1305_MASK44;
+	ctx->h[2] += ((ctx->k[1] >> 24) & POLY1305_MASK42) + c;
+	ctx->h[2] &= POLY1305_MASK42;
+
+	qsc_intutils_le64to8(output, ctx->h[0] | (ctx->h[1] << 44));
+	qsc_intutils_le64to8(output + 8, (ctx->h[1] >> 20) | (ctx->h[2] << 24));
+
+#else
+
 	b = ctx->h[0] >> 26;
 	ctx->h[0] = ctx->h[0] & 0x3FFFFFFUL;
 	ctx->h[1] += b;
@@ -150,6 +679,8 @@ void qsc_poly1305_finalize(qsc_poly1305_state* ctx, uint8_t* output)
 	f3 += (f2 >> 32);
 	qsc_intutils_le32to8(output + 12, (uint32_t)f3);
 
+#endif
+
 	qsc_poly1305_reset(ctx);
 }
 
@@ -158,6 +689,28 @@ void qsc_poly1305_initialize(qsc_poly1305_state* ctx, const uint8_t* key)
 	assert(ctx != NULL);
 	assert(key != NULL);
 
+#if defined(QSC_POLY1305_DONNA64)
+
+	uint64_t t0;
+	uint64_t t1;
+
+	t0 = qsc_intutils_le8to64(&key[0]);
+	t1 = qsc_intutils_le8to64(&key[8]);
+
+	/* r &= 0xFFFFFFC0FFFFFFC0FFFFFFC0FFFFFFF */
+	ctx->r[0] = t0 & 0x00000FFC0FFFFFFFULL;
+	ctx->r[1] = ((t0 >> 44) | (t1 << 20)) & 0x00000FFFFFC0FFFFULL;
+	ctx->r[2] = (t1 >> 24) & 0x00000FFFFFFC0FULL;
+	ctx->s[0] = ctx->r[1] * (5 << 2);
+	ctx->s[1] = ctx->r[2] * (5 << 2);
+	ctx->h[0] = 0;
+	ctx->h[1] = 0;
+	ctx->h[2] = 0;
+	ctx->k[0] = qsc_intutils_le8to64(&key[16]);
+	ctx->k[1] = qsc_intutils_le8to64(&key[24]);
+
+#else
+
 	ctx->r[0] = (qsc_intutils_le8to32(&key[0])) & 0x3FFFFFFUL;
 	ctx->r[1] = (qsc_intutils_le8to32(&key[3]) >> 2) & 0x3FFFF03UL;
 	ctx->r[2] = (qsc_intutils_le8to32(&key[6]) >> 4) & 0x3FFC0FFUL;
@@ -176,21 +729,38 @@ void qsc_poly1305_initialize(qsc_poly1305_state* ctx, const uint8_t* key)
 	ctx->k[1] = qsc_intutils_le8to32(&key[20]);
 	ctx->k[2] = qsc_intutils_le8to32(&key[24]);
 	ctx->k[3] = qsc_intutils_le8to32(&key[28]);
+
+#endif
+
 	ctx->fnl = 0;
 	ctx->rmd = 0;
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	ctx->rpwi = false;
+#endif
 }
 
 void qsc_poly1305_reset(qsc_poly1305_state* ctx)
 {
 	assert(ctx != NULL);
 
+#if defined(QSC_POLY1305_DONNA64)
+	qsc_intutils_clear64(ctx->h, 3);
+	qsc_intutils_clear64(ctx->k, 2);
+	qsc_intutils_clear64(ctx->r, 3);
+	qsc_intutils_clear64(ctx->s, 2);
+#else
 	qsc_intutils_clear32(ctx->h, 5);
 	qsc_intutils_clear32(ctx->k, 4);
 	qsc_intutils_clear32(ctx->r, 5);
 	qsc_intutils_clear32(ctx->s, 4);
+#endif
 	qsc_intutils_clear8(ctx->buf, QSC_POLY1305_BLOCK_SIZE);
 	ctx->rmd = 0;
 	ctx->fnl = 0;
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	qsc_intutils_clear32((uint32_t*)ctx->rpw, sizeof(ctx->rpw) / sizeof(uint32_t));
+	ctx->rpwi = false;
+#endif
 }
 
 void qsc_poly1305_update(qsc_poly1305_state* ctx, const uint8_t* message, size_t msglen)
@@ -226,6 +796,37 @@ void qsc_poly1305_update(qsc_poly1305_state* ctx, const uint8_t* message, size_t
 		}
 	}
 
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	if (msglen >= POLY1305_PARALLEL_SIZE)
+	{
+		const size_t BLKCNT = (msglen / POLY1305_PARALLEL_SIZE) * QSC_POLY1305_PARALLEL_BLOCKS;
+
+#	if defined(QSC_POLY1305_DONNA64)
+		uint32_t hs[5];
+
+		poly1305_radix26(hs, ctx->h);
+#	else
+		uint32_t* hs = ctx->h;
+#	endif
+
+		if (ctx->rpwi == false)
+		{
+			poly1305_compute_powers(ctx);
+		}
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+		poly1305_blocks_x512(ctx, hs, message, BLKCNT);
+#	else
+		poly1305_blocks_x256(ctx, hs, message, BLKCNT);
+#	endif
+#	if defined(QSC_POLY1305_DONNA64)
+		poly1305_radix44(ctx->h, hs);
+#	endif
+		message += BLKCNT * QSC_POLY1305_BLOCK_SIZE;
+		msglen -= BLKCNT * QSC_POLY1305_BLOCK_SIZE;
+	}
+#endif
+
 	while (msglen >= QSC_POLY1305_BLOCK_SIZE)
 	{
 		qsc_poly1305_blockupdate(ctx, message);
@@ -83,19 +83,52 @@
 */
 #define QSC_POLY1305_MAC_SIZE 16
 
+#if defined(QSC_SYSTEM_NATIVE_UINT128) || (defined(QSC_SYSTEM_COMPILER_MSC) && defined(QSC_SYSTEM_ARCH_X64))
+/*!
+* \def QSC_POLY1305_DONNA64
+* \brief The 64-bit radix implementation is used; three 44-bit limbs with 128-bit products
+*/
+#	define QSC_POLY1305_DONNA64
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/*!
+* \def QSC_POLY1305_PARALLEL_BLOCKS
+* \brief The number of message blocks processed in parallel by the vectorized update
+*/
+#	define QSC_POLY1305_PARALLEL_BLOCKS 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+/*!
+* \def QSC_POLY1305_PARALLEL_BLOCKS
+* \brief The number of message blocks processed in parallel by the vectorized update
+*/
+#	define QSC_POLY1305_PARALLEL_BLOCKS 4
+#endif
+
 /*! 
 * \struct qsc_poly1305_state
 * \brief Internal: contains the Poly1305 state
 */
 QSC_EXPORT_API typedef struct qsc_poly1305_state
 {
+#if defined(QSC_POLY1305_DONNA64)
+	uint64_t h[3];
+	uint64_t k[2];
+	uint64_t r[3];
+	uint64_t s[2];
+#else
 	uint32_t h[5];
 	uint32_t k[4];
 	uint32_t r[5];
 	uint32_t s[4];
+#endif
 	uint8_t buf[QSC_POLY1305_BLOCK_SIZE];
 	size_t fnl;
 	size_t rmd;
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	uint32_t rpw[QSC_POLY1305_PARALLEL_BLOCKS][5];
+	bool rpwi;
+#endif
 } qsc_poly1305_state;
 
 
@@ -149,6 +182,8 @@ QSC_EXPORT_API void qsc_poly1305_reset(qsc_poly1305_state* ctx);
 /**
 * \brief Update the poly1305 generator with a length of message input.
 * Absorbs the input message into the state.
+* On AVX2 and AVX512 systems, inputs of at least QSC_POLY1305_PARALLEL_BLOCKS blocks
+* are processed 4 or 8 blocks at a time, using the precomputed powers of the key r^2 to r^8.
 *
 * \param ctx: [struct] The function state; must be initialized
 * \param message: [const] The input message byte array
@@ -1,6 +1,6 @@
 #include "rhx.h"
-#include "../QSC/intutils.h"
-#include "../QSC/memutils.h"
+#include "intutils.h"
+#include "memutils.h"
 
 /*!
 \def AES128_ROUND_COUNT
@@ -85,6 +85,30 @@
 */
 #define AVX512_BLOCK_SIZE (4 * QSC_RHX_BLOCK_SIZE)
 
+/*!
+\def RHX_PARALLEL_BLOCKS
+* The number of blocks processed in parallel by the AES-NI CBC decryption pipeline.
+*/
+#define RHX_PARALLEL_BLOCKS 8
+
+/*!
+\def RHX_MULTI_STREAMS_WIDE
+* The number of independent streams advanced together by the VAES multi-stream CBC encryption.
+*/
+#define RHX_MULTI_STREAMS_WIDE 16
+
+/*!
+\def RHX_BITSLICE_BLOCKS
+* The number of blocks processed in parallel by the bitsliced table-free implementation.
+*/
+#define RHX_BITSLICE_BLOCKS 8
+
+/*!
+\def RHX_BITSLICE_WORDS
+* The number of 64-bit words in the bitsliced state; eight bit planes of two column pairs.
+*/
+#define RHX_BITSLICE_WORDS 16
+
 /* HBA */
 
 /*!
@@ -158,6 +182,109 @@ static void rhx_decrypt_block(qsc_rhx_state* state, __m128i* output, const __m12
 	*output = _mm_aesdeclast_si128(*output, state->roundkeys[keyctr]);
 }
 
+static void rhx_decrypt_block_x8(qsc_rhx_state* state, __m128i* output, const __m128i* input)
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	__m128i rkey;
+	size_t i;
+	size_t keyctr;
+
+	/* interleave the rounds of eight independent blocks to keep the aes pipeline full */
+	keyctr = 0;
+	rkey = state->roundkeys[keyctr];
+
+	for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+	{
+		output[i] = _mm_xor_si128(input[i], rkey);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+		rkey = state->roundkeys[keyctr];
+
+		for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+		{
+			output[i] = _mm_aesdec_si128(output[i], rkey);
+		}
+	}
+
+	++keyctr;
+	rkey = state->roundkeys[keyctr];
+
+	for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+	{
+		output[i] = _mm_aesdeclast_si128(output[i], rkey);
+	}
+}
+
+static void rhx_encrypt_block_x8(qsc_rhx_state* state, __m128i* output, const __m128i* input)
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	__m128i rkey;
+	size_t i;
+	size_t keyctr;
+
+	keyctr = 0;
+	rkey = state->roundkeys[keyctr];
+
+	for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+	{
+		output[i] = _mm_xor_si128(input[i], rkey);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+		rkey = state->roundkeys[keyctr];
+
+		for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+		{
+			output[i] = _mm_aesenc_si128(output[i], rkey);
+		}
+	}
+
+	++keyctr;
+	rkey = state->roundkeys[keyctr];
+
+	for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+	{
+		output[i] = _mm_aesenclast_si128(output[i], rkey);
+	}
+}
+
+static void rhx_encrypt_block_multi(qsc_rhx_state* const* states, __m128i* output, const __m128i* input, size_t count)
+{
+	const size_t RNDCNT = states[0]->roundkeylen - 2;
+	size_t i;
+	size_t keyctr;
+
+	/* one block from each stream, each under its own key schedule, advanced round by round */
+	keyctr = 0;
+
+	for (i = 0; i < count; ++i)
+	{
+		output[i] = _mm_xor_si128(input[i], states[i]->roundkeys[keyctr]);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+
+		for (i = 0; i < count; ++i)
+		{
+			output[i] = _mm_aesenc_si128(output[i], states[i]->roundkeys[keyctr]);
+		}
+	}
+
+	++keyctr;
+
+	for (i = 0; i < count; ++i)
+	{
+		output[i] = _mm_aesenclast_si128(output[i], states[i]->roundkeys[keyctr]);
+	}
+}
+
 static void rhx_encrypt_block(qsc_rhx_state* state, __m128i* output, const __m128i* input)
 {
 	const size_t RNDCNT = state->roundkeylen - 2;
@@ -230,6 +357,109 @@ static void rhx_decrypt_blockw(qsc_rhx_state* state, __m512i* output, const __m5
 	*output = _mm512_aesdeclast_epi128(*output, state->roundkeysw[keyctr]);
 }
 
+static void rhx_decrypt_blockw_x4(qsc_rhx_state* state, __m512i* output, const __m512i* input)
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	__m512i rkey;
+	size_t i;
+	size_t keyctr;
+
+	/* four vectors of four blocks each, sixteen blocks in flight */
+	keyctr = 0;
+	rkey = state->roundkeysw[keyctr];
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_xor_si512(input[i], rkey);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+		rkey = state->roundkeysw[keyctr];
+
+		for (i = 0; i < 4; ++i)
+		{
+			output[i] = _mm512_aesdec_epi128(output[i], rkey);
+		}
+	}
+
+	++keyctr;
+	rkey = state->roundkeysw[keyctr];
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_aesdeclast_epi128(output[i], rkey);
+	}
+}
+
+static void rhx_encrypt_blockw_x4(qsc_rhx_state* state, __m512i* output, const __m512i* input)
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	__m512i rkey;
+	size_t i;
+	size_t keyctr;
+
+	keyctr = 0;
+	rkey = state->roundkeysw[keyctr];
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_xor_si512(input[i], rkey);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+		rkey = state->roundkeysw[keyctr];
+
+		for (i = 0; i < 4; ++i)
+		{
+			output[i] = _mm512_aesenc_epi128(output[i], rkey);
+		}
+	}
+
+	++keyctr;
+	rkey = state->roundkeysw[keyctr];
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_aesenclast_epi128(output[i], rkey);
+	}
+}
+
+static void rhx_encrypt_blockw_multi(const __m512i* roundkeys, size_t roundkeylen, __m512i* output, const __m512i* input)
+{
+	const size_t RNDCNT = roundkeylen - 2;
+	size_t i;
+	size_t keyctr;
+
+	/* roundkeys holds the interleaved schedules of sixteen streams; four vectors per round */
+	keyctr = 0;
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_xor_si512(input[i], roundkeys[i]);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+
+		for (i = 0; i < 4; ++i)
+		{
+			output[i] = _mm512_aesenc_epi128(output[i], roundkeys[(keyctr * 4) + i]);
+		}
+	}
+
+	++keyctr;
+
+	for (i = 0; i < 4; ++i)
+	{
+		output[i] = _mm512_aesenclast_epi128(output[i], roundkeys[(keyctr * 4) + i]);
+	}
+}
+
 static void rhx_encrypt_blockw(qsc_rhx_state* state, __m512i* output, const __m512i* input)
 {
 	const size_t RNDCNT = state->roundkeylen - 2;
@@ -423,6 +653,8 @@ void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams
 	}
 
 	qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
+	qsc_memutils_clear(state->kstream, sizeof(state->kstream));
+	state->kslen = 0;
 
 	if (ctype == RHX256)
 	{
@@ -498,77 +730,102 @@ void qsc_rhx_cbc_decrypt(qsc_rhx_state* state, uint8_t* output, size_t *outputle
 	__m128i inp;
 	__m128i ivt;
 	__m128i otp;
+	size_t i;
 	size_t len;
 	size_t oft;
 
 	oft = 0;
+	ivt = _mm_loadu_si128((const __m128i*)state->nonce);
+
+	/* cbc decryption has no dependency between blocks, so blocks are decrypted in parallel;
+	   each block is xor'd with the preceding cipher-text block, the final block is reserved for the padding */
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
-	if (inputlen > AVX512_BLOCK_SIZE)
+	if (inputlen > 4 * AVX512_BLOCK_SIZE)
 	{
-		__m512i inpw;
-		__m512i ivtw;
-		__m512i otpw;
-		uint8_t ivtb[AVX512_BLOCK_SIZE];
+		__m512i inpw[4];
+		__m512i otpw[4];
 
-		/* assemble the first block in the chain */
-		qsc_memutils_copy(ivtb, state->nonce, QSC_RHX_BLOCK_SIZE);
-		qsc_memutils_copy((uint8_t*)(ivtb + QSC_RHX_BLOCK_SIZE), input, 3 * QSC_RHX_BLOCK_SIZE);
-		ivtw = _mm512_loadu_si512((const __m512i*)ivtb);
+		while (inputlen > 4 * AVX512_BLOCK_SIZE)
+		{
+			for (i = 0; i < 4; ++i)
+			{
+				inpw[i] = _mm512_loadu_si512((const __m512i*)(input + oft + (i * AVX512_BLOCK_SIZE)));
+			}
 
-		/* process the first block */
-		inpw = _mm512_loadu_si512((const __m512i*)input);
-		rhx_decrypt_blockw(state, &otpw, &inpw);
-		otpw = _mm512_xor_si512(otpw, ivtw);
+			rhx_decrypt_blockw_x4(state, otpw, inpw);
 
-		/* store to output */
-		_mm512_storeu_si512((__m512i*)output, otpw);
-		inputlen -= AVX512_BLOCK_SIZE;
-		oft += AVX512_BLOCK_SIZE;
+			/* the chaining vectors are the cipher-text blocks shifted by one block */
+			otpw[0] = _mm512_xor_si512(otpw[0], _mm512_alignr_epi64(inpw[0], _mm512_broadcast_i32x4(ivt), 6));
 
-		/* process remaining blocks */
-		while (inputlen > AVX512_BLOCK_SIZE)
-		{
-			qsc_memutils_copy(ivtb, (uint8_t*)(input + (oft - QSC_RHX_BLOCK_SIZE)), AVX512_BLOCK_SIZE);
-			ivtw = _mm512_loadu_si512((const __m512i*)ivtb);
-			inpw = _mm512_loadu_si512((const __m512i*)((uint8_t*)(input + oft)));
+			for (i = 1; i < 4; ++i)
+			{
+				otpw[i] = _mm512_xor_si512(otpw[i], _mm512_alignr_epi64(inpw[i], inpw[i - 1], 6));
+			}
 
-			rhx_decrypt_blockw(state, &otpw, &inpw);
-			otpw = _mm512_xor_si512(otpw, ivtw);
+			ivt = _mm512_extracti32x4_epi32(inpw[3], 3);
 
-			_mm512_storeu_si512((__m512i*)(uint8_t*)(output + oft), otpw);
-			inputlen -= AVX512_BLOCK_SIZE;
-			oft += AVX512_BLOCK_SIZE;
-		}
+			for (i = 0; i < 4; ++i)
+			{
+				_mm512_storeu_si512((__m512i*)(output + oft + (i * AVX512_BLOCK_SIZE)), otpw[i]);
+			}
 
-		qsc_memutils_copy(state->nonce, (uint8_t*)(input + (oft - QSC_RHX_BLOCK_SIZE)), QSC_RHX_BLOCK_SIZE);
+			inputlen -= 4 * AVX512_BLOCK_SIZE;
+			oft += 4 * AVX512_BLOCK_SIZE;
+		}
 	}
 
 #endif
 
-	if (inputlen > QSC_RHX_BLOCK_SIZE)
+	if (inputlen > RHX_PARALLEL_BLOCKS * QSC_RHX_BLOCK_SIZE)
 	{
-		ivt = _mm_loadu_si128((const __m128i*)state->nonce);
-		inp = _mm_setzero_si128();
+		__m128i inpb[RHX_PARALLEL_BLOCKS];
+		__m128i otpb[RHX_PARALLEL_BLOCKS];
 
-		while (inputlen > QSC_RHX_BLOCK_SIZE)
+		while (inputlen > RHX_PARALLEL_BLOCKS * QSC_RHX_BLOCK_SIZE)
 		{
-			inp = _mm_loadu_si128((const __m128i*)(uint8_t*)(input + oft));
+			for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				inpb[i] = _mm_loadu_si128((const __m128i*)(input + oft + (i * QSC_RHX_BLOCK_SIZE)));
+			}
 
-			rhx_decrypt_block(state, &otp, &inp);
-			otp = _mm_xor_si128(otp, ivt);
+			rhx_decrypt_block_x8(state, otpb, inpb);
+			otpb[0] = _mm_xor_si128(otpb[0], ivt);
 
-			_mm_storeu_si128((__m128i*) & ivt, inp);
-			_mm_storeu_si128((__m128i*)(uint8_t*)(output + oft), otp);
+			for (i = 1; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				otpb[i] = _mm_xor_si128(otpb[i], inpb[i - 1]);
+			}
 
-			inputlen -= QSC_RHX_BLOCK_SIZE;
-			oft += QSC_RHX_BLOCK_SIZE;
+			ivt = inpb[RHX_PARALLEL_BLOCKS - 1];
+
+			for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				_mm_storeu_si128((__m128i*)(output + oft + (i * QSC_RHX_BLOCK_SIZE)), otpb[i]);
+			}
+
+			inputlen -= RHX_PARALLEL_BLOCKS * QSC_RHX_BLOCK_SIZE;
+			oft += RHX_PARALLEL_BLOCKS * QSC_RHX_BLOCK_SIZE;
 		}
+	}
 
-		_mm_storeu_si128((__m128i*)state->nonce, inp);
+	while (inputlen > QSC_RHX_BLOCK_SIZE)
+	{
+		inp = _mm_loadu_si128((const __m128i*)(input + oft));
+
+		rhx_decrypt_block(state, &otp, &inp);
+		otp = _mm_xor_si128(otp, ivt);
+		ivt = inp;
+
+		_mm_storeu_si128((__m128i*)(output + oft), otp);
+
+		inputlen -= QSC_RHX_BLOCK_SIZE;
+		oft += QSC_RHX_BLOCK_SIZE;
 	}
 
+	_mm_storeu_si128((__m128i*)state->nonce, ivt);
+
 	uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
 	qsc_rhx_cbc_decrypt_block(state, tmpb, (uint8_t*)(input + oft));
 	len = qsc_pkcs7_padding_length(tmpb);
@@ -658,50 +915,133 @@ void qsc_rhx_cbc_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 	_mm_storeu_si128((__m128i*)output, otp);
 }
 
-/* ctr mode */
-static void encryption_test()
-{
-	uint8_t msg[AVX512_BLOCK_SIZE] = { 0 };
-	uint8_t ncel[AVX512_BLOCK_SIZE] = { 0 };
-	uint8_t ncea[QSC_RHX_BLOCK_SIZE] = { 0 };
-	uint8_t nces[QSC_RHX_BLOCK_SIZE] = { 0 };
-	uint8_t otpa[AVX512_BLOCK_SIZE] = { 0 };
-	uint8_t otpb[AVX512_BLOCK_SIZE] = { 0 };
-	__m128i inp;
-	__m128i nce;
-	__m128i otp;
-	__m512i ncew;
+void qsc_rhx_cbc_encrypt_multi(qsc_rhx_state* const* states, uint8_t* const* outputs, const uint8_t* const* inputs, size_t inputlen, size_t count)
+{
+	assert(states != NULL);
+	assert(inputs != NULL);
+	assert(outputs != NULL);
+	assert(inputlen % QSC_RHX_BLOCK_SIZE == 0);
+
 	size_t i;
 	size_t oft;
+	size_t sidx;
 
-	oft = 0;
+	sidx = 0;
 
-	for (i = 0; i < 4; ++i)
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	if (count >= RHX_MULTI_STREAMS_WIDE)
 	{
-		nce = _mm_loadu_si128((const __m128i*)nces);
-		inp = _mm_loadu_si128((const __m128i*)(uint8_t*)(msg + oft));
-		// encrypt
-		_mm_storeu_si128((__m128i*)(uint8_t*)(otpa + oft), otp);
-		qsc_intutils_leincrement_x128(&nce);
+		__m512i rkeyw[31 * 4];
+		__m512i ivtw[4];
+		__m512i inpw[4];
+		__m128i otpb[RHX_MULTI_STREAMS_WIDE];
+		size_t j;
+		size_t rlen;
+
+		while (count - sidx >= RHX_MULTI_STREAMS_WIDE)
+		{
+			rlen = states[sidx]->roundkeylen;
+
+			/* interleave the key schedules and chaining vectors, four streams per vector */
+			for (i = 0; i < 4; ++i)
+			{
+				for (j = 0; j < rlen; ++j)
+				{
+					assert(states[sidx + (i * 4)]->roundkeylen == rlen);
+					rkeyw[(j * 4) + i] = _mm512_castsi128_si512(states[sidx + (i * 4)]->roundkeys[j]);
+					rkeyw[(j * 4) + i] = _mm512_inserti32x4(rkeyw[(j * 4) + i], states[sidx + (i * 4) + 1]->roundkeys[j], 1);
+					rkeyw[(j * 4) + i] = _mm512_inserti32x4(rkeyw[(j * 4) + i], states[sidx + (i * 4) + 2]->roundkeys[j], 2);
+					rkeyw[(j * 4) + i] = _mm512_inserti32x4(rkeyw[(j * 4) + i], states[sidx + (i * 4) + 3]->roundkeys[j], 3);
+				}
+
+				ivtw[i] = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)states[sidx + (i * 4)]->nonce));
+				ivtw[i] = _mm512_inserti32x4(ivtw[i], _mm_loadu_si128((const __m128i*)states[sidx + (i * 4) + 1]->nonce), 1);
+				ivtw[i] = _mm512_inserti32x4(ivtw[i], _mm_loadu_si128((const __m128i*)states[sidx + (i * 4) + 2]->nonce), 2);
+				ivtw[i] = _mm512_inserti32x4(ivtw[i], _mm_loadu_si128((const __m128i*)states[sidx + (i * 4) + 3]->nonce), 3);
+			}
+
+			for (oft = 0; oft < inputlen; oft += QSC_RHX_BLOCK_SIZE)
+			{
+				for (i = 0; i < 4; ++i)
+				{
+					inpw[i] = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(inputs[sidx + (i * 4)] + oft)));
+					inpw[i] = _mm512_inserti32x4(inpw[i], _mm_loadu_si128((const __m128i*)(inputs[sidx + (i * 4) + 1] + oft)), 1);
+					inpw[i] = _mm512_inserti32x4(inpw[i], _mm_loadu_si128((const __m128i*)(inputs[sidx + (i * 4) + 2] + oft)), 2);
+					inpw[i] = _mm512_inserti32x4(inpw[i], _mm_loadu_si128((const __m128i*)(inputs[sidx + (i * 4) + 3] + oft)), 3);
+					inpw[i] = _mm512_xor_si512(inpw[i], ivtw[i]);
+				}
+
+				rhx_encrypt_blockw_multi(rkeyw, rlen, ivtw, inpw);
+				_mm512_storeu_si512((__m512i*)otpb, ivtw[0]);
+				_mm512_storeu_si512((__m512i*)(otpb + 4), ivtw[1]);
+				_mm512_storeu_si512((__m512i*)(otpb + 8), ivtw[2]);
+				_mm512_storeu_si512((__m512i*)(otpb + 12), ivtw[3]);
+
+				for (i = 0; i < RHX_MULTI_STREAMS_WIDE; ++i)
+				{
+					_mm_storeu_si128((__m128i*)(outputs[sidx + i] + oft), otpb[i]);
+				}
+			}
+
+			if (inputlen != 0)
+			{
+				for (i = 0; i < RHX_MULTI_STREAMS_WIDE; ++i)
+				{
+					_mm_storeu_si128((__m128i*)states[sidx + i]->nonce, otpb[i]);
+				}
+			}
+
+			sidx += RHX_MULTI_STREAMS_WIDE;
+		}
+
+		qsc_memutils_clear((uint8_t*)rkeyw, sizeof(rkeyw));
 	}
 
-	/* load the ctr nonce block */
-	qsc_memutils_copy(ncel, ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_intutils_le8increment(ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_memutils_copy((uint8_t*)(ncel + 16), ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_intutils_le8increment(ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_memutils_copy((uint8_t*)(ncel + 32), ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_intutils_le8increment(ncea, QSC_RHX_BLOCK_SIZE);
-	qsc_memutils_copy((uint8_t*)(ncel + 48), ncea, QSC_RHX_BLOCK_SIZE);
-	ncew = _mm512_loadu_si512((const __m512i*)ncel);
+#endif
+
+	while (sidx < count)
+	{
+		__m128i ivtb[RHX_PARALLEL_BLOCKS];
+		__m128i inpb[RHX_PARALLEL_BLOCKS];
+		size_t scnt;
+
+		scnt = (count - sidx < RHX_PARALLEL_BLOCKS) ? count - sidx : RHX_PARALLEL_BLOCKS;
+
+		for (i = 0; i < scnt; ++i)
+		{
+			assert(states[sidx + i]->roundkeylen == states[sidx]->roundkeylen);
+			ivtb[i] = _mm_loadu_si128((const __m128i*)states[sidx + i]->nonce);
+		}
+
+		for (oft = 0; oft < inputlen; oft += QSC_RHX_BLOCK_SIZE)
+		{
+			for (i = 0; i < scnt; ++i)
+			{
+				inpb[i] = _mm_loadu_si128((const __m128i*)(inputs[sidx + i] + oft));
+				inpb[i] = _mm_xor_si128(inpb[i], ivtb[i]);
+			}
+
+			rhx_encrypt_block_multi(states + sidx, ivtb, inpb, scnt);
+
+			for (i = 0; i < scnt; ++i)
+			{
+				_mm_storeu_si128((__m128i*)(outputs[sidx + i] + oft), ivtb[i]);
+			}
+		}
+
+		for (i = 0; i < scnt; ++i)
+		{
+			_mm_storeu_si128((__m128i*)states[sidx + i]->nonce, ivtb[i]);
+		}
+
+		sidx += scnt;
+	}
 }
 
-void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+/* ctr mode */
+static void rhx_ctrbe_blocks(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
 {
-	assert(state != NULL);
-	assert(input != NULL);
-	assert(output != NULL);
-
 	__m128i inp;
 	__m128i nce;
 	__m128i otp;
@@ -774,28 +1114,10 @@ void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_
 		_mm_storeu_si128((__m128i*)state->nonce, nce);
 	}
 
-	if (inputlen != 0)
-	{
-		uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
-
-		nce = _mm_loadu_si128((const __m128i*)state->nonce);
-		qsc_intutils_be8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
-
-		rhx_encrypt_block(state, &otp, &nce);
-		inp = _mm_loadu_si128((const __m128i*)((uint8_t*)input + oft));
-		otp = _mm_xor_si128(inp, otp);
-
-		_mm_storeu_si128((__m128i*)tmpb, otp);
-		qsc_memutils_copy(((uint8_t*)output + oft), tmpb, inputlen);
-	}
 }
 
-void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+static void rhx_ctrle_blocks(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
 {
-	assert(state != NULL);
-	assert(input != NULL);
-	assert(output != NULL);
-
 	__m128i inp;
 	__m128i nce;
 	__m128i otp;
@@ -864,20 +1186,6 @@ void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_
 		_mm_storeu_si128((__m128i*)state->nonce, nce);
 	}
 
-	if (inputlen != 0)
-	{
-		uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
-
-		nce = _mm_loadu_si128((const __m128i*)state->nonce);
-		qsc_intutils_le8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
-
-		rhx_encrypt_block(state, &otp, &nce);
-		inp = _mm_loadu_si128((const __m128i*)(uint8_t*)(input + oft));
-		otp = _mm_xor_si128(inp, otp);
-
-		_mm_storeu_si128((__m128i*)tmpb, otp);
-		qsc_memutils_copy((uint8_t*)(output + oft), tmpb, inputlen);
-	}
 }
 
 /* ecb mode */
@@ -927,6 +1235,8 @@ void qsc_rhx_dispose(qsc_rhx_state* state)
 			qsc_memutils_clear((uint8_t*)state->roundkeysw, sizeof(state->roundkeysw));
 		}
 #endif
+		qsc_memutils_clear(state->kstream, sizeof(state->kstream));
+		state->kslen = 0;
 		state->roundkeylen = 0;
 	}
 }
@@ -1207,6 +1517,398 @@ static void rhx_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8
 	qsc_memutils_copy(output, buf, QSC_RHX_BLOCK_SIZE);
 }
 
+/* bitsliced constant-time implementation, eight blocks in parallel;
+   each of the sixteen 64-bit words holds one bit of every byte of two state columns,
+   a byte of the word is one state row, and the bits of that byte are the eight blocks */
+
+static uint64_t rhx_bs_transpose8(uint64_t x)
+{
+	uint64_t t;
+
+	/* transpose an 8x8 bit matrix, rows are bytes and columns are bits */
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
+
+static void rhx_bs_load(uint64_t* q, const uint8_t* input)
+{
+	uint64_t x;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t sft;
+
+	qsc_memutils_clear((uint8_t*)q, RHX_BITSLICE_WORDS * sizeof(uint64_t));
+
+	for (j = 0; j < QSC_RHX_BLOCK_SIZE; ++j)
+	{
+		x = 0;
+
+		for (k = 0; k < RHX_BITSLICE_BLOCKS; ++k)
+		{
+			x |= (uint64_t)input[(k * QSC_RHX_BLOCK_SIZE) + j] << (k * 8);
+		}
+
+		/* byte i of x is now bit i of state byte j, across all blocks */
+		x = rhx_bs_transpose8(x);
+		sft = ((j >> 2) & 1) * 32 + (j & 3) * 8;
+
+		for (i = 0; i < 8; ++i)
+		{
+			q[((j >> 3) * 8) + i] |= ((x >> (i * 8)) & 0xFFULL) << sft;
+		}
+	}
+}
+
+static void rhx_bs_store(uint8_t* output, const uint64_t* q)
+{
+	uint64_t x;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t sft;
+
+	for (j = 0; j < QSC_RHX_BLOCK_SIZE; ++j)
+	{
+		x = 0;
+		sft = ((j >> 2) & 1) * 32 + (j & 3) * 8;
+
+		for (i = 0; i < 8; ++i)
+		{
+			x |= ((q[((j >> 3) * 8) + i] >> sft) & 0xFFULL) << (i * 8);
+		}
+
+		x = rhx_bs_transpose8(x);
+
+		for (k = 0; k < RHX_BITSLICE_BLOCKS; ++k)
+		{
+			output[(k * QSC_RHX_BLOCK_SIZE) + j] = (uint8_t)(x >> (k * 8));
+		}
+	}
+}
+
+static void rhx_bs_sbox(uint64_t* q)
+{
+	/* the Boyar-Peralta s-box circuit; 'A new combinational logic minimization technique
+	   with applications to cryptology', https://eprint.iacr.org/2009/191 */
+	uint64_t x0, x1, x2, x3, x4, x5, x6, x7;
+	uint64_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+	uint64_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+	uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+	uint64_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+	uint64_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+	uint64_t t60, t61, t62, t63, t64, t65, t66, t67;
+	uint64_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+	/* the circuit numbers the bits from the high bit */
+	x0 = q[7];
+	x1 = q[6];
+	x2 = q[5];
+	x3 = q[4];
+	x4 = q[3];
+	x5 = q[2];
+	x6 = q[1];
+	x7 = q[0];
+
+	/* top linear transformation */
+	y14 = x3 ^ x5;
+	y13 = x0 ^ x6;
+	y9 = x0 ^ x3;
+	y8 = x0 ^ x5;
+	t0 = x1 ^ x2;
+	y1 = t0 ^ x7;
+	y4 = y1 ^ x3;
+	y12 = y13 ^ y14;
+	y2 = y1 ^ x0;
+	y5 = y1 ^ x6;
+	y3 = y5 ^ y8;
+	t1 = x4 ^ y12;
+	y15 = t1 ^ x5;
+	y20 = t1 ^ x1;
+	y6 = y15 ^ x7;
+	y10 = y15 ^ t0;
+	y11 = y20 ^ y9;
+	y7 = x7 ^ y11;
+	y17 = y10 ^ y11;
+	y19 = y10 ^ y8;
+	y16 = t0 ^ y11;
+	y21 = y13 ^ y16;
+	y18 = x0 ^ y16;
+
+	/* non-linear section */
+	t2 = y12 & y15;
+	t3 = y3 & y6;
+	t4 = t3 ^ t2;
+	t5 = y4 & x7;
+	t6 = t5 ^ t2;
+	t7 = y13 & y16;
+	t8 = y5 & y1;
+	t9 = t8 ^ t7;
+	t10 = y2 & y7;
+	t11 = t10 ^ t7;
+	t12 = y9 & y11;
+	t13 = y14 & y17;
+	t14 = t13 ^ t12;
+	t15 = y8 & y10;
+	t16 = t15 ^ t12;
+	t17 = t4 ^ t14;
+	t18 = t6 ^ t16;
+	t19 = t9 ^ t14;
+	t20 = t11 ^ t16;
+	t21 = t17 ^ y20;
+	t22 = t18 ^ y19;
+	t23 = t19 ^ y21;
+	t24 = t20 ^ y18;
+
+	t25 = t21 ^ t22;
+	t26 = t21 & t23;
+	t27 = t24 ^ t26;
+	t28 = t25 & t27;
+	t29 = t28 ^ t22;
+	t30 = t23 ^ t24;
+	t31 = t22 ^ t26;
+	t32 = t31 & t30;
+	t33 = t32 ^ t24;
+	t34 = t23 ^ t33;
+	t35 = t27 ^ t33;
+	t36 = t24 & t35;
+	t37 = t36 ^ t34;
+	t38 = t27 ^ t36;
+	t39 = t29 & t38;
+	t40 = t25 ^ t39;
+
+	t41 = t40 ^ t37;
+	t42 = t29 ^ t33;
+	t43 = t29 ^ t40;
+	t44 = t33 ^ t37;
+	t45 = t42 ^ t41;
+	z0 = t44 & y15;
+	z1 = t37 & y6;
+	z2 = t33 & x7;
+	z3 = t43 & y16;
+	z4 = t40 & y1;
+	z5 = t29 & y7;
+	z6 = t42 & y11;
+	z7 = t45 & y17;
+	z8 = t41 & y10;
+	z9 = t44 & y12;
+	z10 = t37 & y3;
+	z11 = t33 & y4;
+	z12 = t43 & y13;
+	z13 = t40 & y5;
+	z14 = t29 & y2;
+	z15 = t42 & y9;
+	z16 = t45 & y14;
+	z17 = t41 & y8;
+
+	/* bottom linear transformation */
+	t46 = z15 ^ z16;
+	t47 = z10 ^ z11;
+	t48 = z5 ^ z13;
+	t49 = z9 ^ z10;
+	t50 = z2 ^ z12;
+	t51 = z2 ^ z5;
+	t52 = z7 ^ z8;
+	t53 = z0 ^ z3;
+	t54 = z6 ^ z7;
+	t55 = z16 ^ z17;
+	t56 = z12 ^ t48;
+	t57 = t50 ^ t53;
+	t58 = z4 ^ t46;
+	t59 = z3 ^ t54;
+	t60 = t46 ^ t57;
+	t61 = z14 ^ t57;
+	t62 = t52 ^ t58;
+	t63 = t49 ^ t58;
+	t64 = z4 ^ t59;
+	t65 = t61 ^ t62;
+	t66 = z1 ^ t63;
+	s0 = t59 ^ t63;
+	s6 = t56 ^ ~t62;
+	s7 = t48 ^ ~t60;
+	t67 = t64 ^ t65;
+	s3 = t53 ^ t66;
+	s4 = t51 ^ t66;
+	s5 = t47 ^ t65;
+	s1 = t64 ^ ~s3;
+	s2 = t55 ^ ~t67;
+
+	q[7] = s0;
+	q[6] = s1;
+	q[5] = s2;
+	q[4] = s3;
+	q[3] = s4;
+	q[2] = s5;
+	q[1] = s6;
+	q[0] = s7;
+}
+
+static void rhx_bs_shift_rows(uint64_t* q)
+{
+	const uint64_t R0 = 0x000000FF000000FFULL;
+	const uint64_t R1 = 0x0000FF000000FF00ULL;
+	const uint64_t R2 = 0x00FF000000FF0000ULL;
+	const uint64_t R3 = 0xFF000000FF000000ULL;
+	uint64_t w0;
+	uint64_t w1;
+	size_t i;
+
+	/* row r of column c takes row r of column c + r */
+	for (i = 0; i < 8; ++i)
+	{
+		w0 = q[i];
+		w1 = q[i + 8];
+		q[i] = (w0 & R0) | (((w0 >> 32) | (w1 << 32)) & R1) | (w1 & R2) | (((w1 >> 32) | (w0 << 32)) & R3);
+		q[i + 8] = (w1 & R0) | (((w1 >> 32) | (w0 << 32)) & R1) | (w0 & R2) | (((w0 >> 32) | (w1 << 32)) & R3);
+	}
+}
+
+static void rhx_bs_mix_columns(uint64_t* q)
+{
+	uint64_t a1[8];
+	uint64_t u[8];
+	size_t i;
+	size_t w;
+
+	/* b(r) = 2(a(r) ^ a(r+1)) ^ a(r+1) ^ a(r+2) ^ a(r+3) */
+	for (w = 0; w < RHX_BITSLICE_WORDS; w += 8)
+	{
+		for (i = 0; i < 8; ++i)
+		{
+			a1[i] = ((q[w + i] >> 8) & 0x00FFFFFF00FFFFFFULL) | ((q[w + i] << 24) & 0xFF000000FF000000ULL);
+			u[i] = q[w + i] ^ a1[i];
+			q[w + i] = a1[i] ^ (((u[i] >> 16) & 0x0000FFFF0000FFFFULL) | ((u[i] << 16) & 0xFFFF0000FFFF0000ULL));
+		}
+
+		/* multiply u by x, and reduce by the polynomial 0x11B */
+		q[w] ^= u[7];
+		q[w + 1] ^= u[0] ^ u[7];
+		q[w + 2] ^= u[1];
+		q[w + 3] ^= u[2] ^ u[7];
+		q[w + 4] ^= u[3] ^ u[7];
+		q[w + 5] ^= u[4];
+		q[w + 6] ^= u[5];
+		q[w + 7] ^= u[6];
+	}
+}
+
+static void rhx_bs_add_roundkey(uint64_t* q, const uint64_t* skeys)
+{
+	size_t i;
+
+	for (i = 0; i < RHX_BITSLICE_WORDS; ++i)
+	{
+		q[i] ^= skeys[i];
+	}
+}
+
+static void rhx_bs_expand_keys(qsc_rhx_state* state)
+{
+	uint64_t* skeys;
+	uint64_t msk;
+	size_t i;
+	size_t j;
+	size_t n;
+	uint8_t kb;
+
+	qsc_memutils_clear((uint8_t*)state->roundkeysb, sizeof(state->roundkeysb));
+
+	/* spread every round-key bit across the eight block lanes of its state byte */
+	for (n = 0; n <= state->rounds; ++n)
+	{
+		skeys = state->roundkeysb + (n * RHX_BITSLICE_WORDS);
+
+		for (j = 0; j < QSC_RHX_BLOCK_SIZE; ++j)
+		{
+			kb = (uint8_t)(state->roundkeys[(n * 4) + (j >> 2)] >> (24 - ((j & 3) * 8)));
+			msk = 0xFFULL << (((j >> 2) & 1) * 32 + (j & 3) * 8);
+
+			for (i = 0; i < 8; ++i)
+			{
+				skeys[((j >> 3) * 8) + i] |= (0ULL - (uint64_t)((kb >> i) & 1)) & msk;
+			}
+		}
+	}
+}
+
+static void rhx_bs_encrypt_blocks(const qsc_rhx_state* state, uint8_t* output, const uint8_t* input)
+{
+	uint64_t q[RHX_BITSLICE_WORDS];
+	size_t i;
+
+	rhx_bs_load(q, input);
+	rhx_bs_add_roundkey(q, state->roundkeysb);
+
+	for (i = 1; i < state->rounds; ++i)
+	{
+		rhx_bs_sbox(q);
+		rhx_bs_sbox(q + 8);
+		rhx_bs_shift_rows(q);
+		rhx_bs_mix_columns(q);
+		rhx_bs_add_roundkey(q, state->roundkeysb + (i * RHX_BITSLICE_WORDS));
+	}
+
+	rhx_bs_sbox(q);
+	rhx_bs_sbox(q + 8);
+	rhx_bs_shift_rows(q);
+	rhx_bs_add_roundkey(q, state->roundkeysb + (state->rounds * RHX_BITSLICE_WORDS));
+	rhx_bs_store(output, q);
+	qsc_memutils_clear((uint8_t*)q, sizeof(q));
+}
+
+static void rhx_bs_ctr_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen, bool bigendian)
+{
+	uint8_t ctrs[RHX_BITSLICE_BLOCKS * QSC_RHX_BLOCK_SIZE];
+	uint8_t ks[RHX_BITSLICE_BLOCKS * QSC_RHX_BLOCK_SIZE];
+	size_t blen;
+	size_t i;
+	size_t oft;
+
+	oft = 0;
+
+	/* every key-stream request is a full bitsliced call, the partial tail is not a special case */
+	while (inputlen != 0)
+	{
+		blen = (inputlen < sizeof(ks)) ? inputlen : sizeof(ks);
+
+		for (i = 0; i < RHX_BITSLICE_BLOCKS; ++i)
+		{
+			qsc_memutils_copy(ctrs + (i * QSC_RHX_BLOCK_SIZE), state->nonce, QSC_RHX_BLOCK_SIZE);
+
+			/* only the counters that are used advance the nonce */
+			if (i * QSC_RHX_BLOCK_SIZE < blen)
+			{
+				if (bigendian)
+				{
+					qsc_intutils_be8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
+				}
+				else
+				{
+					qsc_intutils_le8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
+				}
+			}
+		}
+
+		rhx_bs_encrypt_blocks(state, ks, ctrs);
+
+		for (i = 0; i < blen; ++i)
+		{
+			output[oft + i] = input[oft + i] ^ ks[i];
+		}
+
+		inputlen -= blen;
+		oft += blen;
+	}
+
+	qsc_memutils_clear(ks, sizeof(ks));
+}
+
 static void rhx_expand_rot(uint32_t* key, uint32_t keyindex, uint32_t keyoffset, uint32_t rconindex)
 {
 	uint32_t subkey;
@@ -1390,6 +2092,8 @@ void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams
 	}
 
 	qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
+	qsc_memutils_clear(state->kstream, sizeof(state->kstream));
+	state->kslen = 0;
 
 	if (ctype == RHX256)
 	{
@@ -1420,6 +2124,16 @@ void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams
 		state->rounds = 0;
 		state->roundkeylen = 0;
 	}
+
+	/* the bitsliced schedule is only used by the counter modes, which always encrypt */
+	if (encryption == true)
+	{
+		rhx_bs_expand_keys(state);
+	}
+	else
+	{
+		qsc_memutils_clear((uint8_t*)state->roundkeysb, sizeof(state->roundkeysb));
+	}
 }
 
 /* cbc mode */
@@ -1518,127 +2232,154 @@ void qsc_rhx_cbc_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 	qsc_memutils_copy(state->nonce, output, QSC_RHX_BLOCK_SIZE);
 }
 
-/* ctr mode */
-
-void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+void qsc_rhx_cbc_encrypt_multi(qsc_rhx_state* const* states, uint8_t* const* outputs, const uint8_t* const* inputs, size_t inputlen, size_t count)
 {
-	assert(state != NULL);
-	assert(input != NULL);
-	assert(output != NULL);
+	assert(states != NULL);
+	assert(inputs != NULL);
+	assert(outputs != NULL);
+	assert(inputlen % QSC_RHX_BLOCK_SIZE == 0);
 
 	size_t i;
 	size_t oft;
 
-	oft = 0;
-
-	while (inputlen >= QSC_RHX_BLOCK_SIZE)
+	for (oft = 0; oft < inputlen; oft += QSC_RHX_BLOCK_SIZE)
 	{
-		rhx_encrypt_block(state, (uint8_t*)(output + oft), state->nonce);
-
-		for (i = 0; i < QSC_RHX_BLOCK_SIZE; ++i)
+		for (i = 0; i < count; ++i)
 		{
-			output[oft + i] ^= input[oft + i];
+			qsc_rhx_cbc_encrypt_block(states[i], outputs[i] + oft, inputs[i] + oft);
 		}
+	}
+}
 
-		qsc_intutils_be8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
+/* ctr mode */
 
-		inputlen -= QSC_RHX_BLOCK_SIZE;
-		oft += QSC_RHX_BLOCK_SIZE;
-	}
+static void rhx_ctrbe_blocks(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	rhx_bs_ctr_transform(state, output, input, inputlen, true);
+}
 
-	if (inputlen != 0)
-	{
-		uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
+static void rhx_ctrle_blocks(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	rhx_bs_ctr_transform(state, output, input, inputlen, false);
+}
 
-		rhx_encrypt_block(state, tmpb, state->nonce);
+/* ecb mode */
 
-		for (i = 0; i < inputlen; ++i)
-		{
-			output[oft + i] = tmpb[i] ^ input[oft + i];
-		}
+void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
 
-		qsc_intutils_be8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
-	}
+	rhx_decrypt_block(state, output, input);
 }
 
-void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input)
 {
 	assert(state != NULL);
 	assert(input != NULL);
 	assert(output != NULL);
 
+	rhx_encrypt_block(state, output, input);
+}
+
+void qsc_rhx_dispose(qsc_rhx_state* state)
+{
+	/* erase the state members */
+
+	if (state != NULL)
+	{
+		if (state->roundkeys != NULL)
+		{
+			qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
+		}
+
+		qsc_memutils_clear((uint8_t*)state->roundkeysb, sizeof(state->roundkeysb));
+		qsc_memutils_clear(state->kstream, sizeof(state->kstream));
+		state->kslen = 0;
+		state->roundkeylen = 0;
+	}
+}
+
+#endif
+
+/* ctr mode */
+
+static void rhx_ctr_stream(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen, bool bigendian)
+{
+	size_t blen;
 	size_t i;
 	size_t oft;
 
 	oft = 0;
 
-	while (inputlen >= QSC_RHX_BLOCK_SIZE)
+	/* use the key-stream left over from the partial block of the previous call */
+	while (state->kslen != 0 && inputlen != 0)
 	{
-		rhx_encrypt_block(state, (uint8_t*)(output + oft), state->nonce);
+		output[oft] = input[oft] ^ state->kstream[QSC_RHX_BLOCK_SIZE - state->kslen];
+		--state->kslen;
+		--inputlen;
+		++oft;
+	}
 
-		for (i = 0; i < QSC_RHX_BLOCK_SIZE; ++i)
+	blen = inputlen - (inputlen % QSC_RHX_BLOCK_SIZE);
+
+	if (blen != 0)
+	{
+		if (bigendian)
 		{
-			output[oft + i] ^= input[oft + i];
+			rhx_ctrbe_blocks(state, output + oft, input + oft, blen);
+		}
+		else
+		{
+			rhx_ctrle_blocks(state, output + oft, input + oft, blen);
 		}
 
-		qsc_intutils_le8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
-
-		inputlen -= QSC_RHX_BLOCK_SIZE;
-		oft += QSC_RHX_BLOCK_SIZE;
+		inputlen -= blen;
+		oft += blen;
 	}
 
+	/* a partial block consumes one counter, the remainder is kept for the next call */
 	if (inputlen != 0)
 	{
-		uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
+		qsc_memutils_clear(state->kstream, QSC_RHX_BLOCK_SIZE);
 
-		rhx_encrypt_block(state, tmpb, state->nonce);
+		if (bigendian)
+		{
+			rhx_ctrbe_blocks(state, state->kstream, state->kstream, QSC_RHX_BLOCK_SIZE);
+		}
+		else
+		{
+			rhx_ctrle_blocks(state, state->kstream, state->kstream, QSC_RHX_BLOCK_SIZE);
+		}
 
 		for (i = 0; i < inputlen; ++i)
 		{
-			output[oft + i] = tmpb[i] ^ input[oft + i];
+			output[oft + i] = input[oft + i] ^ state->kstream[i];
 		}
 
-		qsc_intutils_le8increment(state->nonce, QSC_RHX_BLOCK_SIZE);
+		state->kslen = QSC_RHX_BLOCK_SIZE - inputlen;
 	}
 }
 
-/* ecb mode */
-
-void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input)
+void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
 {
 	assert(state != NULL);
 	assert(input != NULL);
 	assert(output != NULL);
 
-	rhx_decrypt_block(state, output, input);
+	rhx_ctr_stream(state, output, input, inputlen, true);
 }
 
-void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input)
+void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
 {
 	assert(state != NULL);
 	assert(input != NULL);
 	assert(output != NULL);
 
-	rhx_encrypt_block(state, output, input);
-}
-
-void qsc_rhx_dispose(qsc_rhx_state* state)
-{
-	/* erase the state members */
-
-	if (state != NULL)
-	{
-		if (state->roundkeys != NULL)
-		{
-			qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
-		}
-
-		state->roundkeylen = 0;
-	}
+	rhx_ctr_stream(state, output, input, inputlen, false);
 }
 
-#endif
-
 /* pkcs7 padding */
 
 void qsc_pkcs7_add_padding(uint8_t* input, size_t length)
@@ -1829,6 +2570,7 @@ void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state)
 		state->aadlen = 0;
 		state->counter = 0;
 		state->custlen = 0;
+		state->active = false;
 		state->encrypt = false;
 	}
 }
@@ -1867,6 +2609,7 @@ void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keypar
 	state->counter = 1;
 	state->encrypt = encrypt;
 	state->aadlen = 0;
+	state->active = false;
 }
 
 void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen)
@@ -1886,6 +2629,9 @@ bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, cons
 
 	res = false;
 
+	/* a message starts on a counter block, key-stream left by a previous message is discarded */
+	state->cstate.kslen = 0;
+
 	/* update the processed bytes counter */
 	state->counter += inputlen;
 
@@ -1924,32 +2670,98 @@ bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, cons
 	return res;
 }
 
-/* rhx-hba512 */
-
-#if defined(QSC_HBA_KMAC_AUTH)
-static const uint8_t rhx_hba512_name[HBA_NAME_LENGTH] =
+void qsc_rhx_hba256_update(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
 {
-	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x48, 0x42, 0x41, 0x2D, 0x52, 0x48,
-	0x58, 0x53, 0x35, 0x31, 0x32, 0x2D, 0x4B, 0x4D, 0x41, 0x43, 0x35, 0x31, 0x32
-};
-#else
-static const uint8_t rhx_hba512_name[HBA_NAME_LENGTH] =
-{
-	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x48, 0x42, 0x41, 0x2D, 0x52, 0x48,
-	0x58, 0x48, 0x35, 0x31, 0x32, 0x2D, 0x48, 0x4D, 0x41, 0x43, 0x53, 0x48, 0x41, 0x32, 0x35, 0x31, 0x32
-};
-#endif
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
 
-static void rhx_hba512_update(qsc_rhx_hba512_state* state, uint8_t* input, size_t inputlen)
-{
-#if defined(QSC_RHX_SHAKE_EXTENSION)
-	qsc_kmac_update(&state->kstate, QSC_KECCAK_512_RATE, input, inputlen);
-#else
-	qsc_hmac512_update(&state->kstate, input, inputlen);
-#endif
-}
+	/* the first segment of a message adds the nonce to the mac */
+	if (state->active == false)
+	{
+		rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+		state->cstate.kslen = 0;
+		state->active = true;
+	}
 
-static void rhx_hba512_finalize(qsc_rhx_hba512_state* state, uint8_t* output)
+	state->counter += inputlen;
+
+	if (state->encrypt)
+	{
+		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+		rhx_hba256_update(state, output, inputlen);
+	}
+	else
+	{
+		/* mac the cipher-text before it is decrypted, the arrays can overlap */
+		rhx_hba256_update(state, input, inputlen);
+		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+	}
+}
+
+bool qsc_rhx_hba256_finalize(qsc_rhx_hba256_state* state, uint8_t* code)
+{
+	assert(state != NULL);
+	assert(code != NULL);
+
+	uint8_t tmpc[QSC_HBA256_MAC_LENGTH] = { 0 };
+	bool res;
+
+	res = false;
+
+	/* an empty message still authenticates the nonce */
+	if (state->active == false)
+	{
+		rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+	}
+
+	rhx_hba256_finalize(state, tmpc);
+
+	if (state->encrypt)
+	{
+		qsc_memutils_copy(code, tmpc, QSC_HBA256_MAC_LENGTH);
+		res = true;
+	}
+	else
+	{
+		res = (qsc_intutils_verify(tmpc, code, QSC_HBA256_MAC_LENGTH) == 0);
+	}
+
+	/* reset the stream for the next message */
+	qsc_memutils_clear(state->cstate.kstream, sizeof(state->cstate.kstream));
+	qsc_memutils_clear(tmpc, sizeof(tmpc));
+	state->cstate.kslen = 0;
+	state->active = false;
+
+	return res;
+}
+
+/* rhx-hba512 */
+
+#if defined(QSC_HBA_KMAC_AUTH)
+static const uint8_t rhx_hba512_name[HBA_NAME_LENGTH] =
+{
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x48, 0x42, 0x41, 0x2D, 0x52, 0x48,
+	0x58, 0x53, 0x35, 0x31, 0x32, 0x2D, 0x4B, 0x4D, 0x41, 0x43, 0x35, 0x31, 0x32
+};
+#else
+static const uint8_t rhx_hba512_name[HBA_NAME_LENGTH] =
+{
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x48, 0x42, 0x41, 0x2D, 0x52, 0x48,
+	0x58, 0x48, 0x35, 0x31, 0x32, 0x2D, 0x48, 0x4D, 0x41, 0x43, 0x53, 0x48, 0x41, 0x32, 0x35, 0x31, 0x32
+};
+#endif
+
+static void rhx_hba512_update(qsc_rhx_hba512_state* state, const uint8_t* input, size_t inputlen)
+{
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+	qsc_kmac_update(&state->kstate, QSC_KECCAK_512_RATE, input, inputlen);
+#else
+	qsc_hmac512_update(&state->kstate, input, inputlen);
+#endif
+}
+
+static void rhx_hba512_finalize(qsc_rhx_hba512_state* state, uint8_t* output)
 {
 	uint8_t mkey[HBA512_MKEY_LENGTH] = { 0 };
 	uint8_t pctr[sizeof(uint64_t)];
@@ -2068,6 +2880,7 @@ void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state)
 		state->aadlen = 0;
 		state->counter = 0;
 		state->custlen = 0;
+		state->active = false;
 		state->encrypt = false;
 	}
 }
@@ -2106,6 +2919,7 @@ void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keypar
 	state->counter = 1;
 	state->encrypt = encrypt;
 	state->aadlen = 0;
+	state->active = false;
 }
 
 void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen)
@@ -2125,6 +2939,9 @@ bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, cons
 
 	res = false;
 
+	/* a message starts on a counter block, key-stream left by a previous message is discarded */
+	state->cstate.kslen = 0;
+
 	/* update the processed bytes counter */
 	state->counter += inputlen;
 
@@ -2162,3 +2979,828 @@ bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, cons
 
 	return res;
 }
+
+void qsc_rhx_hba512_update(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
+
+	/* the first segment of a message adds the nonce to the mac */
+	if (state->active == false)
+	{
+		rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+		state->cstate.kslen = 0;
+		state->active = true;
+	}
+
+	state->counter += inputlen;
+
+	if (state->encrypt)
+	{
+		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+		rhx_hba512_update(state, output, inputlen);
+	}
+	else
+	{
+		/* mac the cipher-text before it is decrypted, the arrays can overlap */
+		rhx_hba512_update(state, input, inputlen);
+		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+	}
+}
+
+bool qsc_rhx_hba512_finalize(qsc_rhx_hba512_state* state, uint8_t* code)
+{
+	assert(state != NULL);
+	assert(code != NULL);
+
+	uint8_t tmpc[QSC_HBA512_MAC_LENGTH] = { 0 };
+	bool res;
+
+	res = false;
+
+	/* an empty message still authenticates the nonce */
+	if (state->active == false)
+	{
+		rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+	}
+
+	rhx_hba512_finalize(state, tmpc);
+
+	if (state->encrypt)
+	{
+		qsc_memutils_copy(code, tmpc, QSC_HBA512_MAC_LENGTH);
+		res = true;
+	}
+	else
+	{
+		res = (qsc_intutils_verify(tmpc, code, QSC_HBA512_MAC_LENGTH) == 0);
+	}
+
+	/* reset the stream for the next message */
+	qsc_memutils_clear(state->cstate.kstream, sizeof(state->cstate.kstream));
+	qsc_memutils_clear(tmpc, sizeof(tmpc));
+	state->cstate.kslen = 0;
+	state->active = false;
+
+	return res;
+}
+
+/* Galois/Counter Mode, -GCM- AEAD authenticated mode */
+
+#if defined(QSC_SYSTEM_AESNI_ENABLED)
+
+/*!
+\def RHX_GCM_AGGREGATE
+* The number of blocks hashed before each reduction in the carry-less multiply GHASH.
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define RHX_GCM_AGGREGATE 8
+#else
+#	define RHX_GCM_AGGREGATE 4
+#endif
+
+static __m128i rhx_gcm_bswap(__m128i x)
+{
+	return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+static void rhx_gcm_clmul(__m128i* lo, __m128i* hi, __m128i a, __m128i b)
+{
+	__m128i mid;
+
+	/* accumulate the unreduced 256-bit product */
+	mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+	*lo = _mm_xor_si128(*lo, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(mid, 8)));
+	*hi = _mm_xor_si128(*hi, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(mid, 8)));
+}
+
+static __m128i rhx_gcm_reduce(__m128i lo, __m128i hi)
+{
+	__m128i t2;
+	__m128i t4;
+	__m128i t5;
+	__m128i t7;
+	__m128i t8;
+	__m128i t9;
+
+	/* shift the product left by one bit to correct for the reflected operands */
+	t7 = _mm_srli_epi32(lo, 31);
+	t8 = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	t9 = _mm_srli_si128(t7, 12);
+	t8 = _mm_slli_si128(t8, 4);
+	t7 = _mm_slli_si128(t7, 4);
+	lo = _mm_or_si128(lo, t7);
+	hi = _mm_or_si128(hi, t8);
+	hi = _mm_or_si128(hi, t9);
+
+	/* reduce modulo x^128 + x^7 + x^2 + x + 1 */
+	t7 = _mm_slli_epi32(lo, 31);
+	t8 = _mm_slli_epi32(lo, 30);
+	t9 = _mm_slli_epi32(lo, 25);
+	t7 = _mm_xor_si128(t7, t8);
+	t7 = _mm_xor_si128(t7, t9);
+	t8 = _mm_srli_si128(t7, 4);
+	t7 = _mm_slli_si128(t7, 12);
+	lo = _mm_xor_si128(lo, t7);
+	t2 = _mm_srli_epi32(lo, 1);
+	t4 = _mm_srli_epi32(lo, 2);
+	t5 = _mm_srli_epi32(lo, 7);
+	t2 = _mm_xor_si128(t2, t4);
+	t2 = _mm_xor_si128(t2, t5);
+	t2 = _mm_xor_si128(t2, t8);
+	lo = _mm_xor_si128(lo, t2);
+
+	return _mm_xor_si128(hi, lo);
+}
+
+static __m128i rhx_gcm_multiply(__m128i a, __m128i b)
+{
+	__m128i hi;
+	__m128i lo;
+
+	hi = _mm_setzero_si128();
+	lo = _mm_setzero_si128();
+	rhx_gcm_clmul(&lo, &hi, a, b);
+
+	return rhx_gcm_reduce(lo, hi);
+}
+
+static void rhx_gcm_load_key(qsc_rhx_gcm_state* state, const uint8_t* hkey)
+{
+	size_t i;
+
+	state->hpow[0] = rhx_gcm_bswap(_mm_loadu_si128((const __m128i*)hkey));
+
+	for (i = 1; i < RHX_GCM_AGGREGATE; ++i)
+	{
+		state->hpow[i] = rhx_gcm_multiply(state->hpow[i - 1], state->hpow[0]);
+	}
+
+	state->ghash = _mm_setzero_si128();
+}
+
+static void rhx_gcm_extract(const qsc_rhx_gcm_state* state, uint8_t* output)
+{
+	_mm_storeu_si128((__m128i*)output, rhx_gcm_bswap(state->ghash));
+}
+
+static void rhx_gcm_reset(qsc_rhx_gcm_state* state)
+{
+	state->ghash = _mm_setzero_si128();
+}
+
+static void rhx_gcm_update(qsc_rhx_gcm_state* state, const uint8_t* input, size_t inputlen)
+{
+	__m128i hi;
+	__m128i lo;
+	__m128i x;
+	size_t i;
+	size_t oft;
+
+	oft = 0;
+	x = state->ghash;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	if (inputlen >= RHX_GCM_AGGREGATE * QSC_RHX_BLOCK_SIZE)
+	{
+		const __m512i BSWAPW = _mm512_set_epi8(
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		__m512i hiw;
+		__m512i hpw0;
+		__m512i hpw1;
+		__m512i low;
+		__m512i midw;
+		__m512i x0;
+		__m512i x1;
+
+		/* lane k of the first vector holds H^(8-k), lane k of the second holds H^(4-k) */
+		hpw0 = _mm512_setzero_si512();
+		hpw1 = _mm512_setzero_si512();
+
+		for (i = 0; i < 4; ++i)
+		{
+			hpw0 = _mm512_mask_broadcast_i32x4(hpw0, (__mmask16)(0x000FU << (i * 4)), state->hpow[7 - i]);
+			hpw1 = _mm512_mask_broadcast_i32x4(hpw1, (__mmask16)(0x000FU << (i * 4)), state->hpow[3 - i]);
+		}
+
+		while (inputlen >= RHX_GCM_AGGREGATE * QSC_RHX_BLOCK_SIZE)
+		{
+			x0 = _mm512_shuffle_epi8(_mm512_loadu_si512((const __m512i*)(input + oft)), BSWAPW);
+			x1 = _mm512_shuffle_epi8(_mm512_loadu_si512((const __m512i*)(input + oft + 64)), BSWAPW);
+			/* add the accumulator to the first block */
+			x0 = _mm512_xor_si512(x0, _mm512_maskz_broadcast_i32x4(0x000F, x));
+
+			/* multiply eight blocks by the key powers, four blocks per instruction */
+			low = _mm512_xor_si512(_mm512_clmulepi64_epi128(x0, hpw0, 0x00), _mm512_clmulepi64_epi128(x1, hpw1, 0x00));
+			hiw = _mm512_xor_si512(_mm512_clmulepi64_epi128(x0, hpw0, 0x11), _mm512_clmulepi64_epi128(x1, hpw1, 0x11));
+			midw = _mm512_xor_si512(_mm512_clmulepi64_epi128(x0, hpw0, 0x10), _mm512_clmulepi64_epi128(x0, hpw0, 0x01));
+			midw = _mm512_xor_si512(midw, _mm512_clmulepi64_epi128(x1, hpw1, 0x10));
+			midw = _mm512_xor_si512(midw, _mm512_clmulepi64_epi128(x1, hpw1, 0x01));
+			low = _mm512_xor_si512(low, _mm512_bslli_epi128(midw, 8));
+			hiw = _mm512_xor_si512(hiw, _mm512_bsrli_epi128(midw, 8));
+
+			/* fold the lanes and reduce once */
+			lo = _mm_xor_si128(_mm512_extracti32x4_epi32(low, 0), _mm512_extracti32x4_epi32(low, 1));
+			lo = _mm_xor_si128(lo, _mm_xor_si128(_mm512_extracti32x4_epi32(low, 2), _mm512_extracti32x4_epi32(low, 3)));
+			hi = _mm_xor_si128(_mm512_extracti32x4_epi32(hiw, 0), _mm512_extracti32x4_epi32(hiw, 1));
+			hi = _mm_xor_si128(hi, _mm_xor_si128(_mm512_extracti32x4_epi32(hiw, 2), _mm512_extracti32x4_epi32(hiw, 3)));
+			x = rhx_gcm_reduce(lo, hi);
+
+			inputlen -= RHX_GCM_AGGREGATE * QSC_RHX_BLOCK_SIZE;
+			oft += RHX_GCM_AGGREGATE * QSC_RHX_BLOCK_SIZE;
+		}
+	}
+
+#endif
+
+	/* aggregate four blocks per reduction */
+	while (inputlen >= 4 * QSC_RHX_BLOCK_SIZE)
+	{
+		hi = _mm_setzero_si128();
+		lo = _mm_setzero_si128();
+
+		for (i = 0; i < 4; ++i)
+		{
+			__m128i blk = rhx_gcm_bswap(_mm_loadu_si128((const __m128i*)(input + oft + (i * QSC_RHX_BLOCK_SIZE))));
+
+			if (i == 0)
+			{
+				blk = _mm_xor_si128(blk, x);
+			}
+
+			rhx_gcm_clmul(&lo, &hi, blk, state->hpow[3 - i]);
+		}
+
+		x = rhx_gcm_reduce(lo, hi);
+		inputlen -= 4 * QSC_RHX_BLOCK_SIZE;
+		oft += 4 * QSC_RHX_BLOCK_SIZE;
+	}
+
+	while (inputlen >= QSC_RHX_BLOCK_SIZE)
+	{
+		x = _mm_xor_si128(x, rhx_gcm_bswap(_mm_loadu_si128((const __m128i*)(input + oft))));
+		x = rhx_gcm_multiply(x, state->hpow[0]);
+		inputlen -= QSC_RHX_BLOCK_SIZE;
+		oft += QSC_RHX_BLOCK_SIZE;
+	}
+
+	/* zero-pad the last partial block */
+	if (inputlen != 0)
+	{
+		uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
+
+		qsc_memutils_copy(tmpb, input + oft, inputlen);
+		x = _mm_xor_si128(x, rhx_gcm_bswap(_mm_loadu_si128((const __m128i*)tmpb)));
+		x = rhx_gcm_multiply(x, state->hpow[0]);
+	}
+
+	state->ghash = x;
+}
+
+#else
+
+static void rhx_gcm_multiply(uint64_t* x, const uint64_t* h)
+{
+	uint64_t mask;
+	uint64_t v0;
+	uint64_t v1;
+	uint64_t z0;
+	uint64_t z1;
+	size_t i;
+
+	v0 = h[0];
+	v1 = h[1];
+	z0 = 0;
+	z1 = 0;
+
+	/* constant-time shift and add multiplication in GF(2^128) */
+	for (i = 0; i < 128; ++i)
+	{
+		mask = 0ULL - ((x[i >> 6] >> (63 - (i & 63))) & 1ULL);
+		z0 ^= v0 & mask;
+		z1 ^= v1 & mask;
+		mask = 0ULL - (v1 & 1ULL);
+		v1 = (v1 >> 1) | (v0 << 63);
+		v0 = (v0 >> 1) ^ (0xE100000000000000ULL & mask);
+	}
+
+	x[0] = z0;
+	x[1] = z1;
+}
+
+static void rhx_gcm_load_key(qsc_rhx_gcm_state* state, const uint8_t* hkey)
+{
+	state->hkey[0] = qsc_intutils_be8to64(hkey);
+	state->hkey[1] = qsc_intutils_be8to64(hkey + sizeof(uint64_t));
+	state->ghash[0] = 0;
+	state->ghash[1] = 0;
+}
+
+static void rhx_gcm_extract(const qsc_rhx_gcm_state* state, uint8_t* output)
+{
+	qsc_intutils_be64to8(output, state->ghash[0]);
+	qsc_intutils_be64to8(output + sizeof(uint64_t), state->ghash[1]);
+}
+
+static void rhx_gcm_reset(qsc_rhx_gcm_state* state)
+{
+	state->ghash[0] = 0;
+	state->ghash[1] = 0;
+}
+
+static void rhx_gcm_update(qsc_rhx_gcm_state* state, const uint8_t* input, size_t inputlen)
+{
+	uint8_t tmpb[QSC_RHX_BLOCK_SIZE];
+	size_t blen;
+	size_t oft;
+
+	oft = 0;
+
+	while (inputlen != 0)
+	{
+		blen = qsc_intutils_min(inputlen, QSC_RHX_BLOCK_SIZE);
+
+		/* zero-pad the last partial block */
+		qsc_memutils_clear(tmpb, sizeof(tmpb));
+		qsc_memutils_copy(tmpb, input + oft, blen);
+		state->ghash[0] ^= qsc_intutils_be8to64(tmpb);
+		state->ghash[1] ^= qsc_intutils_be8to64(tmpb + sizeof(uint64_t));
+		rhx_gcm_multiply(state->ghash, state->hkey);
+
+		inputlen -= blen;
+		oft += blen;
+	}
+}
+
+#endif
+
+static void rhx_gcm_finalize(qsc_rhx_gcm_state* state, uint8_t* output, const uint8_t* j0, size_t msglen)
+{
+	uint8_t blk[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t tag[QSC_RHX_BLOCK_SIZE] = { 0 };
+
+	/* hash the bit lengths of the associated data and cipher-text */
+	qsc_intutils_be64to8(blk, state->aadlen * 8);
+	qsc_intutils_be64to8(blk + sizeof(uint64_t), (uint64_t)msglen * 8);
+	rhx_gcm_update(state, blk, sizeof(blk));
+	rhx_gcm_extract(state, tag);
+
+	/* encrypt the hash with the initial counter block */
+	qsc_rhx_ecb_encrypt_block(&state->cstate, blk, j0);
+	qsc_memutils_xor(tag, blk, QSC_RHX_GCM_MAC_SIZE);
+	qsc_memutils_copy(output, tag, QSC_RHX_GCM_MAC_SIZE);
+}
+
+void qsc_rhx_gcm_dispose(qsc_rhx_gcm_state* state)
+{
+	if (state != NULL)
+	{
+		qsc_rhx_dispose(&state->cstate);
+		qsc_memutils_clear((uint8_t*)state, sizeof(qsc_rhx_gcm_state));
+	}
+}
+
+void qsc_rhx_gcm_initialize(qsc_rhx_gcm_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt, qsc_rhx_cipher_type ctype)
+{
+	assert(state != NULL);
+	assert(keyparams != NULL);
+	assert(keyparams->nonce != NULL);
+
+	const uint8_t zero[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t hkey[QSC_RHX_BLOCK_SIZE] = { 0 };
+
+	/* the counter mode is always initialized for encryption */
+	qsc_rhx_initialize(&state->cstate, keyparams, true, ctype);
+
+	/* the hash key is the encryption of the zero block */
+	qsc_rhx_ecb_encrypt_block(&state->cstate, hkey, zero);
+	rhx_gcm_load_key(state, hkey);
+	qsc_memutils_clear(hkey, sizeof(hkey));
+
+	state->aadlen = 0;
+	state->encrypt = encrypt;
+}
+
+void qsc_rhx_gcm_set_associated(qsc_rhx_gcm_state* state, const uint8_t* data, size_t datalen)
+{
+	assert(state != NULL);
+	assert(data != NULL);
+
+	size_t blen;
+	size_t rmd;
+
+	if (data != NULL && datalen != 0)
+	{
+		rmd = (size_t)(state->aadlen % QSC_RHX_BLOCK_SIZE);
+		state->aadlen += datalen;
+
+		/* complete the partial block held from the previous call */
+		if (rmd != 0)
+		{
+			blen = qsc_intutils_min(QSC_RHX_BLOCK_SIZE - rmd, datalen);
+			qsc_memutils_copy(state->aadbuf + rmd, data, blen);
+			data += blen;
+			datalen -= blen;
+
+			if (rmd + blen == QSC_RHX_BLOCK_SIZE)
+			{
+				rhx_gcm_update(state, state->aadbuf, QSC_RHX_BLOCK_SIZE);
+			}
+		}
+
+		/* hash the whole blocks, and hold the remainder until the next call or the transform */
+		blen = datalen - (datalen % QSC_RHX_BLOCK_SIZE);
+
+		if (blen != 0)
+		{
+			rhx_gcm_update(state, data, blen);
+		}
+
+		if (datalen != blen)
+		{
+			qsc_memutils_copy(state->aadbuf, data + blen, datalen - blen);
+		}
+	}
+}
+
+bool qsc_rhx_gcm_transform(qsc_rhx_gcm_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
+
+	uint8_t ctr[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t j0[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t* nonce;
+	bool res;
+
+	res = false;
+	nonce = state->cstate.nonce;
+
+	/* the initial counter block is the nonce and a 32-bit block counter set to one */
+	qsc_memutils_copy(j0, nonce, QSC_RHX_GCM_NONCE_SIZE);
+	j0[QSC_RHX_BLOCK_SIZE - 1] = 0x01;
+	qsc_memutils_copy(ctr, j0, QSC_RHX_BLOCK_SIZE);
+	qsc_intutils_be8increment(ctr, QSC_RHX_BLOCK_SIZE);
+
+	/* the message is encrypted by the big endian counter mode, starting at the second counter block */
+	state->cstate.nonce = ctr;
+	state->cstate.kslen = 0;
+
+	/* hash the zero-padded partial block of associated data */
+	if ((state->aadlen % QSC_RHX_BLOCK_SIZE) != 0)
+	{
+		rhx_gcm_update(state, state->aadbuf, (size_t)(state->aadlen % QSC_RHX_BLOCK_SIZE));
+	}
+
+	if (state->encrypt)
+	{
+		qsc_rhx_ctrbe_transform(&state->cstate, output, input, inputlen);
+		rhx_gcm_update(state, output, inputlen);
+		rhx_gcm_finalize(state, output + inputlen, j0, inputlen);
+		res = true;
+	}
+	else
+	{
+		uint8_t code[QSC_RHX_GCM_MAC_SIZE] = { 0 };
+
+		rhx_gcm_update(state, input, inputlen);
+		rhx_gcm_finalize(state, code, j0, inputlen);
+
+		/* compare the tags, bypassing the transform if authentication fails */
+		if (qsc_intutils_verify(code, input + inputlen, QSC_RHX_GCM_MAC_SIZE) == 0)
+		{
+			qsc_rhx_ctrbe_transform(&state->cstate, output, input, inputlen);
+			res = true;
+		}
+	}
+
+	/* restore and increment the nonce, and reset the hash for the next message */
+	state->cstate.nonce = nonce;
+	qsc_intutils_be8increment(nonce, QSC_RHX_GCM_NONCE_SIZE);
+	rhx_gcm_reset(state);
+	state->aadlen = 0;
+
+	return res;
+}
+
+/* XEX-based tweaked-codebook mode with ciphertext stealing, -XTS- */
+
+static void rhx_xts_gfdouble(uint8_t* tweak)
+{
+	uint8_t carry;
+	size_t i;
+
+	/* multiply the little endian tweak by the primitive element of GF(2^128) */
+	carry = tweak[QSC_RHX_BLOCK_SIZE - 1] >> 7;
+
+	for (i = QSC_RHX_BLOCK_SIZE - 1; i > 0; --i)
+	{
+		tweak[i] = (uint8_t)((tweak[i] << 1) | (tweak[i - 1] >> 7));
+	}
+
+	tweak[0] = (uint8_t)((tweak[0] << 1) ^ (0x87 & (0x00 - carry)));
+}
+
+static void rhx_xts_block(qsc_rhx_xts_state* state, uint8_t* output, const uint8_t* input, const uint8_t* tweak)
+{
+	uint8_t tmpb[QSC_RHX_BLOCK_SIZE] = { 0 };
+
+	qsc_memutils_copy(tmpb, input, QSC_RHX_BLOCK_SIZE);
+	qsc_memutils_xor(tmpb, tweak, QSC_RHX_BLOCK_SIZE);
+
+	if (state->encrypt)
+	{
+		qsc_rhx_ecb_encrypt_block(&state->dstate, output, tmpb);
+	}
+	else
+	{
+		qsc_rhx_ecb_decrypt_block(&state->dstate, output, tmpb);
+	}
+
+	qsc_memutils_xor(output, tweak, QSC_RHX_BLOCK_SIZE);
+	qsc_memutils_clear(tmpb, sizeof(tmpb));
+}
+
+#if defined(QSC_SYSTEM_AESNI_ENABLED)
+
+static __m128i rhx_xts_double(__m128i tweak)
+{
+	const __m128i poly = _mm_set_epi32(1, 1, 1, 0x87);
+	__m128i mask;
+
+	/* the carry out of each 32-bit word moves to the next word, the carry out of the top word is reduced */
+	mask = _mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x93);
+
+	return _mm_xor_si128(_mm_add_epi32(tweak, tweak), _mm_and_si128(mask, poly));
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static __m512i rhx_xts_advancew(__m512i tweak)
+{
+	const __m512i poly = _mm512_set_epi32(1, 1, 1, 0x87, 1, 1, 1, 0x87, 1, 1, 1, 0x87, 1, 1, 1, 0x87);
+	__m512i mask;
+	size_t i;
+
+	/* advance each of the four tweaks in the vector by four block positions */
+	for (i = 0; i < 4; ++i)
+	{
+		mask = _mm512_shuffle_epi32(_mm512_srai_epi32(tweak, 31), (_MM_PERM_ENUM)0x93);
+		tweak = _mm512_xor_si512(_mm512_add_epi32(tweak, tweak), _mm512_and_si512(mask, poly));
+	}
+
+	return tweak;
+}
+#endif
+
+static void rhx_xts_blocks(qsc_rhx_xts_state* state, uint8_t* output, const uint8_t* input, size_t blocks, uint8_t* tweak)
+{
+	__m128i blk;
+	__m128i twk;
+	size_t i;
+	size_t oft;
+
+	oft = 0;
+	twk = _mm_loadu_si128((const __m128i*)tweak);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	if (blocks >= 16)
+	{
+		__m512i blkw[4];
+		__m512i twkw[4];
+		__m128i tmpt;
+
+		/* the first vector holds the tweaks for blocks 0-3, each following vector is four positions ahead */
+		tmpt = twk;
+		twkw[0] = _mm512_castsi128_si512(tmpt);
+		tmpt = rhx_xts_double(tmpt);
+		twkw[0] = _mm512_inserti32x4(twkw[0], tmpt, 1);
+		tmpt = rhx_xts_double(tmpt);
+		twkw[0] = _mm512_inserti32x4(twkw[0], tmpt, 2);
+		tmpt = rhx_xts_double(tmpt);
+		twkw[0] = _mm512_inserti32x4(twkw[0], tmpt, 3);
+
+		for (i = 1; i < 4; ++i)
+		{
+			twkw[i] = rhx_xts_advancew(twkw[i - 1]);
+		}
+
+		while (blocks >= 16)
+		{
+			for (i = 0; i < 4; ++i)
+			{
+				blkw[i] = _mm512_loadu_si512((const __m512i*)(input + oft + (i * AVX512_BLOCK_SIZE)));
+				blkw[i] = _mm512_xor_si512(blkw[i], twkw[i]);
+			}
+
+			if (state->encrypt)
+			{
+				rhx_encrypt_blockw_x4(&state->dstate, blkw, blkw);
+			}
+			else
+			{
+				rhx_decrypt_blockw_x4(&state->dstate, blkw, blkw);
+			}
+
+			for (i = 0; i < 4; ++i)
+			{
+				blkw[i] = _mm512_xor_si512(blkw[i], twkw[i]);
+				_mm512_storeu_si512((__m512i*)(output + oft + (i * AVX512_BLOCK_SIZE)), blkw[i]);
+			}
+
+			twkw[0] = rhx_xts_advancew(twkw[3]);
+
+			for (i = 1; i < 4; ++i)
+			{
+				twkw[i] = rhx_xts_advancew(twkw[i - 1]);
+			}
+
+			blocks -= 16;
+			oft += 4 * AVX512_BLOCK_SIZE;
+		}
+
+		twk = _mm512_castsi512_si128(twkw[0]);
+	}
+
+#endif
+
+	if (blocks >= RHX_PARALLEL_BLOCKS)
+	{
+		__m128i blkb[RHX_PARALLEL_BLOCKS];
+		__m128i twkb[RHX_PARALLEL_BLOCKS];
+
+		while (blocks >= RHX_PARALLEL_BLOCKS)
+		{
+			twkb[0] = twk;
+
+			for (i = 1; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				twkb[i] = rhx_xts_double(twkb[i - 1]);
+			}
+
+			for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				blkb[i] = _mm_loadu_si128((const __m128i*)(input + oft + (i * QSC_RHX_BLOCK_SIZE)));
+				blkb[i] = _mm_xor_si128(blkb[i], twkb[i]);
+			}
+
+			if (state->encrypt)
+			{
+				rhx_encrypt_block_x8(&state->dstate, blkb, blkb);
+			}
+			else
+			{
+				rhx_decrypt_block_x8(&state->dstate, blkb, blkb);
+			}
+
+			for (i = 0; i < RHX_PARALLEL_BLOCKS; ++i)
+			{
+				blkb[i] = _mm_xor_si128(blkb[i], twkb[i]);
+				_mm_storeu_si128((__m128i*)(output + oft + (i * QSC_RHX_BLOCK_SIZE)), blkb[i]);
+			}
+
+			twk = rhx_xts_double(twkb[RHX_PARALLEL_BLOCKS - 1]);
+			blocks -= RHX_PARALLEL_BLOCKS;
+			oft += RHX_PARALLEL_BLOCKS * QSC_RHX_BLOCK_SIZE;
+		}
+	}
+
+	while (blocks != 0)
+	{
+		blk = _mm_loadu_si128((const __m128i*)(input + oft));
+		blk = _mm_xor_si128(blk, twk);
+
+		if (state->encrypt)
+		{
+			rhx_encrypt_block(&state->dstate, &blk, &blk);
+		}
+		else
+		{
+			rhx_decrypt_block(&state->dstate, &blk, &blk);
+		}
+
+		blk = _mm_xor_si128(blk, twk);
+		_mm_storeu_si128((__m128i*)(output + oft), blk);
+		twk = rhx_xts_double(twk);
+		--blocks;
+		oft += QSC_RHX_BLOCK_SIZE;
+	}
+
+	_mm_storeu_si128((__m128i*)tweak, twk);
+}
+
+#else
+
+static void rhx_xts_blocks(qsc_rhx_xts_state* state, uint8_t* output, const uint8_t* input, size_t blocks, uint8_t* tweak)
+{
+	size_t oft;
+
+	oft = 0;
+
+	while (blocks != 0)
+	{
+		rhx_xts_block(state, output + oft, input + oft, tweak);
+		rhx_xts_gfdouble(tweak);
+		--blocks;
+		oft += QSC_RHX_BLOCK_SIZE;
+	}
+}
+
+#endif
+
+void qsc_rhx_xts_dispose(qsc_rhx_xts_state* state)
+{
+	if (state != NULL)
+	{
+		qsc_rhx_dispose(&state->dstate);
+		qsc_rhx_dispose(&state->tstate);
+		qsc_memutils_clear((uint8_t*)state, sizeof(qsc_rhx_xts_state));
+	}
+}
+
+void qsc_rhx_xts_initialize(qsc_rhx_xts_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt, qsc_rhx_cipher_type ctype)
+{
+	assert(state != NULL);
+	assert(keyparams != NULL);
+	assert(keyparams->key != NULL);
+	assert(keyparams->keylen % 2 == 0);
+
+	const size_t KEYLEN = keyparams->keylen / 2;
+	const qsc_rhx_keyparams kp1 = { keyparams->key, KEYLEN, NULL, keyparams->info, keyparams->infolen };
+	const qsc_rhx_keyparams kp2 = { keyparams->key + KEYLEN, KEYLEN, NULL, keyparams->info, keyparams->infolen };
+
+	state->dstate.nonce = NULL;
+	state->tstate.nonce = NULL;
+
+	/* the first half of the key encrypts the data, the second half encrypts the tweak */
+	qsc_rhx_initialize(&state->dstate, &kp1, encrypt, ctype);
+	qsc_rhx_initialize(&state->tstate, &kp2, true, ctype);
+	state->encrypt = encrypt;
+}
+
+bool qsc_rhx_xts_transform(qsc_rhx_xts_state* state, uint8_t* output, const uint8_t* input, size_t inputlen, const uint8_t* sector)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
+	assert(sector != NULL);
+
+	uint8_t twk[QSC_RHX_BLOCK_SIZE] = { 0 };
+	size_t blocks;
+	size_t oft;
+	size_t rem;
+	bool res;
+
+	res = false;
+
+	if (inputlen >= QSC_RHX_BLOCK_SIZE)
+	{
+		qsc_rhx_ecb_encrypt_block(&state->tstate, twk, sector);
+
+		blocks = inputlen / QSC_RHX_BLOCK_SIZE;
+		rem = inputlen % QSC_RHX_BLOCK_SIZE;
+
+		/* with a partial final block, the last full block is processed with the stealing step */
+		if (rem != 0)
+		{
+			--blocks;
+		}
+
+		rhx_xts_blocks(state, output, input, blocks, twk);
+
+		if (rem != 0)
+		{
+			uint8_t blk[QSC_RHX_BLOCK_SIZE] = { 0 };
+			uint8_t stl[QSC_RHX_BLOCK_SIZE] = { 0 };
+			uint8_t twn[QSC_RHX_BLOCK_SIZE] = { 0 };
+
+			oft = blocks * QSC_RHX_BLOCK_SIZE;
+			qsc_memutils_copy(twn, twk, QSC_RHX_BLOCK_SIZE);
+			rhx_xts_gfdouble(twn);
+
+			/* decryption reverses the order in which the last two tweaks are applied */
+			rhx_xts_block(state, blk, input + oft, state->encrypt ? twk : twn);
+			qsc_memutils_copy(stl, input + oft + QSC_RHX_BLOCK_SIZE, rem);
+			qsc_memutils_copy(stl + rem, blk + rem, QSC_RHX_BLOCK_SIZE - rem);
+			qsc_memutils_copy(output + oft + QSC_RHX_BLOCK_SIZE, blk, rem);
+			rhx_xts_block(state, output + oft, stl, state->encrypt ? twn : twk);
+
+			qsc_memutils_clear(blk, sizeof(blk));
+			qsc_memutils_clear(stl, sizeof(stl));
+			qsc_memutils_clear(twn, sizeof(twn));
+		}
+
+		qsc_memutils_clear(twk, sizeof(twk));
+		res = true;
+	}
+
+	return res;
+}
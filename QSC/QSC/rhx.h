@@ -66,10 +66,14 @@
 * The segmented integer counter mode (CTR). \n
 * The Cipher Block Chaining mode (CBC). \n
 * The authenticated block-cipher counter with Hash Based Authentication AEAD mode; HBA. \n
+* The Galois/Counter Mode AEAD mode; GCM, with a carry-less multiply (PCLMULQDQ) GHASH when AES-NI is enabled. \n
+* The XEX-based tweaked-codebook mode with ciphertext stealing; XTS, for sector and page encryption. \n
 * This implementation has both a C reference, and an implementation that uses the AES-NI instructions that are used in the AES and RHX cipher variants. \n
 * The AES-NI implementation can be enabled by adding the QSC_SYSTEM_AESNI_ENABLED constant to your preprocessor definitions. \n
 * The implementation can be toggled from SHA3 to SHA2 operation mode by adding the QSC_RHX_HKDF_EXTENSION to the pre-processor definitions. \n
 * The AES128 and AES256 implementations along with the ECB, CTR, and CBC modes are tested using vectors from NIST SP800-38a. \n
+* The GCM mode is tested using the AES-128 and AES-256 vectors from the GCM specification. \n
+* The XTS mode is tested using the AES-128 and AES-256 vectors from IEEE 1619. \n
 * The RHX-256, RHX-512, and HBA known answer vectors are taken from the CEX++ cryptographic library;
 * <a href="https://github.com/Steppenwolfe65/CEX">The CEX++ Cryptographic Library</a>. \n
 * See the documentation and the rhx_test.c tests for usage examples.
@@ -172,6 +176,53 @@
 * }
 * \endcode
 *
+* <b>HBA RHX-256 streaming encryption example</b> \n
+* \code
+* qsc_rhx_hba256_initialize(&state, &kp, true);
+* qsc_rhx_hba256_set_associated(&state, aad, AAD_LEN);
+*
+* // process the file in bounded segments
+* while (segment = next(file))
+* {
+*	qsc_rhx_hba256_update(&state, cpt, segment, SEG_LEN);
+* }
+*
+* // write the mac-code after the cipher-text
+* qsc_rhx_hba256_finalize(&state, code);
+* \endcode
+*
+*
+* <b>AES-256 GCM encryption example</b> \n
+* \code
+* uint8_t key[QSC_AES256_KEY_SIZE] = {...};
+* uint8_t nonce[QSC_RHX_GCM_NONCE_SIZE] = {...};
+* uint8_t aad[AAD_LEN] = {...};
+* uint8_t msg[MSG_LEN] = {...};
+* // the authentication tag is appended to the cipher-text
+* uint8_t cpt[MSG_LEN + QSC_RHX_GCM_MAC_SIZE] = { 0 };
+* qsc_rhx_gcm_state state;
+* qsc_rhx_keyparams kp = { key, QSC_AES256_KEY_SIZE, nonce };
+*
+* qsc_rhx_gcm_initialize(&state, &kp, true, AES256);
+* qsc_rhx_gcm_set_associated(&state, aad, AAD_LEN);
+* qsc_rhx_gcm_transform(&state, cpt, msg, MSG_LEN);
+* qsc_rhx_gcm_dispose(&state);
+* \endcode
+*
+* <b>AES-256 XTS sector encryption example</b> \n
+* \code
+* // the xts key is the data key followed by the tweak key
+* uint8_t key[2 * QSC_AES256_KEY_SIZE] = {...};
+* uint8_t sector[QSC_RHX_BLOCK_SIZE] = { sector number, little endian };
+* uint8_t msg[SECTOR_LEN] = {...};
+* uint8_t cpt[SECTOR_LEN] = { 0 };
+* qsc_rhx_xts_state state;
+* qsc_rhx_keyparams kp = { key, sizeof(key) };
+*
+* qsc_rhx_xts_initialize(&state, &kp, true, AES256);
+* qsc_rhx_xts_transform(&state, cpt, msg, SECTOR_LEN, sector);
+* qsc_rhx_xts_dispose(&state);
+* \endcode
 *
 * \remarks
 * Toggle between the cSHAKE (default) and the HKDF(SHA2) extensions by defining the QSC_RHX_SHAKE_EXTENSION definition in this file. \n
@@ -187,12 +238,12 @@
 #ifndef QSC_RHX_H
 #define QSC_RHX_H
 
-#include "../QSC/common.h"
+#include "common.h"
 
 /*! \enum qsc_rhx_cipher_mode
 * The pre-defined cipher mode implementations
 */
-typedef enum
+QSC_EXPORT_API typedef enum
 {
 	AES128 = 1,	/*!< The AES-128 block cipher */
 	AES256 = 2,	/*!< The AES-256 block cipher */
@@ -203,7 +254,7 @@ typedef enum
 /*! \enum qsc_rhx_cipher_mode
 * The pre-defined cipher mode implementations
 */
-typedef enum
+QSC_EXPORT_API typedef enum
 {
 	CBC = 1,	/*!< Cipher Block Chaining */
 	CTR = 2,	/*!< segmented integer counter */
@@ -257,9 +308,9 @@ typedef enum
 #endif
 
 #if defined(QSC_RHX_SHAKE_EXTENSION)
-#	include "../QSC/sha3.h"
+#	include "sha3.h"
 #else
-#	include "../QSC/sha2.h"
+#	include "sha2.h"
 #endif
 
 /***********************************
@@ -278,6 +329,18 @@ typedef enum
 */
 #define QSC_HBA512_MAC_LENGTH 64
 
+/*!
+\def QSC_RHX_GCM_MAC_SIZE
+* The GCM authentication tag array length in bytes.
+*/
+#define QSC_RHX_GCM_MAC_SIZE 16
+
+/*!
+\def QSC_RHX_GCM_NONCE_SIZE
+* The GCM nonce array length in bytes.
+*/
+#define QSC_RHX_GCM_NONCE_SIZE 12
+
 /*!
 \def QSC_HBA_KMAC_AUTH
 * Use KMAC to authenticate HBA; removing this macro is enabled when running in SHAKE extension mode.
@@ -335,7 +398,7 @@ typedef enum
 * Keys must be random and secret, and align to the corresponding key size of the cipher implemented.
 * The info parameter is optional, and can be a salt or cryptographic key.
 */
-typedef struct
+QSC_EXPORT_API typedef struct
 {
 	const uint8_t* key;				/*!< The input cipher key */
 	size_t keylen;					/*!< The length in bytes of the cipher key */
@@ -347,7 +410,7 @@ typedef struct
 /*! \struct qsc_rhx_state
 * The internal state structure containing the round-key array.
 */
-typedef struct
+QSC_EXPORT_API typedef struct
 {
 #if defined(QSC_SYSTEM_AESNI_ENABLED)
 	__m128i roundkeys[31];		/*!< The 128-bit intel integer round-key array */
@@ -356,10 +419,13 @@ typedef struct
 #	endif
 #else
 	uint32_t roundkeys[124];		/*!< The round-keys 32-bit subkey array */
+	uint64_t roundkeysb[31 * 16];	/*!< The bitsliced round-keys used by the constant-time counter mode */
 #endif
 	size_t roundkeylen;				/*!< The round-key array length */
 	size_t rounds;					/*!< The number of transformation rounds */
 	uint8_t* nonce;					/*!< The nonce or initialization vector */
+	uint8_t kstream[QSC_RHX_BLOCK_SIZE];	/*!< The unused key-stream of a partial counter block */
+	size_t kslen;					/*!< The number of unused key-stream bytes carried to the next counter mode call */
 } qsc_rhx_state;
 
 /* common functions */
@@ -367,7 +433,7 @@ typedef struct
 /**
 * \brief Erase the round-key array and size
 */
-void qsc_rhx_dispose(qsc_rhx_state* state);
+QSC_EXPORT_API void qsc_rhx_dispose(qsc_rhx_state* state);
 
 /**
 * \brief Initialize the state with the input cipher-key and optional info tweak. 
@@ -379,7 +445,7 @@ void qsc_rhx_dispose(qsc_rhx_state* state);
 *
 * \warning When using a CTR mode, the cipher is always initialized for encryption.
 */
-void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams, bool encryption, qsc_rhx_cipher_type ctype);
+QSC_EXPORT_API void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams, bool encryption, qsc_rhx_cipher_type ctype);
 
 /* cbc mode */
 
@@ -393,7 +459,7 @@ void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams
 * \param input: [const] The input cipher-text bytes
 * \param inputlen: The number of input cipher-text bytes to decrypt
 */
-void qsc_rhx_cbc_decrypt(qsc_rhx_state* state, uint8_t* output, size_t *outputlen, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API void qsc_rhx_cbc_decrypt(qsc_rhx_state* state, uint8_t* output, size_t *outputlen, const uint8_t* input, size_t inputlen);
 
 /**
 * \brief Encrypt a length of cipher-text using Cipher Block Chaining mode. \n
@@ -405,7 +471,7 @@ void qsc_rhx_cbc_decrypt(qsc_rhx_state* state, uint8_t* output, size_t *outputle
 * \param input: [const] The input plain-text bytes
 * \param inputlen: The number of input plain-text bytes to encrypt
 */
-void qsc_rhx_cbc_encrypt(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API void qsc_rhx_cbc_encrypt(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
 
 /**
 * \brief Decrypt one 16-byte block of cipher-text using Cipher Block Chaining mode. \n
@@ -416,7 +482,7 @@ void qsc_rhx_cbc_encrypt(qsc_rhx_state* state, uint8_t* output, const uint8_t* i
 * \param output: The output byte array; receives the decrypted plain-text
 * \param input: [const] The input cipher-text block of bytes
 */
-void qsc_rhx_cbc_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
+QSC_EXPORT_API void qsc_rhx_cbc_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
 
 /**
 * \brief Encrypt one 16-byte block of cipher-text using Cipher Block Chaining mode. \n
@@ -427,7 +493,24 @@ void qsc_rhx_cbc_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 * \param output: The output byte array; receives the encrypted cipher-text
 * \param input: [const] The input plain-text block of bytes
 */
-void qsc_rhx_cbc_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
+QSC_EXPORT_API void qsc_rhx_cbc_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Encrypt a set of independent Cipher Block Chaining mode streams in lock-step. \n
+* CBC encryption is serial within a stream; this function instead encrypts one block of every stream per step,
+* so the AES-NI and VAES pipelines stay full when many sessions are processed at once.
+* Each stream uses its own key schedule and initialization vector, and each state nonce holds the stream chaining vector on return.
+*
+* \warning the qsc_rhx_initialize function must be called first to initialize each state for encryption. \n
+* All states must use the same cipher type, and the input length must be a multiple of the block size; no padding is added.
+*
+* \param states: [const] The array of initialized qsc_rhx_state structure pointers, one per stream
+* \param outputs: [const] The array of output byte array pointers; each receives inputlen bytes of cipher-text
+* \param inputs: [const] The array of input plain-text byte array pointers
+* \param inputlen: The number of bytes to encrypt in each stream, a multiple of QSC_RHX_BLOCK_SIZE
+* \param count: The number of streams
+*/
+QSC_EXPORT_API void qsc_rhx_cbc_encrypt_multi(qsc_rhx_state* const* states, uint8_t* const* outputs, const uint8_t* const* inputs, size_t inputlen, size_t count);
 
 /* pkcs7 */
 
@@ -438,7 +521,7 @@ void qsc_rhx_cbc_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 * \param offset: The first byte in the block to pad
 * \param length: The length of the plaintext block
 */
-void qsc_pkcs7_add_padding(uint8_t* input, size_t length);
+QSC_EXPORT_API void qsc_pkcs7_add_padding(uint8_t* input, size_t length);
 
 /**
 * \brief Get the number of padded bytes in a block of decrypted cipher-text.
@@ -449,35 +532,41 @@ void qsc_pkcs7_add_padding(uint8_t* input, size_t length);
 * 
 * \return: The length of the block padding
 */
-size_t qsc_pkcs7_padding_length(const uint8_t* input);
+QSC_EXPORT_API size_t qsc_pkcs7_padding_length(const uint8_t* input);
 
 /* ctr mode */
 
 /**
 * \brief Transform a length of data using a Big Endian block cipher Counter mode. \n
 * The CTR mode will encrypt plain-text, and decrypt cipher-text.
+* A call that ends on a partial block consumes its counter and keeps the unused key-stream in the state,
+* the next call continues from it, so a message can be processed in segments of any length.
 *
-* \warning the qsc_rhx_initialize function must be called first to initialize the state
+* \warning the qsc_rhx_initialize function must be called first to initialize the state,
+* and again to discard the carried key-stream before the nonce is changed
 *
 * \param state: [struct] The initialized qsc_rhx_state structure
 * \param output: The output byte array; receives the transformed text
 * \param input: [const] The input data byte array
 * \param inputlen: The number of input bytes to transform
 */
-void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API void qsc_rhx_ctrbe_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
 
 /**
 * \brief Transform a length of data using a Little Endian block cipher Counter mode. \n
 * The CTR mode will encrypt plain-text, and decrypt cipher-text.
+* A call that ends on a partial block consumes its counter and keeps the unused key-stream in the state,
+* the next call continues from it, so a message can be processed in segments of any length.
 *
-* \warning the qsc_rhx_initialize function must be called first to initialize the state
+* \warning the qsc_rhx_initialize function must be called first to initialize the state,
+* and again to discard the carried key-stream before the nonce is changed
 *
 * \param state: [struct] The initialized qsc_rhx_state structure
 * \param output: The output byte array; receives the transformed text
 * \param input: [const] The input data byte array
 * \param inputlen: The number of input bytes to transform
 */
-void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
 
 /* ecb mode */
 
@@ -489,7 +578,7 @@ void qsc_rhx_ctrle_transform(qsc_rhx_state* state, uint8_t* output, const uint8_
 * \param output: The output byte array; receives the decrypted plain-text
 * \param input: [const] The input cipher-text block of bytes
 */
-void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
+QSC_EXPORT_API void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
 
 /**
 * \brief Encrypt one 16-byte block of cipher-text using Electronic CodeBook Mode mode. \n
@@ -499,7 +588,7 @@ void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 * \param output: The output byte array; receives the encrypted cipher-text
 * \param input: [const] The input plain-text block of bytes
 */
-void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
+QSC_EXPORT_API void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
 
 /* HBA-256 */
 
@@ -507,7 +596,7 @@ void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint
 * The HBA-256 state array; pointers for the cipher state, mack key and length, transformation mode, and the state counter.
 * Used by the long-form of the HBA api, and initialized by the hba_initialize function.
 */
-typedef struct
+QSC_EXPORT_API typedef struct
 {
 #if defined(QSC_RHX_SHAKE_EXTENSION)
 	qsc_keccak_state kstate;	/*!< the mac state */
@@ -521,6 +610,7 @@ typedef struct
 	size_t custlen;						/*!< the custom key array length */
 	uint8_t aad[QSC_HBA_MAXAAD_SIZE];	/*!< the additional data array */
 	size_t aadlen;						/*!< the additional data array length */
+	bool active;						/*!< a streamed message is in progress */
 	bool encrypt;						/*!< the transformation mode; true for encryption */
 } qsc_rhx_hba256_state;
 
@@ -533,7 +623,7 @@ typedef struct
 *
 * \param state: [struct] The HBA state structure; contains internal state information
 */
-void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state);
+QSC_EXPORT_API void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state);
 
 /**
 * \brief Initialize the cipher and load the keying material.
@@ -545,7 +635,7 @@ void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state);
 * \param keyparams: [struct] The HBA key parameters, includes the key, and optional AAD and user info arrays
 * \param encrypt: The cipher encryption mode; true for encryption, false for decryption
 */
-void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
+QSC_EXPORT_API void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
 
 /**
 * \brief Set the associated data string used in authenticating the message.
@@ -557,7 +647,7 @@ void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keypar
 * \param data: [const] The associated data array
 * \param datalen: The associated data array length
 */
-void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen);
+QSC_EXPORT_API void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen);
 
 /**
 * \brief Transform an array of bytes using an instance of RHX-256.
@@ -573,7 +663,36 @@ void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* d
 *
 * \return: Returns true if the cipher has been initialized successfully, false on failure
 */
-bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Transform the next segment of a message using an instance of RHX-256, the streaming form of the api.
+* A message is processed by any number of update calls of any length, followed by a call to the finalize function.
+* The first update of a message adds the nonce to the MAC, the output is identical to a single call to the transform function.
+* The associated data must be set before the finalize call.
+*
+* \warning In decryption mode, the plain-text is released before the message is authenticated;
+* it must not be used until the finalize function has returned true.
+*
+* \param state: [struct] The HBA state structure; contains internal state information
+* \param output: The output byte array, receives inputlen bytes of the transformed segment; can be the input array
+* \param input: [const] The input segment
+* \param inputlen: The number of bytes in the segment
+*/
+QSC_EXPORT_API void qsc_rhx_hba256_update(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Finalize a streamed message.
+* In encryption mode, the MAC code is written to the code array.
+* In decryption mode, the code array holds the received MAC code, which is compared to the internal code.
+* The state is ready for the next message on return.
+*
+* \param state: [struct] The HBA state structure; contains internal state information
+* \param code: The QSC_HBA256_MAC_LENGTH MAC code array; output in encryption mode, input in decryption mode
+*
+* \return Returns false if the message authentication failed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba256_finalize(qsc_rhx_hba256_state* state, uint8_t* code);
 
 /* HBA-512 */
 
@@ -581,7 +700,7 @@ bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, cons
 * The HBA state array; pointers for the cipher state, mack key and length, transformation mode, and the state counter.
 * Used by the long-form of the HBA api, and initialized by the hba_initialize function.
 */
-typedef struct
+QSC_EXPORT_API typedef struct
 {
 #if defined(QSC_RHX_SHAKE_EXTENSION)
 	qsc_keccak_state kstate;	/*!< the mac state */
@@ -595,6 +714,7 @@ typedef struct
 	size_t custlen;						/*!< the custom key array length */
 	uint8_t aad[QSC_HBA_MAXAAD_SIZE];	/*!< the additional data array */
 	size_t aadlen;						/*!< the additional data array length */
+	bool active;						/*!< a streamed message is in progress */
 	bool encrypt;						/*!< the transformation mode; true for encryption */
 } qsc_rhx_hba512_state;
 
@@ -607,7 +727,7 @@ typedef struct
 *
 * \param state: [struct] The HBA state structure; contains internal state information
 */
-void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state);
+QSC_EXPORT_API void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state);
 
 /**
 * \brief Initialize the cipher and load the keying material.
@@ -619,7 +739,7 @@ void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state);
 * \param keyparams: [struct] The HBA key parameters, includes the key, and optional AAD and user info arrays
 * \param encrypt: The cipher encryption mode; true for encryption, false for decryption
 */
-void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
+QSC_EXPORT_API void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
 
 /**
 * \brief Set the associated data string used in authenticating the message.
@@ -631,7 +751,7 @@ void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keypar
 * \param data: [const] The associated data array
 * \param datalen: The associated data array length
 */
-void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen);
+QSC_EXPORT_API void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen);
 
 /**
 * \brief Transform an array of bytes using an instance of RHX-512.
@@ -647,6 +767,160 @@ void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* d
 *
 * \return: Returns true if the cipher has been transformed the data successfully, false on failure
 */
-bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+QSC_EXPORT_API bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Transform the next segment of a message using an instance of RHX-512, the streaming form of the api.
+* A message is processed by any number of update calls of any length, followed by a call to the finalize function.
+* The first update of a message adds the nonce to the MAC, the output is identical to a single call to the transform function.
+* The associated data must be set before the finalize call.
+*
+* \warning In decryption mode, the plain-text is released before the message is authenticated;
+* it must not be used until the finalize function has returned true.
+*
+* \param state: [struct] The HBA state structure; contains internal state information
+* \param output: The output byte array, receives inputlen bytes of the transformed segment; can be the input array
+* \param input: [const] The input segment
+* \param inputlen: The number of bytes in the segment
+*/
+QSC_EXPORT_API void qsc_rhx_hba512_update(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Finalize a streamed message.
+* In encryption mode, the MAC code is written to the code array.
+* In decryption mode, the code array holds the received MAC code, which is compared to the internal code.
+* The state is ready for the next message on return.
+*
+* \param state: [struct] The HBA state structure; contains internal state information
+* \param code: The QSC_HBA512_MAC_LENGTH MAC code array; output in encryption mode, input in decryption mode
+*
+* \return Returns false if the message authentication failed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba512_finalize(qsc_rhx_hba512_state* state, uint8_t* code);
+
+/* GCM */
+
+/*! \struct qsc_rhx_gcm_state
+* The GCM state array; the cipher state, the GHASH key and accumulator, the associated data length, and the transformation mode.
+* Initialized by the qsc_rhx_gcm_initialize function.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_rhx_state cstate;				/*!< the underlying block-ciphers state structure */
+#if defined(QSC_SYSTEM_AESNI_ENABLED)
+	__m128i hpow[8];					/*!< the GHASH key powers H^1 to H^8, byte reflected */
+	__m128i ghash;						/*!< the GHASH accumulator, byte reflected */
+#else
+	uint64_t hkey[2];					/*!< the GHASH key H */
+	uint64_t ghash[2];					/*!< the GHASH accumulator */
+#endif
+	uint64_t aadlen;					/*!< the associated data length in bytes */
+	uint8_t aadbuf[QSC_RHX_BLOCK_SIZE];	/*!< the pending partial block of associated data */
+	bool encrypt;						/*!< the transformation mode; true for encryption */
+} qsc_rhx_gcm_state;
+
+/**
+* \brief Dispose of the GCM cipher state
+*
+* \warning The dispose function must be called when disposing of the cipher.
+*
+* \param state: [struct] The GCM state structure; contains internal state information
+*/
+QSC_EXPORT_API void qsc_rhx_gcm_dispose(qsc_rhx_gcm_state* state);
+
+/**
+* \brief Initialize the cipher and load the keying material.
+* The nonce member of the key parameters must point to a QSC_RHX_GCM_NONCE_SIZE array;
+* the nonce is incremented after each call to the transform, so consecutive messages are never encrypted with the same counter block.
+*
+* \warning The initialize function must be called before either the associated data or transform functions are called.
+* Use AES128 or AES256 for interoperable GCM; the RHX cipher types produce a non-standard GCM construction.
+*
+* \param state: [struct] The GCM state structure; contains internal state information
+* \param keyparams: [const][struct] The key parameters, includes the key and nonce arrays
+* \param encrypt: The cipher encryption mode; true for encryption, false for decryption
+* \param ctype: The underlying block cipher type
+*/
+QSC_EXPORT_API void qsc_rhx_gcm_initialize(qsc_rhx_gcm_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt, qsc_rhx_cipher_type ctype);
+
+/**
+* \brief Set the associated data string used in authenticating the message.
+* The associated data is set after initialization, and before each transformation call.
+* The function can be called more than once per message; the segments are authenticated as one concatenated string.
+* Whole blocks are hashed immediately, a trailing partial block is held until the next call or the transform,
+* and the length is reset after each call to the transform.
+*
+* \param state: [struct] The GCM state structure; contains internal state information
+* \param data: [const] The associated data array
+* \param datalen: The associated data array length
+*/
+QSC_EXPORT_API void qsc_rhx_gcm_set_associated(qsc_rhx_gcm_state* state, const uint8_t* data, size_t datalen);
+
+/**
+* \brief Transform an array of bytes using GCM.
+* In encryption mode, the input plain-text is encrypted and then the authentication tag is appended to the ciphertext.
+* In decryption mode, the input cipher-text is authenticated internally and compared to the tag appended to the cipher-text,
+* if the codes to not match, the cipher-text is not decrypted and the call fails.
+*
+* \warning The cipher must be initialized before this function can be called
+*
+* \param state: [struct] The GCM state structure; contains internal state information
+* \param output: The output byte array
+* \param input: [const] The input byte array
+* \param inputlen: The number of message bytes to transform, not including the tag
+*
+* \return: Returns true if the cipher has transformed the data successfully, false on authentication failure
+*/
+QSC_EXPORT_API bool qsc_rhx_gcm_transform(qsc_rhx_gcm_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/* XTS */
+
+/*! \struct qsc_rhx_xts_state
+* The XTS state array; the data and tweak cipher states, and the transformation mode.
+* Initialized by the qsc_rhx_xts_initialize function.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_rhx_state dstate;				/*!< the data-unit cipher state */
+	qsc_rhx_state tstate;				/*!< the tweak cipher state, always in encryption mode */
+	bool encrypt;						/*!< the transformation mode; true for encryption */
+} qsc_rhx_xts_state;
+
+/**
+* \brief Dispose of the XTS cipher state
+*
+* \param state: [struct] The XTS state structure; contains internal state information
+*/
+QSC_EXPORT_API void qsc_rhx_xts_dispose(qsc_rhx_xts_state* state);
+
+/**
+* \brief Initialize the XTS cipher and load the keying material.
+* The key member of the key parameters is two cipher keys; the data key followed by the tweak key,
+* ex. a 64 byte key for AES-256 XTS. The nonce member is not used.
+*
+* \param state: [struct] The XTS state structure; contains internal state information
+* \param keyparams: [struct, const] The key parameters, the key length is twice the cipher key size
+* \param encrypt: The cipher encryption mode; true for encryption, false for decryption
+* \param ctype: The cipher type, AES128 and AES256 are IEEE 1619 compatible
+*/
+QSC_EXPORT_API void qsc_rhx_xts_initialize(qsc_rhx_xts_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt, qsc_rhx_cipher_type ctype);
+
+/**
+* \brief Transform one data unit (sector) using XTS.
+* The sector number selects the tweak, so sectors can be transformed independently and in any order.
+* Data units that are not a multiple of the block size are processed with ciphertext stealing,
+* and the output is the same length as the input.
+*
+* \warning The cipher must be initialized before this function can be called
+*
+* \param state: [struct] The XTS state structure; contains internal state information
+* \param output: The output byte array, can be the same as the input array
+* \param input: [const] The input byte array
+* \param inputlen: The number of bytes in the data unit, at least QSC_RHX_BLOCK_SIZE
+* \param sector: [const] The QSC_RHX_BLOCK_SIZE data unit sequence number, in little endian byte order
+*
+* \return Returns false if the data unit is shorter than one block
+*/
+QSC_EXPORT_API bool qsc_rhx_xts_transform(qsc_rhx_xts_state* state, uint8_t* output, const uint8_t* input, size_t inputlen, const uint8_t* sector);
 
 #endif
@@ -3919,6 +3919,44 @@ void qsc_shake_squeezeblocks(qsc_keccak_state* ctx, keccak_rate rate, uint8_t* o
 	keccak_squeezeblocks(ctx->state, output, nblocks, rate);
 }
 
+void qsc_shake_update(qsc_keccak_state* ctx, keccak_rate rate, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	keccak_update(ctx, rate, message, msglen);
+}
+
+void qsc_shake_finalize(qsc_keccak_state* ctx, keccak_rate rate, uint8_t* output, size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	uint8_t pad[KECCAK_STATE_BYTE_SIZE] = { 0 };
+
+	qsc_memutils_copy(pad, ctx->buffer, ctx->position);
+	pad[ctx->position] = KECCAK_SHAKE_DOMAIN_ID;
+	pad[rate - 1] |= 128U;
+	keccak_fast_absorb(ctx->state, pad, rate);
+
+	while (outlen >= (size_t)rate)
+	{
+		keccak_squeezeblocks(ctx->state, pad, 1, rate);
+		qsc_memutils_copy(output, pad, rate);
+		output += rate;
+		outlen -= rate;
+	}
+
+	if (outlen > 0)
+	{
+		keccak_squeezeblocks(ctx->state, pad, 1, rate);
+		qsc_memutils_copy(output, pad, outlen);
+	}
+
+	qsc_memutils_clear(pad, sizeof(pad));
+	qsc_keccak_dispose(ctx);
+}
+
 /* cshake */
 
 void qsc_cshake128_compute(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen, const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
@@ -361,6 +361,34 @@ QSC_EXPORT_API void qsc_shake_initialize(qsc_keccak_state* ctx, keccak_rate rate
 */
 QSC_EXPORT_API void qsc_shake_squeezeblocks(qsc_keccak_state* ctx, keccak_rate rate, uint8_t* output, size_t nblocks);
 
+/**
+* \brief Update SHAKE with message input.
+* Long form api: must be used in conjunction with the shake finalize function.
+* Absorbs the input message into the state, the message can be processed in any number of calls.
+*
+* \warning State must be initialized by the caller, either zeroed or with qsc_keccak_dispose.
+*
+* \param ctx: [struct] A reference to the keccak state; must be initialized
+* \param rate: The rate of absorption in bytes
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+*/
+QSC_EXPORT_API void qsc_shake_update(qsc_keccak_state* ctx, keccak_rate rate, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize the SHAKE message state and generate an array of pseudo-random bytes.
+* Long form api: must be used in conjunction with the shake update function.
+* The output is identical to the short form compute function over the concatenated message input.
+*
+* \warning Finalizes and erases the message state, can not be used in consecutive calls.
+*
+* \param ctx: [struct] A reference to the keccak state; must be initialized
+* \param rate: The rate of absorption in bytes
+* \param output: The output byte array
+* \param outlen: The number of output bytes to generate
+*/
+QSC_EXPORT_API void qsc_shake_finalize(qsc_keccak_state* ctx, keccak_rate rate, uint8_t* output, size_t outlen);
+
 /* cshake */
 
 /**
@@ -32,5 +32,58 @@ bool qsc_sphincsplus_verify(uint8_t* message, size_t* msglen, const uint8_t* sig
 
 	res = sphincsplus_verify(message, msglen, signedmsg, smsglen, publickey);
 
+	return res;
+}
+
+void qsc_sphincsplus_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	sphincsplus_sign_detached(signature, message, msglen, privatekey, rng_generate);
+}
+
+bool qsc_sphincsplus_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = sphincsplus_verify_detached(signature, message, msglen, publickey);
+
+	return res;
+}
+
+void qsc_sphincsplus_verify_initialize(qsc_sphincsplus_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	assert(ctx != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	sphincsplus_verify_initialize(&ctx->kstate, signature, publickey);
+}
+
+void qsc_sphincsplus_verify_update(qsc_sphincsplus_stream_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_shake_update(&ctx->kstate, keccak_rate_256, message, msglen);
+}
+
+bool qsc_sphincsplus_verify_finalize(qsc_sphincsplus_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey)
+{
+	assert(ctx != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = sphincsplus_verify_finalize(&ctx->kstate, signature, publickey);
+
 	return res;
 }
\ No newline at end of file
@@ -64,6 +64,7 @@
 #define QSC_SPHINCSPLUS_H
 
 #include "common.h"
+#include "sha3.h"
 
 #if defined(QSC_SPHINCSPLUS_S1S128SHAKE)
 
@@ -135,6 +136,16 @@
 */
 #define QSC_SPHINCSPLUS_ALGNAME "SPHINCSPLUS"
 
+/*!
+* \struct qsc_sphincsplus_stream_state
+* \brief The message state of a streaming verification. \n
+* The message is hashed as it arrives, so a large message is never copied or held in memory.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_keccak_state kstate;							/*!< The message hash state */
+} qsc_sphincsplus_stream_state;
+
 /**
 * \brief Generates a Sphincs+ public/private key-pair.
 *
@@ -172,4 +183,61 @@ QSC_EXPORT_API void qsc_sphincsplus_sign(uint8_t* signedmsg, size_t* smsglen, co
 */
 QSC_EXPORT_API bool qsc_sphincsplus_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns the signature alone; the message is neither copied nor modified.
+*
+* \warning Signature array must be sized to QSC_SPHINCSPLUS_SIGNATURE_SIZE. \n
+* The message is read twice, once for the signature randomizer and once for the message digest,
+* so signing has no streaming form; verification does.
+*
+* \param signature: Pointer to the output signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_sphincsplus_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* privatekey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature over a message with the public key.
+*
+* \warning Signature array must be sized to QSC_SPHINCSPLUS_SIGNATURE_SIZE.
+*
+* \param signature: [const] Pointer to the signature array
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_sphincsplus_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Starts a streaming verification of a detached signature.
+* Long form api: must be used in conjunction with the verify update and verify finalize functions.
+*
+* \param ctx: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_sphincsplus_verify_initialize(qsc_sphincsplus_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Adds a block of message to a streaming verification; can be called any number of times.
+*
+* \param ctx: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_sphincsplus_verify_update(qsc_sphincsplus_stream_state* ctx, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Completes a streaming verification and erases the stream state.
+*
+* \param ctx: [struct] The stream state
+* \param signature: [const] Pointer to the signature array used to initialize the stream
+* \param publickey: [const] Pointer to the public verification-key array used to initialize the stream
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_sphincsplus_verify_finalize(qsc_sphincsplus_stream_state* ctx, const uint8_t* signature, const uint8_t* publickey);
+
 #endif
\ No newline at end of file
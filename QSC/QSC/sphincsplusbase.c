@@ -1,4 +1,5 @@
 #include "sphincsplusbase.h"
+#include "parallel.h"
 #include "sha3.h"
 #include <stdlib.h>
 
@@ -254,6 +255,36 @@ static void set_tree_index(uint32_t addr[8], uint32_t tree_index)
 	addr[7] = tree_index;
 }
 
+/* hash lanes */
+
+/*!
+\def SPX_HASH_LANES
+* Read Only: The number of independent addresses hashed per Keccak pass; 8 with AVX-512, 4 with AVX2, otherwise 1
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define SPX_HASH_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define SPX_HASH_LANES 4
+#else
+#	define SPX_HASH_LANES 1
+#endif
+
+#if ((1UL << SPX_TREE_HEIGHT) % SPX_HASH_LANES) != 0 || ((1UL << SPX_FORS_HEIGHT) % SPX_HASH_LANES) != 0
+#	error The tree heights must hold a whole number of hash lanes!
+#endif
+
+static void shake256_lanes(uint8_t* out[SPX_HASH_LANES], size_t outlen, uint8_t* in[SPX_HASH_LANES], size_t inlen)
+{
+#if (SPX_HASH_LANES == 8)
+	shake256x8(out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7], outlen,
+		in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], inlen);
+#elif (SPX_HASH_LANES == 4)
+	shake256x4(out[0], out[1], out[2], out[3], outlen, in[0], in[1], in[2], in[3], inlen);
+#else
+	qsc_shake256_compute(out[0], outlen, in[0], inlen);
+#endif
+}
+
 /* hash.c */
 
 static void initialize_hash_function(const uint8_t* pub_seed, const uint8_t* sk_seed)
@@ -272,52 +303,71 @@ static void prf_addr(uint8_t* out, const uint8_t* key, const uint32_t addr[8])
 	qsc_shake256_compute(out, SPX_N, buf, SPX_N + SPX_ADDR_BYTES);
 }
 
-static void gen_message_random(uint8_t* R, const uint8_t* sk_prf, const uint8_t* optrand, const uint8_t* m, size_t mlen)
+static void prf_addrx(uint8_t* out[SPX_HASH_LANES], const uint8_t* key, uint32_t addr[SPX_HASH_LANES][8])
 {
-	uint8_t* tmp = (uint8_t*)malloc((SPX_N * 2) + mlen);
-
-	assert(tmp != NULL);
+	uint8_t buf[SPX_HASH_LANES][SPX_N + SPX_ADDR_BYTES];
+	uint8_t* pbuf[SPX_HASH_LANES];
+	size_t i;
 
-	if (tmp != NULL)
+	for (i = 0; i < SPX_HASH_LANES; ++i)
 	{
-		memcpy(tmp, sk_prf, SPX_N);
-		memcpy(tmp + SPX_N, optrand, SPX_N);
-		memcpy(tmp + (2 * SPX_N), m, mlen);
-		qsc_shake256_compute(R, SPX_N, tmp, SPX_N * 2 + mlen);
-		free(tmp);
+		memcpy(buf[i], key, SPX_N);
+		addr_to_bytes(buf[i] + SPX_N, addr[i]);
+		pbuf[i] = buf[i];
 	}
+
+	shake256_lanes(out, SPX_N, pbuf, SPX_N + SPX_ADDR_BYTES);
 }
 
-static void hash_message(uint8_t* digest, uint64_t* tree, uint32_t* leaf_idx, const uint8_t* R, const uint8_t* pk, const uint8_t* m, size_t mlen)
+static void gen_message_random(uint8_t* R, const uint8_t* sk_prf, const uint8_t* optrand, const uint8_t* m, size_t mlen)
+{
+	qsc_keccak_state kstate;
+
+	/* the message is absorbed in place rather than copied behind the key */
+	qsc_keccak_dispose(&kstate);
+	qsc_shake_update(&kstate, keccak_rate_256, sk_prf, SPX_N);
+	qsc_shake_update(&kstate, keccak_rate_256, optrand, SPX_N);
+	qsc_shake_update(&kstate, keccak_rate_256, m, mlen);
+	qsc_shake_finalize(&kstate, keccak_rate_256, R, SPX_N);
+}
+
+static void hash_message_initialize(qsc_keccak_state* kstate, const uint8_t* R, const uint8_t* pk)
+{
+	/* H_msg(R, PK, M); R and the public key lead, so the message can follow in any number of updates */
+	qsc_keccak_dispose(kstate);
+	qsc_shake_update(kstate, keccak_rate_256, R, SPX_N);
+	qsc_shake_update(kstate, keccak_rate_256, pk, SPX_PK_BYTES);
+}
+
+static void hash_message_finalize(qsc_keccak_state* kstate, uint8_t* digest, uint64_t* tree, uint32_t* leaf_idx)
 {
 	uint8_t buf[SPX_DGST_BYTES] = { 0 };
 	uint8_t* bufp = buf;
-	uint8_t* tmp = (uint8_t*)malloc(SPX_N + SPX_PK_BYTES + mlen);
 
-	assert(tmp != NULL);
+	qsc_shake_finalize(kstate, keccak_rate_256, buf, SPX_DGST_BYTES);
 
-	if (tmp != NULL)
-	{
-		memcpy(tmp, R, SPX_N);
-		memcpy(tmp + SPX_N, pk, SPX_PK_BYTES);
-		memcpy(tmp + SPX_N + SPX_PK_BYTES, m, mlen);
-		qsc_shake256_compute(buf, SPX_DGST_BYTES, tmp, SPX_N + SPX_PK_BYTES + mlen);
-		free(tmp);
-
-		memcpy(digest, bufp, SPX_FORS_MSG_BYTES);
-		bufp += SPX_FORS_MSG_BYTES;
+	memcpy(digest, bufp, SPX_FORS_MSG_BYTES);
+	bufp += SPX_FORS_MSG_BYTES;
 
 #if SPX_TREE_BITS > 64
 #error For given height and depth, 64 bits cannot represent all subtrees
 #endif
 
-		*tree = bytes_to_ull(bufp, SPX_TREE_BYTES);
-		*tree &= (~0ULL >> (64 - SPX_TREE_BITS));
+	*tree = bytes_to_ull(bufp, SPX_TREE_BYTES);
+	*tree &= (~0ULL >> (64 - SPX_TREE_BITS));
 
-		bufp += SPX_TREE_BYTES;
-		*leaf_idx = (uint32_t)bytes_to_ull(bufp, SPX_LEAF_BYTES);
-		*leaf_idx &= (~0UL >> (32 - SPX_LEAF_BITS));
-	}
+	bufp += SPX_TREE_BYTES;
+	*leaf_idx = (uint32_t)bytes_to_ull(bufp, SPX_LEAF_BYTES);
+	*leaf_idx &= (~0UL >> (32 - SPX_LEAF_BITS));
+}
+
+static void hash_message(uint8_t* digest, uint64_t* tree, uint32_t* leaf_idx, const uint8_t* R, const uint8_t* pk, const uint8_t* m, size_t mlen)
+{
+	qsc_keccak_state kstate;
+
+	hash_message_initialize(&kstate, R, pk);
+	qsc_shake_update(&kstate, keccak_rate_256, m, mlen);
+	hash_message_finalize(&kstate, digest, tree, leaf_idx);
 }
 
 /* thash.c */
@@ -349,6 +399,41 @@ static void thash(uint8_t* out, const uint8_t* in, size_t inblocks, const uint8_
 	}
 }
 
+static void thashx(uint8_t* out[SPX_HASH_LANES], const uint8_t* in[SPX_HASH_LANES], size_t inblocks, const uint8_t* pub_seed, uint32_t addr[SPX_HASH_LANES][8])
+{
+	/* The thash of every lane under its own address; out may alias in.
+	   The widest input is a WOTS public key, so the buffers are sized for it. */
+
+	uint8_t buf[SPX_HASH_LANES][SPX_N + SPX_ADDR_BYTES + SPX_WOTS_BYTES];
+	uint8_t bitmask[SPX_HASH_LANES][SPX_WOTS_BYTES];
+	uint8_t* pbuf[SPX_HASH_LANES];
+	uint8_t* pmask[SPX_HASH_LANES];
+	size_t i;
+	size_t j;
+
+	assert(inblocks <= SPX_WOTS_LEN);
+
+	for (j = 0; j < SPX_HASH_LANES; ++j)
+	{
+		memcpy(buf[j], pub_seed, SPX_N);
+		addr_to_bytes(buf[j] + SPX_N, addr[j]);
+		pbuf[j] = buf[j];
+		pmask[j] = bitmask[j];
+	}
+
+	shake256_lanes(pmask, inblocks * SPX_N, pbuf, SPX_N + SPX_ADDR_BYTES);
+
+	for (j = 0; j < SPX_HASH_LANES; ++j)
+	{
+		for (i = 0; i < (inblocks * SPX_N); ++i)
+		{
+			buf[j][SPX_N + SPX_ADDR_BYTES + i] = (in[j][i] ^ bitmask[j][i]);
+		}
+	}
+
+	shake256_lanes(out, SPX_N, pbuf, SPX_N + SPX_ADDR_BYTES + inblocks * SPX_N);
+}
+
 static void compute_root(uint8_t* root, const uint8_t* leaf, uint32_t leaf_idx, uint32_t idx_offset,
 	const uint8_t* auth_path, uint32_t tree_height, const uint8_t* pub_seed, uint32_t addr[8])
 {
@@ -412,6 +497,7 @@ static void treehash(uint8_t* root, uint8_t* auth_path, const uint8_t* sk_seed,
 {
 	uint8_t* stack = (uint8_t*)malloc(((size_t)tree_height + 1) * SPX_N);
 	uint8_t* heights = (uint8_t*)malloc((size_t)tree_height + 1);
+	uint8_t leaves[SPX_HASH_LANES * SPX_N];
 	size_t offset;
 	uint32_t idx;
 	uint32_t tree_idx;
@@ -424,8 +510,14 @@ static void treehash(uint8_t* root, uint8_t* auth_path, const uint8_t* sk_seed,
 	{
 		for (idx = 0; idx < (1UL << tree_height); ++idx)
 		{
+			/* The leaves are generated a lane group at a time, then pushed one by one. */
+			if ((idx % SPX_HASH_LANES) == 0)
+			{
+				gen_leaf(leaves, sk_seed, pub_seed, idx + idx_offset, tree_addr);
+			}
+
 			/* Add the next leaf node to the stack. */
-			gen_leaf(stack + (offset * SPX_N), sk_seed, pub_seed, idx + idx_offset, tree_addr);
+			memcpy(stack + (offset * SPX_N), leaves + ((idx % SPX_HASH_LANES) * SPX_N), SPX_N);
 			++offset;
 			heights[offset - 1] = 0;
 
@@ -466,35 +558,125 @@ static void treehash(uint8_t* root, uint8_t* auth_path, const uint8_t* sk_seed,
 
 /* wots.c */
 
-static void wots_gen_sk(uint8_t* sk, const uint8_t* sk_seed, uint32_t wots_addr[8])
+static void gen_chainx(uint8_t* out[SPX_HASH_LANES], const uint8_t* in[SPX_HASH_LANES], const uint32_t start[SPX_HASH_LANES],
+	const uint32_t steps[SPX_HASH_LANES], const uint8_t* pub_seed, uint32_t addr[SPX_HASH_LANES][8])
 {
-	/* Computes the starting value for a chain, i.e. the secret key.
-	 * Expects the address to be complete up to the chain address. */
+	/* Computes the chaining function on every lane.
+	 * out and in are n-byte arrays, addr holds the address of each chain.
+	 *
+	 * A lane that has not reached its start, or has completed its steps,
+	 * is hashed into a scratch value so that the others can continue. */
+
+	uint8_t scratch[SPX_HASH_LANES][SPX_N] = { 0 };
+	uint8_t* pout[SPX_HASH_LANES];
+	const uint8_t* pin[SPX_HASH_LANES];
+	uint32_t first;
+	uint32_t i;
+	uint32_t last;
+	size_t j;
+
+	first = SPX_WOTS_W;
+	last = 0;
+
+	/* Initialize out with the value at position 'start'. */
+	for (j = 0; j < SPX_HASH_LANES; ++j)
+	{
+		if (out[j] != in[j])
+		{
+			memcpy(out[j], in[j], SPX_N);
+		}
+
+		/* a lane without steps must not widen the range, or an idle lane would pull first down to zero */
+		if (steps[j] != 0)
+		{
+			first = (start[j] < first) ? start[j] : first;
+			last = (start[j] + steps[j] > last) ? start[j] + steps[j] : last;
+		}
+	}
+
+	last = (last < SPX_WOTS_W) ? last : SPX_WOTS_W;
+
+	/* Iterate the hash function until the longest chain has completed. */
+	for (i = first; i < last; ++i)
+	{
+		for (j = 0; j < SPX_HASH_LANES; ++j)
+		{
+			pout[j] = (i >= start[j] && i < start[j] + steps[j]) ? out[j] : scratch[j];
+			pin[j] = pout[j];
+			set_hash_addr(addr[j], i);
+		}
 
-	 /* Make sure that the hash address is actually zeroed. */
-	set_hash_addr(wots_addr, 0);
-	/* Generate sk element. */
-	prf_addr(sk, sk_seed, wots_addr);
+		thashx(pout, pin, 1, pub_seed, addr);
+	}
 }
 
-static void gen_chain(uint8_t* out, const uint8_t* in, uint32_t start, uint32_t steps, const uint8_t* pub_seed, uint32_t addr[8])
+static void wots_gen_chains(uint8_t* out, const uint8_t* in, const uint32_t* start, const uint32_t* steps, const uint8_t* sk_seed,
+	const uint8_t* pub_seed, const uint32_t addr[8])
 {
-	/* Computes the chaining function.
-	 * out and in have to be n-byte arrays.
-	 *
-	 * Interprets in as start-th value of the chain.
-	 * addr has to contain the address of the chain. */
+	/* Computes the chains of one WOTS key pair a lane group at a time.
+	 * When in is NULL, each chain starts from its secret key element.
+	 * The chains are grouped by step count, so a group runs to about the same length. */
+
+	uint8_t scratch[SPX_N] = { 0 };
+	uint32_t chain_addr[SPX_HASH_LANES][8] = { 0 };
+	uint32_t order[SPX_WOTS_LEN];
+	uint32_t lstart[SPX_HASH_LANES];
+	uint32_t lsteps[SPX_HASH_LANES];
+	uint8_t* pout[SPX_HASH_LANES];
+	const uint8_t* pin[SPX_HASH_LANES];
+	uint32_t c;
+	size_t i;
+	size_t j;
+	size_t k;
 
-	uint32_t i;
+	/* insertion sort of the chain indices by descending step count */
+	for (i = 0; i < SPX_WOTS_LEN; ++i)
+	{
+		c = (uint32_t)i;
 
-	/* Initialize out with the value at position 'start'. */
-	memcpy(out, in, SPX_N);
+		for (k = i; k > 0 && steps[order[k - 1]] < steps[c]; --k)
+		{
+			order[k] = order[k - 1];
+		}
+
+		order[k] = c;
+	}
 
-	/* Iterate 'steps' calls to the hash function. */
-	for (i = start; i < (start + steps) && i < SPX_WOTS_W; ++i)
+	for (i = 0; i < SPX_WOTS_LEN; i += SPX_HASH_LANES)
 	{
-		set_hash_addr(addr, i);
-		thash(out, out, 1, pub_seed, addr);
+		for (j = 0; j < SPX_HASH_LANES; ++j)
+		{
+			memcpy(chain_addr[j], addr, sizeof(chain_addr[j]));
+
+			if (i + j < SPX_WOTS_LEN)
+			{
+				c = order[i + j];
+				set_chain_addr(chain_addr[j], c);
+				pout[j] = out + ((size_t)c * SPX_N);
+				pin[j] = (in != NULL) ? in + ((size_t)c * SPX_N) : pout[j];
+				lstart[j] = start[c];
+				lsteps[j] = steps[c];
+			}
+			else
+			{
+				/* a lane past the last chain idles on a scratch value */
+				pout[j] = scratch;
+				pin[j] = scratch;
+				lstart[j] = 0;
+				lsteps[j] = 0;
+			}
+
+			/* Make sure that the hash address is actually zeroed. */
+			set_hash_addr(chain_addr[j], 0);
+		}
+
+		if (in == NULL)
+		{
+			/* Generate the sk elements. */
+			prf_addrx(pout, sk_seed, chain_addr);
+		}
+
+		gen_chainx(pout, pin, lstart, lsteps, pub_seed, chain_addr);
 	}
 }
 
@@ -559,64 +741,97 @@ static void chain_lengths(int32_t* lengths, const uint8_t* msg)
 	wots_checksum(lengths + SPX_WOTS_LEN1, lengths);
 }
 
-static void wots_gen_pk(uint8_t* pk, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr[8])
+static void wots_gen_pkx(uint8_t* pk[SPX_HASH_LANES], const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr[SPX_HASH_LANES][8])
 {
+	/* Computes the WOTS public keys of one key pair per lane; every chain runs its full length. */
+
+	uint32_t start[SPX_HASH_LANES] = { 0 };
+	uint32_t steps[SPX_HASH_LANES];
+	uint8_t* pout[SPX_HASH_LANES];
+	const uint8_t* pin[SPX_HASH_LANES];
 	size_t i;
+	size_t j;
 
 	for (i = 0; i < SPX_WOTS_LEN; i++)
 	{
-		set_chain_addr(addr, (uint32_t)i);
-		wots_gen_sk(pk + (i * SPX_N), sk_seed, addr);
-		gen_chain(pk + (i * SPX_N), pk + (i * SPX_N), 0, SPX_WOTS_W - 1, pub_seed, addr);
+		for (j = 0; j < SPX_HASH_LANES; ++j)
+		{
+			set_chain_addr(addr[j], (uint32_t)i);
+			set_hash_addr(addr[j], 0);
+			pout[j] = pk[j] + (i * SPX_N);
+			pin[j] = pout[j];
+			steps[j] = SPX_WOTS_W - 1;
+		}
+
+		prf_addrx(pout, sk_seed, addr);
+		gen_chainx(pout, pin, start, steps, pub_seed, addr);
 	}
 }
 
 static void wots_sign(uint8_t* sig, const uint8_t* msg, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr[8])
 {
 	int32_t lengths[SPX_WOTS_LEN];
+	uint32_t start[SPX_WOTS_LEN] = { 0 };
+	uint32_t steps[SPX_WOTS_LEN];
 	uint32_t i;
 
 	chain_lengths(lengths, msg);
 
 	for (i = 0; i < SPX_WOTS_LEN; i++)
 	{
-		set_chain_addr(addr, i);
-		wots_gen_sk(sig + (i * SPX_N), sk_seed, addr);
-		gen_chain(sig + (i * SPX_N), sig + (i * SPX_N), 0, lengths[i], pub_seed, addr);
+		steps[i] = (uint32_t)lengths[i];
 	}
+
+	wots_gen_chains(sig, NULL, start, steps, sk_seed, pub_seed, addr);
 }
 
 static void wots_pk_from_sig(uint8_t* pk, const uint8_t* sig, const uint8_t* msg, const uint8_t* pub_seed, uint32_t addr[8])
 {
 	int32_t lengths[SPX_WOTS_LEN];
+	uint32_t start[SPX_WOTS_LEN];
+	uint32_t steps[SPX_WOTS_LEN];
 	uint32_t i;
 
 	chain_lengths(lengths, msg);
 
 	for (i = 0; i < SPX_WOTS_LEN; i++)
 	{
-		set_chain_addr(addr, i);
-		gen_chain(pk + (i * SPX_N), sig + (i * SPX_N), lengths[i], SPX_WOTS_W - 1 - lengths[i], pub_seed, addr);
+		start[i] = (uint32_t)lengths[i];
+		steps[i] = SPX_WOTS_W - 1 - (uint32_t)lengths[i];
 	}
+
+	wots_gen_chains(pk, sig, start, steps, NULL, pub_seed, addr);
 }
 
-static void wots_gen_leaf(uint8_t* leaf, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr_idx, const uint32_t tree_addr[8])
+static void wots_gen_leafx(uint8_t* leaves, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr_idx, const uint32_t tree_addr[8])
 {
-	/* Computes the leaf at a given address. First generates the WOTS key pair, then computes leaf by hashing horizontally. */
+	/* Computes the leaves at SPX_HASH_LANES consecutive addresses, starting at addr_idx.
+	   First generates the WOTS key pairs, then computes each leaf by hashing horizontally. */
+
+	uint8_t pk[SPX_HASH_LANES][SPX_WOTS_BYTES];
+	uint32_t wots_addr[SPX_HASH_LANES][8] = { 0 };
+	uint32_t wots_pk_addr[SPX_HASH_LANES][8] = { 0 };
+	uint8_t* pout[SPX_HASH_LANES];
+	uint8_t* ppk[SPX_HASH_LANES];
+	const uint8_t* pin[SPX_HASH_LANES];
+	size_t j;
 
-	uint8_t pk[SPX_WOTS_BYTES];
-	uint32_t wots_addr[8] = { 0 };
-	uint32_t wots_pk_addr[8] = { 0 };
+	for (j = 0; j < SPX_HASH_LANES; ++j)
+	{
+		set_type(wots_addr[j], SPX_ADDR_TYPE_WOTS);
+		set_type(wots_pk_addr[j], SPX_ADDR_TYPE_WOTSPK);
 
-	set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-	set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
+		copy_subtree_addr(wots_addr[j], tree_addr);
+		set_keypair_addr(wots_addr[j], addr_idx + (uint32_t)j);
+		copy_keypair_addr(wots_pk_addr[j], wots_addr[j]);
 
-	copy_subtree_addr(wots_addr, tree_addr);
-	set_keypair_addr(wots_addr, addr_idx);
-	wots_gen_pk(pk, sk_seed, pub_seed, wots_addr);
+		pout[j] = leaves + (j * SPX_N);
+		ppk[j] = pk[j];
+		pin[j] = pk[j];
+	}
 
-	copy_keypair_addr(wots_pk_addr, wots_addr);
-	thash(leaf, pk, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
+	wots_gen_pkx(ppk, sk_seed, pub_seed, wots_addr);
+	thashx(pout, pin, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
 }
 
 /* fors.c */
@@ -631,17 +846,28 @@ static void fors_sk_to_leaf(uint8_t* leaf, const uint8_t* sk, const uint8_t* pub
 	thash(leaf, sk, 1, pub_seed, fors_leaf_addr);
 }
 
-static void fors_gen_leaf(uint8_t* leaf, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr_idx, const uint32_t fors_tree_addr[8])
+static void fors_gen_leafx(uint8_t* leaves, const uint8_t* sk_seed, const uint8_t* pub_seed, uint32_t addr_idx, const uint32_t fors_tree_addr[8])
 {
-	uint32_t fors_leaf_addr[8] = { 0 };
+	/* Computes the FORS leaves at SPX_HASH_LANES consecutive addresses, starting at addr_idx. */
+
+	uint32_t fors_leaf_addr[SPX_HASH_LANES][8] = { 0 };
+	uint8_t* pout[SPX_HASH_LANES];
+	const uint8_t* pin[SPX_HASH_LANES];
+	size_t j;
+
+	for (j = 0; j < SPX_HASH_LANES; ++j)
+	{
+		/* Only copy the parts that must be kept in fors_leaf_addr. */
+		copy_keypair_addr(fors_leaf_addr[j], fors_tree_addr);
+		set_type(fors_leaf_addr[j], SPX_ADDR_TYPE_FORSTREE);
+		set_tree_index(fors_leaf_addr[j], addr_idx + (uint32_t)j);
 
-	/* Only copy the parts that must be kept in fors_leaf_addr. */
-	copy_keypair_addr(fors_leaf_addr, fors_tree_addr);
-	set_type(fors_leaf_addr, SPX_ADDR_TYPE_FORSTREE);
-	set_tree_index(fors_leaf_addr, addr_idx);
+		pout[j] = leaves + (j * SPX_N);
+		pin[j] = pout[j];
+	}
 
-	fors_gen_sk(leaf, sk_seed, fors_leaf_addr);
-	fors_sk_to_leaf(leaf, leaf, pub_seed, fors_leaf_addr);
+	prf_addrx(pout, sk_seed, fors_leaf_addr);
+	thashx(pout, pin, 1, pub_seed, fors_leaf_addr);
 }
 
 static void message_to_indices(uint32_t* indices, const uint8_t* m)
@@ -668,41 +894,26 @@ static void message_to_indices(uint32_t* indices, const uint8_t* m)
 	}
 }
 
-static void fors_sign(uint8_t* sig, uint8_t* pk, const uint8_t* m, const uint8_t* sk_seed, const uint8_t* pub_seed, const uint32_t fors_addr[8])
+static void fors_sign_tree(uint8_t* sig, uint8_t* root, uint32_t index, uint32_t tree, const uint8_t* sk_seed, const uint8_t* pub_seed, const uint32_t fors_addr[8])
 {
+	/* Signs with one FORS tree; writes the secret key part of the selected leaf and its authentication path, and returns the tree root. */
+
 	uint32_t fors_tree_addr[8] = { 0 };
-	uint32_t fors_pk_addr[8] = { 0 };
-	uint32_t indices[SPX_FORS_TREES];
-	uint8_t roots[SPX_FORS_TREES * SPX_N];
 	uint32_t idx_offset;
-	size_t i;
 
 	copy_keypair_addr(fors_tree_addr, fors_addr);
-	copy_keypair_addr(fors_pk_addr, fors_addr);
-
 	set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSTREE);
-	set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
-
-	message_to_indices(indices, m);
-
-	for (i = 0; i < SPX_FORS_TREES; ++i)
-	{
-		idx_offset = (uint32_t)i * (1UL << (uint32_t)SPX_FORS_HEIGHT);
 
-		set_tree_height(fors_tree_addr, 0);
-		set_tree_index(fors_tree_addr, indices[i] + idx_offset);
+	idx_offset = tree * (1UL << (uint32_t)SPX_FORS_HEIGHT);
 
-		/* Include the secret key part that produces the selected leaf node. */
-		fors_gen_sk(sig, sk_seed, fors_tree_addr);
-		sig += SPX_N;
+	set_tree_height(fors_tree_addr, 0);
+	set_tree_index(fors_tree_addr, index + idx_offset);
 
-		/* Compute the authentication path for this leaf node. */
-		treehash(roots + (i * SPX_N), sig, sk_seed, pub_seed, indices[i], idx_offset, SPX_FORS_HEIGHT, fors_gen_leaf, fors_tree_addr);
-		sig += SPX_N * SPX_FORS_HEIGHT;
-	}
+	/* Include the secret key part that produces the selected leaf node. */
+	fors_gen_sk(sig, sk_seed, fors_tree_addr);
 
-	/* Hash horizontally across all tree roots to derive the public key. */
-	thash(pk, roots, SPX_FORS_TREES, pub_seed, fors_pk_addr);
+	/* Compute the authentication path for this leaf node. */
+	treehash(root, sig + SPX_N, sk_seed, pub_seed, index, idx_offset, SPX_FORS_HEIGHT, fors_gen_leafx, fors_tree_addr);
 }
 
 static void fors_pk_from_sig(uint8_t* pk, const uint8_t* sig, const uint8_t* m, const uint8_t* pub_seed, const uint32_t fors_addr[8])
@@ -745,6 +956,45 @@ static void fors_pk_from_sig(uint8_t* pk, const uint8_t* sig, const uint8_t* m,
 
 /* sign.c */
 
+typedef struct
+{
+	uint8_t roots[(SPX_FORS_TREES + SPX_D) * SPX_N];
+	uint32_t indices[SPX_FORS_TREES];
+	uint64_t tree[SPX_D];
+	uint32_t idx_leaf[SPX_D];
+	uint32_t fors_addr[8];
+	uint8_t* sig;
+	const uint8_t* sk_seed;
+	const uint8_t* pub_seed;
+} sphincsplus_sign_state;
+
+static void sphincsplus_sign_task(size_t index, void* ctx)
+{
+	/* One FORS tree, or one hypertree layer's authentication path and root;
+	   every task writes only its own part of the signature and its own root. */
+
+	sphincsplus_sign_state* state = (sphincsplus_sign_state*)ctx;
+	uint32_t tree_addr[8] = { 0 };
+	size_t layer;
+
+	if (index < SPX_FORS_TREES)
+	{
+		fors_sign_tree(state->sig + (index * (SPX_FORS_HEIGHT + 1) * SPX_N), state->roots + (index * SPX_N), state->indices[index],
+			(uint32_t)index, state->sk_seed, state->pub_seed, state->fors_addr);
+	}
+	else
+	{
+		layer = index - SPX_FORS_TREES;
+
+		set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+		set_layer_addr(tree_addr, (uint32_t)layer);
+		set_tree_addr(tree_addr, state->tree[layer]);
+
+		treehash(state->roots + (index * SPX_N), state->sig + SPX_FORS_BYTES + (layer * (SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N)) + SPX_WOTS_BYTES,
+			state->sk_seed, state->pub_seed, state->idx_leaf[layer], 0, SPX_TREE_HEIGHT, wots_gen_leafx, tree_addr);
+	}
+}
+
 static void sphincsplus_sign_seed_keypair(uint8_t* pk, uint8_t* sk, const uint8_t* seed)
 {
 	/* We do not need the auth path in key generation, but it simplifies the
@@ -764,7 +1014,7 @@ static void sphincsplus_sign_seed_keypair(uint8_t* pk, uint8_t* sk, const uint8_
 	initialize_hash_function(pk, sk);
 
 	/* Compute root node of the top-most subtree. */
-	treehash(sk + (3 * SPX_N), auth_path, sk, sk + (2 * SPX_N), 0, 0, SPX_TREE_HEIGHT, wots_gen_leaf, top_tree_addr);
+	treehash(sk + (3 * SPX_N), auth_path, sk, sk + (2 * SPX_N), 0, 0, SPX_TREE_HEIGHT, wots_gen_leafx, top_tree_addr);
 	memcpy(pk + SPX_N, sk + (3 * SPX_N), SPX_N);
 }
 
@@ -777,6 +1027,7 @@ static void sphincsplus_sign_signature(uint8_t* sig, size_t* siglen, const uint8
 	const uint8_t* pk = sk + 2 * SPX_N;
 	const uint8_t* pub_seed = pk;
 
+	sphincsplus_sign_state state = { 0 };
 	uint8_t optrand[SPX_N];
 	uint8_t mhash[SPX_FORS_MSG_BYTES];
 	uint8_t root[SPX_N];
@@ -785,6 +1036,7 @@ static void sphincsplus_sign_signature(uint8_t* sig, size_t* siglen, const uint8
 	uint32_t idx_leaf;
 	uint32_t wots_addr[8] = { 0 };
 	uint32_t tree_addr[8] = { 0 };
+	uint32_t fors_pk_addr[8] = { 0 };
 
 	/* This hook allows the hash function instantiation to do whatever
 	   preparation or computation it needs, based on the public seed. */
@@ -808,47 +1060,62 @@ static void sphincsplus_sign_signature(uint8_t* sig, size_t* siglen, const uint8
 	set_tree_addr(wots_addr, tree);
 	set_keypair_addr(wots_addr, idx_leaf);
 
-	/* Sign the message hash using FORS. */
-	fors_sign(sig, root, mhash, sk_seed, pub_seed, wots_addr);
+	/* The FORS trees and the subtree of every layer depend only on the digest,
+	   so they are computed concurrently, one task per tree. */
+	message_to_indices(state.indices, mhash);
+	memcpy(state.fors_addr, wots_addr, sizeof(state.fors_addr));
+	state.sig = sig;
+	state.sk_seed = sk_seed;
+	state.pub_seed = pub_seed;
+
+	for (i = 0; i < SPX_D; i++)
+	{
+		state.tree[i] = tree;
+		state.idx_leaf[i] = idx_leaf;
+
+		/* Update the indices for the next layer. */
+		idx_leaf = (tree & ((1ULL << SPX_TREE_HEIGHT) - 1));
+		tree = tree >> SPX_TREE_HEIGHT;
+	}
+
+	qsc_parallel_state_for(0, SPX_FORS_TREES + SPX_D, &state, sphincsplus_sign_task);
+
+	/* Hash horizontally across all tree roots to derive the FORS public key. */
+	copy_keypair_addr(fors_pk_addr, wots_addr);
+	set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
+	thash(root, state.roots, SPX_FORS_TREES, pub_seed, fors_pk_addr);
 	sig += SPX_FORS_BYTES;
 
+	/* Each WOTS signature signs the root of the layer below; these are short, so they run in order. */
 	for (i = 0; i < SPX_D; i++)
 	{
 		set_layer_addr(tree_addr, (uint32_t)i);
-		set_tree_addr(tree_addr, tree);
+		set_tree_addr(tree_addr, state.tree[i]);
 
 		copy_subtree_addr(wots_addr, tree_addr);
-		set_keypair_addr(wots_addr, idx_leaf);
+		set_keypair_addr(wots_addr, state.idx_leaf[i]);
 
 		/* Compute a WOTS signature. */
 		wots_sign(sig, root, sk_seed, pub_seed, wots_addr);
-		sig += SPX_WOTS_BYTES;
+		sig += SPX_WOTS_BYTES + (SPX_TREE_HEIGHT * SPX_N);
 
-		/* Compute the authentication path for the used WOTS leaf. */
-		treehash(root, sig, sk_seed, pub_seed, idx_leaf, 0, SPX_TREE_HEIGHT, wots_gen_leaf, tree_addr);
-		sig += SPX_TREE_HEIGHT * SPX_N;
-
-		/* Update the indices for the next layer. */
-		idx_leaf = (tree & ((1ULL << SPX_TREE_HEIGHT) - 1));
-		tree = tree >> SPX_TREE_HEIGHT;
+		/* The root of this layer is the message of the next. */
+		memcpy(root, state.roots + ((SPX_FORS_TREES + i) * SPX_N), SPX_N);
 	}
 
 	*siglen = SPX_BYTES;
 }
 
-static int32_t sphincsplus_sign_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+static int32_t sphincsplus_verify_digest(const uint8_t* sig, const uint8_t* mhash, uint64_t tree, uint32_t idx_leaf, const uint8_t* pk)
 {
-	/* Verifies a detached signature and message under a given public key. */
+	/* Verifies the FORS and hypertree layers of a signature over a message digest; sig points past R. */
 
 	const uint8_t* pub_seed = pk;
 	const uint8_t* pub_root = pk + SPX_N;
-	uint8_t mhash[SPX_FORS_MSG_BYTES];
 	uint8_t wots_pk[SPX_WOTS_BYTES];
 	uint8_t root[SPX_N];
 	uint8_t leaf[SPX_N];
 	uint32_t i;
-	uint64_t tree;
-	uint32_t idx_leaf;
 	uint32_t wots_addr[8] = { 0 };
 	uint32_t tree_addr[8] = { 0 };
 	uint32_t wots_pk_addr[8] = { 0 };
@@ -856,62 +1123,50 @@ static int32_t sphincsplus_sign_verify(const uint8_t* sig, size_t siglen, const
 
 	ret = 0;
 
-	if (siglen == SPX_BYTES)
-	{
-		/* This hook allows the hash function instantiation to do whatever
-		   preparation or computation it needs, based on the public seed. */
-		initialize_hash_function(pub_seed, NULL);
+	/* This hook allows the hash function instantiation to do whatever
+	   preparation or computation it needs, based on the public seed. */
+	initialize_hash_function(pub_seed, NULL);
 
-		set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-		set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
-		set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
+	set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
+	set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+	set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
 
-		/* Derive the message digest and leaf index from R || PK || M. */
-		/* The additional SPX_N is a result of the hash domain separator. */
-		hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen);
-		sig += SPX_N;
+	/* Layer correctly defaults to 0, so no need to set_layer_addr */
+	set_tree_addr(wots_addr, tree);
+	set_keypair_addr(wots_addr, idx_leaf);
+
+	fors_pk_from_sig(root, sig, mhash, pub_seed, wots_addr);
+	sig += SPX_FORS_BYTES;
 
-		/* Layer correctly defaults to 0, so no need to set_layer_addr */
-		set_tree_addr(wots_addr, tree);
+	/* For each subtree.. */
+	for (i = 0; i < SPX_D; i++)
+	{
+		set_layer_addr(tree_addr, i);
+		set_tree_addr(tree_addr, tree);
+		copy_subtree_addr(wots_addr, tree_addr);
 		set_keypair_addr(wots_addr, idx_leaf);
+		copy_keypair_addr(wots_pk_addr, wots_addr);
 
-		fors_pk_from_sig(root, sig, mhash, pub_seed, wots_addr);
-		sig += SPX_FORS_BYTES;
+		/* The WOTS public key is only correct if the signature was correct. */
+		/* Initially, root is the FORS pk, but on subsequent iterations it is
+		   the root of the subtree below the currently processed subtree. */
+		wots_pk_from_sig(wots_pk, sig, root, pub_seed, wots_addr);
+		sig += SPX_WOTS_BYTES;
 
-		/* For each subtree.. */
-		for (i = 0; i < SPX_D; i++)
-		{
-			set_layer_addr(tree_addr, i);
-			set_tree_addr(tree_addr, tree);
-			copy_subtree_addr(wots_addr, tree_addr);
-			set_keypair_addr(wots_addr, idx_leaf);
-			copy_keypair_addr(wots_pk_addr, wots_addr);
-
-			/* The WOTS public key is only correct if the signature was correct. */
-			/* Initially, root is the FORS pk, but on subsequent iterations it is
-			   the root of the subtree below the currently processed subtree. */
-			wots_pk_from_sig(wots_pk, sig, root, pub_seed, wots_addr);
-			sig += SPX_WOTS_BYTES;
-
-			/* Compute the leaf node using the WOTS public key. */
-			thash(leaf, wots_pk, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
-
-			/* Compute the root node of this subtree. */
-			compute_root(root, leaf, idx_leaf, 0, sig, SPX_TREE_HEIGHT, pub_seed, tree_addr);
-			sig += SPX_TREE_HEIGHT * SPX_N;
-
-			/* Update the indices for the next layer. */
-			idx_leaf = (tree & ((1ULL << SPX_TREE_HEIGHT) - 1));
-			tree = tree >> SPX_TREE_HEIGHT;
-		}
+		/* Compute the leaf node using the WOTS public key. */
+		thash(leaf, wots_pk, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
 
-		/* Check if the root node equals the root node in the public key. */
-		if (memcmp(root, pub_root, SPX_N))
-		{
-			ret = -1;
-		}
+		/* Compute the root node of this subtree. */
+		compute_root(root, leaf, idx_leaf, 0, sig, SPX_TREE_HEIGHT, pub_seed, tree_addr);
+		sig += SPX_TREE_HEIGHT * SPX_N;
+
+		/* Update the indices for the next layer. */
+		idx_leaf = (tree & ((1ULL << SPX_TREE_HEIGHT) - 1));
+		tree = tree >> SPX_TREE_HEIGHT;
 	}
-	else
+
+	/* Check if the root node equals the root node in the public key. */
+	if (memcmp(root, pub_root, SPX_N))
 	{
 		ret = -1;
 	}
@@ -919,6 +1174,27 @@ static int32_t sphincsplus_sign_verify(const uint8_t* sig, size_t siglen, const
 	return ret;
 }
 
+static int32_t sphincsplus_sign_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+	/* Verifies a detached signature and message under a given public key. */
+
+	uint8_t mhash[SPX_FORS_MSG_BYTES];
+	uint64_t tree;
+	uint32_t idx_leaf;
+	int32_t ret;
+
+	ret = -1;
+
+	if (siglen == SPX_BYTES)
+	{
+		/* Derive the message digest and leaf index from R || PK || M. */
+		hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen);
+		ret = sphincsplus_verify_digest(sig + SPX_N, mhash, tree, idx_leaf, pk);
+	}
+
+	return ret;
+}
+
 void sphincsplus_generate(uint8_t* pk, uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
 {
 	/* Generates an SPX key pair. */
@@ -976,3 +1252,32 @@ bool sphincsplus_verify(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smle
 
 	return res;
 }
+
+void sphincsplus_sign_detached(uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* sk, void (*rng_generate)(uint8_t*, size_t))
+{
+	size_t siglen;
+
+	sphincsplus_sign_signature(sig, &siglen, m, mlen, sk, rng_generate);
+}
+
+bool sphincsplus_verify_detached(const uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+	return (sphincsplus_sign_verify(sig, SPX_BYTES, m, mlen, pk) == 0);
+}
+
+void sphincsplus_verify_initialize(qsc_keccak_state* kstate, const uint8_t* sig, const uint8_t* pk)
+{
+	/* the randomizer R leads the signature */
+	hash_message_initialize(kstate, sig, pk);
+}
+
+bool sphincsplus_verify_finalize(qsc_keccak_state* kstate, const uint8_t* sig, const uint8_t* pk)
+{
+	uint8_t mhash[SPX_FORS_MSG_BYTES];
+	uint64_t tree;
+	uint32_t idx_leaf;
+
+	hash_message_finalize(kstate, mhash, &tree, &idx_leaf);
+
+	return (sphincsplus_verify_digest(sig + SPX_N, mhash, tree, idx_leaf, pk) == 0);
+}
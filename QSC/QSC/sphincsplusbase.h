@@ -2,6 +2,7 @@
 #define QSC_SPHINCSPLUSBASE_H
 
 #include "common.h"
+#include "sha3.h"
 
 /* sign.h */
 
@@ -37,4 +38,45 @@ void sphincsplus_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* messag
 */
 bool sphincsplus_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns the signature alone.
+*
+* \param signature The output signature
+* \param message The message to be signed
+* \param msglen The message length
+* \param secretkey The private signature key
+*/
+void sphincsplus_sign_detached(uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* secretkey, void (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature over a message with the public key.
+*
+* \param signature The signature
+* \param message The message
+* \param msglen The message length
+* \param publickey The public verification key
+* \return Returns true for success
+*/
+bool sphincsplus_verify_detached(const uint8_t* signature, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Starts the verification of a detached signature; absorbs the signature randomizer and public key into the message state.
+* The message is added to the state with qsc_shake_update at the 256-bit rate.
+*
+* \param kstate The message hash state
+* \param signature The signature
+* \param publickey The public verification key
+*/
+void sphincsplus_verify_initialize(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey);
+
+/**
+* \brief Completes the message hash and verifies the detached signature.
+*
+* \param kstate The message hash state
+* \param signature The signature
+* \param publickey The public verification key
+* \return Returns true for success
+*/
+bool sphincsplus_verify_finalize(qsc_keccak_state* kstate, const uint8_t* signature, const uint8_t* publickey);
+
 #endif
\ No newline at end of file
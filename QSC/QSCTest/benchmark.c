@@ -1,5 +1,5 @@
 #include "benchmark.h"
-#include "rhx.h"
+#include "../QSC/rhx.h"
 #include "testutils.h"
 #include "timer.h"
 #include "../QSC/chacha.h"
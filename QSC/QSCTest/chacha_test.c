@@ -4,6 +4,7 @@
 #include "../QSC/intutils.h"
 #include "testutils.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 bool qsctest_chacha128_kat()
@@ -110,6 +111,150 @@ bool qsctest_chacha256_kat()
 	return status;
 }
 
+bool qsctest_xchacha_poly1305_kat()
+{
+	uint8_t ad[12] = { 0 };
+	uint8_t dec[114] = { 0 };
+	uint8_t exp[114 + QSC_XCHACHA_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t hexp[QSC_HCHACHA_OUTPUT_SIZE] = { 0 };
+	uint8_t hkey[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t hnonce[QSC_HCHACHA_NONCE_SIZE] = { 0 };
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t msg[114] = { 0 };
+	uint8_t nonce[QSC_XCHACHA_NONCE_SIZE] = { 0 };
+	uint8_t out[114 + QSC_XCHACHA_POLY1305_MAC_SIZE] = { 0 };
+	bool status;
+
+	status = true;
+
+	qsctest_hex_to_bin("82413B4227B27BFED30E42508A877D73A0F9E4D58A74A853C12EC41326D3ECDC", hexp, sizeof(hexp));
+	qsctest_hex_to_bin("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F", hkey, sizeof(hkey));
+	qsctest_hex_to_bin("000000090000004A0000000031415927", hnonce, sizeof(hnonce));
+
+	qsctest_hex_to_bin("50515253C0C1C2C3C4C5C6C7", ad, sizeof(ad));
+	qsctest_hex_to_bin("BD6D179D3E83D43B9576579493C0E939572A1700252BFACCBED2902C21396CBB731C7F1B0B4AA6440BF3A82F4EDA7E39AE64C6708C54C216CB96B72E1213B452"
+		"2F8C9BA40DB5D945B11B69B982C1BB9E3F3FAC2BC369488F76B2383565D3FFF921F9664C97637DA9768812F615C68B13B52E"
+		"C0875924C1C7987947DEAFD8780ACF49", exp, sizeof(exp));
+	qsctest_hex_to_bin("808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F", key, sizeof(key));
+	qsctest_hex_to_bin("4C616469657320616E642047656E746C656D656E206F662074686520636C617373206F66202739393A204966204920636F756C64206F6666657220796F75206F"
+		"6E6C79206F6E652074697020666F7220746865206675747572652C2073756E73637265656E20776F756C642062652069742E", msg, sizeof(msg));
+	qsctest_hex_to_bin("404142434445464748494A4B4C4D4E4F5051525354555657", nonce, sizeof(nonce));
+
+	qsc_hchacha_compute(out, hkey, hnonce);
+
+	if (qsc_intutils_are_equal8(out, hexp, sizeof(hexp)) == false)
+	{
+		qsctest_print_safe("Failure! xchacha_poly1305_kat: hchacha output does not match the expected answer -XK1 \n");
+		status = false;
+	}
+
+	qsc_xchacha_poly1305_encrypt(out, msg, sizeof(msg), ad, sizeof(ad), nonce, key);
+
+	if (qsc_intutils_are_equal8(out, exp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! xchacha_poly1305_kat: cipher-text does not match the expected answer -XK2 \n");
+		status = false;
+	}
+
+	if (qsc_xchacha_poly1305_decrypt(dec, out, sizeof(msg), ad, sizeof(ad), nonce, key) == false)
+	{
+		qsctest_print_safe("Failure! xchacha_poly1305_kat: authentication failed on a valid cipher-text -XK3 \n");
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(dec, msg, sizeof(msg)) == false)
+	{
+		qsctest_print_safe("Failure! xchacha_poly1305_kat: decrypted output does not match the message -XK4 \n");
+		status = false;
+	}
+
+	out[sizeof(out) - 1] ^= 1U;
+
+	if (qsc_xchacha_poly1305_decrypt(dec, out, sizeof(msg), ad, sizeof(ad), nonce, key) == true)
+	{
+		qsctest_print_safe("Failure! xchacha_poly1305_kat: a modified tag was not rejected -XK5 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_chacha_position()
+{
+	const size_t MSGLEN = 4096;
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t nonce[QSC_CHACHA_NONCE_SIZE] = { 0 };
+	uint8_t rnd[2 * sizeof(uint16_t)] = { 0 };
+	qsc_chacha_state ctx;
+	size_t rlen;
+	size_t roft;
+	size_t tctr;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)malloc(MSGLEN);
+	enc = (uint8_t*)malloc(MSGLEN);
+	msg = (uint8_t*)malloc(MSGLEN);
+
+	if (dec != NULL && enc != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(nonce, sizeof(nonce));
+		qsc_csp_generate(msg, MSGLEN);
+
+		qsc_chacha_keyparams kp = { key, sizeof(key), nonce };
+
+		/* encrypt the full message */
+		qsc_chacha_initialize(&ctx, &kp);
+		qsc_chacha_transform(&ctx, enc, msg, MSGLEN);
+		qsc_chacha_dispose(&ctx);
+
+		for (tctr = 0; tctr < QSCTEST_CHACHA_TEST_CYCLES; ++tctr)
+		{
+			/* select a random range of the cipher-text */
+			qsc_csp_generate(rnd, sizeof(rnd));
+			roft = qsc_intutils_le8to16(rnd) % MSGLEN;
+			rlen = (qsc_intutils_le8to16(rnd + sizeof(uint16_t)) % (MSGLEN - roft)) + 1;
+
+			/* decrypt the range directly from its position */
+			qsc_chacha_initialize(&ctx, &kp);
+			qsc_chacha_set_position(&ctx, roft);
+			qsc_chacha_transform(&ctx, dec, enc + roft, rlen);
+			qsc_chacha_dispose(&ctx);
+
+			if (qsc_intutils_are_equal8(dec, msg + roft, rlen) == false)
+			{
+				status = false;
+				break;
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		free(msg);
+	}
+
+	return status;
+}
+
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 bool qsctest_chacha128_wide_equality()
 {
@@ -343,6 +488,24 @@ void qsctest_chacha_run()
 		qsctest_print_safe("Failure! Failed the ChaCha 256-bit key known answer test. \n");
 	}
 
+	if (qsctest_xchacha_poly1305_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the XChaCha20-Poly1305 known answer test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the XChaCha20-Poly1305 known answer test. \n");
+	}
+
+	if (qsctest_chacha_position() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha key-stream position test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha key-stream position test. \n");
+	}
+
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 	if (qsctest_chacha128_wide_equality() == true)
 	{
@@ -38,6 +38,26 @@ bool qsctest_chacha128_kat();
 */
 bool qsctest_chacha256_kat();
 
+/**
+* \brief Tests the HChaCha20 sub-key derivation and the XChaCha20-Poly1305 AEAD mode.
+* Encrypts and authenticates the known answer message, decrypts it, and tests that a modified tag is rejected.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* draft-irtf-cfrg-xchacha: <a href="https://tools.ietf.org/html/draft-irtf-cfrg-xchacha-03">XChaCha: eXtended-nonce ChaCha and AEAD_XChaCha20_Poly1305</a>
+*/
+bool qsctest_xchacha_poly1305_kat();
+
+/**
+* \brief Tests random-access decryption using the key-stream position function.
+* Encrypts a random message, then decrypts random ranges at random positions,
+* and compares each range with the corresponding range of the message.
+*
+* \return Returns true for success
+*/
+bool qsctest_chacha_position();
+
 
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 
@@ -250,6 +250,89 @@ bool qsctest_csx512_stress()
 	return status;
 }
 
+#if defined(QSCTEST_CSX_POSITION_TESTS)
+bool qsctest_csx_position()
+{
+	const size_t MSGLEN = 8192;
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t key[QSC_CSX_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t nonce[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t rnd[2 * sizeof(uint16_t)] = { 0 };
+	qsc_csx_state ctx;
+	size_t rlen;
+	size_t roft;
+	size_t tctr;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)malloc(MSGLEN);
+	enc = (uint8_t*)malloc(MSGLEN);
+	msg = (uint8_t*)malloc(MSGLEN);
+
+	if (dec != NULL && enc != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, MSGLEN);
+
+		/* start near the nonce carry boundary */
+		qsc_intutils_le64to8(ncopy, 0xFFFFFFFFFFFFFFF0ULL);
+		memcpy(nonce, ncopy, sizeof(nonce));
+		qsc_csx_keyparams kp = { key, sizeof(key), nonce, NULL, 0 };
+
+		/* encrypt the full message */
+		qsc_csx_initialize(&ctx, &kp, true);
+		qsc_csx_transform(&ctx, enc, msg, MSGLEN);
+		qsc_csx_dispose(&ctx);
+
+		for (tctr = 0; tctr < QSCTEST_CSX_TEST_CYCLES; ++tctr)
+		{
+			/* select a random range of the cipher-text */
+			qsc_csp_generate(rnd, sizeof(rnd));
+			roft = qsc_intutils_le8to16(rnd) % MSGLEN;
+			rlen = (qsc_intutils_le8to16(rnd + sizeof(uint16_t)) % (MSGLEN - roft)) + 1;
+
+			/* decrypt the range directly from its position */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_csx_initialize(&ctx, &kp, false);
+			qsc_csx_set_position(&ctx, roft);
+			qsc_csx_transform(&ctx, dec, enc + roft, rlen);
+			qsc_csx_dispose(&ctx);
+
+			if (qsc_intutils_are_equal8(dec, msg + roft, rlen) == false)
+			{
+				status = false;
+				break;
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		free(msg);
+	}
+
+	return status;
+}
+#endif
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 bool qsctest_csx_wide_equality()
 {
@@ -386,6 +469,17 @@ void qsctest_csx_run()
 		qsctest_print_safe("Failure! Failed the CSX stress tests. \n");
 	}
 
+#if defined(QSCTEST_CSX_POSITION_TESTS)
+	if (qsctest_csx_position() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSX key-stream position test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSX key-stream position test. \n");
+	}
+#endif
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 	if (qsctest_csx_wide_equality() == true)
 	{
@@ -22,6 +22,10 @@
 #	endif
 #endif
 
+#if !defined(QSC_CSX_AUTHENTICATED)
+#	define QSCTEST_CSX_POSITION_TESTS
+#endif
+
 /**
 * \brief Tests the CSX 512-bit key KAT vectors from CEX.
 * The C++ <a href="https://github.com/Steppenwolfe65/CEX">CEX cryptrographic library</a>
@@ -41,6 +45,16 @@ bool qsctest_csx512_kat();
 */
 bool qsctest_csx512_stress();
 
+#if defined(QSCTEST_CSX_POSITION_TESTS)
+/**
+* \brief Tests random-access decryption using the key-stream position function.
+* Decrypts random ranges of a cipher-text at random positions, and compares them with the message.
+*
+* \return Returns true for success
+*/
+bool qsctest_csx_position();
+#endif
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 /**
 * \brief Tests the CSX AVX functions for equal output to sequential processing.
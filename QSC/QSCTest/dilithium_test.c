@@ -1130,6 +1130,348 @@ bool qsctest_dilithium_operations_test()
 	return ret;
 }
 
+bool qsctest_dilithium_prepared_test()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t mout[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t sig1[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t sig2[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	qsc_dilithium_prepared_privatekey psk;
+	size_t i;
+	size_t msglen;
+	size_t siglen1;
+	size_t siglen2;
+	bool ret;
+
+	ret = true;
+	msglen = QSCTEST_DILITHIUM_MLEN0;
+	siglen1 = 0;
+	siglen2 = 0;
+
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsc_dilithium_prepare_privatekey(&psk, sk);
+
+	for (i = 0; i < QSCTEST_DILITHIUM_ITERATIONS; i++)
+	{
+		qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+		/* the same random stream must give the same signature through both apis */
+		qsctest_nistrng_prng_initialize(seed, msg, sizeof(msg));
+		qsc_dilithium_sign(sig1, &siglen1, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, msg, sizeof(msg));
+		qsc_dilithium_sign_prepared(sig2, &siglen2, msg, sizeof(msg), &psk, qsctest_nistrng_prng_generate);
+
+		if (siglen1 != siglen2 || qsc_intutils_are_equal8(sig1, sig2, siglen1) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_prepared_test: prepared signature output mismatch -DR1 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_verify(mout, &msglen, sig2, siglen2, pk) != true || msglen != sizeof(msg))
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_prepared_test: prepared signature verification has failed -DR2 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	qsc_dilithium_prepared_privatekey_dispose(&psk);
+
+	return ret;
+}
+
+bool qsctest_dilithium_modes_test()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t mout[QSC_DILITHIUM_SIGNATURE_MAX_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t sig1[QSC_DILITHIUM_SIGNATURE_MAX_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t sig2[QSC_DILITHIUM_SIGNATURE_MAX_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_MAX_SIZE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_MAX_SIZE] = { 0 };
+	const qsc_dilithium_modes modes[3] = { DILITHIUM_MODE2, DILITHIUM_MODE3, DILITHIUM_MODE4 };
+	const qsc_dilithium_modes dmode = (QSC_DILITHIUM_SIGNATURE_SIZE == QSC_DILITHIUM_MODE2_SIGNATURE_SIZE) ? DILITHIUM_MODE2 :
+		(QSC_DILITHIUM_SIGNATURE_SIZE == QSC_DILITHIUM_MODE3_SIGNATURE_SIZE) ? DILITHIUM_MODE3 : DILITHIUM_MODE4;
+	qsc_dilithium_prepared_privatekey psk;
+	qsc_dilithium_stream_state ctx;
+	size_t i;
+	size_t msglen;
+	size_t siglen1;
+	size_t siglen2;
+	bool ret;
+
+	ret = true;
+	msglen = 0;
+	siglen1 = 0;
+	siglen2 = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* the default mode through the runtime api must match the fixed-size api, which is covered by the known answer test */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsc_dilithium_sign(sig1, &siglen1, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, dmode);
+	qsc_dilithium_sign_ex(sig2, &siglen2, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate, dmode);
+
+	if (siglen1 != siglen2 || qsc_intutils_are_equal8(sig1, sig2, siglen1) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_dilithium_modes_test: the default mode output does not match the fixed-size api -DM1 \n");
+		ret = false;
+	}
+
+	for (i = 0; i < 3 && ret == true; i++)
+	{
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, modes[i]);
+		qsc_dilithium_sign_ex(sig1, &siglen1, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate, modes[i]);
+
+		if (siglen1 != qsc_dilithium_signature_size(modes[i]) + sizeof(msg))
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: the signed message length is incorrect -DM2 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_verify_ex(mout, &msglen, sig1, siglen1, pk, modes[i]) != true || msglen != sizeof(msg) ||
+			qsc_intutils_are_equal8(mout, msg, sizeof(msg)) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: signature verification has failed -DM3 \n");
+			ret = false;
+			break;
+		}
+
+		/* a prepared key records its mode and signs identically */
+		qsc_dilithium_prepare_privatekey_ex(&psk, sk, modes[i]);
+		qsc_dilithium_sign_prepared(sig2, &siglen2, msg, sizeof(msg), &psk, qsctest_nistrng_prng_generate);
+		qsc_dilithium_prepared_privatekey_dispose(&psk);
+
+		if (siglen1 != siglen2 || qsc_intutils_are_equal8(sig1, sig2, siglen1) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: prepared signature output mismatch -DM4 \n");
+			ret = false;
+			break;
+		}
+
+		/* a modified signature must not verify in any mode */
+		sig1[0] ^= 1;
+
+		if (qsc_dilithium_verify_ex(mout, &msglen, sig1, siglen1, pk, modes[i]) == true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: a modified signature has verified -DM5 \n");
+			ret = false;
+			break;
+		}
+
+		/* the detached and streaming signatures in the selected mode match the signature part of the signed message */
+		qsc_dilithium_sign_detached_ex(mout, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate, modes[i]);
+		qsc_dilithium_sign_initialize_ex(&ctx, sk, modes[i]);
+		qsc_dilithium_sign_update(&ctx, msg, sizeof(msg));
+		qsc_dilithium_sign_finalize(&ctx, sig1, sk, qsctest_nistrng_prng_generate);
+		qsc_dilithium_verify_initialize_ex(&ctx, pk, modes[i]);
+		qsc_dilithium_verify_update(&ctx, msg, sizeof(msg));
+
+		if (qsc_intutils_are_equal8(mout, sig2, qsc_dilithium_signature_size(modes[i])) != true ||
+			qsc_intutils_are_equal8(sig1, sig2, qsc_dilithium_signature_size(modes[i])) != true ||
+			qsc_dilithium_verify_detached_ex(mout, msg, sizeof(msg), pk, modes[i]) != true ||
+			qsc_dilithium_verify_finalize(&ctx, sig1, pk) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: detached or streaming signature has failed -DM6 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	/* an unknown mode is rejected, and signing with a prepared key of an unknown mode returns an empty signature */
+	if (ret == true)
+	{
+		siglen2 = sizeof(msg);
+		psk.mode = (qsc_dilithium_modes)0;
+		qsc_dilithium_sign_prepared(sig2, &siglen2, msg, sizeof(msg), &psk, qsctest_nistrng_prng_generate);
+
+		if (qsc_dilithium_signature_size((qsc_dilithium_modes)0) != 0 ||
+			qsc_dilithium_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, (qsc_dilithium_modes)0) == true ||
+			qsc_dilithium_sign_initialize_ex(&ctx, sk, (qsc_dilithium_modes)0) == true ||
+			qsc_dilithium_verify_detached_ex(sig1, msg, sizeof(msg), pk, (qsc_dilithium_modes)0) == true ||
+			siglen2 != 0)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_modes_test: an unknown mode was accepted -DM7 \n");
+			ret = false;
+		}
+	}
+
+	return ret;
+}
+
+bool qsctest_dilithium_batch_test()
+{
+	uint8_t msgs[QSCTEST_DILITHIUM_BATCH_COUNT][QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t mout[QSCTEST_DILITHIUM_BATCH_COUNT][QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t sigs[QSCTEST_DILITHIUM_BATCH_COUNT][QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t tmp[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN0] = { 0 };
+	uint8_t* pmout[QSCTEST_DILITHIUM_BATCH_COUNT];
+	const uint8_t* psigs[QSCTEST_DILITHIUM_BATCH_COUNT];
+	size_t msglens[QSCTEST_DILITHIUM_BATCH_COUNT] = { 0 };
+	size_t siglens[QSCTEST_DILITHIUM_BATCH_COUNT] = { 0 };
+	bool valid[QSCTEST_DILITHIUM_BATCH_COUNT] = { 0 };
+	qsc_dilithium_prepared_publickey ppk;
+	size_t i;
+	size_t msglen;
+	size_t nvalid;
+	bool exp;
+	bool ret;
+
+	ret = true;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsc_dilithium_prepare_publickey(&ppk, pk);
+
+	for (i = 0; i < QSCTEST_DILITHIUM_BATCH_COUNT; i++)
+	{
+		qsctest_nistrng_prng_generate(msgs[i], sizeof(msgs[i]));
+		qsc_dilithium_sign(sigs[i], &siglens[i], msgs[i], sizeof(msgs[i]), sk, qsctest_nistrng_prng_generate);
+		pmout[i] = mout[i];
+		psigs[i] = sigs[i];
+	}
+
+	/* tamper with two signatures, one in the signature and one in the message */
+	sigs[3][0] ^= 1U;
+	sigs[7][QSC_DILITHIUM_SIGNATURE_SIZE] ^= 1U;
+
+	nvalid = qsc_dilithium_verify_batch(valid, pmout, msglens, psigs, siglens, QSCTEST_DILITHIUM_BATCH_COUNT, &ppk);
+
+	if (nvalid != QSCTEST_DILITHIUM_BATCH_COUNT - 2)
+	{
+		qsctest_print_safe("Failure! qsctest_dilithium_batch_test: the batch valid count is incorrect -DB1 \n");
+		ret = false;
+	}
+
+	for (i = 0; i < QSCTEST_DILITHIUM_BATCH_COUNT && ret == true; i++)
+	{
+		exp = (i != 3 && i != 7);
+
+		/* the batch result must match the packed-key verification of the same item */
+		if (valid[i] != exp || qsc_dilithium_verify(tmp, &msglen, sigs[i], siglens[i], pk) != exp)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_batch_test: a batch result is incorrect -DB2 \n");
+			ret = false;
+			break;
+		}
+
+		if (exp == true && (msglens[i] != QSCTEST_DILITHIUM_MLEN0 || qsc_intutils_are_equal8(mout[i], msgs[i], QSCTEST_DILITHIUM_MLEN0) != true))
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_batch_test: a verified message is incorrect -DB3 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_verify_prepared(tmp, &msglen, sigs[i], siglens[i], &ppk) != exp)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_batch_test: prepared verification result is incorrect -DB4 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+
+bool qsctest_dilithium_detached_test()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_STREAM_MLEN] = { 0 };
+	uint8_t smsg[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_STREAM_MLEN] = { 0 };
+	uint8_t sig1[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t sig2[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	qsc_dilithium_stream_state ctx;
+	size_t blen;
+	size_t i;
+	size_t pos;
+	size_t smsglen;
+	bool ret;
+
+	ret = true;
+	smsglen = 0;
+
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+	for (i = 0; i < QSCTEST_DILITHIUM_ITERATIONS; i++)
+	{
+		qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+		/* the detached signature is the signature part of the signed message */
+		qsctest_nistrng_prng_initialize(seed, msg, QSCTEST_DILITHIUM_MLEN0);
+		qsc_dilithium_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, msg, QSCTEST_DILITHIUM_MLEN0);
+		qsc_dilithium_sign_detached(sig1, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(smsg, sig1, QSC_DILITHIUM_SIGNATURE_SIZE) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_detached_test: detached signature output mismatch -DD1 \n");
+			ret = false;
+			break;
+		}
+
+		/* uneven blocks that straddle the hash rate */
+		qsctest_nistrng_prng_initialize(seed, msg, QSCTEST_DILITHIUM_MLEN0);
+		qsc_dilithium_sign_initialize(&ctx, sk);
+
+		blen = (i + 1) * 37;
+
+		for (pos = 0; pos < sizeof(msg); pos += blen)
+		{
+			qsc_dilithium_sign_update(&ctx, msg + pos, (sizeof(msg) - pos < blen) ? sizeof(msg) - pos : blen);
+		}
+
+		qsc_dilithium_sign_finalize(&ctx, sig2, sk, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(sig1, sig2, QSC_DILITHIUM_SIGNATURE_SIZE) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_detached_test: streaming signature output mismatch -DD2 \n");
+			ret = false;
+			break;
+		}
+
+		qsc_dilithium_verify_initialize(&ctx, pk);
+		qsc_dilithium_verify_update(&ctx, msg, 100);
+		qsc_dilithium_verify_update(&ctx, msg + 100, sizeof(msg) - 100);
+
+		if (qsc_dilithium_verify_detached(sig1, msg, sizeof(msg), pk) != true || qsc_dilithium_verify_finalize(&ctx, sig2, pk) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_detached_test: detached signature verification has failed -DD3 \n");
+			ret = false;
+			break;
+		}
+
+		msg[i] ^= 1U;
+
+		if (qsc_dilithium_verify_detached(sig1, msg, sizeof(msg), pk) != false)
+		{
+			qsctest_print_safe("Failure! qsctest_dilithium_detached_test: a modified message was accepted -DD4 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+
 bool qsctest_dilithium_privatekey_integrity()
 {
 	uint8_t msg[QSCTEST_DILITHIUM_MLEN0] = { 0 };
@@ -1337,6 +1679,42 @@ void qsctest_dilithium_run()
 		qsctest_print_safe("Failure! Failed Dilithium known answer integrity tests. \n");
 	}
 
+	if (qsctest_dilithium_prepared_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium prepared private-key signing test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium prepared private-key signing test. \n");
+	}
+
+	if (qsctest_dilithium_modes_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium mode 2, mode 3 and mode 4 runtime mode test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium runtime mode test. \n");
+	}
+
+	if (qsctest_dilithium_batch_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium prepared public-key batch verification test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium prepared public-key batch verification test. \n");
+	}
+
+	if (qsctest_dilithium_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium detached and streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium detached and streaming signature test. \n");
+	}
+
 	if (qsctest_dilithium_stress_test() == true)
 	{
 		qsctest_print_safe("Success! The Dilithium stress test has succeeded. \n");
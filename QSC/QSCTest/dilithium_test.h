@@ -23,6 +23,9 @@
 #	define QSCTEST_DILITHIUM_ITERATIONS 10
 #endif
 
+#define QSCTEST_DILITHIUM_BATCH_COUNT 10
+#define QSCTEST_DILITHIUM_STREAM_MLEN 1000
+
 /**
 * \brief Test the first ten vectors of the NIST PQ Round 2 KAT tests
 */
@@ -36,6 +39,30 @@ bool qsctest_dilithium_kat_test();
 */
 bool qsctest_dilithium_operations_test();
 
+/**
+* \brief Test that signing with a prepared private key matches the packed-key signature and verifies
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_prepared_test();
+
+/**
+* \brief Test keygen, signing and verification of every security mode through the runtime mode api
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_modes_test();
+
+/**
+* \brief Test batch verification with a prepared public key, including two tampered signatures
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_batch_test();
+
+/**
+* \brief Test that detached and streaming signatures match the signed-message api and reject a modified message
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_detached_test();
+
 /**
 * \brief Test the validity of a mutated secret key
 * \return Returns true for test success
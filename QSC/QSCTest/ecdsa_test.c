@@ -12,6 +12,7 @@
 #define QSCTEST_ECDSA_MSG1_SIZE 64
 #define QSCTEST_ECDSA_MSG2_SIZE 96
 #define QSCTEST_ECDSA_MSG3_SIZE 128
+#define QSCTEST_ECDSA_STREAM_SIZE 1000
 
 bool qsctest_ecdsa_kat_test()
 {
@@ -306,6 +307,71 @@ bool qsctest_ecdsa_signature_integrity()
 	return ret;
 }
 
+bool qsctest_ecdsa_detached_test()
+{
+	uint8_t msg[QSCTEST_ECDSA_STREAM_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_ECDSA_SIGNATURE_SIZE] = { 0 };
+	uint8_t smsg[QSC_ECDSA_SIGNATURE_SIZE + QSCTEST_ECDSA_STREAM_SIZE] = { 0 };
+	uint8_t sk[QSC_ECDSA_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_ECDSA_PUBLICKEY_SIZE] = { 0 };
+	qsc_ecdsa_stream_state ctx;
+	size_t blen;
+	size_t i;
+	size_t pos;
+	size_t smsglen;
+	bool ret;
+
+	ret = true;
+	smsglen = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_ecdsa_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+	for (i = 0; i < QSCTEST_ECDSA_ITERATIONS; i++)
+	{
+		qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+		/* the detached signature is the signature part of the signed message */
+		qsc_ecdsa_sign(smsg, &smsglen, msg, sizeof(msg), sk);
+		qsc_ecdsa_sign_detached(sig, msg, sizeof(msg), sk);
+
+		if (qsc_intutils_are_equal8(smsg, sig, QSC_ECDSA_SIGNATURE_SIZE) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: detached signature output mismatch -ED1 \n");
+			ret = false;
+			break;
+		}
+
+		/* uneven blocks that straddle the hash rate */
+		blen = (i % 200) + 1;
+		qsc_ecdsa_verify_initialize(&ctx, sig, pk);
+
+		for (pos = 0; pos < sizeof(msg); pos += blen)
+		{
+			qsc_ecdsa_verify_update(&ctx, msg + pos, (sizeof(msg) - pos < blen) ? sizeof(msg) - pos : blen);
+		}
+
+		if (qsc_ecdsa_verify_finalize(&ctx, sig, pk) != true || qsc_ecdsa_verify_detached(sig, msg, sizeof(msg), pk) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: detached signature verification has failed -ED2 \n");
+			ret = false;
+			break;
+		}
+
+		msg[i] ^= 1U;
+
+		if (qsc_ecdsa_verify_detached(sig, msg, sizeof(msg), pk) != false)
+		{
+			qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: a modified message was accepted -ED3 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+
 bool qsctest_ecdsa_stress_test()
 {
 	uint8_t msg[QSCTEST_ECDSA_MSG0_SIZE] = { 0 };
@@ -370,6 +436,15 @@ void qsctest_ecdsa_run()
 		qsctest_print_safe("Failure! Failed ECDSA known answer test. \n");
 	}
 
+	if (qsctest_ecdsa_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the ECDSA detached and streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ECDSA detached and streaming signature test. \n");
+	}
+
 	if (qsctest_ecdsa_stress_test() == true)
 	{
 		qsctest_print_safe("Success! The ECDSA stress test has succeeded. \n");
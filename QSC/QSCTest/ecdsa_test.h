@@ -41,6 +41,12 @@ bool qsctest_ecdsa_publickey_integrity();
 */
 bool qsctest_ecdsa_signature_integrity();
 
+/**
+* \brief Test that detached signatures match the signed-message api, and that streaming verification accepts them and rejects a modified message
+* \return Returns true for test success
+*/
+bool qsctest_ecdsa_detached_test();
+
 /**
 * \brief Stress test the key generation, encryption, and decryption functions in a looping test.
 * \return Returns true for test success
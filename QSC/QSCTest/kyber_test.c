@@ -3,9 +3,15 @@
 #include "testutils.h"
 #include "../QSC/csp.h"
 #include "../QSC/kyber.h"
+#include "../QSC/kyberpool.h"
 #include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
+#include "../QSC/parallel.h"
+#include <stdlib.h>
 
 #define QSCTEST_KYBER_NTESTS 100
+#define QSCTEST_KYBER_POOL_TAKERS 8
+#define QSCTEST_KYBER_POOL_TAKES 4
 
 bool qsctest_kyber_ciphertext_integrity()
 {
@@ -373,6 +379,397 @@ bool qsctest_kyber_kat_test()
 	return ret;
 }
 
+bool qsctest_kyber_parameters_test()
+{
+	uint8_t ct[QSC_KYBER_CIPHERTEXT_MAX_SIZE] = { 0 };
+	uint8_t pk[QSC_KYBER_PUBLICKEY_MAX_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_KYBER_PRIVATEKEY_MAX_SIZE] = { 0 };
+	uint8_t ssk1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ssk2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t exp[3][QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	const qsc_kyber_parameters params[3] = { KYBER512, KYBER768, KYBER1024 };
+	size_t i;
+	bool res;
+
+	res = true;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	/* the first NIST PQ Round 2 shared secret of each parameter set */
+	qsctest_hex_to_bin("D0FF6083EE6E516C10AECB53DB05426C382A1A75F3E943C9F469A060C634EF4E", exp[0], sizeof(exp[0]));
+	qsctest_hex_to_bin("ED20140C05D78B15F2E412671A84154217FD77619A2C522D3C3CB688CB34C68B", exp[1], sizeof(exp[1]));
+	qsctest_hex_to_bin("FBC4EEA691EEF4C1B476A29936453F4C3D4881794EE37BAF0FD72840743E7B7D", exp[2], sizeof(exp[2]));
+
+	for (i = 0; i < 3; i++)
+	{
+		if (qsc_kyber_ciphertext_size(params[i]) > sizeof(ct) || qsc_kyber_publickey_size(params[i]) > sizeof(pk) ||
+			qsc_kyber_privatekey_size(params[i]) > sizeof(sk) || qsc_kyber_ciphertext_size(params[i]) == 0)
+		{
+			qsctest_print_safe("Failure! kyber_parameters_test: invalid parameter set sizes -KP1 \n");
+			res = false;
+			break;
+		}
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, params[i]);
+		qsc_kyber_encapsulate_ex(ssk2, ct, pk, qsctest_nistrng_prng_generate, params[i]);
+
+		if (qsc_kyber_decapsulate_ex(ssk1, ct, sk, params[i]) != true)
+		{
+			qsctest_print_safe("Failure! kyber_parameters_test: decapsulation failure -KP2 \n");
+			res = false;
+			break;
+		}
+
+		if (qsc_intutils_are_equal8(ssk1, ssk2, QSC_KYBER_SHAREDSECRET_SIZE) != true ||
+			qsc_intutils_are_equal8(ssk1, exp[i], QSC_KYBER_SHAREDSECRET_SIZE) != true)
+		{
+			qsctest_print_safe("Failure! kyber_parameters_test: the shared secret does not match the known answer -KP3 \n");
+			res = false;
+			break;
+		}
+
+		/* a tampered cipher-text must not decapsulate under any parameter set */
+		ct[0] ^= 1;
+
+		if (qsc_kyber_decapsulate_ex(ssk1, ct, sk, params[i]) == true)
+		{
+			qsctest_print_safe("Failure! kyber_parameters_test: tampered cipher-text accepted -KP4 \n");
+			res = false;
+			break;
+		}
+	}
+
+	/* an unknown parameter set is rejected, and the secret is not left unwritten */
+	if (res == true)
+	{
+		qsc_memutils_setvalue(ssk2, sizeof(ssk2), 0xFF);
+		qsc_intutils_clear8(ssk1, sizeof(ssk1));
+
+		if (qsc_kyber_ciphertext_size((qsc_kyber_parameters)0) != 0 ||
+			qsc_kyber_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, (qsc_kyber_parameters)0) == true ||
+			qsc_kyber_encapsulate_ex(ssk2, ct, pk, qsctest_nistrng_prng_generate, (qsc_kyber_parameters)0) == true ||
+			qsc_intutils_are_equal8(ssk1, ssk2, sizeof(ssk2)) != true)
+		{
+			qsctest_print_safe("Failure! kyber_parameters_test: an unknown parameter set was accepted -KP5 \n");
+			res = false;
+		}
+	}
+
+	return res;
+}
+
+bool qsctest_kyber_prepared_test()
+{
+	uint8_t ct1[QSC_KYBER_CIPHERTEXT_MAX_SIZE] = { 0 };
+	uint8_t ct2[QSC_KYBER_CIPHERTEXT_MAX_SIZE] = { 0 };
+	uint8_t pk[QSC_KYBER_PUBLICKEY_MAX_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_KYBER_PRIVATEKEY_MAX_SIZE] = { 0 };
+	uint8_t ssk1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ssk2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ssk3[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	const qsc_kyber_parameters params[3] = { KYBER512, KYBER768, KYBER1024 };
+	qsc_kyber_prepared_publickey ppk;
+	qsc_kyber_prepared_privatekey psk;
+	size_t ctlen;
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = true;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+
+	for (i = 0; i < 3 && res == true; i++)
+	{
+		ctlen = qsc_kyber_ciphertext_size(params[i]);
+
+		/* the same random stream must give the same output through both apis */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, params[i]);
+		qsc_kyber_encapsulate_ex(ssk1, ct1, pk, qsctest_nistrng_prng_generate, params[i]);
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, params[i]);
+
+		if (qsc_kyber_prepare_publickey(&ppk, pk, params[i]) != true ||
+			qsc_kyber_prepare_privatekey(&psk, sk, params[i]) != true)
+		{
+			qsctest_print_safe("Failure! kyber_prepared_test: key preparation failure -KR1 \n");
+			res = false;
+			break;
+		}
+
+		qsc_kyber_encapsulate_prepared(ssk2, ct2, &ppk, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(ct1, ct2, ctlen) != true ||
+			qsc_intutils_are_equal8(ssk1, ssk2, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+		{
+			qsctest_print_safe("Failure! kyber_prepared_test: prepared encapsulation output mismatch -KR2 \n");
+			res = false;
+			break;
+		}
+
+		for (j = 0; j < QSCTEST_KYBER_NTESTS / 10; j++)
+		{
+			qsc_kyber_encapsulate_prepared(ssk2, ct2, &ppk, qsctest_nistrng_prng_generate);
+
+			if (qsc_kyber_decapsulate_prepared(ssk3, ct2, &psk) != true ||
+				qsc_intutils_are_equal8(ssk2, ssk3, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+			{
+				qsctest_print_safe("Failure! kyber_prepared_test: prepared decapsulation failure -KR3 \n");
+				res = false;
+				break;
+			}
+
+			/* the prepared private key must reject a tampered cipher-text like the packed key */
+			ct2[j] ^= 1;
+
+			if (qsc_kyber_decapsulate_prepared(ssk3, ct2, &psk) == true ||
+				qsc_kyber_decapsulate_ex(ssk1, ct2, sk, params[i]) == true ||
+				qsc_intutils_are_equal8(ssk1, ssk3, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+			{
+				qsctest_print_safe("Failure! kyber_prepared_test: tampered cipher-text handling mismatch -KR4 \n");
+				res = false;
+				break;
+			}
+		}
+
+		qsc_kyber_prepared_privatekey_dispose(&psk);
+
+		/* a disposed key has no parameter set; encapsulation must fail and clear the secret */
+		if (res == true)
+		{
+			qsc_memutils_setvalue(ssk2, sizeof(ssk2), 0xFF);
+			qsc_intutils_clear8(ssk3, sizeof(ssk3));
+
+			if (qsc_kyber_encapsulate_prepared(ssk2, ct2, &psk.ppk, qsctest_nistrng_prng_generate) == true ||
+				qsc_intutils_are_equal8(ssk2, ssk3, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+			{
+				qsctest_print_safe("Failure! kyber_prepared_test: encapsulation with a disposed key was accepted -KR5 \n");
+				res = false;
+			}
+		}
+	}
+
+	return res;
+}
+
+static void kyber_pool_rng(uint8_t* output, size_t length)
+{
+	qsc_csp_generate(output, length);
+}
+
+bool qsctest_kyber_pool_test()
+{
+	uint8_t ct[QSC_KYBER768_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t pk[QSC_KYBER768_PUBLICKEY_SIZE] = { 0 };
+	uint8_t pkp[QSC_KYBER768_PUBLICKEY_SIZE] = { 0 };
+	uint8_t sk[QSC_KYBER768_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t ssk1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ssk2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	qsc_kyberpool_state pool;
+	size_t i;
+	bool res;
+
+	res = true;
+
+	if (qsc_kyberpool_initialize(&pool, 8, 9, KYBER768, kyber_pool_rng) == true)
+	{
+		qsctest_print_safe("Failure! kyber_pool_test: accepted a low-water mark above the depth -KL1 \n");
+		qsc_kyberpool_dispose(&pool);
+		res = false;
+	}
+	else if (qsc_kyberpool_initialize(&pool, 8, 4, KYBER768, kyber_pool_rng) == true)
+	{
+		/* take more keypairs than the pool holds; each must be a fresh and valid keypair */
+		for (i = 0; i < QSCTEST_KYBER_NTESTS / 2; i++)
+		{
+			qsc_kyberpool_take(&pool, pk, sk);
+
+			qsc_kyber_encapsulate_ex(ssk2, ct, pk, kyber_pool_rng, KYBER768);
+
+			if (qsc_kyber_decapsulate_ex(ssk1, ct, sk, KYBER768) != true ||
+				qsc_intutils_are_equal8(ssk1, ssk2, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+			{
+				qsctest_print_safe("Failure! kyber_pool_test: invalid keypair from the pool -KL3 \n");
+				res = false;
+				break;
+			}
+
+			if (qsc_intutils_are_equal8(pk, pkp, sizeof(pk)) == true)
+			{
+				qsctest_print_safe("Failure! kyber_pool_test: a keypair was handed out twice -KL4 \n");
+				res = false;
+				break;
+			}
+
+			qsc_memutils_copy(pkp, pk, sizeof(pk));
+		}
+
+		qsc_kyberpool_dispose(&pool);
+	}
+	else
+	{
+		qsctest_print_safe("Failure! kyber_pool_test: the pool could not be initialized -KL2 \n");
+		res = false;
+	}
+
+	return res;
+}
+
+typedef struct
+{
+	qsc_kyberpool_state* pool;
+	uint8_t* pks;
+	uint8_t* sks;
+} kyber_pool_takers;
+
+static void kyber_pool_taker(size_t index, void* ctx)
+{
+	kyber_pool_takers* takers = (kyber_pool_takers*)ctx;
+	size_t i;
+	size_t pos;
+
+	for (i = 0; i < QSCTEST_KYBER_POOL_TAKES; ++i)
+	{
+		pos = (index * QSCTEST_KYBER_POOL_TAKES) + i;
+		qsc_kyberpool_take(takers->pool, takers->pks + (pos * QSC_KYBER768_PUBLICKEY_SIZE), takers->sks + (pos * QSC_KYBER768_PRIVATEKEY_SIZE));
+	}
+}
+
+bool qsctest_kyber_pool_concurrent_test()
+{
+	uint8_t ct[QSC_KYBER768_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t ssk1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ssk2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	const size_t COUNT = QSCTEST_KYBER_POOL_TAKERS * QSCTEST_KYBER_POOL_TAKES;
+	kyber_pool_takers takers;
+	qsc_kyberpool_state pool;
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = true;
+	takers.pool = &pool;
+	takers.pks = (uint8_t*)malloc(COUNT * QSC_KYBER768_PUBLICKEY_SIZE);
+	takers.sks = (uint8_t*)malloc(COUNT * QSC_KYBER768_PRIVATEKEY_SIZE);
+
+	if (takers.pks != NULL && takers.sks != NULL && qsc_kyberpool_initialize(&pool, 16, 8, KYBER768, kyber_pool_rng) == true)
+	{
+		/* let the worker fill the pool, so the takers contend for ready slots as well as fall back to generating */
+		while (qsc_kyberpool_available(&pool) < 16)
+		{
+		}
+
+		/* several threads take keypairs at once, more than the pool holds */
+		qsc_parallel_state_for(0, QSCTEST_KYBER_POOL_TAKERS, &takers, kyber_pool_taker);
+		qsc_kyberpool_dispose(&pool);
+
+		for (i = 0; i < COUNT && res == true; ++i)
+		{
+			qsc_kyber_encapsulate_ex(ssk2, ct, takers.pks + (i * QSC_KYBER768_PUBLICKEY_SIZE), kyber_pool_rng, KYBER768);
+
+			if (qsc_kyber_decapsulate_ex(ssk1, ct, takers.sks + (i * QSC_KYBER768_PRIVATEKEY_SIZE), KYBER768) != true ||
+				qsc_intutils_are_equal8(ssk1, ssk2, QSC_KYBER_SHAREDSECRET_SIZE) != true)
+			{
+				qsctest_print_safe("Failure! kyber_pool_concurrent_test: invalid keypair from the pool -KC1 \n");
+				res = false;
+			}
+
+			for (j = i + 1; j < COUNT && res == true; ++j)
+			{
+				if (qsc_intutils_are_equal8(takers.pks + (i * QSC_KYBER768_PUBLICKEY_SIZE), takers.pks + (j * QSC_KYBER768_PUBLICKEY_SIZE), QSC_KYBER768_PUBLICKEY_SIZE) == true)
+				{
+					qsctest_print_safe("Failure! kyber_pool_concurrent_test: a keypair was handed out twice -KC2 \n");
+					res = false;
+				}
+			}
+		}
+	}
+	else
+	{
+		qsctest_print_safe("Failure! kyber_pool_concurrent_test: the pool could not be initialized -KC3 \n");
+		res = false;
+	}
+
+	if (takers.pks != NULL)
+	{
+		free(takers.pks);
+	}
+
+	if (takers.sks != NULL)
+	{
+		qsc_intutils_clear8(takers.sks, COUNT * QSC_KYBER768_PRIVATEKEY_SIZE);
+		free(takers.sks);
+	}
+
+	return res;
+}
+
+bool qsctest_kyber_batch_test()
+{
+	uint8_t ct[10 * QSC_KYBER_CIPHERTEXT_MAX_SIZE] = { 0 };
+	uint8_t pk[QSC_KYBER_PUBLICKEY_MAX_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_KYBER_PRIVATEKEY_MAX_SIZE] = { 0 };
+	uint8_t ssb[10 * QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t sse[10 * QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	const qsc_kyber_parameters params[3] = { KYBER512, KYBER768, KYBER1024 };
+	bool valid[10] = { 0 };
+	size_t ctlen;
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = true;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+
+	for (i = 0; i < 3 && res == true; i++)
+	{
+		ctlen = qsc_kyber_ciphertext_size(params[i]);
+		qsc_kyber_generate_keypair_ex(pk, sk, qsctest_nistrng_prng_generate, params[i]);
+
+		/* ten cipher-texts cover two full groups of four and a tail */
+		for (j = 0; j < 10; j++)
+		{
+			qsc_kyber_encapsulate_ex(sse + (j * QSC_KYBER_SHAREDSECRET_SIZE), ct + (j * ctlen), pk, qsctest_nistrng_prng_generate, params[i]);
+		}
+
+		/* tamper with one cipher-text in a group and one in the tail */
+		ct[(5 * ctlen) + 7] ^= 1;
+		ct[(9 * ctlen) + 3] ^= 1;
+		qsc_kyber_decapsulate_ex(sse + (5 * QSC_KYBER_SHAREDSECRET_SIZE), ct + (5 * ctlen), sk, params[i]);
+		qsc_kyber_decapsulate_ex(sse + (9 * QSC_KYBER_SHAREDSECRET_SIZE), ct + (9 * ctlen), sk, params[i]);
+
+		if (qsc_kyber_decapsulate_batch(ssb, valid, ct, 10, sk, params[i]) != 8)
+		{
+			qsctest_print_safe("Failure! kyber_batch_test: wrong number of valid cipher-texts -KB1 \n");
+			res = false;
+			break;
+		}
+
+		for (j = 0; j < 10; j++)
+		{
+			if (valid[j] != (j != 5 && j != 9))
+			{
+				qsctest_print_safe("Failure! kyber_batch_test: wrong decapsulation result -KB2 \n");
+				res = false;
+				break;
+			}
+		}
+
+		/* valid and rejected cipher-texts both match single decapsulation */
+		if (res == true && qsc_intutils_are_equal8(ssb, sse, sizeof(ssb)) != true)
+		{
+			qsctest_print_safe("Failure! kyber_batch_test: shared secrets differ from single decapsulation -KB3 \n");
+			res = false;
+		}
+	}
+
+	return res;
+}
+
 bool qsctest_kyber_privatekey_integrity()
 {
 	uint8_t ct[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
@@ -475,6 +872,51 @@ void qsctest_kyber_run()
 		qsctest_print_safe("Failure! Failed Kyber known answer test. \n \n");
 	}
 
+	if (qsctest_kyber_parameters_test() == true)
+	{
+		qsctest_print_safe("Success! Passed Kyber-512, Kyber-768 and Kyber-1024 runtime parameter test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed Kyber runtime parameter test. \n \n");
+	}
+
+	if (qsctest_kyber_prepared_test() == true)
+	{
+		qsctest_print_safe("Success! Passed Kyber prepared public and private key test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed Kyber prepared key test. \n \n");
+	}
+
+	if (qsctest_kyber_pool_test() == true)
+	{
+		qsctest_print_safe("Success! Passed Kyber keypair pool test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed Kyber keypair pool test. \n \n");
+	}
+
+	if (qsctest_kyber_pool_concurrent_test() == true)
+	{
+		qsctest_print_safe("Success! Passed Kyber keypair pool concurrent take test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed Kyber keypair pool concurrent take test. \n \n");
+	}
+
+	if (qsctest_kyber_batch_test() == true)
+	{
+		qsctest_print_safe("Success! Passed Kyber batch decapsulation test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed Kyber batch decapsulation test. \n \n");
+	}
+
 	if (qsctest_kyber_operations_test() == true)
 	{
 		qsctest_print_safe("Success! Passed key generation, encryption, and decryption stress test. \n");
@@ -33,6 +33,37 @@ bool qsctest_kyber_kat_test();
 */
 bool qsctest_kyber_operations_test();
 
+/**
+* \brief Test the Kyber-512, Kyber-768 and Kyber-1024 parameter sets through the runtime api,
+* against the NIST PQ Round 2 shared secrets
+* \return Returns true for test success
+*/
+bool qsctest_kyber_parameters_test();
+
+/**
+* \brief Test that prepared public and private keys match the packed-key api for every parameter set
+* \return Returns true for test success
+*/
+bool qsctest_kyber_prepared_test();
+
+/**
+* \brief Test that the keypair pool hands out valid keypairs, each only once, including when it runs empty
+* \return Returns true for test success
+*/
+bool qsctest_kyber_pool_test();
+
+/**
+* \brief Test the keypair pool with several threads taking keypairs at once; each keypair must be valid and handed out only once
+* \return Returns true for test success
+*/
+bool qsctest_kyber_pool_concurrent_test();
+
+/**
+* \brief Test batch decapsulation against single decapsulation, including rejected cipher-texts
+* \return Returns true for test success
+*/
+bool qsctest_kyber_batch_test();
+
 /**
 * \brief Test the validity of a mutated secret key in a 100 round loop.
 * \return Returns true for test success
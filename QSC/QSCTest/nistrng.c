@@ -1,6 +1,6 @@
 #include "nistrng.h"
 #include "../QSC/intutils.h"
-#include "rhx.h"
+#include "../QSC/rhx.h"
 
 /*lint -e747 */
 
@@ -1,8 +1,10 @@
 #include "poly1305_test.h"
 #include "common.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/intutils.h"
 #include "../QSC/poly1305.h"
+#include <stdlib.h>
 
 bool qsctest_poly1305_kat()
 {
@@ -13,6 +15,9 @@ bool qsctest_poly1305_kat()
 	uint8_t msg2[12] = { 0 };
 	uint8_t msg3[64] = { 0 };
 	uint8_t msg4[64] = { 0 };
+	uint8_t msg5[128] = { 0 };
+	uint8_t exp5[16] = { 0 };
+	uint8_t key5[32] = { 0 };
 	size_t i;
 	bool status;
 
@@ -92,8 +97,95 @@ bool qsctest_poly1305_kat()
 		status = false;
 	}
 
+	/* with r = 1 the parallel lanes sum to h[1] = 0x3FFFFFF with a carry from the wrapped top limb, and an odd h[2] */
+
+	qsctest_hex_to_bin("0100000000000000000000000000000000000000000000000000000000000000", key5, sizeof(key5));
+	qsctest_hex_to_bin("FFFFFFFFFFFF0F00000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000", msg5, sizeof(msg5));
+	qsctest_hex_to_bin("09000000000020000000000000000000", exp5, sizeof(exp5));
+
+	qsc_intutils_clear8(out, 16);
+	qsc_poly1305_compute(out, msg5, sizeof(msg5), key5);
+
+	if (qsc_intutils_are_equal8(out, exp5, 16) == false)
+	{
+		qsctest_print_safe("Failure! poly1305_kat: MAC output does not match the known answer -PK6 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+#if defined(QSCTEST_POLY1305_WIDE_BLOCK_TESTS)
+bool qsctest_poly1305_wide_equality()
+{
+	const size_t SMPMIN = 8 * QSC_POLY1305_BLOCK_SIZE;
+	uint8_t key[QSC_POLY1305_KEY_SIZE] = { 0 };
+	uint8_t mac1[QSC_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t mac2[QSC_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* msg;
+	qsc_poly1305_state ctx;
+	size_t mlen;
+	size_t moft;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < QSCTEST_POLY1305_TEST_CYCLES)
+	{
+		mlen = 0;
+
+		do
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+		} 
+		while (mlen < SMPMIN);
+
+		msg = (uint8_t*)malloc(mlen);
+
+		if (msg != NULL)
+		{
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(msg, mlen);
+
+			/* the long-form update uses the vectorized path */
+			qsc_poly1305_compute(mac1, msg, mlen, key);
+
+			/* process one block at a time, bypassing the parallel update */
+			qsc_poly1305_initialize(&ctx, key);
+			moft = 0;
+
+			while (mlen - moft >= QSC_POLY1305_BLOCK_SIZE)
+			{
+				qsc_poly1305_blockupdate(&ctx, msg + moft);
+				moft += QSC_POLY1305_BLOCK_SIZE;
+			}
+
+			qsc_poly1305_update(&ctx, msg + moft, mlen - moft);
+			qsc_poly1305_finalize(&ctx, mac2);
+			free(msg);
+
+			if (qsc_intutils_are_equal8(mac1, mac2, QSC_POLY1305_MAC_SIZE) == false)
+			{
+				status = false;
+				break;
+			}
+
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
 	return status;
 }
+#endif
 
 void qsctest_poly1305_run()
 {
@@ -105,4 +197,15 @@ void qsctest_poly1305_run()
 	{
 		qsctest_print_safe("Failure! Failed the Poly1305 KAT tests. \n");
 	}
+
+#if defined(QSCTEST_POLY1305_WIDE_BLOCK_TESTS)
+	if (qsctest_poly1305_wide_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Poly1305 AVX mode equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Poly1305 AVX mode equality test. \n");
+	}
+#endif
 }
@@ -12,6 +12,12 @@
 
 #include "../QSC/common.h"
 
+#define QSCTEST_POLY1305_TEST_CYCLES 100
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSCTEST_POLY1305_WIDE_BLOCK_TESTS
+#endif
+
 /**
 * \brief Tests the Poly1305 implementation.
 *
@@ -22,6 +28,16 @@
 */
 bool qsctest_poly1305_kat();
 
+#if defined(QSCTEST_POLY1305_WIDE_BLOCK_TESTS)
+/**
+* \brief Tests the AVX2 and AVX512 multi-block update for equivalence with the sequential block update.
+* Random length messages are processed with the vectorized api, and compared with the MAC generated one block at a time.
+*
+* \return Returns true for success
+*/
+bool qsctest_poly1305_wide_equality();
+#endif
+
 /**
 * \brief Run all Poly1305 MAC generator tests
 */
@@ -1,8 +1,8 @@
 #include "rhx_test.h"
-#include "../RHX/intutils.h"
-#include "../RHX/sha2.h"
-#include "../RHX/sha3.h"
-#include "../RHX/csp.h"
+#include "../QSC/intutils.h"
+#include "../QSC/sha2.h"
+#include "../QSC/sha3.h"
+#include "../QSC/csp.h"
 #include "testutils.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,6 +12,7 @@
 #define MONTE_CARLO_CYCLES 10000
 #define HBA_TEST_CYCLES 100
 #define RHX_TEST_CYCLES 100
+#define RHX_MULTI_TEST_STREAMS 21
 
 
 static bool aes128_cbc_monte_carlo(const uint8_t* key, const uint8_t* iv, const uint8_t message[4][QSC_RHX_BLOCK_SIZE], const uint8_t expected[4][QSC_RHX_BLOCK_SIZE])
@@ -593,14 +594,626 @@ bool qsctest_fips_aes256_ecb()
 	return aes256_ecb_monte_carlo(key, msg, exp);
 }
 
+static bool aes_gcm_kat(qsc_rhx_cipher_type ctype, const char* key, const char* nonce, const char* aad, const char* msg, const char* expected)
+{
+	uint8_t dec[64] = { 0 };
+	uint8_t enc[64 + QSC_RHX_GCM_MAC_SIZE] = { 0 };
+	uint8_t exp[64 + QSC_RHX_GCM_MAC_SIZE] = { 0 };
+	uint8_t ad[20] = { 0 };
+	uint8_t kb[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t mb[64] = { 0 };
+	uint8_t ncopy[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	uint8_t nb[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	qsc_rhx_gcm_state state;
+	const size_t ADLEN = strlen(aad) / 2;
+	const size_t KEYLEN = strlen(key) / 2;
+	const size_t MSGLEN = strlen(msg) / 2;
+	bool status;
+
+	status = true;
+	qsctest_hex_to_bin(key, kb, KEYLEN);
+	qsctest_hex_to_bin(nonce, ncopy, sizeof(ncopy));
+	qsctest_hex_to_bin(aad, ad, ADLEN);
+	qsctest_hex_to_bin(msg, mb, MSGLEN);
+	qsctest_hex_to_bin(expected, exp, MSGLEN + QSC_RHX_GCM_MAC_SIZE);
+
+	memcpy(nb, ncopy, sizeof(nb));
+	qsc_rhx_keyparams kp = { kb, KEYLEN, nb };
+
+	/* encrypt and compare the cipher-text and tag */
+	qsc_rhx_gcm_initialize(&state, &kp, true, ctype);
+
+	if (ADLEN != 0)
+	{
+		qsc_rhx_gcm_set_associated(&state, ad, ADLEN);
+	}
+
+	qsc_rhx_gcm_transform(&state, enc, mb, MSGLEN);
+
+	if (qsc_intutils_are_equal8(enc, exp, MSGLEN + QSC_RHX_GCM_MAC_SIZE) == false)
+	{
+		status = false;
+	}
+
+	/* reset the nonce and decrypt, setting the associated data in two segments that split a block */
+	memcpy(nb, ncopy, sizeof(nb));
+	qsc_rhx_gcm_initialize(&state, &kp, false, ctype);
+
+	if (ADLEN != 0)
+	{
+		qsc_rhx_gcm_set_associated(&state, ad, ADLEN / 4);
+		qsc_rhx_gcm_set_associated(&state, ad + (ADLEN / 4), ADLEN - (ADLEN / 4));
+	}
+
+	if (qsc_rhx_gcm_transform(&state, dec, enc, MSGLEN) == false)
+	{
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(dec, mb, MSGLEN) == false)
+	{
+		status = false;
+	}
+
+	qsc_rhx_gcm_dispose(&state);
+
+	return status;
+}
+
+bool qsctest_aes128_gcm_kat()
+{
+	bool status;
+
+	/* GCM specification, test case 2 */
+	status = aes_gcm_kat(AES128,
+		"00000000000000000000000000000000",
+		"000000000000000000000000",
+		"",
+		"00000000000000000000000000000000",
+		"0388DACE60B6A392F328C2B971B2FE78AB6E47D42CEC13BDF53A67B21257BDDF");
+
+	/* test case 4 */
+	if (aes_gcm_kat(AES128,
+		"FEFFE9928665731C6D6A8F9467308308",
+		"CAFEBABEFACEDBADDECAF888",
+		"FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2",
+		"D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39",
+		"42831EC2217774244B7221B784D0D49CE3AA212F2C02A4E035C17E2329ACA12E21D514B25466931C7D8F6A5AAC84AA051BA30B396A0AAC973D58E091"
+		"5BC94FBC3221A5DB94FAE95AE7121A47") == false)
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_aes256_gcm_kat()
+{
+	bool status;
+
+	/* GCM specification, test case 14 */
+	status = aes_gcm_kat(AES256,
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"000000000000000000000000",
+		"",
+		"00000000000000000000000000000000",
+		"CEA7403D4D606B6E074EC5D3BAF39D18D0D1C8A799996BF0265B98B5D48AB919");
+
+	/* test case 16 */
+	if (aes_gcm_kat(AES256,
+		"FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308",
+		"CAFEBABEFACEDBADDECAF888",
+		"FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2",
+		"D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39",
+		"522DC1F099567D07F47F37A32A84427D643A8CDCBFE5C0C97598A2BD2555D1AA8CB08E48590DBB3DA7B08B1056828838C5F61E6393BA7A0ABCC9F662"
+		"76FC6ECE0F4E1768CDDF8853BB2D551B") == false)
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_aes256_gcm_long_kat()
+{
+	uint8_t ad[270] = { 0 };
+	uint8_t dec[280] = { 0 };
+	uint8_t enc[280 + QSC_RHX_GCM_MAC_SIZE] = { 0 };
+	uint8_t exp[280 + QSC_RHX_GCM_MAC_SIZE] = { 0 };
+	uint8_t kb[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t msg[280] = { 0 };
+	uint8_t ncopy[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	uint8_t nb[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	qsc_rhx_gcm_state state;
+	size_t i;
+	bool status;
+
+	/* the GCM specification test case 16 key and nonce, with a 270 byte associated data string (0xFF, 0xFE, ..)
+	   and a 280 byte message (0x00, 0x01, ..), both longer than 16 blocks; the expected output was generated with OpenSSL */
+	qsctest_hex_to_bin("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308", kb, sizeof(kb));
+	qsctest_hex_to_bin("CAFEBABEFACEDBADDECAF888", ncopy, sizeof(ncopy));
+	qsctest_hex_to_bin("8B1DF1D665D77DE5592F346D897C6AE8F28C379CBEC4210443CD889BB37945C7B0ADA0FEE8409449A056AF1F3309133244ADC1A50D82AA6A3E93B760"
+		"AF12F9C724EE3915A4A83B0D00DCC456BAB5AEA08CCFBCE7BF43FF5E032E478D049947AA079AF6EB7E11F5143D36B7161C5AA3C2F0FF1BCC1ABE72B8"
+		"D64A51D469F49A2C3C18B3626061ABA40267453583A5C2D0DAC05BF17B416CA2CF8FEA3AA56510E65C50D9373CA33D90F9BC09DB6A51D324FDEEABE1"
+		"1AEFCBA64855A71EC040796D18DDE7D762C2CA6565BB417B2A4C248A471F0A3E8CD6F0209277676D12AEA445551FF7074723AF1EDD0496221201B4BE"
+		"171DC98DEA776B7978952F04B848CAB27D7BD096DFDE0E88C14506B7349678B69ECC2FEDED500776"
+		"4BA4908CE9572C75BBF1F42634819A65", exp, sizeof(exp));
+
+	for (i = 0; i < sizeof(ad); ++i)
+	{
+		ad[i] = (uint8_t)(0xFF - i);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)i;
+	}
+
+	status = true;
+	memcpy(nb, ncopy, sizeof(nb));
+	qsc_rhx_keyparams kp = { kb, sizeof(kb), nb };
+
+	/* encrypt with the associated data set in one call */
+	qsc_rhx_gcm_initialize(&state, &kp, true, AES256);
+	qsc_rhx_gcm_set_associated(&state, ad, sizeof(ad));
+	qsc_rhx_gcm_transform(&state, enc, msg, sizeof(msg));
+
+	if (qsc_intutils_are_equal8(enc, exp, sizeof(exp)) == false)
+	{
+		status = false;
+	}
+
+	/* encrypt again, setting the associated data in unaligned segments */
+	memcpy(nb, ncopy, sizeof(nb));
+	qsc_intutils_clear8(enc, sizeof(enc));
+	qsc_rhx_gcm_initialize(&state, &kp, true, AES256);
+	qsc_rhx_gcm_set_associated(&state, ad, 5);
+	qsc_rhx_gcm_set_associated(&state, ad + 5, 11);
+	qsc_rhx_gcm_set_associated(&state, ad + 16, 1);
+	qsc_rhx_gcm_set_associated(&state, ad + 17, sizeof(ad) - 17);
+	qsc_rhx_gcm_transform(&state, enc, msg, sizeof(msg));
+
+	if (qsc_intutils_are_equal8(enc, exp, sizeof(exp)) == false)
+	{
+		status = false;
+	}
+
+	/* reset the nonce and decrypt */
+	memcpy(nb, ncopy, sizeof(nb));
+	qsc_rhx_gcm_initialize(&state, &kp, false, AES256);
+	qsc_rhx_gcm_set_associated(&state, ad, 100);
+	qsc_rhx_gcm_set_associated(&state, ad + 100, sizeof(ad) - 100);
+
+	if (qsc_rhx_gcm_transform(&state, dec, enc, sizeof(msg)) == false)
+	{
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(dec, msg, sizeof(msg)) == false)
+	{
+		status = false;
+	}
+
+	qsc_rhx_gcm_dispose(&state);
+
+	return status;
+}
+
+bool qsctest_aes_gcm_stress()
+{
+	uint8_t aad[20] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t key[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t* msg;
+	uint8_t ncopy[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_GCM_NONCE_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint16_t mlen;
+	size_t tctr;
+	bool status;
+	qsc_rhx_gcm_state state;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES)
+	{
+		mlen = 0;
+
+		while (mlen == 0)
+		{
+			/* unlikely but this could return zero */
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+		}
+
+		dec = (uint8_t*)malloc(mlen);
+		enc = (uint8_t*)malloc(mlen + QSC_RHX_GCM_MAC_SIZE);
+		msg = (uint8_t*)malloc(mlen);
+
+		if (dec != NULL && enc != NULL && msg != NULL)
+		{
+			qsc_intutils_clear8(dec, mlen);
+			qsc_intutils_clear8(enc, mlen + QSC_RHX_GCM_MAC_SIZE);
+			qsc_csp_generate(aad, sizeof(aad));
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(ncopy, sizeof(ncopy));
+			qsc_csp_generate(msg, mlen);
+			memcpy(nonce, ncopy, sizeof(nonce));
+
+			qsc_rhx_keyparams kp = { key, sizeof(key), nonce };
+
+			/* encrypt the message */
+			qsc_rhx_gcm_initialize(&state, &kp, true, AES256);
+			qsc_rhx_gcm_set_associated(&state, aad, sizeof(aad));
+
+			if (qsc_rhx_gcm_transform(&state, enc, msg, mlen) == false)
+			{
+				status = false;
+			}
+
+			/* reset the nonce and decrypt the message */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_rhx_gcm_initialize(&state, &kp, false, AES256);
+			qsc_rhx_gcm_set_associated(&state, aad, sizeof(aad));
+
+			if (qsc_rhx_gcm_transform(&state, dec, enc, mlen) == false)
+			{
+				status = false;
+			}
+
+			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			{
+				status = false;
+			}
+
+			/* a modified tag must be rejected */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_rhx_gcm_initialize(&state, &kp, false, AES256);
+			qsc_rhx_gcm_set_associated(&state, aad, sizeof(aad));
+			enc[mlen] ^= 0x01;
+
+			if (qsc_rhx_gcm_transform(&state, dec, enc, mlen) == true)
+			{
+				status = false;
+			}
+
+			qsc_rhx_gcm_dispose(&state);
+			free(dec);
+			free(enc);
+			free(msg);
+
+			if (status == false)
+			{
+				break;
+			}
+
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+static bool aes_xts_kat(qsc_rhx_cipher_type ctype, const char* key, const char* sector, const char* msg, const char* expected)
+{
+	uint8_t dec[256] = { 0 };
+	uint8_t enc[256] = { 0 };
+	uint8_t exp[256] = { 0 };
+	uint8_t kb[2 * QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t mb[256] = { 0 };
+	uint8_t sb[QSC_RHX_BLOCK_SIZE] = { 0 };
+	qsc_rhx_xts_state state;
+	const size_t KEYLEN = strlen(key) / 2;
+	const size_t MSGLEN = strlen(msg) / 2;
+	bool status;
+
+	status = true;
+	qsctest_hex_to_bin(key, kb, KEYLEN);
+	qsctest_hex_to_bin(sector, sb, sizeof(sb));
+	qsctest_hex_to_bin(msg, mb, MSGLEN);
+	qsctest_hex_to_bin(expected, exp, MSGLEN);
+
+	qsc_rhx_keyparams kp = { kb, KEYLEN };
+
+	/* encrypt and compare the cipher-text */
+	qsc_rhx_xts_initialize(&state, &kp, true, ctype);
+
+	if (qsc_rhx_xts_transform(&state, enc, mb, MSGLEN, sb) == false)
+	{
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(enc, exp, MSGLEN) == false)
+	{
+		status = false;
+	}
+
+	/* decrypt in-place */
+	qsc_rhx_xts_initialize(&state, &kp, false, ctype);
+	memcpy(dec, enc, MSGLEN);
+
+	if (qsc_rhx_xts_transform(&state, dec, dec, MSGLEN, sb) == false)
+	{
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(dec, mb, MSGLEN) == false)
+	{
+		status = false;
+	}
+
+	qsc_rhx_xts_dispose(&state);
+
+	return status;
+}
+
+bool qsctest_aes128_xts_kat()
+{
+	bool status;
+
+	/* IEEE 1619, vector 2 */
+	status = aes_xts_kat(AES128,
+		"1111111111111111111111111111111122222222222222222222222222222222",
+		"33333333330000000000000000000000",
+		"4444444444444444444444444444444444444444444444444444444444444444",
+		"C454185E6A16936E39334038ACEF838BFB186FFF7480ADC4289382ECD6D394F0");
+
+	/* vector 15, ciphertext stealing */
+	if (aes_xts_kat(AES128,
+		"FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0",
+		"9A785634120000000000000000000000",
+		"000102030405060708090A0B0C0D0E0F10",
+		"6C1625DB4671522D3D7599601DE7CA09ED") == false)
+	{
+		status = false;
+	}
+
+	/* vector 16 */
+	if (aes_xts_kat(AES128,
+		"FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0",
+		"9A785634120000000000000000000000",
+		"000102030405060708090A0B0C0D0E0F10111213",
+		"9D84C813F719AA2C7BE3F66171C7C5C2EDBF9DAC") == false)
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_aes256_xts_kat()
+{
+	bool status;
+
+	/* IEEE 1619, vector 10, the first 256 bytes of the data unit */
+	status = aes_xts_kat(AES256,
+		"2718281828459045235360287471352662497757247093699959574966967627"
+		"3141592653589793238462643383279502884197169399375105820974944592",
+		"FF000000000000000000000000000000",
+		"000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F202122232425262728292A2B2C2D2E2F303132333435363738393A3B"
+		"3C3D3E3F404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F606162636465666768696A6B6C6D6E6F7071727374757677"
+		"78797A7B7C7D7E7F808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9FA0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3"
+		"B4B5B6B7B8B9BABBBCBDBEBFC0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDFE0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+		"F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF",
+		"1C3B3A102F770386E4836C99E370CF9BEA00803F5E482357A4AE12D414A3E63B5D31E276F8FE4A8D66B317F9AC683F44680A86AC35ADFC3345BEFECB"
+		"4BB188FD5776926C49A3095EB108FD1098BAEC70AAA66999A72A82F27D848B21D4A741B0C5CD4D5FFF9DAC89AEBA122961D03A757123E9870F8ACF10"
+		"00020887891429CA2A3E7A7D7DF7B10355165C8B9A6D0A7DE8B062C4500DC4CD120C0F7418DAE3D0B5781C34803FA75421C790DFE1DE1834F280D766"
+		"7B327F6C8CD7557E12AC3A0F93EC05C52E0493EF31A12D3D9260F79A289D6A379BC70C50841473D1A8CC81EC583E9645E07B8D9670655BA5BBCFECC6"
+		"DC3966380AD8FECB17B6BA02469A020A");
+
+	return status;
+}
+
+bool qsctest_rhx_xts_stress()
+{
+	const qsc_rhx_cipher_type ctypes[2] = { RHX256, RHX512 };
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t key[2 * QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t* msg;
+	uint8_t sector[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	qsc_rhx_xts_state state;
+	size_t klen;
+	size_t mlen;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES)
+	{
+		mlen = 0;
+
+		/* a random sized data unit, 16-65535 bytes */
+		do
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+		}
+		while (mlen < QSC_RHX_BLOCK_SIZE);
+
+		klen = (ctypes[tctr % 2] == RHX256) ? 2 * QSC_RHX256_KEY_SIZE : 2 * QSC_RHX512_KEY_SIZE;
+		dec = (uint8_t*)malloc(mlen);
+		enc = (uint8_t*)malloc(mlen);
+		msg = (uint8_t*)malloc(mlen);
+
+		if (dec != NULL && enc != NULL && msg != NULL)
+		{
+			qsc_csp_generate(key, klen);
+			qsc_csp_generate(sector, sizeof(sector));
+			qsc_csp_generate(msg, mlen);
+
+			qsc_rhx_keyparams kp = { key, klen };
+
+			/* encrypt the data unit */
+			qsc_rhx_xts_initialize(&state, &kp, true, ctypes[tctr % 2]);
+
+			if (qsc_rhx_xts_transform(&state, enc, msg, mlen, sector) == false)
+			{
+				status = false;
+			}
+
+			/* decrypt in-place and compare */
+			qsc_rhx_xts_initialize(&state, &kp, false, ctypes[tctr % 2]);
+			memcpy(dec, enc, mlen);
+
+			if (qsc_rhx_xts_transform(&state, dec, dec, mlen, sector) == false)
+			{
+				status = false;
+			}
+
+			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			{
+				status = false;
+			}
+
+			/* a different sector must produce a different cipher-text */
+			qsc_rhx_xts_initialize(&state, &kp, true, ctypes[tctr % 2]);
+			sector[0] ^= 0x01;
+			qsc_rhx_xts_transform(&state, dec, msg, mlen, sector);
+
+			if (qsc_intutils_are_equal8(dec, enc, mlen) == true)
+			{
+				status = false;
+			}
+
+			qsc_rhx_xts_dispose(&state);
+			free(dec);
+			free(enc);
+			free(msg);
+
+			if (status == false)
+			{
+				break;
+			}
+
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
 bool qsctest_rhx256_cbc_stress()
 {
 	uint8_t* dec;
 	uint8_t* enc;
-	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t* msg;
+	uint8_t iv[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t ivcopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	qsc_rhx_state state1;
+	qsc_rhx_state state2;
+	size_t mlen;
+	size_t elen;
+	size_t outlen;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES)
+	{
+		mlen = 0;
+		outlen = 0;
+
+		do
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+
+			if (mlen < QSC_RHX_BLOCK_SIZE)
+			{
+				mlen = 0;
+			}
+		}
+		while (mlen == 0);
+
+		elen = (mlen % QSC_RHX_BLOCK_SIZE) == 0 ? mlen : mlen + (QSC_RHX_BLOCK_SIZE - (mlen % QSC_RHX_BLOCK_SIZE));
+		dec = (uint8_t*)malloc(mlen);
+		enc = (uint8_t*)malloc(elen);
+		msg = (uint8_t*)malloc(mlen);
+
+		if (dec != NULL && enc != NULL && msg != NULL)
+		{
+			qsc_intutils_clear8(dec, mlen);
+			qsc_intutils_clear8(enc, elen);
+			qsc_intutils_clear8(msg, mlen);
+
+			/* generate the key and iv */
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(ivcopy, sizeof(ivcopy));
+			/* use a random sized message 1-65535 */
+			qsc_csp_generate(msg, mlen);
+
+			memcpy(iv, ivcopy, sizeof(ivcopy));
+			qsc_rhx_keyparams kp1 = { key, sizeof(key), iv, NULL, 0 };
+
+			/* encrypt the message */
+			qsc_rhx_initialize(&state1, &kp1, true, RHX256);
+			qsc_rhx_cbc_encrypt(&state1, enc, msg, mlen);
+
+			/* erase the round-key array and reset the state */
+			qsc_rhx_dispose(&state1);
+
+			/* reset the iv */
+			memcpy(iv, ivcopy, sizeof(ivcopy));
+			qsc_rhx_keyparams kp2 = { key, sizeof(key), iv, NULL, 0 };
+
+			/* decrypt the message */
+			qsc_rhx_initialize(&state2, &kp2, false, RHX256);
+			qsc_rhx_cbc_decrypt(&state2, dec, &outlen, enc, elen);
+
+			/* erase the round-key array and reset the state */
+			qsc_rhx_dispose(&state2);
+
+			/* compare decryption output to message */
+			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			{
+				status = false;
+				break;
+			}
+
+			/* reset the state */
+			free(dec);
+			free(enc);
+			free(msg);
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_rhx512_cbc_stress()
+{
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
 	uint8_t* msg;
-	uint8_t iv[QSC_RHX_BLOCK_SIZE] = { 0 };
 	uint8_t ivcopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t iv[QSC_RHX_BLOCK_SIZE] = { 0 };
 	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
 	qsc_rhx_state state1;
 	qsc_rhx_state state2;
@@ -627,7 +1240,7 @@ bool qsctest_rhx256_cbc_stress()
 			{
 				mlen = 0;
 			}
-		}
+		} 
 		while (mlen == 0);
 
 		elen = (mlen % QSC_RHX_BLOCK_SIZE) == 0 ? mlen : mlen + (QSC_RHX_BLOCK_SIZE - (mlen % QSC_RHX_BLOCK_SIZE));
@@ -651,7 +1264,7 @@ bool qsctest_rhx256_cbc_stress()
 			qsc_rhx_keyparams kp1 = { key, sizeof(key), iv, NULL, 0 };
 
 			/* encrypt the message */
-			qsc_rhx_initialize(&state1, &kp1, true, RHX256);
+			qsc_rhx_initialize(&state1, &kp1, true, RHX512);
 			qsc_rhx_cbc_encrypt(&state1, enc, msg, mlen);
 
 			/* erase the round-key array and reset the state */
@@ -662,7 +1275,7 @@ bool qsctest_rhx256_cbc_stress()
 			qsc_rhx_keyparams kp2 = { key, sizeof(key), iv, NULL, 0 };
 
 			/* decrypt the message */
-			qsc_rhx_initialize(&state2, &kp2, false, RHX256);
+			qsc_rhx_initialize(&state2, &kp2, false, RHX512);
 			qsc_rhx_cbc_decrypt(&state2, dec, &outlen, enc, elen);
 
 			/* erase the round-key array and reset the state */
@@ -691,19 +1304,18 @@ bool qsctest_rhx256_cbc_stress()
 	return status;
 }
 
-bool qsctest_rhx512_cbc_stress()
+bool qsctest_rhx256_cbc_parallel_equality()
 {
-	uint8_t* dec;
+	uint8_t* dec1;
+	uint8_t* dec2;
 	uint8_t* enc;
-	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
-	uint8_t* msg;
-	uint8_t ivcopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
 	uint8_t iv[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t ivcopy[QSC_RHX_BLOCK_SIZE] = { 0 };
 	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
-	qsc_rhx_state state1;
-	qsc_rhx_state state2;
-	size_t mlen;
+	qsc_rhx_state state;
 	size_t elen;
+	size_t i;
 	size_t outlen;
 	size_t tctr;
 	bool status;
@@ -713,60 +1325,239 @@ bool qsctest_rhx512_cbc_stress()
 
 	while (tctr < RHX_TEST_CYCLES)
 	{
-		mlen = 0;
+		elen = 0;
 		outlen = 0;
 
+		/* a random number of whole blocks, exercising the wide, parallel, and serial loops */
 		do
 		{
 			qsc_csp_generate(pmcnt, sizeof(pmcnt));
-			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			memcpy(&elen, pmcnt, sizeof(uint16_t));
+			elen -= (elen % QSC_RHX_BLOCK_SIZE);
+		}
+		while (elen == 0);
 
-			if (mlen < QSC_RHX_BLOCK_SIZE)
+		dec1 = (uint8_t*)malloc(elen);
+		dec2 = (uint8_t*)malloc(elen);
+		enc = (uint8_t*)malloc(elen);
+
+		if (dec1 != NULL && dec2 != NULL && enc != NULL)
+		{
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(ivcopy, sizeof(ivcopy));
+			qsc_csp_generate(enc, elen);
+
+			/* the reference; decrypt the cipher-text one block at a time */
+			memcpy(iv, ivcopy, sizeof(ivcopy));
+			qsc_rhx_keyparams kp1 = { key, sizeof(key), iv, NULL, 0 };
+			qsc_rhx_initialize(&state, &kp1, false, RHX256);
+
+			for (i = 0; i < elen; i += QSC_RHX_BLOCK_SIZE)
 			{
-				mlen = 0;
+				qsc_rhx_cbc_decrypt_block(&state, dec1 + i, enc + i);
+			}
+
+			qsc_rhx_dispose(&state);
+
+			/* decrypt the cipher-text in-place with the parallel decryption function */
+			memcpy(dec2, enc, elen);
+			memcpy(iv, ivcopy, sizeof(ivcopy));
+			qsc_rhx_keyparams kp2 = { key, sizeof(key), iv, NULL, 0 };
+			qsc_rhx_initialize(&state, &kp2, false, RHX256);
+			qsc_rhx_cbc_decrypt(&state, dec2, &outlen, dec2, elen);
+			qsc_rhx_dispose(&state);
+
+			/* the final block is removed as padding, compare the blocks that precede it */
+			if (qsc_intutils_are_equal8(dec1, dec2, elen - QSC_RHX_BLOCK_SIZE) == false)
+			{
+				status = false;
+			}
+
+			free(dec1);
+			free(dec2);
+			free(enc);
+
+			if (status == false)
+			{
+				break;
+			}
+
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_rhx256_cbc_multi_equality()
+{
+	uint8_t keys[RHX_MULTI_TEST_STREAMS][QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t ivs1[RHX_MULTI_TEST_STREAMS][QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t ivs2[RHX_MULTI_TEST_STREAMS][QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint8_t)] = { 0 };
+	uint8_t* enc1[RHX_MULTI_TEST_STREAMS] = { NULL };
+	uint8_t* enc2[RHX_MULTI_TEST_STREAMS] = { NULL };
+	const uint8_t* msgp[RHX_MULTI_TEST_STREAMS] = { NULL };
+	qsc_rhx_state* statep[RHX_MULTI_TEST_STREAMS] = { NULL };
+	qsc_rhx_state states1[RHX_MULTI_TEST_STREAMS];
+	qsc_rhx_state states2[RHX_MULTI_TEST_STREAMS];
+	uint8_t* msg;
+	size_t i;
+	size_t mlen;
+	size_t oft;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES && status == true)
+	{
+		/* a random number of blocks, 1-256, per stream */
+		qsc_csp_generate(pmcnt, sizeof(pmcnt));
+		mlen = ((size_t)pmcnt[0] + 1) * QSC_RHX_BLOCK_SIZE;
+		msg = (uint8_t*)malloc(mlen * RHX_MULTI_TEST_STREAMS * 3);
+
+		if (msg != NULL)
+		{
+			qsc_csp_generate(msg, mlen * RHX_MULTI_TEST_STREAMS);
+			qsc_csp_generate((uint8_t*)keys, sizeof(keys));
+			qsc_csp_generate((uint8_t*)ivs1, sizeof(ivs1));
+			memcpy(ivs2, ivs1, sizeof(ivs1));
+
+			for (i = 0; i < RHX_MULTI_TEST_STREAMS; ++i)
+			{
+				qsc_rhx_keyparams kp1 = { keys[i], QSC_RHX256_KEY_SIZE, ivs1[i], NULL, 0 };
+				qsc_rhx_keyparams kp2 = { keys[i], QSC_RHX256_KEY_SIZE, ivs2[i], NULL, 0 };
+
+				msgp[i] = msg + (i * mlen);
+				enc1[i] = msg + ((RHX_MULTI_TEST_STREAMS + i) * mlen);
+				enc2[i] = msg + (((2 * RHX_MULTI_TEST_STREAMS) + i) * mlen);
+				qsc_rhx_initialize(&states1[i], &kp1, true, RHX256);
+				qsc_rhx_initialize(&states2[i], &kp2, true, RHX256);
+				statep[i] = &states2[i];
+			}
+
+			/* the reference; each stream encrypted serially */
+			for (i = 0; i < RHX_MULTI_TEST_STREAMS; ++i)
+			{
+				for (oft = 0; oft < mlen; oft += QSC_RHX_BLOCK_SIZE)
+				{
+					qsc_rhx_cbc_encrypt_block(&states1[i], enc1[i] + oft, msgp[i] + oft);
+				}
+			}
+
+			/* all streams in lock-step, in two calls to test the chaining vector carry-over */
+			qsc_rhx_cbc_encrypt_multi(statep, enc2, msgp, QSC_RHX_BLOCK_SIZE, RHX_MULTI_TEST_STREAMS);
+
+			for (i = 0; i < RHX_MULTI_TEST_STREAMS; ++i)
+			{
+				msgp[i] += QSC_RHX_BLOCK_SIZE;
+				enc2[i] += QSC_RHX_BLOCK_SIZE;
+			}
+
+			qsc_rhx_cbc_encrypt_multi(statep, enc2, msgp, mlen - QSC_RHX_BLOCK_SIZE, RHX_MULTI_TEST_STREAMS);
+
+			for (i = 0; i < RHX_MULTI_TEST_STREAMS; ++i)
+			{
+				if (qsc_intutils_are_equal8(enc1[i], enc2[i] - QSC_RHX_BLOCK_SIZE, mlen) == false ||
+					qsc_intutils_are_equal8(ivs1[i], ivs2[i], QSC_RHX_BLOCK_SIZE) == false)
+				{
+					status = false;
+				}
+
+				qsc_rhx_dispose(&states1[i]);
+				qsc_rhx_dispose(&states2[i]);
 			}
+
+			free(msg);
+			++tctr;
+		}
+		else
+		{
+			status = false;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_rhx256_ctr_stress()
+{
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t* msg;
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	qsc_rhx_state state1;
+	qsc_rhx_state state2;
+	size_t mlen;
+	size_t tctr;
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES)
+	{
+		mlen = 0;
+
+		do
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
 		} 
 		while (mlen == 0);
 
-		elen = (mlen % QSC_RHX_BLOCK_SIZE) == 0 ? mlen : mlen + (QSC_RHX_BLOCK_SIZE - (mlen % QSC_RHX_BLOCK_SIZE));
 		dec = (uint8_t*)malloc(mlen);
-		enc = (uint8_t*)malloc(elen);
+		enc = (uint8_t*)malloc(mlen);
 		msg = (uint8_t*)malloc(mlen);
 
 		if (dec != NULL && enc != NULL && msg != NULL)
 		{
 			qsc_intutils_clear8(dec, mlen);
-			qsc_intutils_clear8(enc, elen);
+			qsc_intutils_clear8(enc, mlen);
 			qsc_intutils_clear8(msg, mlen);
 
-			/* generate the key and iv */
+			/* generate the key and nonce */
 			qsc_csp_generate(key, sizeof(key));
-			qsc_csp_generate(ivcopy, sizeof(ivcopy));
+			qsc_csp_generate(ncopy, sizeof(ncopy));
 			/* use a random sized message 1-65535 */
 			qsc_csp_generate(msg, mlen);
 
-			memcpy(iv, ivcopy, sizeof(ivcopy));
-			qsc_rhx_keyparams kp1 = { key, sizeof(key), iv, NULL, 0 };
+			/* initialize the key parameters struct, info is optional */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce, NULL, 0 };
 
-			/* encrypt the message */
-			qsc_rhx_initialize(&state1, &kp1, true, RHX512);
-			qsc_rhx_cbc_encrypt(&state1, enc, msg, mlen);
+			/* initialize the state */
+			qsc_rhx_initialize(&state1, &kp1, true, RHX256);
+
+			/* encrypt the array */
+			qsc_rhx_ctrbe_transform(&state1, enc, msg, mlen);
 
 			/* erase the round-key array and reset the state */
 			qsc_rhx_dispose(&state1);
 
-			/* reset the iv */
-			memcpy(iv, ivcopy, sizeof(ivcopy));
-			qsc_rhx_keyparams kp2 = { key, sizeof(key), iv, NULL, 0 };
+			/* reset the nonce */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce, NULL, 0 };
 
-			/* decrypt the message */
-			qsc_rhx_initialize(&state2, &kp2, false, RHX512);
-			qsc_rhx_cbc_decrypt(&state2, dec, &outlen, enc, elen);
+			/* initialize the state; CTR mode is always initialized as encrypt equals true */
+			qsc_rhx_initialize(&state2, &kp2, true, RHX256);
+
+			/* test decryption by using ciphertest as input */
+			qsc_rhx_ctrbe_transform(&state2, dec, enc, mlen);
 
 			/* erase the round-key array and reset the state */
 			qsc_rhx_dispose(&state2);
 
-			/* compare decryption output to message */
 			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
 			{
 				status = false;
@@ -789,11 +1580,11 @@ bool qsctest_rhx512_cbc_stress()
 	return status;
 }
 
-bool qsctest_rhx256_ctr_stress()
+bool qsctest_rhx512_ctr_stress()
 {
 	uint8_t* dec;
 	uint8_t* enc;
-	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
 	uint8_t* msg;
 	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
 	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
@@ -839,137 +1630,270 @@ bool qsctest_rhx256_ctr_stress()
 			qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce, NULL, 0 };
 
 			/* initialize the state */
-			qsc_rhx_initialize(&state1, &kp1, true, RHX256);
+			qsc_rhx_initialize(&state1, &kp1, true, RHX512);
+
+			/* encrypt the array */
+			qsc_rhx_ctrbe_transform(&state1, enc, msg, mlen);
+
+			/* erase the round-key array and reset the state */
+			qsc_rhx_dispose(&state1);
+
+			/* reset the nonce */
+			memcpy(nonce, ncopy, sizeof(nonce));
+			qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce, NULL, 0 };
+
+			/* initialize the state; CTR mode is always initialized as encrypt equals true */
+			qsc_rhx_initialize(&state2, &kp2, true, RHX512);
+
+			/* test decryption by using ciphertest as input */
+			qsc_rhx_ctrbe_transform(&state2, dec, enc, mlen);
+
+			/* erase the round-key array and reset the state */
+			qsc_rhx_dispose(&state2);
+
+			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			{
+				status = false;
+				break;
+			}
+
+			/* reset the state */
+			free(dec);
+			free(enc);
+			free(msg);
+			++tctr;
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_rhx512_ctr_ecb_equality()
+{
+	uint8_t ctrb[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t ctrl[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t ks[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* encb;
+	uint8_t* encl;
+	uint8_t* expb;
+	uint8_t* expl;
+	uint8_t* msg;
+	qsc_rhx_state state;
+	size_t i;
+	size_t mlen;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < RHX_TEST_CYCLES && status == true)
+	{
+		/* a random length 1-4095, with a partial final block */
+		mlen = 0;
+
+		while (mlen == 0)
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			mlen &= 0x0FFF;
+		}
+
+		encb = (uint8_t*)malloc(mlen);
+		encl = (uint8_t*)malloc(mlen);
+		expb = (uint8_t*)malloc(mlen);
+		expl = (uint8_t*)malloc(mlen);
+		msg = (uint8_t*)malloc(mlen);
+
+		if (encb != NULL && encl != NULL && expb != NULL && expl != NULL && msg != NULL)
+		{
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(nonce, sizeof(nonce));
+			qsc_csp_generate(msg, mlen);
+
+			/* start at a carry boundary for both byte orders */
+			nonce[0] = 0xFF;
+			nonce[1] = 0xFF;
+			nonce[QSC_RHX_BLOCK_SIZE - 2] = 0xFF;
+			nonce[QSC_RHX_BLOCK_SIZE - 1] = 0xFF;
+			memcpy(ctrb, nonce, sizeof(ctrb));
+			memcpy(ctrl, nonce, sizeof(ctrl));
+
+			qsc_rhx_keyparams kp = { key, sizeof(key), ctrb };
+			qsc_rhx_initialize(&state, &kp, true, RHX512);
 
-			/* encrypt the array */
-			qsc_rhx_ctrbe_transform(&state1, enc, msg, mlen);
+			/* the reference key-stream, one counter block at a time */
+			for (i = 0; i < mlen; ++i)
+			{
+				if (i % QSC_RHX_BLOCK_SIZE == 0)
+				{
+					qsc_rhx_ecb_encrypt_block(&state, ks, ctrb);
+					qsc_intutils_be8increment(ctrb, QSC_RHX_BLOCK_SIZE);
+				}
 
-			/* erase the round-key array and reset the state */
-			qsc_rhx_dispose(&state1);
+				expb[i] = msg[i] ^ ks[i % QSC_RHX_BLOCK_SIZE];
+			}
 
-			/* reset the nonce */
-			memcpy(nonce, ncopy, sizeof(nonce));
-			qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce, NULL, 0 };
+			for (i = 0; i < mlen; ++i)
+			{
+				if (i % QSC_RHX_BLOCK_SIZE == 0)
+				{
+					qsc_rhx_ecb_encrypt_block(&state, ks, ctrl);
+					qsc_intutils_le8increment(ctrl, QSC_RHX_BLOCK_SIZE);
+				}
 
-			/* initialize the state; CTR mode is always initialized as encrypt equals true */
-			qsc_rhx_initialize(&state2, &kp2, true, RHX256);
+				expl[i] = msg[i] ^ ks[i % QSC_RHX_BLOCK_SIZE];
+			}
 
-			/* test decryption by using ciphertest as input */
-			qsc_rhx_ctrbe_transform(&state2, dec, enc, mlen);
+			/* the counter mode functions, these must also leave the nonce at the next counter */
+			memcpy(ks, nonce, sizeof(ks));
+			state.nonce = ks;
+			qsc_rhx_ctrbe_transform(&state, encb, msg, mlen);
 
-			/* erase the round-key array and reset the state */
-			qsc_rhx_dispose(&state2);
+			if (qsc_intutils_are_equal8(encb, expb, mlen) == false ||
+				qsc_intutils_are_equal8(ks, ctrb, QSC_RHX_BLOCK_SIZE) == false)
+			{
+				status = false;
+			}
 
-			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			/* re-initialize to discard the carried key-stream before the nonce is rewound */
+			memcpy(ks, nonce, sizeof(ks));
+			qsc_rhx_initialize(&state, &kp, true, RHX512);
+			state.nonce = ks;
+			qsc_rhx_ctrle_transform(&state, encl, msg, mlen);
+
+			if (qsc_intutils_are_equal8(encl, expl, mlen) == false ||
+				qsc_intutils_are_equal8(ks, ctrl, QSC_RHX_BLOCK_SIZE) == false)
 			{
 				status = false;
-				break;
 			}
 
-			/* reset the state */
-			free(dec);
-			free(enc);
-			free(msg);
+			qsc_rhx_dispose(&state);
 			++tctr;
 		}
 		else
 		{
 			status = false;
-			break;
 		}
+
+		free(encb);
+		free(encl);
+		free(expb);
+		free(expl);
+		free(msg);
 	}
 
 	return status;
 }
 
-bool qsctest_rhx512_ctr_stress()
+bool qsctest_rhx256_ctr_stream()
 {
-	uint8_t* dec;
-	uint8_t* enc;
-	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
-	uint8_t* msg;
-	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
 	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce1[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce2[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
 	qsc_rhx_state state1;
 	qsc_rhx_state state2;
+	size_t i;
 	size_t mlen;
+	size_t oft;
+	size_t seg;
 	size_t tctr;
-	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
 	bool status;
 
 	tctr = 0;
 	status = true;
 
-	while (tctr < RHX_TEST_CYCLES)
+	while (tctr < RHX_TEST_CYCLES && status == true)
 	{
+		/* a random length 1-4095 */
 		mlen = 0;
 
-		do
+		while (mlen == 0)
 		{
 			qsc_csp_generate(pmcnt, sizeof(pmcnt));
 			memcpy(&mlen, pmcnt, sizeof(uint16_t));
-		} 
-		while (mlen == 0);
+			mlen &= 0x0FFF;
+		}
 
-		dec = (uint8_t*)malloc(mlen);
-		enc = (uint8_t*)malloc(mlen);
+		enc1 = (uint8_t*)malloc(mlen);
+		enc2 = (uint8_t*)malloc(mlen);
 		msg = (uint8_t*)malloc(mlen);
 
-		if (dec != NULL && enc != NULL && msg != NULL)
+		if (enc1 != NULL && enc2 != NULL && msg != NULL)
 		{
-			qsc_intutils_clear8(dec, mlen);
-			qsc_intutils_clear8(enc, mlen);
-			qsc_intutils_clear8(msg, mlen);
-
-			/* generate the key and nonce */
 			qsc_csp_generate(key, sizeof(key));
 			qsc_csp_generate(ncopy, sizeof(ncopy));
-			/* use a random sized message 1-65535 */
 			qsc_csp_generate(msg, mlen);
 
-			/* initialize the key parameters struct, info is optional */
-			memcpy(nonce, ncopy, sizeof(nonce));
-			qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce, NULL, 0 };
-
-			/* initialize the state */
-			qsc_rhx_initialize(&state1, &kp1, true, RHX512);
-
-			/* encrypt the array */
-			qsc_rhx_ctrbe_transform(&state1, enc, msg, mlen);
-
-			/* erase the round-key array and reset the state */
-			qsc_rhx_dispose(&state1);
-
-			/* reset the nonce */
-			memcpy(nonce, ncopy, sizeof(nonce));
-			qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce, NULL, 0 };
-
-			/* initialize the state; CTR mode is always initialized as encrypt equals true */
-			qsc_rhx_initialize(&state2, &kp2, true, RHX512);
-
-			/* test decryption by using ciphertest as input */
-			qsc_rhx_ctrbe_transform(&state2, dec, enc, mlen);
-
-			/* erase the round-key array and reset the state */
-			qsc_rhx_dispose(&state2);
-
-			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			/* big endian on the first pass, little endian on the second */
+			for (i = 0; i < 2; ++i)
 			{
-				status = false;
-				break;
+				memcpy(nonce1, ncopy, sizeof(ncopy));
+				memcpy(nonce2, ncopy, sizeof(ncopy));
+				qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce1, NULL, 0 };
+				qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce2, NULL, 0 };
+				qsc_rhx_initialize(&state1, &kp1, true, RHX256);
+				qsc_rhx_initialize(&state2, &kp2, true, RHX256);
+
+				if (i == 0)
+				{
+					qsc_rhx_ctrbe_transform(&state1, enc1, msg, mlen);
+				}
+				else
+				{
+					qsc_rhx_ctrle_transform(&state1, enc1, msg, mlen);
+				}
+
+				/* transform the same message in random sized segments */
+				for (oft = 0; oft < mlen; oft += seg)
+				{
+					qsc_csp_generate(pmcnt, 1);
+					seg = qsc_intutils_min((size_t)pmcnt[0] + 1, mlen - oft);
+
+					if (i == 0)
+					{
+						qsc_rhx_ctrbe_transform(&state2, enc2 + oft, msg + oft, seg);
+					}
+					else
+					{
+						qsc_rhx_ctrle_transform(&state2, enc2 + oft, msg + oft, seg);
+					}
+				}
+
+				/* the output and the final counter must match the single call */
+				if (qsc_intutils_are_equal8(enc1, enc2, mlen) == false ||
+					qsc_intutils_are_equal8(nonce1, nonce2, sizeof(nonce1)) == false)
+				{
+					status = false;
+				}
+
+				qsc_rhx_dispose(&state1);
+				qsc_rhx_dispose(&state2);
 			}
 
-			/* reset the state */
-			free(dec);
-			free(enc);
-			free(msg);
 			++tctr;
 		}
 		else
 		{
 			status = false;
-			break;
 		}
+
+		free(enc1);
+		free(enc2);
+		free(msg);
 	}
 
 	return status;
@@ -2055,6 +2979,274 @@ bool qsctest_hba_rhx512_stress()
 	return status;
 }
 
+bool qsctest_hba_rhx256_stream()
+{
+	uint8_t aad[20] = { 0 };
+	uint8_t code[QSC_HBA256_MAC_LENGTH] = { 0 };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce1[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce2[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce3[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	qsc_rhx_hba256_state state1;
+	qsc_rhx_hba256_state state2;
+	qsc_rhx_hba256_state state3;
+	size_t i;
+	size_t mlen;
+	size_t oft;
+	size_t seg;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < HBA_TEST_CYCLES && status == true)
+	{
+		qsc_csp_generate(aad, sizeof(aad));
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		memcpy(nonce1, ncopy, sizeof(ncopy));
+		memcpy(nonce2, ncopy, sizeof(ncopy));
+		memcpy(nonce3, ncopy, sizeof(ncopy));
+
+		qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce1, NULL, 0 };
+		qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce2, NULL, 0 };
+		qsc_rhx_keyparams kp3 = { key, sizeof(key), nonce3, NULL, 0 };
+
+		/* single call encryption, streamed encryption, and streamed decryption */
+		qsc_rhx_hba256_initialize(&state1, &kp1, true);
+		qsc_rhx_hba256_initialize(&state2, &kp2, true);
+		qsc_rhx_hba256_initialize(&state3, &kp3, false);
+
+		/* two messages, the states must remain synchronized across messages */
+		for (i = 0; i < 2; ++i)
+		{
+			/* a random length 0-4095 */
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			mlen &= 0x0FFF;
+
+			dec = (uint8_t*)malloc(mlen + 1);
+			enc1 = (uint8_t*)malloc(mlen + QSC_HBA256_MAC_LENGTH);
+			enc2 = (uint8_t*)malloc(mlen + 1);
+			msg = (uint8_t*)malloc(mlen + 1);
+
+			if (dec != NULL && enc1 != NULL && enc2 != NULL && msg != NULL)
+			{
+				qsc_csp_generate(msg, mlen + 1);
+
+				qsc_rhx_hba256_set_associated(&state1, aad, sizeof(aad));
+				qsc_rhx_hba256_transform(&state1, enc1, msg, mlen);
+
+				/* encrypt the same message in random sized segments */
+				for (oft = 0; oft < mlen; oft += seg)
+				{
+					qsc_csp_generate(pmcnt, 1);
+					seg = qsc_intutils_min((size_t)pmcnt[0] + 1, mlen - oft);
+					qsc_rhx_hba256_update(&state2, enc2 + oft, msg + oft, seg);
+				}
+
+				qsc_rhx_hba256_set_associated(&state2, aad, sizeof(aad));
+				qsc_rhx_hba256_finalize(&state2, code);
+
+				if (qsc_intutils_are_equal8(enc1, enc2, mlen) == false ||
+					qsc_intutils_are_equal8(enc1 + mlen, code, QSC_HBA256_MAC_LENGTH) == false)
+				{
+					status = false;
+				}
+
+				/* decrypt in-place, in segments that do not align with the block size */
+				memcpy(dec, enc1, mlen);
+
+				for (oft = 0; oft < mlen; oft += seg)
+				{
+					seg = qsc_intutils_min((size_t)QSC_RHX_BLOCK_SIZE + 3, mlen - oft);
+					qsc_rhx_hba256_update(&state3, dec + oft, dec + oft, seg);
+				}
+
+				qsc_rhx_hba256_set_associated(&state3, aad, sizeof(aad));
+
+				if (qsc_rhx_hba256_finalize(&state3, enc1 + mlen) == false)
+				{
+					status = false;
+				}
+
+				if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+				{
+					status = false;
+				}
+			}
+			else
+			{
+				status = false;
+			}
+
+			free(dec);
+			free(enc1);
+			free(enc2);
+			free(msg);
+		}
+
+		/* a modified code must be rejected */
+		qsc_rhx_hba256_set_associated(&state2, aad, sizeof(aad));
+		qsc_rhx_hba256_finalize(&state2, code);
+		code[0] ^= 0x01;
+		qsc_rhx_hba256_set_associated(&state3, aad, sizeof(aad));
+
+		if (qsc_rhx_hba256_finalize(&state3, code) == true)
+		{
+			status = false;
+		}
+
+		qsc_rhx_hba256_dispose(&state1);
+		qsc_rhx_hba256_dispose(&state2);
+		qsc_rhx_hba256_dispose(&state3);
+		++tctr;
+	}
+
+	return status;
+}
+
+bool qsctest_hba_rhx512_stream()
+{
+	uint8_t aad[20] = { 0 };
+	uint8_t code[QSC_HBA512_MAC_LENGTH] = { 0 };
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce1[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce2[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce3[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	qsc_rhx_hba512_state state1;
+	qsc_rhx_hba512_state state2;
+	qsc_rhx_hba512_state state3;
+	size_t i;
+	size_t mlen;
+	size_t oft;
+	size_t seg;
+	size_t tctr;
+	bool status;
+
+	tctr = 0;
+	status = true;
+
+	while (tctr < HBA_TEST_CYCLES && status == true)
+	{
+		qsc_csp_generate(aad, sizeof(aad));
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		memcpy(nonce1, ncopy, sizeof(ncopy));
+		memcpy(nonce2, ncopy, sizeof(ncopy));
+		memcpy(nonce3, ncopy, sizeof(ncopy));
+
+		qsc_rhx_keyparams kp1 = { key, sizeof(key), nonce1, NULL, 0 };
+		qsc_rhx_keyparams kp2 = { key, sizeof(key), nonce2, NULL, 0 };
+		qsc_rhx_keyparams kp3 = { key, sizeof(key), nonce3, NULL, 0 };
+
+		/* single call encryption, streamed encryption, and streamed decryption */
+		qsc_rhx_hba512_initialize(&state1, &kp1, true);
+		qsc_rhx_hba512_initialize(&state2, &kp2, true);
+		qsc_rhx_hba512_initialize(&state3, &kp3, false);
+
+		/* two messages, the states must remain synchronized across messages */
+		for (i = 0; i < 2; ++i)
+		{
+			/* a random length 0-4095 */
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			mlen &= 0x0FFF;
+
+			dec = (uint8_t*)malloc(mlen + 1);
+			enc1 = (uint8_t*)malloc(mlen + QSC_HBA512_MAC_LENGTH);
+			enc2 = (uint8_t*)malloc(mlen + 1);
+			msg = (uint8_t*)malloc(mlen + 1);
+
+			if (dec != NULL && enc1 != NULL && enc2 != NULL && msg != NULL)
+			{
+				qsc_csp_generate(msg, mlen + 1);
+
+				qsc_rhx_hba512_set_associated(&state1, aad, sizeof(aad));
+				qsc_rhx_hba512_transform(&state1, enc1, msg, mlen);
+
+				/* encrypt the same message in random sized segments */
+				for (oft = 0; oft < mlen; oft += seg)
+				{
+					qsc_csp_generate(pmcnt, 1);
+					seg = qsc_intutils_min((size_t)pmcnt[0] + 1, mlen - oft);
+					qsc_rhx_hba512_update(&state2, enc2 + oft, msg + oft, seg);
+				}
+
+				qsc_rhx_hba512_set_associated(&state2, aad, sizeof(aad));
+				qsc_rhx_hba512_finalize(&state2, code);
+
+				if (qsc_intutils_are_equal8(enc1, enc2, mlen) == false ||
+					qsc_intutils_are_equal8(enc1 + mlen, code, QSC_HBA512_MAC_LENGTH) == false)
+				{
+					status = false;
+				}
+
+				/* decrypt in-place, in segments that do not align with the block size */
+				memcpy(dec, enc1, mlen);
+
+				for (oft = 0; oft < mlen; oft += seg)
+				{
+					seg = qsc_intutils_min((size_t)QSC_RHX_BLOCK_SIZE + 3, mlen - oft);
+					qsc_rhx_hba512_update(&state3, dec + oft, dec + oft, seg);
+				}
+
+				qsc_rhx_hba512_set_associated(&state3, aad, sizeof(aad));
+
+				if (qsc_rhx_hba512_finalize(&state3, enc1 + mlen) == false)
+				{
+					status = false;
+				}
+
+				if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+				{
+					status = false;
+				}
+			}
+			else
+			{
+				status = false;
+			}
+
+			free(dec);
+			free(enc1);
+			free(enc2);
+			free(msg);
+		}
+
+		/* a modified code must be rejected */
+		qsc_rhx_hba512_set_associated(&state2, aad, sizeof(aad));
+		qsc_rhx_hba512_finalize(&state2, code);
+		code[0] ^= 0x01;
+		qsc_rhx_hba512_set_associated(&state3, aad, sizeof(aad));
+
+		if (qsc_rhx_hba512_finalize(&state3, code) == true)
+		{
+			status = false;
+		}
+
+		qsc_rhx_hba512_dispose(&state1);
+		qsc_rhx_hba512_dispose(&state2);
+		qsc_rhx_hba512_dispose(&state3);
+		++tctr;
+	}
+
+	return status;
+}
+
 void qsctest_aes_run()
 {
 	if (qsctest_fips_aes128_cbc() == true)
@@ -2110,6 +3302,60 @@ void qsctest_aes_run()
 	{
 		qsctest_print_safe("Failure! Failed the FIPS 197 ECB(AES-256) KAT test. \n");
 	}
+
+	if (qsctest_aes128_gcm_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the GCM(AES-128) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the GCM(AES-128) KAT test. \n");
+	}
+
+	if (qsctest_aes256_gcm_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the GCM(AES-256) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the GCM(AES-256) KAT test. \n");
+	}
+
+	if (qsctest_aes256_gcm_long_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the GCM(AES-256) long KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the GCM(AES-256) long KAT test. \n");
+	}
+
+	if (qsctest_aes_gcm_stress() == true)
+	{
+		qsctest_print_safe("Success! Passed the GCM(AES-256) stress test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the GCM(AES-256) stress test. \n");
+	}
+
+	if (qsctest_aes128_xts_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the IEEE 1619 XTS(AES-128) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the IEEE 1619 XTS(AES-128) KAT test. \n");
+	}
+
+	if (qsctest_aes256_xts_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the IEEE 1619 XTS(AES-256) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the IEEE 1619 XTS(AES-256) KAT test. \n");
+	}
 }
 
 void qsctest_rhx_run()
@@ -2150,6 +3396,33 @@ void qsctest_rhx_run()
 		qsctest_print_safe("Failure! Failed the CBC(RHX-512) stress test. \n");
 	}
 
+	if (qsctest_rhx256_cbc_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CBC(RHX-256) parallel decryption equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CBC(RHX-256) parallel decryption equality test. \n");
+	}
+
+	if (qsctest_rhx256_cbc_multi_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CBC(RHX-256) multi-stream encryption equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CBC(RHX-256) multi-stream encryption equality test. \n");
+	}
+
+	if (qsctest_rhx_xts_stress() == true)
+	{
+		qsctest_print_safe("Success! Passed the XTS(RHX-256, RHX-512) stress test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the XTS(RHX-256, RHX-512) stress test. \n");
+	}
+
 	if (qsctest_rhx256_ctr_stress() == true)
 	{
 		qsctest_print_safe("Success! Passed the CTR(RHX-256) stress test. \n");
@@ -2208,6 +3481,24 @@ void qsctest_rhx_run()
 
 #endif
 
+	if (qsctest_rhx512_ctr_ecb_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CTR(RHX-512) counter and key-stream equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CTR(RHX-512) counter and key-stream equality test. \n");
+	}
+
+	if (qsctest_rhx256_ctr_stream() == true)
+	{
+		qsctest_print_safe("Success! Passed the CTR(RHX-256) streaming test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CTR(RHX-256) streaming test. \n");
+	}
+
 	if (qsctest_rhx256_monte_carlo() == true)
 	{
 		qsctest_print_safe("Success! Passed the RHX-256 Monte Carlo test. \n");
@@ -2261,4 +3552,22 @@ void qsctest_rhx_run()
 	{
 		qsctest_print_safe("Failure! Failed the RHX-512 HBA AEAD mode stress test. \n");
 	}
+
+	if (qsctest_hba_rhx256_stream() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-256 HBA AEAD streaming equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-256 HBA AEAD streaming equality test. \n");
+	}
+
+	if (qsctest_hba_rhx512_stream() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-512 HBA AEAD streaming equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-512 HBA AEAD streaming equality test. \n");
+	}
 }
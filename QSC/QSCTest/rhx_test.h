@@ -14,7 +14,7 @@
 #define QSCTEST_RHX_TEST_H
 
 #include "common.h"
-#include "../RHX/rhx.h"
+#include "../QSC/rhx.h"
 
 #if defined(QSC_SYSTEM_AESNI_ENABLED) && defined(QSC_SYSTEM_HAS_AVX512)
 #	define WIDE_BLOCK_TESTS
@@ -82,6 +82,57 @@ bool qsctest_fips_aes128_ecb();
 */
 bool qsctest_fips_aes256_ecb();
 
+/**
+* \brief Tests the GCM mode with 128-bit key KAT vectors from the GCM specification.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* GCM: <a href="https://csrc.nist.rip/groups/ST/toolkit/BCM/documents/proposedmodes/gcm/gcm-spec.pdf">The Galois/Counter Mode of Operation, Appendix B, Test Cases 2 and 4</a>
+*/
+bool qsctest_aes128_gcm_kat();
+
+/**
+* \brief Tests the GCM mode with 256-bit key KAT vectors from the GCM specification.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* GCM: <a href="https://csrc.nist.rip/groups/ST/toolkit/BCM/documents/proposedmodes/gcm/gcm-spec.pdf">The Galois/Counter Mode of Operation, Appendix B, Test Cases 14 and 16</a>
+*/
+bool qsctest_aes256_gcm_kat();
+
+/**
+* \brief Tests the GCM(AES-256) mode with a message and associated data longer than 16 blocks,
+* setting the associated data in one call and in unaligned segments.
+*
+* \return Returns true for success
+*/
+bool qsctest_aes256_gcm_long_kat();
+
+/**
+* \brief Tests the GCM(AES-256) AEAD mode for correct operation with random message sizes, and that a modified tag is rejected.
+*
+* \return Returns true for success
+*/
+bool qsctest_aes_gcm_stress();
+
+/**
+* \brief Compares the big and little endian CTR(RHX-512) modes with a key-stream built from single ECB blocks,
+* on random lengths, and checks the final counter value.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx512_ctr_ecb_equality();
+
+/**
+* \brief Compares the big and little endian CTR(RHX-256) modes called in random sized segments with a single call,
+* including the final counter value.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx256_ctr_stream();
+
 /**
 * \brief Tests the counter mode; CTR(RHX-256) for correct operation.
 *
@@ -89,6 +140,27 @@ bool qsctest_fips_aes256_ecb();
 */
 bool qsctest_rhx256_ctr_stress();
 
+/**
+* \brief Tests the AES-128 XTS mode using the IEEE 1619 vectors, including ciphertext stealing.
+*
+* \return Returns true for success
+*/
+bool qsctest_aes128_xts_kat();
+
+/**
+* \brief Tests the AES-256 XTS mode using an IEEE 1619 vector.
+*
+* \return Returns true for success
+*/
+bool qsctest_aes256_xts_kat();
+
+/**
+* \brief Tests the XTS mode with the RHX-256 and RHX-512 ciphers for correct operation on random sized data units.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx_xts_stress();
+
 /**
 * \brief Tests the cipher block chaining mode; CBC(RHX-256) for correct operation.
 *
@@ -103,6 +175,20 @@ bool qsctest_rhx256_cbc_stress();
 */
 bool qsctest_rhx512_cbc_stress();
 
+/**
+* \brief Tests the parallel CBC(RHX-256) decryption against block-wise decryption, decrypting in-place.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx256_cbc_parallel_equality();
+
+/**
+* \brief Tests the multi-stream CBC(RHX-256) encryption against serial encryption of each stream.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx256_cbc_multi_equality();
+
 /**
 * \brief Tests the counter mode; CTR(RHX-512) for correct operation.
 *
@@ -228,6 +314,22 @@ bool qsctest_hba_rhx256_stress();
 */
 bool qsctest_hba_rhx512_stress();
 
+/**
+* \brief Compares the streamed HBA RHX-256 update and finalize functions with the single call transform,
+* using random segment sizes, and tests streamed in-place decryption.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx256_stream();
+
+/**
+* \brief Compares the streamed HBA RHX-512 update and finalize functions with the single call transform,
+* using random segment sizes, and tests streamed in-place decryption.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx512_stream();
+
 /**
 * \brief Run the set of FIPS 197 AES tests
 */
@@ -4770,6 +4770,84 @@ bool qsctest_sphincsplus_signature_integrity()
 	return ret;
 }
 
+bool qsctest_sphincsplus_detached_test()
+{
+	uint8_t msg[QSCTEST_SPHINCSPLUS_STREAM_MLEN] = { 0 };
+	uint8_t* smsg = (uint8_t*)malloc(QSC_SPHINCSPLUS_SIGNATURE_SIZE + QSCTEST_SPHINCSPLUS_STREAM_MLEN);
+	uint8_t* sig = (uint8_t*)malloc(QSC_SPHINCSPLUS_SIGNATURE_SIZE);
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_SPHINCSPLUS_PRIVATEKEY_SIZE];
+	uint8_t pk[QSC_SPHINCSPLUS_PUBLICKEY_SIZE];
+	qsc_sphincsplus_stream_state ctx;
+	size_t pos;
+	size_t smsglen;
+	bool ret;
+
+	assert(smsg != NULL && sig != NULL);
+
+	ret = true;
+	smsglen = 0;
+
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_sphincsplus_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* the same random stream must give the signature part of the signed message */
+	qsctest_nistrng_prng_initialize(seed, msg, QSCTEST_SPHINCSPLUS_MLEN0);
+	qsc_sphincsplus_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, msg, QSCTEST_SPHINCSPLUS_MLEN0);
+	qsc_sphincsplus_sign_detached(sig, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+	if (qsc_intutils_are_equal8(smsg, sig, QSC_SPHINCSPLUS_SIGNATURE_SIZE) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_sphincsplus_detached_test: detached signature output mismatch -SD1 \n");
+		ret = false;
+	}
+
+	if (ret == true)
+	{
+		qsc_sphincsplus_verify_initialize(&ctx, sig, pk);
+
+		/* uneven blocks that straddle the hash rate */
+		for (pos = 0; pos < sizeof(msg); pos += 77)
+		{
+			qsc_sphincsplus_verify_update(&ctx, msg + pos, (sizeof(msg) - pos < 77) ? sizeof(msg) - pos : 77);
+		}
+
+		if (qsc_sphincsplus_verify_finalize(&ctx, sig, pk) != true || qsc_sphincsplus_verify_detached(sig, msg, sizeof(msg), pk) != true)
+		{
+			qsctest_print_safe("Failure! qsctest_sphincsplus_detached_test: detached signature verification has failed -SD2 \n");
+			ret = false;
+		}
+	}
+
+	if (ret == true)
+	{
+		msg[sizeof(msg) - 1] ^= 1U;
+		qsc_sphincsplus_verify_initialize(&ctx, sig, pk);
+		qsc_sphincsplus_verify_update(&ctx, msg, sizeof(msg));
+
+		if (qsc_sphincsplus_verify_finalize(&ctx, sig, pk) != false)
+		{
+			qsctest_print_safe("Failure! qsctest_sphincsplus_detached_test: a modified message was accepted -SD3 \n");
+			ret = false;
+		}
+	}
+
+	if (smsg != NULL)
+	{
+		free(smsg);
+	}
+
+	if (sig != NULL)
+	{
+		free(sig);
+	}
+
+	return ret;
+}
+
 bool qsctest_sphincsplus_stress_test()
 {
 	uint8_t msg[QSCTEST_SPHINCSPLUS_MLEN0] = { 0 };
@@ -4855,6 +4933,15 @@ void qsctest_sphincsplus_run()
 		qsctest_print_safe("Failure! Failed SphincsPlus known answer integrity tests. \n");
 	}
 
+	if (qsctest_sphincsplus_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the SphincsPlus detached and streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SphincsPlus detached and streaming signature test. \n");
+	}
+
 	if (qsctest_sphincsplus_stress_test() == true)
 	{
 		qsctest_print_safe("Success! The SphincsPlus stress test has succeeded. \n");
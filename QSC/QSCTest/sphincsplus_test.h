@@ -16,6 +16,7 @@
 #define QSCTEST_SPHINCSPLUS_MLEN1 66
 #define QSCTEST_SPHINCSPLUS_MLEN2 99
 #define QSCTEST_SPHINCSPLUS_MLEN3 132
+#define QSCTEST_SPHINCSPLUS_STREAM_MLEN 1000
 
 #ifdef _DEBUG
 #	define QSCTEST_SPHINCSPLUS_ITERATIONS 1
@@ -36,6 +37,12 @@ bool qsctest_sphincsplus_kat_test();
 */
 bool qsctest_sphincsplus_operations_test();
 
+/**
+* \brief Test that detached signatures match the signed-message api, and that streaming verification accepts them and rejects a modified message
+* \return Returns true for test success
+*/
+bool qsctest_sphincsplus_detached_test();
+
 /**
 * \brief Test the validity of a mutated secret key
 * \return Returns one (true) for test success